@@ -0,0 +1,68 @@
+#ifndef KATANA_LIBGALOIS_BENCHMARKS_RUNTIMEBENCH_H_
+#define KATANA_LIBGALOIS_BENCHMARKS_RUNTIMEBENCH_H_
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/Strings.h"
+#include "katana/Threads.h"
+
+/// \returns the thread counts to run benchmarks with: those listed in the
+/// environment variable KATANA_BENCHMARK_THREADS, e.g., "1,8,64", or else
+/// powers of two up to and including the number of hardware threads
+inline std::vector<long>
+BenchmarkThreadCounts() {
+  std::vector<long> counts;
+
+  std::string list;
+  if (katana::GetEnv("KATANA_BENCHMARK_THREADS", &list) && !list.empty()) {
+    for (std::string_view count : katana::SplitView(list, ",")) {
+      counts.emplace_back(std::stol(std::string(count)));
+    }
+    return counts;
+  }
+
+  long max_threads = std::max(1U, std::thread::hardware_concurrency());
+  for (long threads = 1; threads < max_threads; threads *= 2) {
+    counts.emplace_back(threads);
+  }
+  counts.emplace_back(max_threads);
+  return counts;
+}
+
+/// Register the arguments {threads, size} for every thread count and each of
+/// sizes, e.g., ->Apply(ThreadsAndSizes<1024, 1 << 20>)
+template <long... sizes>
+void
+ThreadsAndSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"threads", "size"});
+  for (long threads : BenchmarkThreadCounts()) {
+    for (long size : {sizes...}) {
+      b->Args({threads, size});
+    }
+  }
+  b->UseRealTime();
+}
+
+/// Activate the threads requested by state.range(0), and report the number
+/// actually activated, which can be fewer, as the threads counter
+inline void
+SetBenchmarkThreads(benchmark::State& state) {
+  unsigned threads = katana::setActiveThreads(state.range(0));
+  state.counters["threads"] = threads;
+}
+
+/// Report state.range(1) items per iteration, for an items_per_second rate
+/// that is comparable across sizes
+inline void
+SetBenchmarkItems(benchmark::State& state) {
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "RuntimeBench.h"
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Galois.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+
+namespace {
+
+void
+InsertBagPush(benchmark::State& state) {
+  SetBenchmarkThreads(state);
+  uint64_t size = state.range(1);
+
+  for (auto _ : state) {
+    katana::InsertBag<uint64_t> bag;
+    katana::do_all(katana::iterate(uint64_t{0}, size), [&](uint64_t i) {
+      bag.push(i);
+    });
+    benchmark::DoNotOptimize(bag.begin());
+  }
+
+  SetBenchmarkItems(state);
+}
+
+void
+PerThreadStorageGetLocal(benchmark::State& state) {
+  SetBenchmarkThreads(state);
+  uint64_t size = state.range(1);
+  katana::PerThreadStorage<uint64_t> sums;
+
+  for (auto _ : state) {
+    katana::do_all(katana::iterate(uint64_t{0}, size), [&](uint64_t i) {
+      *sums.getLocal() += i;
+    });
+  }
+  benchmark::DoNotOptimize(*sums.getLocal());
+
+  SetBenchmarkItems(state);
+}
+
+void
+GAccumulatorReduce(benchmark::State& state) {
+  SetBenchmarkThreads(state);
+  uint64_t size = state.range(1);
+
+  for (auto _ : state) {
+    katana::GAccumulator<uint64_t> sum;
+    katana::do_all(katana::iterate(uint64_t{0}, size), [&](uint64_t i) {
+      sum += i;
+    });
+    KATANA_LOG_ASSERT(sum.reduce() == size * (size - 1) / 2);
+  }
+
+  SetBenchmarkItems(state);
+}
+
+void
+DynamicBitsetSet(benchmark::State& state) {
+  SetBenchmarkThreads(state);
+  uint64_t size = state.range(1);
+  katana::DynamicBitset bitset;
+  bitset.resize(size);
+
+  for (auto _ : state) {
+    bitset.reset();
+    // Set every third bit, so that neighboring threads contend for words
+    katana::do_all(katana::iterate(uint64_t{0}, size / 3), [&](uint64_t i) {
+      bitset.set(i * 3);
+    });
+    benchmark::DoNotOptimize(bitset.test(0));
+  }
+
+  state.SetItemsProcessed(state.iterations() * (size / 3));
+}
+
+void
+DynamicBitsetCount(benchmark::State& state) {
+  SetBenchmarkThreads(state);
+  uint64_t size = state.range(1);
+  katana::DynamicBitset bitset;
+  bitset.resize(size);
+  for (uint64_t i = 0; i < size; i += 3) {
+    bitset.set(i);
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(bitset.count());
+  }
+
+  SetBenchmarkItems(state);
+}
+
+BENCHMARK(InsertBagPush)->Apply(ThreadsAndSizes<1 << 12, 1 << 22>);
+BENCHMARK(PerThreadStorageGetLocal)->Apply(ThreadsAndSizes<1 << 12, 1 << 22>);
+BENCHMARK(GAccumulatorReduce)->Apply(ThreadsAndSizes<1 << 12, 1 << 22>);
+BENCHMARK(DynamicBitsetSet)->Apply(ThreadsAndSizes<1 << 12, 1 << 22>);
+BENCHMARK(DynamicBitsetCount)->Apply(ThreadsAndSizes<1 << 12, 1 << 26>);
+
+}  // namespace
@@ -0,0 +1,117 @@
+#include <memory>
+
+#include "RuntimeBench.h"
+#include "katana/Barrier.h"
+#include "katana/Galois.h"
+
+namespace {
+
+/// A do_all with an empty operator, to measure the overhead of scheduling
+/// iterations. With steal, every thread also looks for work to steal before
+/// it finishes.
+template <bool steal>
+void
+DoAll(benchmark::State& state) {
+  SetBenchmarkThreads(state);
+  uint64_t size = state.range(1);
+
+  for (auto _ : state) {
+    if constexpr (steal) {
+      katana::do_all(
+          katana::iterate(uint64_t{0}, size),
+          [](uint64_t i) { benchmark::DoNotOptimize(i); }, katana::steal());
+    } else {
+      katana::do_all(katana::iterate(uint64_t{0}, size), [](uint64_t i) {
+        benchmark::DoNotOptimize(i);
+      });
+    }
+  }
+
+  SetBenchmarkItems(state);
+}
+
+/// A do_all where the iterations of the first thread are much more expensive
+/// than the others, so that other threads must steal to balance the load
+void
+DoAllStealImbalanced(benchmark::State& state) {
+  SetBenchmarkThreads(state);
+  uint64_t size = state.range(1);
+  uint64_t first_block = size / katana::getActiveThreads();
+
+  for (auto _ : state) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, size),
+        [&](uint64_t i) {
+          uint64_t work = i < first_block ? 64 : 1;
+          for (uint64_t j = 0; j < work; ++j) {
+            benchmark::DoNotOptimize(j);
+          }
+        },
+        katana::steal());
+  }
+
+  SetBenchmarkItems(state);
+}
+
+/// size runs of on_each with an empty operator, to measure the cost of waking
+/// and joining the threads of the thread pool
+void
+OnEach(benchmark::State& state) {
+  SetBenchmarkThreads(state);
+  uint64_t size = state.range(1);
+
+  for (auto _ : state) {
+    for (uint64_t i = 0; i < size; ++i) {
+      katana::on_each([](unsigned tid, unsigned) {
+        benchmark::DoNotOptimize(tid);
+      });
+    }
+  }
+
+  SetBenchmarkItems(state);
+}
+
+/// Every thread waits size times at a barrier made by make_barrier
+void
+BarrierWait(
+    benchmark::State& state,
+    std::unique_ptr<katana::Barrier> (*make_barrier)(unsigned)) {
+  SetBenchmarkThreads(state);
+  uint64_t size = state.range(1);
+
+  std::unique_ptr<katana::Barrier> barrier =
+      make_barrier(katana::getActiveThreads());
+  if (!barrier) {
+    state.SkipWithError("barrier is not available");
+    return;
+  }
+
+  for (auto _ : state) {
+    katana::on_each([&](unsigned, unsigned) {
+      for (uint64_t i = 0; i < size; ++i) {
+        barrier->Wait();
+      }
+    });
+  }
+
+  SetBenchmarkItems(state);
+}
+
+BENCHMARK_TEMPLATE(DoAll, false)->Apply(ThreadsAndSizes<1 << 10, 1 << 22>);
+BENCHMARK_TEMPLATE(DoAll, true)->Apply(ThreadsAndSizes<1 << 10, 1 << 22>);
+BENCHMARK(DoAllStealImbalanced)->Apply(ThreadsAndSizes<1 << 20>);
+BENCHMARK(OnEach)->Apply(ThreadsAndSizes<1 << 10>);
+
+BENCHMARK_CAPTURE(BarrierWait, Counting, katana::CreateCountingBarrier)
+    ->Apply(ThreadsAndSizes<1 << 12>);
+BENCHMARK_CAPTURE(
+    BarrierWait, Dissemination, katana::CreateDisseminationBarrier)
+    ->Apply(ThreadsAndSizes<1 << 12>);
+BENCHMARK_CAPTURE(BarrierWait, MCS, katana::CreateMCSBarrier)
+    ->Apply(ThreadsAndSizes<1 << 12>);
+BENCHMARK_CAPTURE(BarrierWait, Simple, katana::CreateSimpleBarrier)
+    ->Apply(ThreadsAndSizes<1 << 12>);
+BENCHMARK_CAPTURE(BarrierWait, Topo, katana::CreateTopoBarrier)
+    ->Apply(ThreadsAndSizes<1 << 12>);
+
+}  // namespace
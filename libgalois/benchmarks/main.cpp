@@ -0,0 +1,14 @@
+#include <benchmark/benchmark.h>
+
+#include "katana/SharedMemSys.h"
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  katana::SharedMemSys sys;
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,50 @@
+#include "RuntimeBench.h"
+#include "katana/Galois.h"
+
+namespace {
+
+/// A for_each where each of size initial items pushes one more item, to
+/// measure the cost of pushing to and popping from a worklist
+template <typename WL>
+void
+ForEach(benchmark::State& state) {
+  SetBenchmarkThreads(state);
+  uint64_t size = state.range(1);
+
+  for (auto _ : state) {
+    katana::for_each(
+        katana::iterate(uint64_t{0}, size),
+        [&](uint64_t i, auto& ctx) {
+          if (i < size) {
+            ctx.push(i + size);
+          }
+        },
+        katana::wl<WL>(), katana::disable_conflict_detection());
+  }
+
+  state.SetItemsProcessed(state.iterations() * 2 * state.range(1));
+}
+
+/// Priorities for OBIM: items are ordered by blocks of 1024
+struct BlockIndexer {
+  uint64_t operator()(uint64_t i) const { return i / 1024; }
+};
+
+using Obim = katana::OrderedByIntegerMetric<
+    BlockIndexer, katana::PerSocketChunkFIFO<64>>;
+
+BENCHMARK_TEMPLATE(ForEach, katana::ChunkFIFO<64>)
+    ->Apply(ThreadsAndSizes<1 << 20>);
+BENCHMARK_TEMPLATE(ForEach, katana::ChunkLIFO<64>)
+    ->Apply(ThreadsAndSizes<1 << 20>);
+BENCHMARK_TEMPLATE(ForEach, katana::PerSocketChunkFIFO<8>)
+    ->Apply(ThreadsAndSizes<1 << 20>);
+BENCHMARK_TEMPLATE(ForEach, katana::PerSocketChunkFIFO<64>)
+    ->Apply(ThreadsAndSizes<1 << 20>);
+BENCHMARK_TEMPLATE(ForEach, katana::PerSocketChunkLIFO<64>)
+    ->Apply(ThreadsAndSizes<1 << 20>);
+BENCHMARK_TEMPLATE(ForEach, katana::PerSocketChunkBag<64>)
+    ->Apply(ThreadsAndSizes<1 << 20>);
+BENCHMARK_TEMPLATE(ForEach, Obim)->Apply(ThreadsAndSizes<1 << 20>);
+
+}  // namespace
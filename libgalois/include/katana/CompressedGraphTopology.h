@@ -0,0 +1,249 @@
+#ifndef KATANA_LIBGALOIS_KATANA_COMPRESSEDGRAPHTOPOLOGY_H_
+#define KATANA_LIBGALOIS_KATANA_COMPRESSEDGRAPHTOPOLOGY_H_
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+
+#include "katana/LargeArray.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Range.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+#include "tsuba/FileFrame.h"
+#include "tsuba/FileView.h"
+
+namespace katana {
+
+/// A compressed graph topology holds the same out-edges as a GraphTopology,
+/// but stores the destinations of the out-edges of each node as a string of
+/// delta and varint coded bytes rather than as 32-bit node ids. When the
+/// neighbors of a node have nearby ids, this takes a fraction of the space.
+///
+/// Edge ids are the same as in the GraphTopology the compressed topology is
+/// made from, so edge properties are looked up as usual. Destinations are
+/// decoded on the fly while iterating over edges(node); there is no random
+/// access to the destination of an edge.
+///
+/// The on-storage layout is described by tsuba::CompressedCSRTopologyHeader.
+class KATANA_EXPORT CompressedGraphTopology {
+public:
+  using Node = GraphTopology::Node;
+  using Edge = GraphTopology::Edge;
+  using node_iterator = GraphTopology::node_iterator;
+  using nodes_range = GraphTopology::nodes_range;
+  using iterator = node_iterator;
+
+  /// Number of nodes covered by each entry of the sparse index into the
+  /// encoded destinations
+  static constexpr uint64_t kNodesPerBlock = 64;
+
+  /// An out-edge as produced by edge_iterator
+  struct OutEdge {
+    Edge id;
+    Node dest;
+  };
+
+  /// Iterates over the out-edges of a node, decoding destinations as it goes
+  class edge_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = OutEdge;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const OutEdge*;
+    using reference = const OutEdge&;
+
+    edge_iterator() = default;
+
+    /// \param pos points to the encoded destination of edge \param id;
+    /// \param src is the node whose edges end at \param end
+    edge_iterator(const uint8_t* pos, Edge id, Edge end, Node src)
+        : pos_(pos), edge_{id, src}, end_(end) {
+      if (edge_.id != end_) {
+        Decode();
+      }
+    }
+
+    reference operator*() const { return edge_; }
+    pointer operator->() const { return &edge_; }
+
+    edge_iterator& operator++() {
+      ++edge_.id;
+      if (edge_.id != end_) {
+        Decode();
+      }
+      return *this;
+    }
+
+    edge_iterator operator++(int) {
+      edge_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const edge_iterator& other) const {
+      return edge_.id == other.edge_.id;
+    }
+    bool operator!=(const edge_iterator& other) const {
+      return !(*this == other);
+    }
+
+  private:
+    void Decode() {
+      edge_.dest = static_cast<Node>(
+          static_cast<int64_t>(edge_.dest) + ZigZagDecode(ReadVarint(&pos_)));
+    }
+
+    const uint8_t* pos_{nullptr};
+    OutEdge edge_{};
+    Edge end_{};
+  };
+
+  using edges_range = StandardRange<edge_iterator>;
+
+  CompressedGraphTopology() = default;
+
+  CompressedGraphTopology(const CompressedGraphTopology&) = delete;
+  CompressedGraphTopology& operator=(const CompressedGraphTopology&) = delete;
+
+  /// Compress \param topology
+  static std::unique_ptr<CompressedGraphTopology> Make(
+      const GraphTopology& topology);
+
+  /// Use the compressed topology file in \param file_view in place. The
+  /// result refers to the memory of \param file_view and must not outlive it.
+  static Result<std::unique_ptr<CompressedGraphTopology>> Make(
+      const tsuba::FileView& file_view);
+
+  /// \returns a copy of \param that in memory of its own
+  static std::unique_ptr<CompressedGraphTopology> Copy(
+      const CompressedGraphTopology& that);
+
+  /// \returns a GraphTopology with the same edges as this one
+  std::unique_ptr<GraphTopology> Decompress() const;
+
+  /// \returns this topology in the compressed CSR file format
+  Result<std::unique_ptr<tsuba::FileFrame>> ToFileFrame() const;
+
+  uint64_t num_nodes() const { return out_indices_.size(); }
+
+  uint64_t num_edges() const { return num_edges_; }
+
+  /// \returns the number of bytes used to hold the encoded destinations
+  uint64_t num_dest_bytes() const { return dests_.size(); }
+
+  bool Equals(const CompressedGraphTopology& other) const;
+
+  // Edge accessors
+
+  std::pair<Edge, Edge> edge_range(Node node) const {
+    KATANA_LOG_DEBUG_ASSERT(node < out_indices_.size());
+    auto edge_start = node > 0 ? out_indices_[node - 1] : 0;
+    auto edge_end = out_indices_[node];
+    return std::make_pair(edge_start, edge_end);
+  }
+
+  uint64_t out_degree(Node node) const {
+    auto [begin_edge, end_edge] = edge_range(node);
+    return end_edge - begin_edge;
+  }
+
+  /// Gets the out-edges of some node. The size of the returned range is
+  /// computed by decoding it; prefer out_degree.
+  ///
+  /// \param node node to get the edges of
+  /// \returns iterable range of the OutEdges of node
+  edges_range edges(Node node) const {
+    auto [begin_edge, end_edge] = edge_range(node);
+    return MakeStandardRange(
+        edge_iterator(FindDests(node), begin_edge, end_edge, node),
+        edge_iterator(nullptr, end_edge, end_edge, node));
+  }
+
+  nodes_range nodes(Node begin, Node end) const {
+    return MakeStandardRange<node_iterator>(begin, end);
+  }
+
+  // Standard container concepts
+
+  node_iterator begin() const { return node_iterator(0); }
+
+  node_iterator end() const { return node_iterator(num_nodes()); }
+
+  size_t size() const { return num_nodes(); }
+
+  bool empty() const { return num_nodes() == 0; }
+
+  // Coding of destinations
+
+  static uint64_t ZigZagEncode(int64_t val) {
+    return (static_cast<uint64_t>(val) << 1) ^
+           static_cast<uint64_t>(val >> 63);
+  }
+
+  static int64_t ZigZagDecode(uint64_t val) {
+    return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+  }
+
+  /// \returns the number of bytes needed to write \param val as a varint
+  static uint64_t VarintSize(uint64_t val) {
+    uint64_t size = 1;
+    while (val >= 0x80) {
+      val >>= 7;
+      ++size;
+    }
+    return size;
+  }
+
+  /// Write \param val as a varint at \param *pos and advance \param *pos past
+  /// it
+  static void WriteVarint(uint64_t val, uint8_t** pos) {
+    while (val >= 0x80) {
+      *(*pos)++ = static_cast<uint8_t>(val | 0x80);
+      val >>= 7;
+    }
+    *(*pos)++ = static_cast<uint8_t>(val);
+  }
+
+  /// Read a varint at \param *pos and advance \param *pos past it
+  static uint64_t ReadVarint(const uint8_t** pos) {
+    uint64_t val = 0;
+    int shift = 0;
+    uint8_t byte = 0;
+    do {
+      byte = *(*pos)++;
+      val |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return val;
+  }
+
+private:
+  CompressedGraphTopology(
+      LargeArray<Edge>&& out_indices, LargeArray<uint64_t>&& block_offsets,
+      LargeArray<uint8_t>&& dests) noexcept;
+
+  /// \returns a pointer to the encoded destinations of \param node
+  const uint8_t* FindDests(Node node) const {
+    uint64_t block = node / kNodesPerBlock;
+    const uint8_t* pos = dests_.data() + block_offsets_[block];
+    // Skip the destinations of the nodes in the block before node
+    Node first = block * kNodesPerBlock;
+    uint64_t to_skip = edge_range(node).first - edge_range(first).first;
+    while (to_skip > 0) {
+      if (!(*pos++ & 0x80)) {
+        --to_skip;
+      }
+    }
+    return pos;
+  }
+
+  LargeArray<Edge> out_indices_;
+  LargeArray<uint64_t> block_offsets_;
+  LargeArray<uint8_t> dests_;
+  uint64_t num_edges_{0};
+};
+
+}  // namespace katana
+
+#endif
@@ -30,6 +30,7 @@
 #include "katana/TerminationDetection.h"
 #include "katana/ThreadPool.h"
 #include "katana/Timer.h"
+#include "katana/Trace.h"
 #include "katana/config.h"
 #include "katana/gIO.h"
 
@@ -58,6 +59,8 @@ class DoAllStealingExec {
     Iter shared_end;
     Diff_ty m_size;
     size_t num_iter;
+    // Chunks of work taken from other threads
+    size_t num_steals;
 
     // Stats
 
@@ -67,7 +70,8 @@ class DoAllStealingExec {
           shared_beg(),
           shared_end(),
           m_size(0),
-          num_iter(0) {
+          num_iter(0),
+          num_steals(0) {
       // TODO: fix this initialization problem,
       // see initThread
     }
@@ -78,9 +82,11 @@ class DoAllStealingExec {
           shared_beg(beg),
           shared_end(end),
           m_size(std::distance(beg, end)),
-          num_iter(0) {}
+          num_iter(0),
+          num_steals(0) {}
 
-    bool doWork(F func, const unsigned chunk_size) {
+    bool doWork(
+        F func, const unsigned chunk_size, const char* trace_category) {
       Iter beg(shared_beg);
       Iter end(shared_end);
 
@@ -88,6 +94,7 @@ class DoAllStealingExec {
 
       while (getWork(beg, end, chunk_size)) {
         didwork = true;
+        TraceSpan span("chunk", trace_category);
 
         for (; beg != end; ++beg) {
           if (NEED_STATS) {
@@ -254,6 +261,9 @@ private:
           std::distance(steal_beg, steal_end) == steal_size);
 
       poor.assignWork(steal_beg, steal_end, steal_size);
+      if (NEED_STATS) {
+        ++poor.num_steals;
+      }
     }
 
     return succ;
@@ -356,6 +366,7 @@ private:
   R range;
   F func;
   const char* loopname;
+  const char* trace_category;
   Diff_ty chunk_size;
   PerThreadStorage<ThreadContext> workers;
 
@@ -373,6 +384,8 @@ public:
       : range(_range),
         func(_func),
         loopname(katana::internal::getLoopName(argsTuple)),
+        trace_category(
+            Tracer::IsEnabled() ? Tracer::Intern(loopname) : loopname),
         chunk_size(get_trait_value<chunk_size_tag>(argsTuple).value),
         term(GetTerminationDetection(activeThreads)),
         totalTime(loopname, "Total"),
@@ -409,6 +422,8 @@ public:
     // printStats ();
   }
 
+  const char* TraceCategory() const { return trace_category; }
+
   void operator()(void) {
     ThreadContext& ctx = *workers.getLocal();
     totalTime.start();
@@ -418,7 +433,7 @@ public:
 
       execTime.start();
 
-      if (ctx.doWork(func, chunk_size)) {
+      if (ctx.doWork(func, chunk_size, trace_category)) {
         workHappened = true;
       }
 
@@ -427,7 +442,11 @@ public:
       KATANA_LOG_DEBUG_ASSERT(!ctx.hasWork());
 
       stealTime.start();
-      bool stole = trySteal(ctx);
+      bool stole;
+      {
+        TraceSpan span("steal", trace_category);
+        stole = trySteal(ctx);
+      }
       stealTime.stop();
 
       if (stole) {
@@ -437,9 +456,12 @@ public:
         KATANA_LOG_DEBUG_ASSERT(!ctx.hasWork());
         if (USE_TERM) {
           termTime.start();
-          term.SignalWorked(workHappened);
-
-          bool quit = !term.Working();
+          bool quit;
+          {
+            TraceSpan span("term", trace_category);
+            term.SignalWorked(workHappened);
+            quit = !term.Working();
+          }
           termTime.stop();
 
           if (quit) {
@@ -456,6 +478,7 @@ public:
 
     if (NEED_STATS) {
       katana::ReportStatSum(loopname, "Iterations", ctx.num_iter);
+      katana::ReportStatSum(loopname, "Steals", ctx.num_steals);
     }
   }
 };
@@ -472,7 +495,11 @@ struct ChooseDoAllImpl {
 
     GetThreadPool().run(
         activeThreads, [&exec]() { exec.initThread(); },
-        [&barrier]() { barrier.Wait(); }, std::ref(exec));
+        [&barrier, &exec]() {
+          TraceSpan span("barrier", exec.TraceCategory());
+          barrier.Wait();
+        },
+        std::ref(exec));
   }
 };
 
@@ -488,6 +515,8 @@ struct ChooseDoAllImpl<false> {
               NEED_STATS && has_trait<more_stats_tag, ArgsT>();
 
           const char* const loopname = katana::internal::getLoopName(argsTuple);
+          const char* const trace_category =
+              Tracer::IsEnabled() ? Tracer::Intern(loopname) : loopname;
 
           PerThreadTimer<MORE_STATS> totalTime(loopname, "Total");
           PerThreadTimer<MORE_STATS> initTime(loopname, "Init");
@@ -505,10 +534,13 @@ struct ChooseDoAllImpl<false> {
 
           size_t iter = 0;
 
-          while (begin != end) {
-            func(*begin++);
-            if (NEED_STATS) {
-              ++iter;
+          {
+            TraceSpan span("chunk", trace_category);
+            while (begin != end) {
+              func(*begin++);
+              if (NEED_STATS) {
+                ++iter;
+              }
             }
           }
           execTime.stop();
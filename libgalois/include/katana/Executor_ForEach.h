@@ -38,6 +38,7 @@
 #include "katana/ThreadTimer.h"
 #include "katana/Threads.h"
 #include "katana/Timer.h"
+#include "katana/Trace.h"
 #include "katana/Traits.h"
 #include "katana/UserContextAccess.h"
 #include "katana/config.h"
@@ -189,6 +190,7 @@ protected:
   WorkListTy wl;
   FunctionTy origFunction;
   const char* loopname;
+  const char* trace_category;
   bool broke;
 
   PerThreadTimer<MORE_STATS> initTime;
@@ -317,6 +319,7 @@ protected:
 
         // Run some iterations
         if (couldAbort || needsBreak) {
+          TraceSpan span("work", trace_category);
           constexpr int __NUM = (needsBreak || isLeader) ? 64 : 0;
           bool b = runQueue<__NUM>(tld, wl);
           didWork = b || didWork;
@@ -326,11 +329,13 @@ protected:
             didWork = b || didWork;
           }
         } else {  // No try/catch
+          TraceSpan span("work", trace_category);
           bool b = runQueueSimple(tld);
           didWork = b || didWork;
         }
 
         // Update node color and prop token
+        TraceSpan span("term", trace_category);
         term.SignalWorked(didWork);
         asmPause();  // Let token propagate
       } while (term.Working() && (!needsBreak || !broke));
@@ -346,6 +351,7 @@ protected:
       }
 
       term.InitializeThread();
+      TraceSpan span("barrier", trace_category);
       barrier.Wait();
     }
 
@@ -363,6 +369,8 @@ protected:
         wl(std::forward<WArgsTy>(wargs)...),
         origFunction(f),
         loopname(katana::internal::getLoopName(args)),
+        trace_category(
+            Tracer::IsEnabled() ? Tracer::Intern(loopname) : loopname),
         broke(false),
         initTime(loopname, "Init"),
         execTime(loopname, "Execute") {}
@@ -452,12 +460,19 @@ for_each_impl(const RangeTy& range, FunctionTy&& fn, const ArgsTy& args) {
   typedef ForEachExecutor<WorkListTy, FuncRefType, ArgsTy> WorkTy;
 
   auto& barrier = GetBarrier(activeThreads);
+  const char* loopname = getLoopName(args);
+  const char* trace_category =
+      Tracer::IsEnabled() ? Tracer::Intern(loopname) : loopname;
   FuncRefType fn_ref = fn;
   WorkTy W(fn_ref, args);
   W.init(range);
   GetThreadPool().run(
       activeThreads, [&W, &range]() { W.initThread(range); },
-      [&barrier] { barrier.Wait(); }, std::ref(W));
+      [&barrier, trace_category] {
+        TraceSpan span("barrier", trace_category);
+        barrier.Wait();
+      },
+      std::ref(W));
 }
 
 // TODO: Need to decide whether user should provide num_run tag or
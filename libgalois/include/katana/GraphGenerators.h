@@ -0,0 +1,71 @@
+#ifndef KATANA_LIBGALOIS_KATANA_GRAPHGENERATORS_H_
+#define KATANA_LIBGALOIS_KATANA_GRAPHGENERATORS_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "katana/PropertyGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Options shared by the synthetic graph generators.
+///
+/// Generated graphs have no self loops and no duplicate edges, and the edges
+/// of each node are sorted by destination. The same options and arguments
+/// always generate the same graph, whatever the number of threads.
+struct GraphGeneratorOptions {
+  /// Seed of the random choices of the generator
+  uint64_t seed{0};
+  /// Store every edge in both directions, as algorithms like triangle
+  /// counting, k-core and Louvain clustering require
+  bool symmetric{true};
+  /// Name of a uint32 edge property of random weights, or empty for none.
+  /// Both directions of a symmetric edge have the same weight.
+  std::string edge_weight_property_name{"weight"};
+  /// Weights are uniform in [1, max_weight]
+  uint32_t max_weight{255};
+};
+
+/// Parameters of the recursive matrix (R-MAT) model: each edge lands in the
+/// top-left, top-right, bottom-left or bottom-right quadrant of the adjacency
+/// matrix with probabilities a, b, c and 1 - a - b - c, recursively. The
+/// defaults are those of Graph500.
+struct RmatParameters {
+  double a{0.57};
+  double b{0.19};
+  double c{0.19};
+};
+
+/// Generate an R-MAT graph with 2^scale nodes and edge_factor * 2^scale
+/// sampled edges, before removing self loops and duplicates. High node ids
+/// have few edges; see GenerateKroneckerGraph for a graph without that
+/// correlation.
+KATANA_EXPORT Result<std::unique_ptr<PropertyGraph>> GenerateRmatGraph(
+    uint32_t scale, uint32_t edge_factor, const RmatParameters& parameters = {},
+    const GraphGeneratorOptions& options = {});
+
+/// Generate a graph like the Graph500 Kronecker generator: an R-MAT graph with
+/// the Graph500 parameters whose node ids are randomly permuted, so that the
+/// degree of a node does not depend on its id
+KATANA_EXPORT Result<std::unique_ptr<PropertyGraph>> GenerateKroneckerGraph(
+    uint32_t scale, uint32_t edge_factor,
+    const GraphGeneratorOptions& options = {});
+
+/// Generate a uniform random graph with num_nodes nodes and num_edges sampled
+/// edges, before removing self loops and duplicates
+KATANA_EXPORT Result<std::unique_ptr<PropertyGraph>> GenerateUniformGraph(
+    uint32_t num_nodes, uint64_t num_edges,
+    const GraphGeneratorOptions& options = {});
+
+/// Generate a two-dimensional grid of rows * columns nodes, with edges from
+/// each node to its right and lower neighbors (and back if symmetric). Node
+/// (i, j) has id i * columns + j.
+KATANA_EXPORT Result<std::unique_ptr<PropertyGraph>> GenerateGridGraph(
+    uint32_t rows, uint32_t columns, const GraphGeneratorOptions& options = {});
+
+}  // namespace katana
+
+#endif
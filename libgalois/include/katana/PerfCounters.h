@@ -0,0 +1,95 @@
+#ifndef KATANA_LIBGALOIS_KATANA_PERFCOUNTERS_H_
+#define KATANA_LIBGALOIS_KATANA_PERFCOUNTERS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "katana/PerThreadStorage.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Hardware events that PerfCounters can count
+enum class PerfEvent {
+  kCycles,
+  kInstructions,
+  kLLCMisses,
+  kDTLBMisses,
+  kBranchMisses,
+};
+
+/// \returns the name of event, which is also its statistic category
+KATANA_EXPORT const char* PerfEventName(PerfEvent event);
+
+/// \returns all events that PerfCounters can count
+KATANA_EXPORT std::vector<PerfEvent> AllPerfEvents();
+
+/// Parse a comma-separated list of event names, as returned by PerfEventName,
+/// e.g., "Cycles,LLCMisses"
+KATANA_EXPORT Result<std::vector<PerfEvent>> ParsePerfEvents(
+    const std::string& names);
+
+namespace internal {
+
+/// \returns the events named by the KATANA_PERF_EVENTS environment variable,
+/// or all events if it is not set
+KATANA_EXPORT std::vector<PerfEvent> PerfEventsFromEnv();
+
+}  // namespace internal
+
+/// PerfCounters counts hardware events on each active thread with the Linux
+/// perf_event_open interface, which needs no external library. Counting is
+/// limited to user space, so it works with the default
+/// kernel.perf_event_paranoid setting of 2.
+///
+/// Events that cannot be counted, because perf_event_open is not permitted or
+/// the processor lacks them, are left out with a warning; on other platforms,
+/// no events are counted. When there are more events than hardware counters,
+/// the kernel time-multiplexes them and the values are scaled estimates.
+///
+/// Counters are opened on the threads that are active at construction, so the
+/// number of active threads must not change during the lifetime of a
+/// PerfCounters object.
+class KATANA_EXPORT PerfCounters {
+public:
+  explicit PerfCounters(std::vector<PerfEvent> events = AllPerfEvents());
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters(PerfCounters&&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  PerfCounters& operator=(PerfCounters&&) = delete;
+
+  /// Start counting from zero on each active thread
+  void Start();
+
+  /// Stop counting on each active thread and read the counts
+  void Stop();
+
+  /// Report the counts of each thread as TSUM statistics of region, with the
+  /// event names as categories
+  void Report(const std::string& region);
+
+  /// \returns the events being counted
+  const std::vector<PerfEvent>& events() const { return events_; }
+
+  /// \returns the count of events()[index] on thread tid as of the last Stop
+  uint64_t value(unsigned tid, size_t index) {
+    return counters_.getRemote(tid)->values[index];
+  }
+
+private:
+  struct ThreadCounters {
+    std::vector<int> fds;
+    std::vector<uint64_t> values;
+  };
+
+  std::vector<PerfEvent> events_;
+  PerThreadStorage<ThreadCounters> counters_;
+};
+
+}  // namespace katana
+
+#endif
@@ -34,6 +34,7 @@ extern "C" {
 #endif
 
 #include "katana/Galois.h"
+#include "katana/PerfCounters.h"
 #include "katana/Timer.h"
 #include "katana/config.h"
 #include "katana/gIO.h"
@@ -244,6 +245,26 @@ profilePapi(const F& func, const char* region) {
 
 #endif
 
+/// profilePerf runs func and reports, as statistics of region, the hardware
+/// events counted on each active thread while it ran. It needs no external
+/// library; see PerfCounters. The events can be chosen with the environment
+/// variable KATANA_PERF_EVENTS, e.g., KATANA_PERF_EVENTS=Cycles,LLCMisses.
+template <typename F>
+void
+profilePerf(const F& func, const char* region) {
+  region = region ? region : "(NULL)";
+
+  PerfCounters counters(internal::PerfEventsFromEnv());
+  counters.Start();
+  {
+    katana::StatTimer timer(region);
+    katana::TimerGuard timer_guard(timer);
+    func();
+  }
+  counters.Stop();
+  counters.Report(region);
+}
+
 }  // namespace katana
 
 #endif
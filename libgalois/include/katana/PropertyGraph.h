@@ -1,7 +1,10 @@
 #ifndef KATANA_LIBGALOIS_KATANA_PROPERTYGRAPH_H_
 #define KATANA_LIBGALOIS_KATANA_PROPERTYGRAPH_H_
 
+#include <atomic>
 #include <bitset>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,8 +21,11 @@
 
 namespace katana {
 
+class CompressedGraphTopology;
+
 /// A graph topology represents the adjacency information for a graph in CSR
-/// format.
+/// format. It may optionally also carry the in-edges of every node in CSC
+/// format; see \ref PropertyGraph::PopulateInEdges.
 class KATANA_EXPORT GraphTopology {
 public:
   using Node = uint32_t;
@@ -107,6 +113,73 @@ public:
     return dests_[edge_id];
   }
 
+  /// Gets the destinations of the out-edges of some node, which are
+  /// contiguous in memory, in the same order as edges(node).
+  ///
+  /// \param node node to get the destinations of
+  /// \returns pointers to the first destination and one past the last
+  std::pair<const Node*, const Node*> edge_dests(Node node) const {
+    auto [begin_edge, end_edge] = edge_range(node);
+    return std::make_pair(
+        dests_.data() + begin_edge, dests_.data() + end_edge);
+  }
+
+  // In-edge accessors. In-edges have their own ids, distinct from the ids of
+  // out-edges; use in_edge_to_edge to look up the properties of an in-edge.
+
+  /// \returns true if the in-edges (CSC) of this topology are available
+  bool has_in_edges() const { return has_in_edges_; }
+
+  /// Gets the in-edge range of some node.
+  ///
+  /// \param node node to get the in-edge range of
+  /// \returns iterable in-edge range for node.
+  edges_range in_edges(Node node) const {
+    KATANA_LOG_DEBUG_ASSERT(has_in_edges_);
+    KATANA_LOG_DEBUG_ASSERT(node < in_indices_.size());
+    auto edge_start = node > 0 ? in_indices_[node - 1] : 0;
+    auto edge_end = in_indices_[node];
+    return MakeStandardRange<edge_iterator>(edge_start, edge_end);
+  }
+
+  /// \returns the source node of an in-edge
+  Node in_edge_src(Edge in_edge_id) const {
+    KATANA_LOG_DEBUG_ASSERT(in_edge_id < in_srcs_.size());
+    return in_srcs_[in_edge_id];
+  }
+
+  /// \returns the id of the out-edge that corresponds to an in-edge
+  Edge in_edge_to_edge(Edge in_edge_id) const {
+    KATANA_LOG_DEBUG_ASSERT(in_edge_id < in_edge_ids_.size());
+    return in_edge_ids_[in_edge_id];
+  }
+
+  /// Gets the in-edge arrays, which are each contiguous in memory: the end
+  /// of the in-edges of each node, the source of each in-edge and the
+  /// out-edge id of each in-edge.
+  const Edge* in_indices_data() const { return in_indices_.data(); }
+  const Node* in_srcs_data() const { return in_srcs_.data(); }
+  const Edge* in_edge_ids_data() const { return in_edge_ids_.data(); }
+
+  /// Attach in-edges to this topology. \param in_indices holds the end of the
+  /// in-edges of each node, \param in_srcs the source of each in-edge and
+  /// \param in_edge_ids the out-edge id of each in-edge.
+  void SetInEdges(
+      LargeArray<Edge>&& in_indices, LargeArray<Node>&& in_srcs,
+      LargeArray<Edge>&& in_edge_ids) noexcept {
+    in_indices_ = std::move(in_indices);
+    in_srcs_ = std::move(in_srcs);
+    in_edge_ids_ = std::move(in_edge_ids);
+    has_in_edges_ = true;
+  }
+
+  void DropInEdges() noexcept {
+    in_indices_ = LargeArray<Edge>();
+    in_srcs_ = LargeArray<Node>();
+    in_edge_ids_ = LargeArray<Edge>();
+    has_in_edges_ = false;
+  }
+
   nodes_range nodes(Node begin, Node end) const {
     return MakeStandardRange<node_iterator>(begin, end);
   }
@@ -140,6 +213,11 @@ private:
   LargeArray<Edge> adj_indices_;
   LargeArray<Node> dests_;
 
+  bool has_in_edges_{false};
+  LargeArray<Edge> in_indices_;
+  LargeArray<Node> in_srcs_;
+  LargeArray<Edge> in_edge_ids_;
+
 public:
   // TODO(amber): make these private in the near future. No other class should
   // access these directly. Instead provide access methods. Also, can't move these
@@ -192,6 +270,31 @@ private:
   /// Validate performs a sanity check on the the graph after loading
   Result<void> Validate();
 
+  /// Cast property to an array of T. A property with more than one chunk is
+  /// not supported, since a copy of its chunks could not be written through.
+  template <typename T>
+  static Result<std::shared_ptr<typename arrow::CTypeTraits<T>::ArrayType>>
+  TypedArray(const std::shared_ptr<arrow::ChunkedArray>& property) {
+    if (!property) {
+      return ErrorCode::PropertyNotFound;
+    }
+    if (property->num_chunks() != 1) {
+      return ErrorCode::NotImplemented;
+    }
+
+    auto array =
+        std::dynamic_pointer_cast<typename arrow::CTypeTraits<T>::ArrayType>(
+            property->chunk(0));
+    if (!array) {
+      return ErrorCode::TypeError;
+    }
+    return array;
+  }
+
+  /// Decode topology_ from compressed_topology_ and free the latter unless
+  /// that was done already
+  void DecompressTopology() const;
+
   Result<void> DoWrite(
       tsuba::RDGHandle handle, const std::string& command_line);
   Result<void> WriteGraph(
@@ -200,9 +303,29 @@ private:
   tsuba::RDG rdg_;
   std::unique_ptr<tsuba::RDGFile> file_;
 
-  // The topology is either backed by rdg_ or shared with the
-  // caller of SetTopology.
-  std::unique_ptr<GraphTopology> topology_ = std::make_unique<GraphTopology>();
+  // How the topology is encoded when written; that of the loaded topology
+  // unless changed by Write
+  tsuba::TopologyEncoding topology_encoding_ = tsuba::TopologyEncoding::kCSR;
+  // How the topology file at the storage location of rdg_ is encoded, if
+  // that file holds the current topology. This differs from the file in
+  // rdg_.topology_file_storage() once a topology in another encoding has been
+  // written there.
+  std::optional<tsuba::TopologyEncoding> stored_topology_encoding_;
+
+  // A topology loaded from a compressed file is only kept compressed, and
+  // topology_ is decoded from it on first use, which frees it. Until then,
+  // topology_compressed_ is set and the sizes of the topology are kept
+  // alongside so that they can be read while it is being decoded.
+  mutable std::shared_ptr<const CompressedGraphTopology> compressed_topology_;
+  mutable std::atomic<bool> topology_compressed_{false};
+  mutable std::mutex decompress_mutex_;
+  uint64_t compressed_num_nodes_{0};
+  uint64_t compressed_num_edges_{0};
+
+  // The topology is either backed by rdg_, decoded from compressed_topology_
+  // or shared with the caller of SetTopology.
+  mutable std::unique_ptr<GraphTopology> topology_ =
+      std::make_unique<GraphTopology>();
 
   /// A map from the node TypeSetID to
   /// the set of the node type names it contains
@@ -316,9 +439,13 @@ public:
       std::unique_ptr<GraphTopology> topo_to_assign);
 
   /// Make a property graph from a constructed RDG. Take ownership of the RDG
-  /// and its underlying resources.
+  /// and its underlying resources. The topology is placed in memory as
+  /// requested by \param placement; with tsuba::TopologyPlacement::kInPlace,
+  /// it is used directly from the RDG's topology file storage.
   static Result<std::unique_ptr<PropertyGraph>> Make(
-      std::unique_ptr<tsuba::RDGFile> rdg_file, tsuba::RDG&& rdg);
+      std::unique_ptr<tsuba::RDGFile> rdg_file, tsuba::RDG&& rdg,
+      tsuba::TopologyPlacement placement =
+          tsuba::TopologyPlacement::kInterleaved);
 
   /// Make a property graph from an RDG name.
   static Result<std::unique_ptr<PropertyGraph>> Make(
@@ -388,10 +515,13 @@ public:
   }
 
   /// Create a new storage location for a graph and write everything into it.
+  /// The topology is written with \param encoding, which later calls to
+  /// Commit keep using. Later calls to Commit update the new location.
   ///
   /// \returns io_error if, for instance, a file already exists
   Result<void> Write(
-      const std::string& rdg_name, const std::string& command_line);
+      const std::string& rdg_name, const std::string& command_line,
+      tsuba::TopologyEncoding encoding = tsuba::TopologyEncoding::kCSR);
 
   /// Commit updates modified state and re-uses graph components already in storage.
   ///
@@ -548,44 +678,22 @@ public:
   ///
   /// \tparam T The type of the property.
   /// \param name The name of the property.
-  /// \return The property array or an error if the property does not exist or has a different type.
+  /// \return The property array or an error if the property does not exist, has a different type or has more than one chunk.
   template <typename T>
   Result<std::shared_ptr<typename arrow::CTypeTraits<T>::ArrayType>>
-  GetNodePropertyTyped(const std::string& name) {
-    auto chunked_array = GetNodeProperty(name);
-    if (!chunked_array) {
-      return ErrorCode::PropertyNotFound;
-    }
-
-    auto array =
-        std::dynamic_pointer_cast<typename arrow::CTypeTraits<T>::ArrayType>(
-            chunked_array->chunk(0));
-    if (!array) {
-      return ErrorCode::TypeError;
-    }
-    return array;
+  GetNodePropertyTyped(const std::string& name) const {
+    return TypedArray<T>(GetNodeProperty(name));
   }
 
   /// Get an edge property by name and cast it to a type.
   ///
   /// \tparam T The type of the property.
   /// \param name The name of the property.
-  /// \return The property array or an error if the property does not exist or has a different type.
+  /// \return The property array or an error if the property does not exist, has a different type or has more than one chunk.
   template <typename T>
   Result<std::shared_ptr<typename arrow::CTypeTraits<T>::ArrayType>>
-  GetEdgePropertyTyped(const std::string& name) {
-    auto chunked_array = GetEdgeProperty(name);
-    if (!chunked_array) {
-      return ErrorCode::PropertyNotFound;
-    }
-
-    auto array =
-        std::dynamic_pointer_cast<typename arrow::CTypeTraits<T>::ArrayType>(
-            chunked_array->chunk(0));
-    if (!array) {
-      return ErrorCode::TypeError;
-    }
-    return array;
+  GetEdgePropertyTyped(const std::string& name) const {
+    return TypedArray<T>(GetEdgeProperty(name));
   }
 
   void MarkAllPropertiesPersistent() {
@@ -607,11 +715,28 @@ public:
     return rdg_.MarkEdgePropertiesPersistent(persist_edge_props);
   }
 
-  const GraphTopology& topology() const noexcept {
+  /// \returns the topology of this graph. A topology loaded from a
+  /// compressed file is decoded by the first call, which frees the compressed
+  /// topology, so only one of the two is ever held.
+  const GraphTopology& topology() const {
+    if (topology_compressed_.load(std::memory_order_acquire)) {
+      DecompressTopology();
+    }
     KATANA_LOG_DEBUG_ASSERT(topology_);
     return *topology_;
   }
 
+  /// \returns the topology this graph was loaded from if it was stored
+  /// compressed and topology() has not been called yet, and nullptr
+  /// otherwise. Its edges can be iterated without decoding the whole
+  /// topology. The first call to topology() frees it, so do not call
+  /// topology() while using it.
+  const CompressedGraphTopology* compressed_topology() const {
+    return topology_compressed_.load(std::memory_order_acquire)
+               ? compressed_topology_.get()
+               : nullptr;
+  }
+
   /// Add Node properties that do not exist in the current graph
   Result<void> AddNodeProperties(const std::shared_ptr<arrow::Table>& props);
   /// Add Edge properties that do not exist in the current graph
@@ -664,10 +789,24 @@ public:
   // This one takes over an existing topology through move operation
   Result<void> SetTopology(
       std::unique_ptr<GraphTopology>&& topo_to_assign) noexcept {
+    topology_compressed_ = false;
+    compressed_topology_.reset();
+    stored_topology_encoding_.reset();
     topology_ = std::move(topo_to_assign);
-    return katana::ResultSuccess();
+    return rdg_.DropTransposeTopology();
   }
 
+  /// Make the in-edges of every node available through
+  /// topology().in_edges(). If this graph has a transpose topology in
+  /// storage, it is mapped from there; otherwise the transpose is computed in
+  /// memory. Either way, the result is kept so later calls are free, and it is
+  /// persisted alongside the topology by the next Write or Commit.
+  Result<void> PopulateInEdges();
+
+  /// Release the in-edges of this graph, in memory and in storage. Call this
+  /// after modifying the topology in place.
+  Result<void> DropInEdges();
+
   /// Return the node property table for local nodes
   const std::shared_ptr<arrow::Table>& node_properties() const {
     return rdg_.node_properties();
@@ -690,9 +829,17 @@ public:
 
   /// Return the number of local nodes
   ///  num_nodes in repartitioner is of type LocalNodeID
-  uint64_t num_nodes() const { return topology().num_nodes(); }
+  uint64_t num_nodes() const {
+    return topology_compressed_.load(std::memory_order_acquire)
+               ? compressed_num_nodes_
+               : topology_->num_nodes();
+  }
   /// Return the number of local edges
-  uint64_t num_edges() const { return topology().num_edges(); }
+  uint64_t num_edges() const {
+    return topology_compressed_.load(std::memory_order_acquire)
+               ? compressed_num_edges_
+               : topology_->num_edges();
+  }
 
   /// Gets the edge range of some node.
   ///
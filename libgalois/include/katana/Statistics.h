@@ -24,6 +24,7 @@
 #include <string>
 #include <type_traits>
 
+#include "katana/Result.h"
 #include "katana/config.h"
 #include "katana/gIO.h"
 #include "katana/gstl.h"
@@ -286,6 +287,21 @@ using ScalarStatManager = BasicStatMap<ScalarStat<T>>;
 
 }  // end namespace internal
 
+/// The layout of printed statistics. Besides SetStatFormat, the layout can be
+/// chosen with the KATANA_STAT_FORMAT environment variable set to text, csv
+/// or json.
+enum class StatFormat {
+  /// A table with one row per statistic, and its per-thread values on a
+  /// second row only if PRINT_PER_THREAD_STATS is set
+  kText,
+  /// CSV (RFC 4180) with one row per statistic, including its per-thread
+  /// values
+  kCSV,
+  /// JSON lines: one object per region (e.g., loopname) with a list of its
+  /// statistics, including their per-thread values
+  kJSON,
+};
+
 class KATANA_EXPORT StatManager {
   class Impl;
 
@@ -348,6 +364,8 @@ public:
 
   void SetStatFile(const std::string& outfile);
 
+  void SetStatFormat(StatFormat format);
+
   void AddInt(
       const std::string& region, const std::string& category, int64_t val,
       const StatTotal::Type& type);
@@ -464,6 +482,11 @@ KATANA_EXPORT void PrintStats();
 
 KATANA_EXPORT void SetStatFile(const std::string& f);
 
+KATANA_EXPORT void SetStatFormat(StatFormat format);
+
+/// \returns the format named name: text, csv or json
+KATANA_EXPORT Result<StatFormat> ParseStatFormat(const std::string& name);
+
 }  // end namespace katana
 
 #endif
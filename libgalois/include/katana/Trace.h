@@ -0,0 +1,107 @@
+#ifndef KATANA_LIBGALOIS_KATANA_TRACE_H_
+#define KATANA_LIBGALOIS_KATANA_TRACE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Tracer records a timeline of what each thread does inside parallel loops:
+/// when it runs chunks of work, steals work, and waits at barriers. The
+/// timeline is written as Chrome trace JSON, which chrome://tracing and
+/// Perfetto display as one row of spans per thread.
+///
+/// Tracing is off by default; when off, each traced point costs one relaxed
+/// load and a branch. SharedMemSys turns it on if the KATANA_TRACE_FILE
+/// environment variable names an output file, and writes the trace there at
+/// exit. KATANA_TRACE_SPANS_PER_THREAD sets the capacity of the buffers.
+///
+/// Each thread records into its own fixed-size ring buffer, so recording
+/// takes no locks and memory is bounded; when a buffer is full, the oldest
+/// spans of that thread are overwritten. Span names and categories are not
+/// copied, so they must outlive the tracer, as string literals do; other
+/// names, like loop names, should go through Intern first.
+class KATANA_EXPORT Tracer {
+public:
+  static constexpr size_t kDefaultSpansPerThread = size_t{1} << 16;
+
+  static bool IsEnabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /// \returns the current time in nanoseconds, on the clock of spans
+  static uint64_t Now();
+
+  /// Record a span of the calling thread from begin_ns to end_ns, as given by
+  /// Now
+  static void Record(
+      const char* name, const char* category, uint64_t begin_ns,
+      uint64_t end_ns);
+
+  /// \returns a copy of name that lives as long as the process, for names
+  /// whose storage may be freed before the trace is written. Copies are
+  /// shared, so this is meant to be called once per loop rather than per span.
+  static const char* Intern(const char* name);
+
+  /// Start tracing, discarding spans recorded before. This must not be called
+  /// during a parallel loop.
+  static void Enable(size_t spans_per_thread = kDefaultSpansPerThread);
+
+  /// Stop recording spans; the recorded spans are kept
+  static void Disable();
+
+  /// Write the recorded spans as Chrome trace JSON
+  static void WriteChromeTrace(std::ostream& out);
+  static Result<void> WriteChromeTrace(const std::string& path);
+
+private:
+  static std::atomic<bool> enabled_;
+};
+
+/// TraceSpan records a span from its construction to its destruction if
+/// tracing was enabled at construction
+class TraceSpan {
+public:
+  TraceSpan(const char* name, const char* category)
+      : name_(name),
+        category_(category),
+        begin_ns_(Tracer::IsEnabled() ? Tracer::Now() : 0) {}
+
+  ~TraceSpan() {
+    if (begin_ns_ != 0) {
+      Tracer::Record(name_, category_, begin_ns_, Tracer::Now());
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan(TraceSpan&&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+  TraceSpan& operator=(TraceSpan&&) = delete;
+
+private:
+  const char* name_;
+  const char* category_;
+  uint64_t begin_ns_;
+};
+
+namespace internal {
+
+/// Enable tracing as configured by KATANA_TRACE_FILE and
+/// KATANA_TRACE_SPANS_PER_THREAD
+KATANA_EXPORT void StartTracingFromEnv();
+
+/// Write the trace to KATANA_TRACE_FILE if tracing was started by
+/// StartTracingFromEnv
+KATANA_EXPORT void FinishTracingFromEnv();
+
+}  // namespace internal
+
+}  // namespace katana
+
+#endif
@@ -23,11 +23,13 @@
 #include <fstream>
 #include <iostream>
 #include <random>
+#include <vector>
 
 #include "katana/AtomicHelpers.h"
 #include "katana/Galois.h"
 #include "katana/LargeArray.h"
 #include "katana/analytics/Utils.h"
+#include "katana/analytics/coarsening/coarsening.h"
 
 namespace katana::analytics {
 
@@ -48,6 +50,87 @@ using DegreeWeight = katana::PODProperty<EdgeWeightType>;
 template <typename EdgeWeightType>
 using EdgeWeight = katana::PODProperty<EdgeWeightType>;
 
+/// Accumulates the total weight of the edges from a node to each cluster
+/// among its neighbors.
+///
+/// Clusters are kept in an open addressing hash table together with a list
+/// of the clusters in the order they were first added. Clearing only touches
+/// the slots in use and keeps the memory, so one accumulator per thread can
+/// be reused for every node without allocating once it has grown to the
+/// largest neighborhood.
+template <typename EdgeTy>
+class NeighborClusterAccumulator {
+public:
+  /// Forget all clusters
+  void Clear() {
+    for (size_t slot : used_slots_) {
+      slots_[slot] = kEmpty;
+    }
+    used_slots_.clear();
+    clusters_.clear();
+    weights_.clear();
+  }
+
+  /// Add \param weight to the weight of \param cluster, adding the cluster
+  /// if it is new
+  void Add(uint64_t cluster, EdgeTy weight) {
+    if (2 * (clusters_.size() + 1) > slots_.size()) {
+      Grow();
+    }
+    size_t slot = Find(cluster);
+    if (slots_[slot] == kEmpty) {
+      slots_[slot] = clusters_.size();
+      used_slots_.push_back(slot);
+      clusters_.push_back(cluster);
+      weights_.push_back(weight);
+    } else {
+      weights_[slots_[slot]] += weight;
+    }
+  }
+
+  /// \returns the number of clusters added since the last Clear
+  size_t size() const { return clusters_.size(); }
+
+  /// \returns the id of the \param i'th cluster added
+  uint64_t cluster(size_t i) const { return clusters_[i]; }
+
+  /// \returns the total weight of the \param i'th cluster added
+  EdgeTy weight(size_t i) const { return weights_[i]; }
+
+private:
+  static constexpr size_t kEmpty = std::numeric_limits<size_t>::max();
+  static constexpr size_t kMinSlots = 16;
+
+  /// \returns the slot holding \param cluster or the empty slot where it
+  /// belongs
+  size_t Find(uint64_t cluster) const {
+    size_t mask = slots_.size() - 1;
+    // Fibonacci hashing spreads consecutive cluster ids over the table
+    size_t slot = (cluster * UINT64_C(0x9E3779B97F4A7C15)) & mask;
+    while (slots_[slot] != kEmpty && clusters_[slots_[slot]] != cluster) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void Grow() {
+    size_t num_slots = std::max(kMinSlots, 2 * slots_.size());
+    slots_.assign(num_slots, kEmpty);
+    used_slots_.clear();
+    for (size_t i = 0; i < clusters_.size(); ++i) {
+      size_t slot = Find(clusters_[i]);
+      slots_[slot] = i;
+      used_slots_.push_back(slot);
+    }
+  }
+
+  /// Index into clusters_ and weights_ or kEmpty
+  std::vector<size_t> slots_;
+  std::vector<size_t> used_slots_;
+  std::vector<uint64_t> clusters_;
+  std::vector<EdgeTy> weights_;
+};
+
 template <typename _Graph, typename _EdgeType, typename _CommunityType>
 struct ClusteringImplementationBase {
   using Graph = _Graph;
@@ -64,24 +147,19 @@ struct ClusteringImplementationBase {
    * Algorithm to find the best cluster for the node
    * to move to among its neighbors in the graph and moves.
    *
-   * It updates the mapping of neighboring nodes clusters
-   * in cluster_local_map, total unique cluster edge weights
-   * in counter as well as total weight of self edges in self_loop_wt.
+   * It accumulates the total edge weight from n to each neighboring
+   * cluster in clusters, starting with n's own cluster, as well as
+   * the total weight of self edges in self_loop_wt.
    */
   template <typename EdgeWeightType>
   void FindNeighboringClusters(
       const Graph& graph, GNode& n,
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeTy>& counter, EdgeTy& self_loop_wt) {
-    uint64_t num_unique_clusters = 0;
+      NeighborClusterAccumulator<EdgeTy>* clusters, EdgeTy& self_loop_wt) {
+    clusters->Clear();
 
     // Add the node's current cluster to be considered
-    // for movement as well
-    cluster_local_map[graph.template GetData<CurrentCommunityId>(n)] =
-        0;                 // Add n's current cluster
-    counter.push_back(0);  // Initialize the counter to zero (no edges incident
-                           // yet)
-    num_unique_clusters++;
+    // for movement as well (no edges incident yet)
+    clusters->Add(graph.template GetData<CurrentCommunityId>(n), 0);
 
     // Assuming we have grabbed lock on all the neighbors
     for (auto ii = graph.edge_begin(n); ii != graph.edge_end(n); ++ii) {
@@ -91,17 +169,7 @@ struct ClusteringImplementationBase {
       if (*dst == n) {
         self_loop_wt += edge_wt;  // Self loop weights is recorded
       }
-      auto stored_already =
-          cluster_local_map.find(graph.template GetData<CurrentCommunityId>(
-              dst));  // Check if it already exists
-      if (stored_already != cluster_local_map.end()) {
-        counter[stored_already->second] += edge_wt;
-      } else {
-        cluster_local_map[graph.template GetData<CurrentCommunityId>(dst)] =
-            num_unique_clusters;
-        counter.push_back(edge_wt);
-        num_unique_clusters++;
-      }
+      clusters->Add(graph.template GetData<CurrentCommunityId>(dst), edge_wt);
     }  // End edge loop
     return;
   }
@@ -207,44 +275,41 @@ struct ClusteringImplementationBase {
    * without swapping the cluster assignment.
    */
   uint64_t MaxModularityWithoutSwaps(
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeTy>& counter, uint64_t self_loop_wt,
-      CommunityArray& c_info, EdgeTy degree_wt, uint64_t sc, double constant) {
+      const NeighborClusterAccumulator<EdgeTy>& clusters,
+      uint64_t self_loop_wt, CommunityArray& c_info, EdgeTy degree_wt,
+      uint64_t sc, double constant) {
     uint64_t max_index = sc;  // Assign the intial value as self community
     double cur_gain = 0;
     double max_gain = 0;
-    double eix = counter[0] - self_loop_wt;
+    double eix = clusters.weight(0) - self_loop_wt;
     double ax = c_info[sc].degree_wt - degree_wt;
     double eiy = 0;
     double ay = 0;
 
-    auto stored_already = cluster_local_map.begin();
-    do {
-      if (sc != stored_already->first) {
-        ay = c_info[stored_already->first].degree_wt;  // Degree wt of cluster y
-
-        if (ay < (ax + degree_wt)) {
-          stored_already++;
-          continue;
-        } else if (ay == (ax + degree_wt) && stored_already->first > sc) {
-          stored_already++;
-          continue;
-        }
+    for (size_t i = 0; i < clusters.size(); ++i) {
+      uint64_t cluster = clusters.cluster(i);
+      if (sc == cluster) {
+        continue;
+      }
+      ay = c_info[cluster].degree_wt;  // Degree wt of cluster y
+
+      if (ay < (ax + degree_wt)) {
+        continue;
+      } else if (ay == (ax + degree_wt) && cluster > sc) {
+        continue;
+      }
 
-        eiy = counter[stored_already
-                          ->second];  // Total edges incident on cluster y
-        cur_gain = 2 * constant * (eiy - eix) +
-                   2 * degree_wt * ((ax - ay) * constant * constant);
+      eiy = clusters.weight(i);  // Total edges incident on cluster y
+      cur_gain = 2 * constant * (eiy - eix) +
+                 2 * degree_wt * ((ax - ay) * constant * constant);
 
-        if ((cur_gain > max_gain) ||
-            ((cur_gain == max_gain) && (cur_gain != 0) &&
-             (stored_already->first < max_index))) {
-          max_gain = cur_gain;
-          max_index = stored_already->first;
-        }
+      if ((cur_gain > max_gain) ||
+          ((cur_gain == max_gain) && (cur_gain != 0) &&
+           (cluster < max_index))) {
+        max_gain = cur_gain;
+        max_index = cluster;
       }
-      stored_already++;  // Explore next cluster
-    } while (stored_already != cluster_local_map.end());
+    }
 
     if ((c_info[max_index].size == 1 && c_info[sc].size == 1 &&
          max_index > sc)) {
@@ -526,84 +591,38 @@ struct ClusteringImplementationBase {
  * the number of unique clusters in the previous level of the graph.
  * All the edges inside a cluster are merged (edge weights are summed
  * up) to form the edges within super nodes.
+ *
+ * The clusters are contracted by ContractClusters, with the cluster ids
+ * and edge weights of graph.
  */
   template <typename NodeData, typename EdgeData, typename EdgeWeightType>
   katana::Result<std::unique_ptr<katana::PropertyGraph>> GraphCoarsening(
       const Graph& graph, katana::PropertyGraph* pfg_mutable,
-      uint64_t num_unique_clusters,
+      [[maybe_unused]] uint64_t num_unique_clusters,
       const std::vector<std::string>& temp_node_property_names,
       const std::vector<std::string>& temp_edge_property_names) {
-    using GNode = typename Graph::Node;
+    static_assert(
+        std::is_same_v<std::tuple_element_t<1, NodeData>, CurrentCommunityId>,
+        "CurrentCommunityId must be the second node property");
+    static_assert(
+        std::is_same_v<
+            std::tuple_element_t<0, EdgeData>, EdgeWeight<EdgeWeightType>>,
+        "the edge weight must be the first edge property");
 
     katana::StatTimer TimerGraphBuild("Timer_Graph_build");
-    TimerGraphBuild.start();
-    uint64_t num_nodes_next = num_unique_clusters;
-    uint64_t num_edges_next = 0;  // Unknown right now
-
-    std::vector<std::vector<GNode>> cluster_bags(num_unique_clusters);
-    // Comment: Serial separation is better than do_all due to contention
-    for (GNode n = 0; n < graph.num_nodes(); ++n) {
-      auto n_data_curr_comm_id = graph.template GetData<CurrentCommunityId>(n);
-      if (n_data_curr_comm_id != UNASSIGNED)
-        cluster_bags[n_data_curr_comm_id].push_back(n);
+    katana::TimerGuard TimerGraphBuildGuard(TimerGraphBuild);
+
+    // Graph views the properties by position
+    const katana::PropertyGraph& pfg_curr = graph.GetPropertyGraph();
+    auto coarsened_result = katana::analytics::ContractClusters(
+        &pfg_curr, pfg_curr.edge_schema()->field(0)->name(),
+        pfg_curr.node_schema()->field(1)->name(), temp_edge_property_names[0]);
+    if (!coarsened_result) {
+      return coarsened_result.error();
     }
-
-    std::vector<std::vector<uint32_t>> edges_id(num_unique_clusters);
-    std::vector<std::vector<EdgeTy>> edges_data(num_unique_clusters);
-
-    /* First pass to find the number of edges */
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_unique_clusters),
-        [&](uint64_t c) {
-          std::map<uint64_t, uint64_t> cluster_local_map;
-          uint64_t num_unique_clusters = 0;
-          for (auto cb_ii = cluster_bags[c].begin();
-               cb_ii != cluster_bags[c].end(); ++cb_ii) {
-            KATANA_LOG_DEBUG_ASSERT(
-                graph.template GetData<CurrentCommunityId>(*cb_ii) ==
-                c);  // All nodes in this bag must have same cluster id
-
-            for (auto ii = graph.edge_begin(*cb_ii);
-                 ii != graph.edge_end(*cb_ii); ++ii) {
-              auto dst = graph.GetEdgeDest(ii);
-              auto dst_data_curr_comm_id =
-                  graph.template GetData<CurrentCommunityId>(dst);
-              KATANA_LOG_DEBUG_ASSERT(dst_data_curr_comm_id != UNASSIGNED);
-              auto stored_already = cluster_local_map.find(
-                  dst_data_curr_comm_id);  // Check if it already exists
-              if (stored_already != cluster_local_map.end()) {
-                edges_data[c][stored_already->second] +=
-                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii);
-              } else {
-                cluster_local_map[dst_data_curr_comm_id] = num_unique_clusters;
-                edges_id[c].push_back(dst_data_curr_comm_id);
-                edges_data[c].push_back(
-                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii));
-                num_unique_clusters++;
-              }
-            }  // End edge loop
-          }
-        },
-        katana::steal(), katana::loopname("BuildGraph: Find edges"));
-
-    /* Serial loop to reduce all the edge counts */
-    std::vector<uint64_t> prefix_edges_count(num_unique_clusters);
-    katana::GAccumulator<uint64_t> num_edges_acc;
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_nodes_next), [&](uint64_t c) {
-          prefix_edges_count[c] = edges_id[c].size();
-          num_edges_acc += prefix_edges_count[c];
-        });
-
-    num_edges_next = num_edges_acc.reduce();
-    for (uint64_t c = 1; c < num_nodes_next; ++c) {
-      prefix_edges_count[c] += prefix_edges_count[c - 1];
-    }
-
-    KATANA_LOG_DEBUG_ASSERT(
-        prefix_edges_count[num_unique_clusters - 1] == num_edges_next);
-    katana::StatTimer TimerConstructFrom("Timer_Construct_From");
-    TimerConstructFrom.start();
+    std::unique_ptr<katana::PropertyGraph> pfg_next =
+        std::move(coarsened_result.value().graph);
+    KATANA_LOG_DEBUG_ASSERT(pfg_next->num_nodes() == num_unique_clusters);
 
     // Remove all the existing node/edge properties
     for (auto property : temp_node_property_names) {
@@ -617,88 +636,12 @@ struct ClusteringImplementationBase {
       }
     }
 
-    const katana::GraphTopology& topology = pfg_mutable->topology();
-
-    using Node = katana::GraphTopology::Node;
-    using Edge = katana::GraphTopology::Edge;
-
-    katana::LargeArray<Edge> out_indices_next;
-    out_indices_next.allocateInterleaved(num_nodes_next);
-    katana::LargeArray<Node> out_dests_next;
-    out_dests_next.allocateInterleaved(num_edges_next);
-
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_nodes_next),
-        [&](uint64_t i) {
-          out_indices_next[i] = topology.out_indices->Value(i);
-        },
-        katana::no_stats());
-
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_edges_next),
-        [&](uint64_t i) { out_dests_next[i] = topology.out_dests->Value(i); },
-        katana::no_stats());
-
-    auto topo_next = std::make_unique<katana::GraphTopology>(
-        std::move(out_indices_next), std::move(out_dests_next));
-
-    auto pfg_next = std::make_unique<katana::PropertyGraph>();
-    if (auto r = pfg_next->SetTopology(std::move(topo_next)); !r) {
-      return r.error();
-    }
-
-    const katana::GraphTopology& topology_next = pfg_next->topology();
-
-    auto out_indices_view_result =
-        katana::ConstructPropertyView<katana::UInt64Property>(
-            topology_next.out_indices.get());
-    if (!out_indices_view_result) {
-      return out_indices_view_result.error();
-    }
-    auto out_indices_view = std::move(out_indices_view_result.value());
-
-    auto out_dests_view_result =
-        katana::ConstructPropertyView<katana::UInt32Property>(
-            topology_next.out_dests.get());
-    if (!out_dests_view_result) {
-      return out_dests_view_result.error();
-    }
-    auto out_dests_view = std::move(out_dests_view_result.value());
-
     if (auto result = katana::analytics::ConstructNodeProperties<NodeData>(
             pfg_next.get(), temp_node_property_names);
         !result) {
       return result.error();
     }
 
-    if (auto result = katana::analytics::ConstructEdgeProperties<EdgeData>(
-            pfg_next.get(), temp_edge_property_names);
-        !result) {
-      return result.error();
-    }
-
-    auto graph_result = Graph::Make(pfg_next.get());
-    if (!graph_result) {
-      return graph_result.error();
-    }
-    Graph graph_curr = graph_result.value();
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_nodes_next), [&](uint64_t n) {
-          out_indices_view[n] = prefix_edges_count[n];
-          uint64_t number_of_edges =
-              (n == 0) ? prefix_edges_count[0]
-                       : (prefix_edges_count[n] - prefix_edges_count[n - 1]);
-          uint64_t start_index = (n == 0) ? 0 : prefix_edges_count[n - 1];
-          for (uint32_t k = 0; k < number_of_edges; ++k) {
-            out_dests_view[start_index + k] = edges_id[n][k];
-            graph_curr.template GetEdgeData<EdgeWeight<EdgeWeightType>>(
-                start_index + k) = edges_data[n][k];
-          }
-        });
-
-    TimerConstructFrom.stop();
-
-    TimerGraphBuild.stop();
     return std::unique_ptr<katana::PropertyGraph>(std::move(pfg_next));
   }
 };
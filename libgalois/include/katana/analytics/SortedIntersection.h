@@ -0,0 +1,111 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_SORTEDINTERSECTION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_SORTEDINTERSECTION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "katana/config.h"
+
+namespace katana::analytics {
+
+// Intersections of sorted neighbor lists, shared by the triangle based
+// analytics (triangle counting, local clustering coefficient, Jaccard
+// similarity and k-truss).
+//
+// All ranges must be sorted in increasing order without duplicates, as the
+// out-edges of a node of a graph sorted with SortAllEdgesByDest are when the
+// graph has no parallel edges.
+
+/// When one range is this many times longer than the other, intersections
+/// search for each element of the shorter range in the longer one (galloping)
+/// instead of merging them.
+constexpr size_t kGallopingRatio = 32;
+
+/// \returns the number of elements in both [a, a + a_size) and
+/// [b, b + b_size).
+///
+/// Ranges of similar sizes are merged a block of elements at a time with
+/// AVX-512 or AVX2 instructions when the processor supports them (chosen
+/// once at run time, independently of the flags the library is built with),
+/// and with a scalar merge otherwise.
+KATANA_EXPORT uint64_t SortedIntersectionSize(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size);
+
+/// Write the elements in both [a, a + a_size) and [b, b + b_size) to out in
+/// increasing order, as SortedIntersectionSize counts them. out must have
+/// room for min(a_size, b_size) elements.
+///
+/// \returns the number of elements written
+KATANA_EXPORT size_t SortedIntersection(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out);
+
+/// \returns the name of the instruction set SortedIntersectionSize and
+/// SortedIntersection use on this processor: "avx512", "avx2" or "scalar"
+KATANA_EXPORT const char* SortedIntersectionInstructionSet();
+
+/// \returns the first position in [first, first + size) whose element is not
+/// less than value, found by doubling the step from the front and then
+/// bisecting, so it costs O(log(position)) rather than O(log(size)).
+inline size_t
+GallopLowerBound(const uint32_t* first, size_t size, uint32_t value) {
+  size_t end = 1;
+  while (end < size && first[end - 1] < value) {
+    end *= 2;
+  }
+  size_t begin = end / 2;
+  end = std::min(end, size);
+  return std::lower_bound(first + begin, first + end, value) - first;
+}
+
+/// Call fn(i, j) for each pair of positions with a[i] == b[j], in increasing
+/// order. If fn returns false, stop early.
+///
+/// Unlike SortedIntersection, this is scalar, but it gives the positions of
+/// the common elements in both ranges, so callers can look up per-edge data
+/// (such as whether an edge was removed) for either side.
+template <typename Fn>
+void
+ForEachSortedIntersection(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    Fn fn) {
+  size_t i = 0;
+  size_t j = 0;
+  if (b_size >= kGallopingRatio * a_size) {
+    for (; i < a_size && j < b_size; ++i) {
+      j += GallopLowerBound(b + j, b_size - j, a[i]);
+      if (j < b_size && b[j] == a[i] && !fn(i, j)) {
+        return;
+      }
+    }
+    return;
+  }
+  if (a_size >= kGallopingRatio * b_size) {
+    for (; j < b_size && i < a_size; ++j) {
+      i += GallopLowerBound(a + i, a_size - i, b[j]);
+      if (i < a_size && a[i] == b[j] && !fn(i, j)) {
+        return;
+      }
+    }
+    return;
+  }
+  while (i < a_size && j < b_size) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      if (!fn(i, j)) {
+        return;
+      }
+      ++i;
+      ++j;
+    }
+  }
+}
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_WEDGESAMPLING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_WEDGESAMPLING_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+#include "katana/PropertyGraph.h"
+#include "katana/config.h"
+
+namespace katana::analytics {
+
+// Wedge sampling, shared by the approximate triangle count and local
+// clustering coefficient.
+//
+// A wedge is a path u - center - w of two edges. It is closed when u and w
+// are adjacent, and then it is one of the three wedges of a triangle, so the
+// fraction of closed wedges estimates triangle counts and clustering
+// coefficients. The graph must be symmetric, without self loops or parallel
+// edges, and its edges must be sorted by destination.
+
+/// \returns the number of wedges centered at a node of the given degree
+inline uint64_t
+NumWedges(uint64_t degree) {
+  return degree < 2 ? 0 : degree * (degree - 1) / 2;
+}
+
+/// \returns the seed of the generator of the given stream, e.g., a block of
+/// samples or a node, of a sampler seeded with seed. Streams get unrelated
+/// seeds, and so do different seeds.
+inline uint64_t
+WedgeSamplingSeed(uint64_t seed, uint64_t stream) {
+  // splitmix64 of the pair
+  uint64_t x = seed * 0x9e3779b97f4a7c15ULL + stream;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/// Pick a wedge centered at center uniformly at random, and \returns whether
+/// it is closed. center must have at least two neighbors.
+template <typename Rng>
+bool
+SampleWedgeIsClosed(const GraphTopology& topology, uint32_t center, Rng* rng) {
+  auto [begin, end] = topology.edge_dests(center);
+  uint64_t degree = end - begin;
+  std::uniform_int_distribution<uint64_t> first_dist(0, degree - 1);
+  std::uniform_int_distribution<uint64_t> second_dist(0, degree - 2);
+  uint64_t first = first_dist(*rng);
+  uint64_t second = second_dist(*rng);
+  // Skip first so the two neighbors are distinct
+  second += second >= first;
+
+  uint32_t u = begin[first];
+  uint32_t w = begin[second];
+  auto [u_begin, u_end] = topology.edge_dests(u);
+  auto [w_begin, w_end] = topology.edge_dests(w);
+  if (u_end - u_begin <= w_end - w_begin) {
+    return std::binary_search(u_begin, u_end, w);
+  }
+  return std::binary_search(w_begin, w_end, u);
+}
+
+/// \returns the z such that a standard normal variable is in [-z, z] with
+/// probability confidence, which must be in (0, 1)
+KATANA_EXPORT double TwoSidedNormalQuantile(double confidence);
+
+/// A confidence interval of the probability of success of a Bernoulli trial
+struct ProportionInterval {
+  double lower;
+  double upper;
+};
+
+/// \returns the Wilson score interval of the probability of success given
+/// successes out of trials, for the normal quantile z. Unlike the plain
+/// normal approximation, it stays in [0, 1] and is usable when successes are
+/// rare, as closed wedges are in sparse graphs.
+KATANA_EXPORT ProportionInterval
+WilsonInterval(uint64_t successes, uint64_t trials, double z);
+
+}  // namespace katana::analytics
+
+#endif
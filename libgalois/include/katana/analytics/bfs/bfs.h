@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_BFS_BFS_H_
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "katana/analytics/Plan.h"
 #include "katana/analytics/Utils.h"
@@ -86,6 +88,39 @@ KATANA_EXPORT Result<void> Bfs(
 KATANA_EXPORT Result<void> BfsAssertValid(
     PropertyGraph* pg, uint32_t source, const std::string& property_name);
 
+/// The number of sources MultiSourceBfs searches from at once
+constexpr size_t kMultiSourceBfsBatchSize = 64;
+
+/// Compute the BFS level (hop distance) of every node in the graph pg from
+/// each of sources. The levels from sources[i] are stored in a property named
+/// output_property_names[i]. Nodes a source does not reach get the value Bfs
+/// gives unvisited nodes, std::numeric_limits<uint32_t>::max() / 4. These
+/// properties are created by this function and may not exist before the
+/// call.
+///
+/// Up to kMultiSourceBfsBatchSize sources are searched together, sharing one
+/// traversal of the graph with a bitmask of sources per node, so the cost of
+/// a batch is close to that of a single BFS. More sources are processed in
+/// successive batches. The plan must be kSynchronousDirectOpt; its alpha and
+/// beta choose between pushing and pulling as in Bfs.
+KATANA_EXPORT Result<void> MultiSourceBfs(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::vector<std::string>& output_property_names, BfsPlan algo = {});
+
+/// Like MultiSourceBfs but returns the levels instead of storing them as
+/// properties: the result has one row per source, each with the level of every
+/// node from that source.
+KATANA_EXPORT Result<std::vector<std::vector<uint32_t>>> MultiSourceBfsLevels(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources, BfsPlan algo = {});
+
+/// Check the levels stored by MultiSourceBfs against a serial BFS from each
+/// source.
+/// @return a failure if any level is incorrect or if there is a failure
+///     during checking.
+KATANA_EXPORT Result<void> MultiSourceBfsAssertValid(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::vector<std::string>& property_names);
+
 /// Statistics about a graph that can be extracted from the results of BFS.
 struct KATANA_EXPORT BfsStatistics {
   /// The number of nodes reachable from the source node.
@@ -0,0 +1,74 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_COARSENING_COARSENING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_COARSENING_COARSENING_H_
+
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "katana/LargeArray.h"
+#include "katana/analytics/Utils.h"
+
+namespace katana::analytics {
+
+/// The cluster of a node that is left out of the coarsened graph
+constexpr uint64_t kUnassignedCluster = std::numeric_limits<uint64_t>::max();
+
+/// A coarsened graph together with the node of it that each node of the
+/// original (fine) graph was merged into
+struct KATANA_EXPORT CoarsenedGraph {
+  /// The coarse graph, with an edge weight property and no node properties
+  std::unique_ptr<PropertyGraph> graph;
+  /// The coarse node of each fine node, or kUnassignedCluster if the fine
+  /// node was left out
+  LargeArray<uint64_t> fine_to_coarse;
+};
+
+/// Contract the clusters of pg into single nodes. The cluster of each node is
+/// taken from the node property named cluster_property_name (as uint64_t);
+/// cluster ids must be below the number of nodes of pg, or
+/// kUnassignedCluster to leave the node and its edges out. The coarse nodes
+/// are numbered in the order of the cluster ids, so if the ids are already
+/// contiguous, they are the coarse node ids.
+///
+/// There is an edge between two coarse nodes (or a self loop) for every
+/// pair of clusters with edges between them, with the sum of their weights.
+/// Edge weights are taken from the property named edge_weight_property_name
+/// (which may be a 32- or 64-bit sign or unsigned int, or a float or double)
+/// and stored in the coarse graph in the property named
+/// output_edge_weight_property_name with the same type. The out-edges of each
+/// coarse node are sorted by destination.
+///
+/// Edges are gathered into one buffer with a slot per fine edge, sorted and
+/// merged per cluster in parallel, so no per-cluster containers are
+/// allocated.
+KATANA_EXPORT Result<CoarsenedGraph> ContractClusters(
+    const PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& cluster_property_name,
+    const std::string& output_edge_weight_property_name);
+
+/// Match the nodes of pg in pairs along heavy edges, with edge weights taken
+/// from the property named edge_weight_property_name as in ContractClusters.
+/// The cluster of each node is stored in the property named
+/// output_property_name (as uint64_t), which is the smaller id of the two
+/// nodes of a matched pair or the id of the node itself if it is unmatched.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+///
+/// Matching proceeds in rounds. In each round, every unmatched node picks its
+/// heaviest edge to another unmatched node and two nodes that pick each other
+/// are matched. Ties between edges of the same weight are broken by a hash of
+/// their end points, which keeps the number of rounds small on graphs with
+/// uniform weights. The graph is expected to be symmetric.
+KATANA_EXPORT Result<void> HeavyEdgeMatching(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name);
+
+/// Coarsen pg by a heavy edge matching followed by ContractClusters, which
+/// roughly halves the number of nodes of graphs without many isolated nodes.
+KATANA_EXPORT Result<CoarsenedGraph> Coarsen(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_edge_weight_property_name);
+
+}  // namespace katana::analytics
+
+#endif
@@ -2,6 +2,9 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_CONNECTEDCOMPONENTS_CONNECTEDCOMPONENTS_H_
 
 #include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "katana/AtomicHelpers.h"
 #include "katana/analytics/Plan.h"
@@ -164,6 +167,42 @@ KATANA_EXPORT Result<void> ConnectedComponents(
 KATANA_EXPORT Result<void> ConnectedComponentsAssertValid(
     PropertyGraph* pg, const std::string& property_name);
 
+/// Build an index from each component of pg to its nodes for the components
+/// stored in the property named property_name. Component ids must be node ids
+/// of a node in the component whose own component id is itself, as computed by
+/// the Afforest and LabelProp plans.
+///
+/// The index is two node properties: index_property_prefix + "next" (as
+/// uint32_t) links the nodes of each component in a cycle, and
+/// index_property_prefix + "size" (as uint64_t) holds the number of nodes of
+/// each component at its id and 0 at other nodes. These properties are created
+/// by this function and may not exist before the call. They and the property
+/// named property_name are marked persistent, so the index is written with the
+/// graph and kept up to date by ConnectedComponentsInsertEdges.
+KATANA_EXPORT Result<void> ConnectedComponentsBuildIndex(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::string& index_property_prefix);
+
+/// Update the components in the property named property_name and the index
+/// built by ConnectedComponentsBuildIndex with the same index_property_prefix
+/// after inserted_edges have been added to pg.
+///
+/// The components of the end points of the inserted edges are merged with the
+/// same union-find as the Afforest plan, and each merged component takes the
+/// id of the largest component merged into it. Only the nodes of the smaller
+/// components are visited and relabeled, by following the index, so the cost
+/// depends on the inserted edges and not on the size of pg.
+KATANA_EXPORT Result<void> ConnectedComponentsInsertEdges(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::string& index_property_prefix,
+    const std::vector<std::pair<uint32_t, uint32_t>>& inserted_edges);
+
+/// Return the nodes of the component with id component using the index built
+/// by ConnectedComponentsBuildIndex with the same index_property_prefix.
+KATANA_EXPORT Result<std::vector<uint32_t>> ConnectedComponentMembers(
+    PropertyGraph* pg, const std::string& index_property_prefix,
+    uint64_t component);
+
 struct KATANA_EXPORT ConnectedComponentsStatistics {
   /// Total number of unique components in the graph.
   uint64_t total_components;
@@ -64,6 +64,27 @@ KATANA_EXPORT Result<void> Jaccard(
 KATANA_EXPORT Result<void> JaccardAssertValid(
     PropertyGraph* pg, uint32_t compare_node, const std::string& property_name);
 
+/// The names of the fields of the entries of the output property of
+/// JaccardTopK.
+constexpr const char* kJaccardTopKNodeField = "node";
+constexpr const char* kJaccardTopKSimilarityField = "similarity";
+
+/// For each node in nodes, or each node of the graph if nodes is empty, find
+/// the k other nodes most similar to it, without calling Jaccard once per
+/// node. Only nodes that share at least one neighbor are similar at all, so
+/// they are found by walking the wedges node -> neighbor <- other, and the
+/// shared neighbors are counted per thread in a dense array.
+///
+/// The result is stored in a property named by output_property_name whose
+/// values are lists of {node: uint32, similarity: double}, most similar
+/// first (ties go to the smaller node). Nodes not in nodes have empty lists.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call. The edge lists do not need to be sorted,
+/// but the in-edges of the graph are populated if they were not.
+KATANA_EXPORT Result<void> JaccardTopK(
+    PropertyGraph* pg, uint32_t k, const std::string& output_property_name,
+    const std::vector<uint32_t>& nodes = {});
+
 struct KATANA_EXPORT JaccardStatistics {
   /// The maximum similarity excluding the comparison node.
   double max_similarity;
@@ -14,7 +14,11 @@ namespace katana::analytics {
 /// Clustering Coefficient of the nodes in the graph.
 class LocalClusteringCoefficientPlan : public Plan {
 public:
-  enum Algorithm { kOrderedCountAtomics, kOrderedCountPerThread };
+  enum Algorithm {
+    kOrderedCountAtomics,
+    kOrderedCountPerThread,
+    kWedgeSampling
+  };
 
   enum Relabeling {
     kRelabel,
@@ -24,19 +28,29 @@ public:
 
   static const Relabeling kDefaultRelabeling = kAutoRelabel;
   static const bool kDefaultEdgesSorted = false;
+  static constexpr double kDefaultAbsoluteError = 0.01;
+  static constexpr double kDefaultConfidence = 0.95;
+  static const uint64_t kDefaultSeed = 0;
 
 private:
   Algorithm algorithm_;
   bool edges_sorted_;
   Relabeling relabeling_;
+  double absolute_error_;
+  double confidence_;
+  uint64_t seed_;
 
   LocalClusteringCoefficientPlan(
       Architecture architecture, Algorithm algorithm, bool edges_sorted,
-      Relabeling relabeling)
+      Relabeling relabeling, double absolute_error = kDefaultAbsoluteError,
+      double confidence = kDefaultConfidence, uint64_t seed = kDefaultSeed)
       : Plan(architecture),
         algorithm_(algorithm),
         edges_sorted_(edges_sorted),
-        relabeling_(relabeling) {}
+        relabeling_(relabeling),
+        absolute_error_(absolute_error),
+        confidence_(confidence),
+        seed_(seed) {}
 
 public:
   LocalClusteringCoefficientPlan()
@@ -48,6 +62,14 @@ public:
   // TODO(amp): These parameters should be documented.
   bool edges_sorted() const { return edges_sorted_; }
   Relabeling relabeling() const { return relabeling_; }
+  /// The target half-width of the confidence interval of the coefficient of
+  /// each node for kWedgeSampling
+  double absolute_error() const { return absolute_error_; }
+  /// The probability that the confidence interval of each node holds its
+  /// exact coefficient for kWedgeSampling
+  double confidence() const { return confidence_; }
+  /// The seed of the random choices of kWedgeSampling
+  uint64_t seed() const { return seed_; }
 
   /**
    * An ordered count algorithm that sorts the nodes by degree before
@@ -69,6 +91,31 @@ public:
       Relabeling relabeling = kDefaultRelabeling) {
     return {kCPU, kOrderedCountPerThread, edges_sorted, relabeling};
   }
+
+  /**
+   * Estimate the coefficient of each node from a sample of the wedges (pairs
+   * of neighbors) centered at it, the fraction of which that are adjacent is
+   * the coefficient. Nodes with fewer wedges than samples are counted
+   * exactly, so only high degree nodes, whose exact count is the most
+   * expensive, are sampled, and with as many samples each whatever their
+   * degree.
+   *
+   * @param absolute_error The target half-width of the confidence interval of
+   *     the coefficient of each node.
+   * @param confidence The probability the interval of a node holds its exact
+   *     coefficient.
+   * @param edges_sorted Are the edges of the graph already sorted.
+   * @param seed The seed of the random choices; the same seed gives the
+   *     same coefficients whatever the number of threads.
+   */
+  static LocalClusteringCoefficientPlan WedgeSampling(
+      double absolute_error = kDefaultAbsoluteError,
+      double confidence = kDefaultConfidence,
+      bool edges_sorted = kDefaultEdgesSorted, uint64_t seed = kDefaultSeed) {
+    return LocalClusteringCoefficientPlan(
+        kCPU, kWedgeSampling, edges_sorted, kNoRelabel, absolute_error,
+        confidence, seed);
+  }
 };
 
 /**
@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_PAGERANK_PAGERANK_H_
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "katana/Properties.h"
 #include "katana/PropertyGraph.h"
@@ -112,6 +114,63 @@ KATANA_EXPORT Result<void> Pagerank(
     PropertyGraph* pg, const std::string& output_property_name,
     PagerankPlan plan = {});
 
+/// A batch of edges, as (source, destination) pairs, inserted into and
+/// deleted from a graph. An edge may appear more than once to insert or
+/// delete several parallel edges.
+struct KATANA_EXPORT PagerankEdgeChanges {
+  std::vector<std::pair<uint32_t, uint32_t>> inserted;
+  std::vector<std::pair<uint32_t, uint32_t>> deleted;
+};
+
+/// Update the Page Rank of each node after a batch of edge changes. pg is the
+/// graph after the changes and the property named rank_property_name holds
+/// the ranks computed by Pagerank for the graph before them (with one of the
+/// residual algorithms, which share the scale of the ranks). The ranks are
+/// updated in place.
+///
+/// Instead of starting over from the initial residuals, the residuals that
+/// the changes introduce at the out-neighbors of the changed sources are
+/// pushed asynchronously as with kPushAsynchronous; residuals may become
+/// negative where edges were deleted. When the batch is small only the
+/// neighborhood of the changes is visited. The algorithm of plan is ignored.
+///
+/// The residuals below the tolerance that the earlier computation left behind
+/// are not stored with the ranks and are lost, so the error of the ranks
+/// accumulates over many updates; recompute from scratch now and then.
+KATANA_EXPORT Result<void> PagerankIncremental(
+    PropertyGraph* pg, const std::string& rank_property_name,
+    const PagerankEdgeChanges& changes, PagerankPlan plan = {});
+
+/// The nodes with the highest personalized Page Rank for one seed set, in
+/// descending order of rank
+struct KATANA_EXPORT PersonalizedPagerankResult {
+  std::vector<uint32_t> nodes;
+  std::vector<float> ranks;
+};
+
+/// Compute the personalized Page Rank for each seed set in seed_sets, that
+/// is, the probability of ending at each node of a random walk that starts
+/// at a random seed of the set and stops after each step with probability
+/// 1 - plan.alpha(), and return the k nodes with the highest rank for each.
+///
+/// Ranks are approximated by forward push: a node pushes its residual to its
+/// out-neighbors while the residual is at least plan.tolerance() times its
+/// out-degree. The work per seed set is bounded by 1 / plan.tolerance()
+/// pushes regardless of the size of the graph, and the state of a query is
+/// kept only for the nodes it reaches, so no node property is created. Use a
+/// tolerance well below 1 / k; the algorithm of plan is ignored.
+///
+/// Seed sets are processed in parallel, so batching many queries in one call
+/// uses the machine much better than calling this once per seed.
+KATANA_EXPORT Result<std::vector<PersonalizedPagerankResult>>
+PersonalizedPagerank(
+    PropertyGraph* pg, const std::vector<std::vector<uint32_t>>& seed_sets,
+    size_t k, PagerankPlan plan = {});
+
+/// Compute the personalized Page Rank for the single seed seed as above
+KATANA_EXPORT Result<PersonalizedPagerankResult> PersonalizedPagerank(
+    PropertyGraph* pg, uint32_t seed, size_t k, PagerankPlan plan = {});
+
 KATANA_EXPORT Result<void> PagerankAssertValid(
     PropertyGraph* pg, const std::string& property_name);
 
@@ -1,11 +1,14 @@
 #ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_RANDOMWALKS_RANDOMWALKS_H_
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_RANDOMWALKS_RANDOMWALKS_H_
 
+#include <functional>
 #include <iostream>
 
 #include <katana/analytics/Plan.h>
 
 #include "katana/AtomicHelpers.h"
+#include "katana/LargeArray.h"
+#include "katana/PropertyGraph.h"
 #include "katana/analytics/Utils.h"
 
 // API
@@ -133,13 +136,99 @@ public:
   }
 };
 
+/// Random walks stored back to back in one buffer, instead of a vector per
+/// walk: walk i is nodes()[offsets()[i]] up to nodes()[offsets()[i + 1]].
+/// This is the layout of an arrow list array.
+class KATANA_EXPORT RandomWalkBuffer {
+  katana::LargeArray<uint32_t> nodes_;
+  katana::LargeArray<uint64_t> offsets_;
+
+public:
+  RandomWalkBuffer() = default;
+  RandomWalkBuffer(
+      katana::LargeArray<uint32_t>&& nodes,
+      katana::LargeArray<uint64_t>&& offsets)
+      : nodes_(std::move(nodes)), offsets_(std::move(offsets)) {}
+
+  size_t num_walks() const {
+    return offsets_.size() == 0 ? 0 : offsets_.size() - 1;
+  }
+
+  /// \returns pointers to the first node of walk i and one past its last
+  std::pair<const uint32_t*, const uint32_t*> walk(size_t i) const {
+    return std::make_pair(
+        nodes_.data() + offsets_[i], nodes_.data() + offsets_[i + 1]);
+  }
+
+  /// The nodes of all the walks
+  const uint32_t* nodes() const { return nodes_.data(); }
+
+  /// The position in nodes() of the start of each walk, and the total number
+  /// of nodes last
+  const uint64_t* offsets() const { return offsets_.data(); }
+
+  /// \returns a copy of the walks, one vector per walk
+  std::vector<std::vector<uint32_t>> ToVectors() const;
+
+  /// \returns a copy of the walks as a list of node ids per walk
+  Result<std::shared_ptr<arrow::LargeListArray>> ToArrow() const;
+};
+
+/// Receives a batch of walks; an error stops the walks
+using RandomWalksBatchCallback =
+    std::function<Result<void>(RandomWalkBuffer&& batch)>;
+
+/// The number of walks generated at a time when streaming them
+constexpr uint64_t kDefaultRandomWalksPerBatch = uint64_t{1} << 20;
+
+/// The column of the walks written by RandomWalksToParquet
+constexpr const char* kRandomWalksColumnName = "walk";
+
 /// Compute the random-walks for pg. The pg is expected to be symmetric. The
 /// parameters can be specified, but have reasonable defaults. Not all
-/// parameters are used by the algorithms. The generated random-walks generated
-/// are returned as a vector of vectors.
-KATANA_EXPORT Result<std::vector<std::vector<uint32_t>>> RandomWalks(
+/// parameters are used by the algorithms. The walks are generated in place
+/// in a buffer sized for number_of_walks walks of walk_length steps from each
+/// node with neighbors; each step picks a neighbor uniformly, biased by
+/// rejection sampling for the backward and forward probabilities.
+KATANA_EXPORT Result<RandomWalkBuffer> RandomWalks(
     PropertyGraph* pg, RandomWalksPlan plan = RandomWalksPlan());
 
+/// Compute weighted random-walks for pg: like RandomWalks, but each step
+/// picks a neighbor in proportion to the weight of the edge to it, taken
+/// from the property named edge_weight_property_name (which may be a 32- or
+/// 64-bit sign or unsigned int, or a float or double). Weights must not be
+/// negative; a node whose weights are all zero picks uniformly. Steps take
+/// constant time from an alias table of the edges of each node, built once.
+KATANA_EXPORT Result<RandomWalkBuffer> RandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan = RandomWalksPlan());
+
+/// Compute the random-walks for pg like RandomWalks, but in batches of at
+/// most walks_per_batch walks: each batch is handed to callback before the
+/// next is generated, so memory for walks is bounded by the batch size
+/// rather than by number_of_walks. The batches come in the order of the
+/// walks returned by RandomWalks. Only Node2Vec supports batches smaller
+/// than all the walks, since each Edge2Vec iteration learns from all the
+/// walks of the previous one.
+KATANA_EXPORT Result<void> RandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan, uint64_t walks_per_batch,
+    const RandomWalksBatchCallback& callback);
+
+/// Compute the random-walks for pg in batches, and write each batch to a
+/// Parquet file at uri_prefix with a suffix of .000000, .000001 and so on, as
+/// blocked ParquetWriter output is named. Each file has a single column,
+/// kRandomWalksColumnName, with a list of node ids per walk. A batch is
+/// written in the background while the next one is generated, so at most
+/// two batches are in memory at once. An empty edge_weight_property_name
+/// picks neighbors uniformly.
+///
+/// \returns the number of files written
+KATANA_EXPORT Result<uint64_t> RandomWalksToParquet(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan, const std::string& uri_prefix,
+    uint64_t walks_per_batch = kDefaultRandomWalksPerBatch);
+
 KATANA_EXPORT Result<void> RandomWalksAssertValid(PropertyGraph* pg);
 
 }  // namespace katana::analytics
@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_SSSP_SSSP_H_
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "katana/AtomicHelpers.h"
 #include "katana/analytics/Plan.h"
@@ -31,6 +33,7 @@ public:
 
   static const int kDefaultDelta = 13;
   static const int kDefaultEdgeTileSize = 512;
+  static const unsigned kDefaultChunkSize = 64;
 
   // Don't allow people to directly construct these, so as to have only one
   // consistent way to configure.
@@ -38,21 +41,24 @@ private:
   Algorithm algorithm_;
   unsigned delta_;
   ptrdiff_t edge_tile_size_;
-  // TODO: should chunk_size be in the plan? Or fixed?
-  //  It cannot be in the plan currently because it is a template parameter and
-  //  cannot be easily changed since the value is statically passed on to
-  //  FixedSizeRing.
-  //unsigned chunk_size_ = 64;
+  // The chunk size is a template parameter of the worklist (it is statically
+  // passed on to FixedSizeRing), so only a few values are instantiated
+  unsigned chunk_size_;
 
   SsspPlan(
       Architecture architecture, Algorithm algorithm, unsigned delta,
-      ptrdiff_t edge_tile_size)
+      ptrdiff_t edge_tile_size, unsigned chunk_size = kDefaultChunkSize)
       : Plan(architecture),
         algorithm_(algorithm),
         delta_(delta),
-        edge_tile_size_(edge_tile_size) {}
+        edge_tile_size_(edge_tile_size),
+        chunk_size_(chunk_size) {}
 
 public:
+  /// The automatic plan. When run, it chooses the algorithm as
+  /// SsspPlan(const PropertyGraph*) does and picks delta and the chunk size
+  /// from a sample of the degrees and edge weights of the graph. The chosen
+  /// parameters are reported as statistics.
   SsspPlan() : SsspPlan{kCPU, kAutomatic, 0, 0} {}
 
   SsspPlan(const katana::PropertyGraph* pg) : Plan(kCPU) {
@@ -70,18 +76,27 @@ public:
   unsigned delta() const { return delta_; }
   ptrdiff_t edge_tile_size() const { return edge_tile_size_; }
 
+  /// The number of work items per chunk of the delta-stepping worklist:
+  /// 16, 64 or 256.
+  unsigned chunk_size() const { return chunk_size_; }
+
   static SsspPlan DeltaTile(
       unsigned delta = kDefaultDelta,
-      ptrdiff_t edge_tile_size = kDefaultEdgeTileSize) {
-    return {kCPU, kDeltaTile, delta, edge_tile_size};
+      ptrdiff_t edge_tile_size = kDefaultEdgeTileSize,
+      unsigned chunk_size = kDefaultChunkSize) {
+    return {kCPU, kDeltaTile, delta, edge_tile_size, chunk_size};
   }
 
-  static SsspPlan DeltaStep(unsigned delta = kDefaultDelta) {
-    return {kCPU, kDeltaStep, delta, 0};
+  static SsspPlan DeltaStep(
+      unsigned delta = kDefaultDelta,
+      unsigned chunk_size = kDefaultChunkSize) {
+    return {kCPU, kDeltaStep, delta, 0, chunk_size};
   }
 
-  static SsspPlan DeltaStepBarrier(unsigned delta = kDefaultDelta) {
-    return {kCPU, kDeltaStepBarrier, delta, 0};
+  static SsspPlan DeltaStepBarrier(
+      unsigned delta = kDefaultDelta,
+      unsigned chunk_size = kDefaultChunkSize) {
+    return {kCPU, kDeltaStepBarrier, delta, 0, chunk_size};
   }
 
   static SsspPlan DeltaStepFusion(unsigned delta = kDefaultDelta) {
@@ -131,6 +146,65 @@ KATANA_EXPORT Result<void> SsspAssertValid(
     const std::string& edge_weight_property_name,
     const std::string& output_property_name);
 
+/// The result of a point-to-point shortest path query
+struct KATANA_EXPORT SsspPath {
+  /// Whether there is a path from the start node to the target node
+  bool reachable{false};
+  /// The length of the shortest path, if there is one
+  double distance{0};
+  /// The nodes on the shortest path from the start node to the target node,
+  /// both included, if there is one
+  std::vector<uint32_t> nodes;
+};
+
+/// Compute the shortest path in pg from start_node to target_node, with edge
+/// weights taken from the property named edge_weight_property_name as in
+/// Sssp. Unlike Sssp, no node property is written.
+///
+/// The search runs delta-stepping forward from start_node along out-edges and
+/// backward from target_node along in-edges, and stops once the two searches
+/// can no longer find a path shorter than the best one seen, so usually only
+/// edges near the path are relaxed. Each query still allocates and
+/// initializes two distance arrays with an entry per node, so queries cost
+/// time and memory linear in the number of nodes; answer many queries with
+/// SsspLandmarkQuery instead. The delta of delta-stepping plans is used;
+/// other plans use SsspPlan::kDefaultDelta. Edge weights must not be
+/// negative.
+KATANA_EXPORT Result<SsspPath> SsspPointToPoint(
+    PropertyGraph* pg, size_t start_node, size_t target_node,
+    const std::string& edge_weight_property_name, SsspPlan plan = {});
+
+/// Build a landmark index of pg for SsspLandmarkQuery. num_landmarks nodes
+/// are picked as landmarks, each as far as possible from those picked before
+/// it, and the shortest path distances from and to landmark i are stored in
+/// the node properties named index_property_prefix + "from_<i>" and
+/// index_property_prefix + "to_<i>" (with the type of the edge weights).
+/// These properties are created by this function, may not exist before the
+/// call and are marked persistent, so the index is written with the graph and
+/// can be reused after loading it again.
+///
+/// Each landmark costs a forward and a backward delta-stepping search with
+/// the delta of delta-stepping plans or SsspPlan::kDefaultDelta otherwise.
+/// The index must be rebuilt when the topology or edge weights change.
+KATANA_EXPORT Result<void> SsspBuildLandmarkIndex(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    uint32_t num_landmarks, const std::string& index_property_prefix,
+    SsspPlan plan = {});
+
+/// Compute the shortest path in pg from start_node to target_node as
+/// SsspPointToPoint does, using the index built by SsspBuildLandmarkIndex
+/// with the same edge weights and index_property_prefix.
+///
+/// The search is A* with lower bounds on the remaining distance derived from
+/// the landmark distances (ALT), which steers it towards target_node. On
+/// graphs with a large diameter, such as road networks, it settles a small
+/// fraction of the nodes a full search would. The search is serial, so it is
+/// meant for answering many independent queries.
+KATANA_EXPORT Result<SsspPath> SsspLandmarkQuery(
+    PropertyGraph* pg, size_t start_node, size_t target_node,
+    const std::string& edge_weight_property_name,
+    const std::string& index_property_prefix);
+
 struct KATANA_EXPORT SsspStatistics {
   /// The number of nodes reachable from the source node.
   uint64_t n_reached_nodes;
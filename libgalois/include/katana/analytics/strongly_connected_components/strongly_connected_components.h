@@ -0,0 +1,107 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+
+#include <iostream>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for StronglyConnectedComponents, specifying the
+/// algorithm and any parameters associated with it.
+class StronglyConnectedComponentsPlan : public Plan {
+public:
+  /// Algorithm selectors for strongly connected components
+  enum Algorithm { kSerial, kColoring, kForwardBackward };
+
+  static const uint32_t kDefaultTrimRounds = 4;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t trim_rounds_;
+
+  StronglyConnectedComponentsPlan(
+      Architecture architecture, Algorithm algorithm, uint32_t trim_rounds)
+      : Plan(architecture), algorithm_(algorithm), trim_rounds_(trim_rounds) {}
+
+public:
+  StronglyConnectedComponentsPlan()
+      : StronglyConnectedComponentsPlan{
+            kCPU, kForwardBackward, kDefaultTrimRounds} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// The maximum number of passes removing nodes without in-edges or
+  /// out-edges before the main algorithm runs.
+  uint32_t trim_rounds() const { return trim_rounds_; }
+
+  /// Serial algorithm (Tarjan's). Uses only the out-edges of the graph.
+  static StronglyConnectedComponentsPlan Serial() {
+    return {kCPU, kSerial, 0};
+  }
+
+  /// Trimming followed by coloring. Each round of coloring propagates the
+  /// smallest node id forward from every remaining node. A node that keeps
+  /// its own id is the root of a component, which is the nodes with its
+  /// color that reach it, found by a backward search. The remaining nodes
+  /// are colored again until none are left.
+  static StronglyConnectedComponentsPlan Coloring(
+      uint32_t trim_rounds = kDefaultTrimRounds) {
+    return {kCPU, kColoring, trim_rounds};
+  }
+
+  /// Trimming, then a forward and backward search from a node of high degree
+  /// to find the (typically giant) component containing it, then coloring
+  /// for the rest of the graph.
+  /// [1] G. M. Slota, S. Rajamanickam and K. Madduri, "BFS and Coloring-Based
+  /// Parallel Algorithms for Strongly Connected Components and Related
+  /// Problems," 2014 IEEE International Parallel and Distributed Processing
+  /// Symposium (IPDPS), Phoenix, AZ, 2014, pp. 550-559.
+  static StronglyConnectedComponentsPlan ForwardBackward(
+      uint32_t trim_rounds = kDefaultTrimRounds) {
+    return {kCPU, kForwardBackward, trim_rounds};
+  }
+};
+
+/// Compute the strongly connected components of pg. The component of each
+/// node is stored in the property named output_property_name (as uint64_t)
+/// and is the id of a node in the component.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+///
+/// The parallel algorithms also follow in-edges, so pg->PopulateInEdges() is
+/// called first: a transpose topology stored with the graph is used if there
+/// is one, and otherwise it is computed and kept with pg.
+KATANA_EXPORT Result<void> StronglyConnectedComponents(
+    PropertyGraph* pg, const std::string& output_property_name,
+    StronglyConnectedComponentsPlan plan = {});
+
+/// Check the components in the property named property_name against those
+/// computed by the serial algorithm.
+KATANA_EXPORT Result<void> StronglyConnectedComponentsAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT StronglyConnectedComponentsStatistics {
+  /// Total number of unique components in the graph.
+  uint64_t total_components;
+  /// Total number of components with more than 1 node.
+  uint64_t total_non_trivial_components;
+  /// The number of nodes present in the largest component.
+  uint64_t largest_component_size;
+  /// The ratio of nodes present in the largest component.
+  double largest_component_ratio;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<StronglyConnectedComponentsStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+#endif
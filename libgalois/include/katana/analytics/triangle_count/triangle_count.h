@@ -15,6 +15,7 @@ public:
     kNodeIteration,
     kEdgeIteration,
     kOrderedCount,
+    kWedgeSampling,
   };
 
   enum Relabeling {
@@ -25,19 +26,29 @@ public:
 
   static const Relabeling kDefaultRelabeling = kAutoRelabel;
   static const bool kDefaultEdgeSorted = false;
+  static constexpr double kDefaultRelativeError = 0.01;
+  static constexpr double kDefaultConfidence = 0.95;
+  static const uint64_t kDefaultSeed = 0;
 
 private:
   Algorithm algorithm_;
   Relabeling relabeling_;
   bool edges_sorted_;
+  double relative_error_;
+  double confidence_;
+  uint64_t seed_;
 
   TriangleCountPlan(
       Architecture architecture, Algorithm algorithm, bool edges_sorted,
-      Relabeling relabeling)
+      Relabeling relabeling, double relative_error = kDefaultRelativeError,
+      double confidence = kDefaultConfidence, uint64_t seed = kDefaultSeed)
       : Plan(architecture),
         algorithm_(algorithm),
         relabeling_(relabeling),
-        edges_sorted_(edges_sorted) {}
+        edges_sorted_(edges_sorted),
+        relative_error_(relative_error),
+        confidence_(confidence),
+        seed_(seed) {}
 
 public:
   TriangleCountPlan()
@@ -47,6 +58,14 @@ public:
   Algorithm algorithm() const { return algorithm_; }
   Relabeling relabeling() const { return relabeling_; }
   bool edges_sorted() const { return edges_sorted_; }
+  /// The target half-width of the confidence interval of kWedgeSampling,
+  /// relative to the estimate
+  double relative_error() const { return relative_error_; }
+  /// The probability that the confidence interval of kWedgeSampling holds
+  /// the exact count
+  double confidence() const { return confidence_; }
+  /// The seed of the random choices of kWedgeSampling
+  uint64_t seed() const { return seed_; }
 
   /**
    * The node-iterator algorithm from the following:
@@ -90,6 +109,54 @@ public:
       Relabeling relabeling = kDefaultRelabeling) {
     return {kCPU, kOrderedCount, edges_sorted, relabeling};
   }
+
+  /**
+   * Estimate the count from a sample of wedges (paths of two edges), of
+   * which a fraction are closed by a triangle, from the following:
+   *   C. Seshadhri, Ali Pinar, and Tamara G. Kolda. Triadic Measures on Graphs:
+   *   The Power of Wedge Sampling. SDM 2013.
+   *
+   * Wedges are sampled in rounds of doubling size until the confidence
+   * interval of the count is within relative_error of the estimate. The cost
+   * depends on the error and the fraction of closed wedges, not on the size
+   * of the graph, beyond a pass over the nodes. Nodes are never relabeled.
+   *
+   * When few wedges are closed, as in nearly triangle-free graphs, reaching
+   * the relative error could take more samples than a quarter of the wedges.
+   * The triangles are then counted exactly instead, as kOrderedCount does.
+   *
+   * @param relative_error The target half-width of the confidence interval,
+   *     relative to the estimate.
+   * @param confidence The probability the interval holds the exact count.
+   * @param edges_sorted Are the edges of the graph already sorted.
+   * @param seed The seed of the random choices; the same seed gives the
+   *     same estimate whatever the number of threads.
+   */
+  static TriangleCountPlan WedgeSampling(
+      double relative_error = kDefaultRelativeError,
+      double confidence = kDefaultConfidence,
+      bool edges_sorted = kDefaultEdgeSorted, uint64_t seed = kDefaultSeed) {
+    return TriangleCountPlan(
+        kCPU, kWedgeSampling, edges_sorted, kNoRelabel, relative_error,
+        confidence, seed);
+  }
+};
+
+/// An estimate of the number of triangles of a graph
+struct KATANA_EXPORT TriangleCountEstimate {
+  /// The estimated number of triangles
+  double estimate;
+  /// The confidence interval of the number of triangles
+  double lower_bound;
+  double upper_bound;
+  /// The estimated fraction of wedges that are closed, which is the global
+  /// clustering coefficient (transitivity) of the graph
+  double closed_wedge_fraction;
+  /// The number of wedges sampled
+  uint64_t num_samples;
+  /// Whether sampling gave up for an exact count, so that the estimate and
+  /// both bounds are the exact number of triangles
+  bool exact{false};
 };
 
 /**
@@ -104,6 +171,20 @@ public:
 KATANA_EXPORT katana::Result<uint64_t> TriangleCount(
     PropertyGraph* pg, TriangleCountPlan plan = {});
 
+/**
+ * Estimate the total number of triangles in the graph, with a confidence
+ * interval, by sampling wedges. The graph must be symmetric! TriangleCount
+ * with the same plan returns the estimate rounded to an integer.
+ *
+ * This algorithm copies the graph internally unless its edges are sorted.
+ *
+ * @param pg The graph to process.
+ * @param plan A TriangleCountPlan::WedgeSampling plan.
+ */
+KATANA_EXPORT katana::Result<TriangleCountEstimate> ApproximateTriangleCount(
+    PropertyGraph* pg,
+    TriangleCountPlan plan = TriangleCountPlan::WedgeSampling());
+
 }  // namespace katana::analytics
 
 #endif
@@ -0,0 +1,304 @@
+#include "katana/CompressedGraphTopology.h"
+
+#include <algorithm>
+
+#include "katana/BitMath.h"
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
+#include "tsuba/CSRTopology.h"
+#include "tsuba/Errors.h"
+
+namespace {
+
+using Node = katana::CompressedGraphTopology::Node;
+using Edge = katana::CompressedGraphTopology::Edge;
+
+uint64_t
+NumBlocks(uint64_t num_nodes) {
+  return (num_nodes + katana::CompressedGraphTopology::kNodesPerBlock - 1) /
+         katana::CompressedGraphTopology::kNodesPerBlock;
+}
+
+/// \returns the number of bytes needed to encode the destinations of \param
+/// node
+uint64_t
+EncodedSize(const katana::GraphTopology& topology, Node node) {
+  uint64_t size = 0;
+  int64_t prev = node;
+  for (auto e : topology.edges(node)) {
+    int64_t dest = topology.edge_dest(e);
+    size += katana::CompressedGraphTopology::VarintSize(
+        katana::CompressedGraphTopology::ZigZagEncode(dest - prev));
+    prev = dest;
+  }
+  return size;
+}
+
+/// Encode the destinations of \param node at \param *pos and advance \param
+/// *pos past them
+void
+Encode(const katana::GraphTopology& topology, Node node, uint8_t** pos) {
+  int64_t prev = node;
+  for (auto e : topology.edges(node)) {
+    int64_t dest = topology.edge_dest(e);
+    katana::CompressedGraphTopology::WriteVarint(
+        katana::CompressedGraphTopology::ZigZagEncode(dest - prev), pos);
+    prev = dest;
+  }
+}
+
+}  // namespace
+
+katana::CompressedGraphTopology::CompressedGraphTopology(
+    LargeArray<Edge>&& out_indices, LargeArray<uint64_t>&& block_offsets,
+    LargeArray<uint8_t>&& dests) noexcept
+    : out_indices_(std::move(out_indices)),
+      block_offsets_(std::move(block_offsets)),
+      dests_(std::move(dests)) {
+  num_edges_ = out_indices_.size() > 0 ? out_indices_[out_indices_.size() - 1]
+                                       : 0;
+}
+
+std::unique_ptr<katana::CompressedGraphTopology>
+katana::CompressedGraphTopology::Make(const GraphTopology& topology) {
+  uint64_t num_nodes = topology.num_nodes();
+  uint64_t num_blocks = NumBlocks(num_nodes);
+
+  LargeArray<Edge> out_indices;
+  out_indices.allocateInterleaved(num_nodes);
+  katana::ParallelSTL::copy(
+      topology.out_indices->raw_values(),
+      topology.out_indices->raw_values() + num_nodes, out_indices.begin());
+
+  // Size each block in parallel and then turn the sizes into offsets. There
+  // are few enough blocks that the scan is done serially.
+  LargeArray<uint64_t> block_offsets;
+  block_offsets.allocateInterleaved(num_blocks);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_blocks),
+      [&](uint64_t block) {
+        uint64_t first = block * kNodesPerBlock;
+        uint64_t last = std::min(first + kNodesPerBlock, num_nodes);
+        uint64_t size = 0;
+        for (uint64_t n = first; n < last; ++n) {
+          size += EncodedSize(topology, n);
+        }
+        block_offsets[block] = size;
+      },
+      katana::steal(), katana::no_stats());
+
+  uint64_t num_bytes = 0;
+  for (uint64_t block = 0; block < num_blocks; ++block) {
+    uint64_t size = block_offsets[block];
+    block_offsets[block] = num_bytes;
+    num_bytes += size;
+  }
+
+  LargeArray<uint8_t> dests;
+  dests.allocateInterleaved(num_bytes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_blocks),
+      [&](uint64_t block) {
+        uint64_t first = block * kNodesPerBlock;
+        uint64_t last = std::min(first + kNodesPerBlock, num_nodes);
+        uint8_t* pos = dests.data() + block_offsets[block];
+        for (uint64_t n = first; n < last; ++n) {
+          Encode(topology, n, &pos);
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return std::unique_ptr<CompressedGraphTopology>(new CompressedGraphTopology(
+      std::move(out_indices), std::move(block_offsets), std::move(dests)));
+}
+
+katana::Result<std::unique_ptr<katana::CompressedGraphTopology>>
+katana::CompressedGraphTopology::Make(const tsuba::FileView& file_view) {
+  if (file_view.size() < sizeof(tsuba::CSRTopologyHeader)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "compressed topology file too small: {}", file_view.size());
+  }
+  const auto* header = file_view.ptr<tsuba::CSRTopologyHeader>();
+  if (header->version != tsuba::kCompressedCSRVersion) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "unexpected compressed topology version {}", header->version);
+  }
+
+  uint64_t prefix_size =
+      sizeof(*header) + header->num_nodes * sizeof(uint64_t) +
+      sizeof(tsuba::CompressedCSRTopologyHeader);
+  if (file_view.size() < prefix_size) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "file_view size: {} expected {}",
+        file_view.size(), prefix_size);
+  }
+
+  auto* out_indices = const_cast<uint64_t*>(
+      reinterpret_cast<const uint64_t*>(header + 1));
+  const auto* compressed_header =
+      reinterpret_cast<const tsuba::CompressedCSRTopologyHeader*>(
+          out_indices + header->num_nodes);
+  if (compressed_header->nodes_per_block != kNodesPerBlock) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "unsupported compressed topology block size {}",
+        compressed_header->nodes_per_block);
+  }
+
+  uint64_t expected_size =
+      tsuba::CompressedCSRTopologyFileSize(*header, *compressed_header);
+  if (file_view.size() < expected_size) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "file_view size: {} expected {}",
+        file_view.size(), expected_size);
+  }
+
+  uint64_t num_blocks =
+      tsuba::CompressedCSRTopologyNumBlocks(*header, *compressed_header);
+  auto* block_offsets = const_cast<uint64_t*>(
+      reinterpret_cast<const uint64_t*>(compressed_header + 1));
+  auto* dests = reinterpret_cast<uint8_t*>(block_offsets + num_blocks);
+
+  auto topo = std::unique_ptr<CompressedGraphTopology>(
+      new CompressedGraphTopology(
+          LargeArray<Edge>(out_indices, header->num_nodes),
+          LargeArray<uint64_t>(block_offsets, num_blocks),
+          LargeArray<uint8_t>(dests, compressed_header->dests_size)));
+  if (topo->num_edges() != header->num_edges) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "compressed topology has {} edges, header says {}", topo->num_edges(),
+        header->num_edges);
+  }
+  return std::unique_ptr<CompressedGraphTopology>(std::move(topo));
+}
+
+std::unique_ptr<katana::CompressedGraphTopology>
+katana::CompressedGraphTopology::Copy(const CompressedGraphTopology& that) {
+  LargeArray<Edge> out_indices;
+  LargeArray<uint64_t> block_offsets;
+  LargeArray<uint8_t> dests;
+  out_indices.allocateInterleaved(that.out_indices_.size());
+  block_offsets.allocateInterleaved(that.block_offsets_.size());
+  dests.allocateInterleaved(that.dests_.size());
+  katana::ParallelSTL::copy(
+      that.out_indices_.begin(), that.out_indices_.end(), out_indices.begin());
+  katana::ParallelSTL::copy(
+      that.block_offsets_.begin(), that.block_offsets_.end(),
+      block_offsets.begin());
+  katana::ParallelSTL::copy(
+      that.dests_.begin(), that.dests_.end(), dests.begin());
+
+  return std::unique_ptr<CompressedGraphTopology>(new CompressedGraphTopology(
+      std::move(out_indices), std::move(block_offsets), std::move(dests)));
+}
+
+std::unique_ptr<katana::GraphTopology>
+katana::CompressedGraphTopology::Decompress() const {
+  uint64_t num_nodes = this->num_nodes();
+
+  LargeArray<Edge> out_indices;
+  LargeArray<Node> out_dests;
+  out_indices.allocateInterleaved(num_nodes);
+  out_dests.allocateInterleaved(num_edges_);
+  katana::ParallelSTL::copy(
+      out_indices_.begin(), out_indices_.end(), out_indices.begin());
+
+  // Decode a block at a time so that each node only finds its destinations
+  // by continuing from the previous one
+  katana::do_all(
+      katana::iterate(uint64_t{0}, block_offsets_.size()),
+      [&](uint64_t block) {
+        uint64_t first = block * kNodesPerBlock;
+        uint64_t last = std::min(first + kNodesPerBlock, num_nodes);
+        const uint8_t* pos = dests_.data() + block_offsets_[block];
+        for (uint64_t n = first; n < last; ++n) {
+          auto [begin_edge, end_edge] = edge_range(n);
+          int64_t prev = n;
+          for (Edge e = begin_edge; e < end_edge; ++e) {
+            prev += ZigZagDecode(ReadVarint(&pos));
+            out_dests[e] = static_cast<Node>(prev);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return std::make_unique<GraphTopology>(
+      std::move(out_indices), std::move(out_dests));
+}
+
+katana::Result<std::unique_ptr<tsuba::FileFrame>>
+katana::CompressedGraphTopology::ToFileFrame() const {
+  auto ff = std::make_unique<tsuba::FileFrame>();
+  if (auto res = ff->Init(); !res) {
+    return res.error();
+  }
+
+  tsuba::CSRTopologyHeader header{
+      .version = tsuba::kCompressedCSRVersion,
+      .edge_type_size = 0,
+      .num_nodes = num_nodes(),
+      .num_edges = num_edges(),
+  };
+  arrow::Status aro_sts = ff->Write(&header, sizeof(header));
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+
+  if (num_nodes()) {
+    aro_sts = ff->Write(out_indices_.data(), num_nodes() * sizeof(uint64_t));
+    if (!aro_sts.ok()) {
+      return tsuba::ArrowToTsuba(aro_sts.code());
+    }
+  }
+
+  tsuba::CompressedCSRTopologyHeader compressed_header{
+      .nodes_per_block = kNodesPerBlock,
+      .dests_size = dests_.size(),
+  };
+  aro_sts = ff->Write(&compressed_header, sizeof(compressed_header));
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+
+  if (block_offsets_.size()) {
+    aro_sts = ff->Write(
+        block_offsets_.data(), block_offsets_.size() * sizeof(uint64_t));
+    if (!aro_sts.ok()) {
+      return tsuba::ArrowToTsuba(aro_sts.code());
+    }
+  }
+
+  if (dests_.size()) {
+    aro_sts = ff->Write(dests_.data(), dests_.size());
+    if (!aro_sts.ok()) {
+      return tsuba::ArrowToTsuba(aro_sts.code());
+    }
+  }
+
+  uint64_t padding = katana::AlignUp<uint64_t>(dests_.size()) - dests_.size();
+  if (padding) {
+    uint64_t zero = 0;
+    aro_sts = ff->Write(&zero, padding);
+    if (!aro_sts.ok()) {
+      return tsuba::ArrowToTsuba(aro_sts.code());
+    }
+  }
+
+  return std::unique_ptr<tsuba::FileFrame>(std::move(ff));
+}
+
+bool
+katana::CompressedGraphTopology::Equals(
+    const CompressedGraphTopology& other) const {
+  if (num_nodes() != other.num_nodes() || num_edges() != other.num_edges() ||
+      num_dest_bytes() != other.num_dest_bytes()) {
+    return false;
+  }
+  return std::equal(
+             out_indices_.begin(), out_indices_.end(),
+             other.out_indices_.begin()) &&
+         std::equal(dests_.begin(), dests_.end(), other.dests_.begin());
+}
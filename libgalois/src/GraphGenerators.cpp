@@ -0,0 +1,350 @@
+#include "katana/GraphGenerators.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/Galois.h"
+#include "katana/LargeArray.h"
+#include "katana/Logging.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+struct EdgePair {
+  Node src;
+  Node dst;
+};
+
+/// Edges are sampled in blocks of this many, each from its own generator
+constexpr uint64_t kEdgesPerBlock = uint64_t{1} << 16;
+
+/// The splitmix64 finalizer, to derive independent seeds and hash values
+uint64_t
+Mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/// Sample num_edges edges with sample(generator). Block b of edges draws from a
+/// generator seeded by seed and b, so that the edges do not depend on the
+/// number of threads.
+template <typename Sample>
+std::vector<EdgePair>
+SampleEdges(uint64_t num_edges, uint64_t seed, const Sample& sample) {
+  std::vector<EdgePair> edges(num_edges);
+  uint64_t num_blocks = (num_edges + kEdgesPerBlock - 1) / kEdgesPerBlock;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_blocks),
+      [&](uint64_t block) {
+        std::mt19937_64 generator(Mix(seed ^ Mix(block)));
+        uint64_t end = std::min(num_edges, (block + 1) * kEdgesPerBlock);
+        for (uint64_t i = block * kEdgesPerBlock; i < end; ++i) {
+          edges[i] = sample(generator);
+        }
+      },
+      katana::steal(), katana::loopname("GraphGeneratorSample"));
+  return edges;
+}
+
+/// \returns the weight of the edge between a and b, which is the same in both
+/// directions
+uint32_t
+EdgeWeight(Node a, Node b, const katana::GraphGeneratorOptions& options) {
+  uint64_t key = (uint64_t{std::min(a, b)} << 32) | std::max(a, b);
+  return 1 + Mix(options.seed ^ Mix(key)) % options.max_weight;
+}
+
+katana::Result<void>
+AddEdgeWeights(
+    katana::PropertyGraph* pg, const katana::GraphGeneratorOptions& options) {
+  const katana::GraphTopology& topology = pg->topology();
+  std::vector<uint32_t> weights(topology.num_edges());
+  katana::do_all(
+      katana::iterate(Node{0}, static_cast<Node>(topology.num_nodes())),
+      [&](Node src) {
+        for (Edge e : topology.edges(src)) {
+          weights[e] = EdgeWeight(src, topology.edge_dest(e), options);
+        }
+      },
+      katana::steal(), katana::loopname("GraphGeneratorWeights"));
+
+  arrow::UInt32Builder builder;
+  std::shared_ptr<arrow::Array> array;
+  if (!builder.AppendValues(weights).ok() || !builder.Finish(&array).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  auto table = arrow::Table::Make(
+      arrow::schema(
+          {arrow::field(options.edge_weight_property_name, arrow::uint32())}),
+      {array});
+  return pg->AddEdgeProperties(table);
+}
+
+/// Make a graph of edges, dropping self loops and duplicates and adding the
+/// reverse edges if the graph is symmetric
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+MakeGraph(
+    uint32_t num_nodes, const std::vector<EdgePair>& edges,
+    const katana::GraphGeneratorOptions& options) {
+  // Count the edges of each node and place them, unsorted, in CSR order
+  std::vector<std::atomic<uint64_t>> counts(num_nodes);
+  katana::do_all(
+      katana::iterate(edges.begin(), edges.end()),
+      [&](const EdgePair& edge) {
+        if (edge.src == edge.dst) {
+          return;
+        }
+        counts[edge.src].fetch_add(1, std::memory_order_relaxed);
+        if (options.symmetric) {
+          counts[edge.dst].fetch_add(1, std::memory_order_relaxed);
+        }
+      },
+      katana::loopname("GraphGeneratorCount"));
+
+  std::vector<uint64_t> offsets(uint64_t{num_nodes} + 1);
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    offsets[n + 1] = offsets[n] + counts[n].load(std::memory_order_relaxed);
+    counts[n].store(0, std::memory_order_relaxed);
+  }
+
+  std::vector<Node> unsorted(offsets[num_nodes]);
+  auto place = [&](Node src, Node dst) {
+    uint64_t i = counts[src].fetch_add(1, std::memory_order_relaxed);
+    unsorted[offsets[src] + i] = dst;
+  };
+  katana::do_all(
+      katana::iterate(edges.begin(), edges.end()),
+      [&](const EdgePair& edge) {
+        if (edge.src == edge.dst) {
+          return;
+        }
+        place(edge.src, edge.dst);
+        if (options.symmetric) {
+          place(edge.dst, edge.src);
+        }
+      },
+      katana::loopname("GraphGeneratorPlace"));
+
+  // Sort the edges of each node and drop duplicates
+  std::vector<uint64_t> degrees(num_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) {
+        auto begin = unsorted.begin() + offsets[n];
+        auto end = unsorted.begin() + offsets[n + 1];
+        std::sort(begin, end);
+        degrees[n] = std::unique(begin, end) - begin;
+      },
+      katana::steal(), katana::loopname("GraphGeneratorSort"));
+
+  katana::LargeArray<Edge> adj_indices;
+  adj_indices.allocateInterleaved(num_nodes);
+  uint64_t num_edges = 0;
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    num_edges += degrees[n];
+    adj_indices[n] = num_edges;
+  }
+
+  katana::LargeArray<Node> dests;
+  dests.allocateInterleaved(num_edges);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) {
+        uint64_t begin = n == 0 ? 0 : adj_indices[n - 1];
+        std::copy_n(
+            unsorted.begin() + offsets[n], degrees[n], dests.begin() + begin);
+      },
+      katana::steal(), katana::loopname("GraphGeneratorCopy"));
+
+  auto pg = std::make_unique<katana::PropertyGraph>();
+  if (auto r = pg->SetTopology(std::make_unique<katana::GraphTopology>(
+          std::move(adj_indices), std::move(dests)));
+      !r) {
+    return r.error();
+  }
+
+  if (!options.edge_weight_property_name.empty()) {
+    if (auto r = AddEdgeWeights(pg.get(), options); !r) {
+      return r.error();
+    }
+  }
+
+  return std::unique_ptr<katana::PropertyGraph>(std::move(pg));
+}
+
+katana::Result<void>
+CheckOptions(const katana::GraphGeneratorOptions& options) {
+  if (!options.edge_weight_property_name.empty() && options.max_weight == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "max_weight must be positive");
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+CheckScale(uint32_t scale) {
+  if (scale > 31) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "scale {} is too large; node ids have 32 bits", scale);
+  }
+  return katana::ResultSuccess();
+}
+
+/// An R-MAT edge: at each level, choose a quadrant of the remaining matrix
+EdgePair
+SampleRmatEdge(
+    std::mt19937_64& generator, uint32_t scale,
+    const katana::RmatParameters& parameters) {
+  std::uniform_real_distribution<double> dist;
+  double ab = parameters.a + parameters.b;
+  double abc = ab + parameters.c;
+
+  EdgePair edge{0, 0};
+  for (uint32_t level = 0; level < scale; ++level) {
+    double r = dist(generator);
+    edge.src <<= 1;
+    edge.dst <<= 1;
+    if (r < parameters.a) {
+      continue;
+    }
+    if (r < ab) {
+      edge.dst |= 1;
+    } else if (r < abc) {
+      edge.src |= 1;
+    } else {
+      edge.src |= 1;
+      edge.dst |= 1;
+    }
+  }
+  return edge;
+}
+
+/// A random permutation of [0, 2^scale), evaluated without a table: each step
+/// of each round is a bijection on scale-bit integers
+Node
+PermuteNode(Node node, uint32_t scale, uint64_t seed) {
+  uint64_t mask = (uint64_t{1} << scale) - 1;
+  uint32_t shift = (scale + 1) / 2;
+  uint64_t x = node;
+  for (uint64_t round = 0; round < 3; ++round) {
+    uint64_t key = Mix(seed ^ Mix(round));
+    x = (x * (key | 1)) & mask;
+    x ^= x >> shift;
+    x = (x + (key >> 32)) & mask;
+  }
+  return static_cast<Node>(x);
+}
+
+}  // namespace
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::GenerateRmatGraph(
+    uint32_t scale, uint32_t edge_factor, const RmatParameters& parameters,
+    const GraphGeneratorOptions& options) {
+  if (auto r = CheckScale(scale); !r) {
+    return r.error();
+  }
+  if (auto r = CheckOptions(options); !r) {
+    return r.error();
+  }
+  if (parameters.a < 0 || parameters.b < 0 || parameters.c < 0 ||
+      parameters.a + parameters.b + parameters.c > 1) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "R-MAT probabilities {}, {}, {} must be non-negative and sum to at "
+        "most 1",
+        parameters.a, parameters.b, parameters.c);
+  }
+
+  uint64_t num_nodes = uint64_t{1} << scale;
+  auto edges = SampleEdges(
+      edge_factor * num_nodes, options.seed, [&](std::mt19937_64& generator) {
+        return SampleRmatEdge(generator, scale, parameters);
+      });
+  return MakeGraph(num_nodes, edges, options);
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::GenerateKroneckerGraph(
+    uint32_t scale, uint32_t edge_factor,
+    const GraphGeneratorOptions& options) {
+  if (auto r = CheckScale(scale); !r) {
+    return r.error();
+  }
+  if (auto r = CheckOptions(options); !r) {
+    return r.error();
+  }
+
+  uint64_t num_nodes = uint64_t{1} << scale;
+  uint64_t permutation_seed = Mix(options.seed ^ 0x6b726f6e65636b72ULL);
+  RmatParameters parameters;
+  auto edges = SampleEdges(
+      edge_factor * num_nodes, options.seed, [&](std::mt19937_64& generator) {
+        EdgePair edge = SampleRmatEdge(generator, scale, parameters);
+        return EdgePair{
+            PermuteNode(edge.src, scale, permutation_seed),
+            PermuteNode(edge.dst, scale, permutation_seed)};
+      });
+  return MakeGraph(num_nodes, edges, options);
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::GenerateUniformGraph(
+    uint32_t num_nodes, uint64_t num_edges,
+    const GraphGeneratorOptions& options) {
+  if (auto r = CheckOptions(options); !r) {
+    return r.error();
+  }
+  if (num_nodes == 0 && num_edges > 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "cannot place edges without nodes");
+  }
+
+  auto edges = SampleEdges(
+      num_edges, options.seed, [&](std::mt19937_64& generator) {
+        std::uniform_int_distribution<Node> dist(0, num_nodes - 1);
+        Node src = dist(generator);
+        return EdgePair{src, dist(generator)};
+      });
+  return MakeGraph(num_nodes, edges, options);
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::GenerateGridGraph(
+    uint32_t rows, uint32_t columns, const GraphGeneratorOptions& options) {
+  if (auto r = CheckOptions(options); !r) {
+    return r.error();
+  }
+  uint64_t num_nodes = uint64_t{rows} * columns;
+  if (num_nodes > std::numeric_limits<Node>::max()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "{} x {} grid is too large; node ids have 32 bits", rows, columns);
+  }
+
+  // Each node has an edge to the right and one down; edges that would leave
+  // the grid are self loops, which MakeGraph drops
+  std::vector<EdgePair> edges(2 * num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        Node node = n;
+        uint64_t row = n / columns;
+        uint64_t column = n % columns;
+        edges[2 * n] = {node, column + 1 < columns ? node + 1 : node};
+        edges[2 * n + 1] = {node, row + 1 < rows ? node + columns : node};
+      },
+      katana::loopname("GraphGeneratorGrid"));
+  return MakeGraph(num_nodes, edges, options);
+}
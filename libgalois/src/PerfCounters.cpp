@@ -0,0 +1,283 @@
+#include "katana/PerfCounters.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "katana/Env.h"
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/Statistics.h"
+#include "katana/Threads.h"
+
+namespace {
+
+#ifdef __linux__
+
+constexpr uint64_t
+CacheMissConfig(uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+/// \returns a file descriptor counting event on the calling thread, or
+/// -errno on failure
+int
+OpenCounter(katana::PerfEvent event) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  switch (event) {
+  case katana::PerfEvent::kCycles:
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    break;
+  case katana::PerfEvent::kInstructions:
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    break;
+  case katana::PerfEvent::kLLCMisses:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = CacheMissConfig(PERF_COUNT_HW_CACHE_LL);
+    break;
+  case katana::PerfEvent::kDTLBMisses:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = CacheMissConfig(PERF_COUNT_HW_CACHE_DTLB);
+    break;
+  case katana::PerfEvent::kBranchMisses:
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+    break;
+  }
+
+  // Count the calling thread on whichever CPU it runs
+  long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+  return fd < 0 ? -errno : static_cast<int>(fd);
+}
+
+/// \returns the count of the counter fd, scaled up if the counter was
+/// multiplexed with others and only ran for part of the time
+uint64_t
+ReadCounter(int fd) {
+  struct {
+    uint64_t value;
+    uint64_t time_enabled;
+    uint64_t time_running;
+  } data;
+  if (read(fd, &data, sizeof(data)) != sizeof(data)) {
+    return 0;
+  }
+  if (data.time_running == 0) {
+    return 0;
+  }
+  if (data.time_running == data.time_enabled) {
+    return data.value;
+  }
+  return static_cast<uint64_t>(
+      static_cast<double>(data.value) * data.time_enabled / data.time_running);
+}
+
+void
+ControlCounter(int fd, unsigned long request) {
+  ioctl(fd, request, 0);
+}
+
+void
+CloseCounter(int fd) {
+  close(fd);
+}
+
+#else
+
+int
+OpenCounter(katana::PerfEvent) {
+  return -ENOSYS;
+}
+
+uint64_t
+ReadCounter(int) {
+  return 0;
+}
+
+void
+CloseCounter(int) {}
+
+#endif
+
+}  // namespace
+
+const char*
+katana::PerfEventName(PerfEvent event) {
+  switch (event) {
+  case PerfEvent::kCycles:
+    return "Cycles";
+  case PerfEvent::kInstructions:
+    return "Instructions";
+  case PerfEvent::kLLCMisses:
+    return "LLCMisses";
+  case PerfEvent::kDTLBMisses:
+    return "DTLBMisses";
+  case PerfEvent::kBranchMisses:
+    return "BranchMisses";
+  }
+  return "Unknown";
+}
+
+std::vector<katana::PerfEvent>
+katana::AllPerfEvents() {
+  return {
+      PerfEvent::kCycles,     PerfEvent::kInstructions,
+      PerfEvent::kLLCMisses,  PerfEvent::kDTLBMisses,
+      PerfEvent::kBranchMisses,
+  };
+}
+
+katana::Result<std::vector<katana::PerfEvent>>
+katana::ParsePerfEvents(const std::string& names) {
+  std::vector<PerfEvent> events;
+  size_t begin = 0;
+  while (begin <= names.size()) {
+    size_t end = names.find(',', begin);
+    if (end == std::string::npos) {
+      end = names.size();
+    }
+    std::string name = names.substr(begin, end - begin);
+    begin = end + 1;
+
+    bool found = false;
+    for (PerfEvent event : AllPerfEvents()) {
+      if (name == PerfEventName(event)) {
+        events.emplace_back(event);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "unknown perf event {}; expected Cycles, Instructions, LLCMisses, "
+          "DTLBMisses or BranchMisses",
+          name);
+    }
+  }
+  return events;
+}
+
+std::vector<katana::PerfEvent>
+katana::internal::PerfEventsFromEnv() {
+  std::string names;
+  if (!GetEnv("KATANA_PERF_EVENTS", &names) || names.empty()) {
+    return AllPerfEvents();
+  }
+  auto events = ParsePerfEvents(names);
+  if (!events) {
+    KATANA_LOG_WARN("ignoring KATANA_PERF_EVENTS: {}", events.error());
+    return AllPerfEvents();
+  }
+  return events.value();
+}
+
+katana::PerfCounters::PerfCounters(std::vector<PerfEvent> events)
+    : events_(std::move(events)) {
+  on_each([&](unsigned, unsigned) {
+    ThreadCounters& counters = *counters_.getLocal();
+    for (PerfEvent event : events_) {
+      counters.fds.emplace_back(OpenCounter(event));
+    }
+  });
+
+  // Keep only the events that could be counted on every thread
+  std::vector<bool> keep(events_.size(), true);
+  for (size_t i = 0; i < events_.size(); ++i) {
+    for (unsigned tid = 0; tid < getActiveThreads(); ++tid) {
+      int fd = counters_.getRemote(tid)->fds[i];
+      if (fd < 0) {
+        KATANA_LOG_WARN(
+            "cannot count {}: {}", PerfEventName(events_[i]),
+            std::strerror(-fd));
+        keep[i] = false;
+        break;
+      }
+    }
+  }
+
+  on_each([&](unsigned, unsigned) {
+    ThreadCounters& counters = *counters_.getLocal();
+    std::vector<int> fds;
+    for (size_t i = 0; i < events_.size(); ++i) {
+      if (keep[i]) {
+        fds.emplace_back(counters.fds[i]);
+      } else if (counters.fds[i] >= 0) {
+        CloseCounter(counters.fds[i]);
+      }
+    }
+    counters.fds = std::move(fds);
+    counters.values.assign(counters.fds.size(), 0);
+  });
+
+  std::vector<PerfEvent> kept;
+  for (size_t i = 0; i < events_.size(); ++i) {
+    if (keep[i]) {
+      kept.emplace_back(events_[i]);
+    }
+  }
+  events_ = std::move(kept);
+}
+
+katana::PerfCounters::~PerfCounters() {
+  for (unsigned tid = 0; tid < counters_.size(); ++tid) {
+    for (int fd : counters_.getRemote(tid)->fds) {
+      CloseCounter(fd);
+    }
+  }
+}
+
+void
+katana::PerfCounters::Start() {
+#ifdef __linux__
+  on_each([&](unsigned, unsigned) {
+    for (int fd : counters_.getLocal()->fds) {
+      ControlCounter(fd, PERF_EVENT_IOC_RESET);
+      ControlCounter(fd, PERF_EVENT_IOC_ENABLE);
+    }
+  });
+#endif
+}
+
+void
+katana::PerfCounters::Stop() {
+  on_each([&](unsigned, unsigned) {
+    ThreadCounters& counters = *counters_.getLocal();
+#ifdef __linux__
+    for (int fd : counters.fds) {
+      ControlCounter(fd, PERF_EVENT_IOC_DISABLE);
+    }
+#endif
+    for (size_t i = 0; i < counters.fds.size(); ++i) {
+      counters.values[i] = ReadCounter(counters.fds[i]);
+    }
+  });
+}
+
+void
+katana::PerfCounters::Report(const std::string& region) {
+  on_each([&](unsigned, unsigned) {
+    const ThreadCounters& counters = *counters_.getLocal();
+    for (size_t i = 0; i < events_.size(); ++i) {
+      ReportStatSum(region, PerfEventName(events_[i]), counters.values[i]);
+    }
+  });
+}
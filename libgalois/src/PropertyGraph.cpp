@@ -1,14 +1,19 @@
 #include "katana/PropertyGraph.h"
 
 #include <sys/mman.h>
+#include <sys/resource.h>
 
 #include "katana/ArrowInterchange.h"
+#include "katana/CompressedGraphTopology.h"
 #include "katana/Logging.h"
 #include "katana/Loops.h"
 #include "katana/PerThreadStorage.h"
 #include "katana/Platform.h"
 #include "katana/Properties.h"
 #include "katana/Result.h"
+#include "katana/Statistics.h"
+#include "katana/Timer.h"
+#include "tsuba/CSRTopology.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FileFrame.h"
 #include "tsuba/RDG.h"
@@ -53,6 +58,56 @@ CheckTopology(
   return !has_bad_adj && !has_bad_dest;
 }
 
+/// \returns the number of page faults taken by this process so far
+uint64_t
+PageFaults() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  return usage.ru_minflt + usage.ru_majflt;
+}
+
+/// FaultIn touches every page of the \param size bytes at \param data in
+/// parallel, so that copying them afterwards does not take page faults
+void
+FaultIn(const void* data, size_t size) {
+  // Pages are at least this large, so every page is touched
+  constexpr size_t kStride = 4096;
+  const auto* bytes = static_cast<const volatile uint8_t*>(data);
+  katana::do_all(
+      katana::iterate(size_t{0}, (size + kStride - 1) / kStride),
+      [&](size_t page) { [[maybe_unused]] uint8_t b = bytes[page * kStride]; },
+      katana::no_stats());
+}
+
+/// PlaceArray returns a LargeArray holding the \param num elements at
+/// \param src. Unless \param placement is kInPlace, the elements are copied
+/// into memory placed accordingly; otherwise, the result refers to \param src
+/// and must not outlive it.
+template <typename T>
+katana::LargeArray<T>
+PlaceArray(const T* src, size_t num, tsuba::TopologyPlacement placement) {
+  if (placement == tsuba::TopologyPlacement::kInPlace) {
+    return katana::LargeArray<T>(const_cast<T*>(src), num);
+  }
+
+  katana::LargeArray<T> dst;
+  switch (placement) {
+  case tsuba::TopologyPlacement::kBlocked:
+    dst.allocateBlocked(num);
+    break;
+  case tsuba::TopologyPlacement::kLocal:
+    dst.allocateLocal(num);
+    break;
+  default:
+    dst.allocateInterleaved(num);
+    break;
+  }
+  katana::ParallelSTL::copy(src, src + num, dst.begin());
+  return dst;
+}
+
 /// MapTopology takes a file buffer of a topology file and extracts the
 /// topology files.
 ///
@@ -69,8 +124,13 @@ CheckTopology(
 ///
 /// Since property graphs store their edge data separately, we will
 /// ignore the size_of_edge_data (data[1]).
+///
+/// The topology is placed in memory according to \param placement. Files
+/// with compressed destinations (version tsuba::kCompressedCSRVersion) are
+/// handled by katana::CompressedGraphTopology instead.
 katana::Result<std::unique_ptr<katana::GraphTopology>>
-MapTopology(const tsuba::FileView& file_view) {
+MapTopology(
+    const tsuba::FileView& file_view, tsuba::TopologyPlacement placement) {
   const auto* data = file_view.ptr<uint64_t>();
   if (file_view.size() < 4) {
     return katana::ErrorCode::InvalidArgument;
@@ -97,11 +157,28 @@ MapTopology(const tsuba::FileView& file_view) {
   KATANA_LOG_DEBUG_ASSERT(
       CheckTopology(out_indices, num_nodes, out_dests, num_edges));
   return std::make_unique<katana::GraphTopology>(
-      out_indices, num_nodes, out_dests, num_edges);
+      PlaceArray(out_indices, num_nodes, placement),
+      PlaceArray(out_dests, num_edges, placement));
+}
+
+/// \returns the encoding of the topology file in \param file_view
+tsuba::TopologyEncoding
+TopologyFileEncoding(const tsuba::FileView& file_view) {
+  if (file_view.size() >= sizeof(tsuba::CSRTopologyHeader) &&
+      file_view.ptr<tsuba::CSRTopologyHeader>()->version ==
+          tsuba::kCompressedCSRVersion) {
+    return tsuba::TopologyEncoding::kCompressedCSR;
+  }
+  return tsuba::TopologyEncoding::kCSR;
 }
 
 katana::Result<std::unique_ptr<tsuba::FileFrame>>
-WriteTopology(const katana::GraphTopology& topology) {
+WriteTopology(
+    const katana::GraphTopology& topology, tsuba::TopologyEncoding encoding) {
+  if (encoding == tsuba::TopologyEncoding::kCompressedCSR) {
+    return katana::CompressedGraphTopology::Make(topology)->ToFileFrame();
+  }
+
   auto ff = std::make_unique<tsuba::FileFrame>();
   if (auto res = ff->Init(); !res) {
     return res.error();
@@ -139,6 +216,204 @@ WriteTopology(const katana::GraphTopology& topology) {
   return std::unique_ptr<tsuba::FileFrame>(std::move(ff));
 }
 
+/// BuildInEdges computes the in-edges (CSC) of \param topology and attaches
+/// them to it.
+void
+BuildInEdges(katana::GraphTopology* topology) {
+  uint64_t num_nodes = topology->num_nodes();
+  uint64_t num_edges = topology->num_edges();
+
+  katana::LargeArray<katana::GraphTopology::Edge> in_indices;
+  katana::LargeArray<katana::GraphTopology::Node> in_srcs;
+  katana::LargeArray<katana::GraphTopology::Edge> in_edge_ids;
+  in_indices.allocateInterleaved(num_nodes);
+  in_srcs.allocateInterleaved(num_edges);
+  in_edge_ids.allocateInterleaved(num_edges);
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { in_indices[n] = uint64_t{0}; }, katana::no_stats());
+
+  // Count the in-degree of every node
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](uint64_t e) {
+        __sync_add_and_fetch(&(in_indices[topology->edge_dest(e)]), 1);
+      },
+      katana::no_stats());
+
+  katana::ParallelSTL::partial_sum(
+      in_indices.begin(), in_indices.end(), in_indices.begin());
+
+  // Next free in-edge slot of every node
+  katana::LargeArray<uint64_t> in_offset;
+  in_offset.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { in_offset[n] = n > 0 ? in_indices[n - 1] : 0; },
+      katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t src) {
+        for (auto e : topology->edges(src)) {
+          auto dest = topology->edge_dest(e);
+          auto in_e = __sync_fetch_and_add(&(in_offset[dest]), 1);
+          in_srcs[in_e] = src;
+          in_edge_ids[in_e] = e;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  // Threads placed the in-edges of each node in no particular order; order
+  // them by edge id. Edge ids grow with their source, so sorting the sources
+  // separately keeps them paired with their edges.
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint64_t begin = n > 0 ? in_indices[n - 1] : 0;
+        uint64_t end = in_indices[n];
+        std::sort(in_srcs.begin() + begin, in_srcs.begin() + end);
+        std::sort(in_edge_ids.begin() + begin, in_edge_ids.begin() + end);
+      },
+      katana::steal(), katana::no_stats());
+
+  topology->SetInEdges(
+      std::move(in_indices), std::move(in_srcs), std::move(in_edge_ids));
+}
+
+/// MapInEdges takes a file buffer of a transpose topology file and attaches
+/// the in-edges it contains to \param topology without copying them.
+///
+/// A transpose topology file has the same layout as a topology file (see
+/// MapTopology) describing the transpose graph, with the original id of each
+/// edge stored as its uint64_t edge data:
+///
+///   uint64_t version: 1
+///   uint64_t sizeof_edge_data: 8
+///   uint64_t num_nodes: number of nodes
+///   uint64_t num_edges: number of edges
+///   uint64_t[num_nodes] in_indices: end of the in-edges of each node
+///   uint32_t[num_edges] in_srcs: sources of each in-edge
+///   uint32_t padding if num_edges is odd
+///   uint64_t[num_edges] in_edge_ids: out-edge id of each in-edge
+katana::Result<void>
+MapInEdges(
+    const tsuba::FileView& file_view, katana::GraphTopology* topology) {
+  if (file_view.size() < sizeof(tsuba::CSRTopologyHeader)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "transpose topology too small");
+  }
+  const auto* header = file_view.ptr<tsuba::CSRTopologyHeader>();
+  if (header->version != 1 || header->edge_type_size != sizeof(uint64_t)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "unexpected transpose topology version {} edge data size {}",
+        header->version, header->edge_type_size);
+  }
+  if (header->num_nodes != topology->num_nodes() ||
+      header->num_edges != topology->num_edges()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "transpose topology nodes/edges {}/{} does not match topology {}/{}",
+        header->num_nodes, header->num_edges, topology->num_nodes(),
+        topology->num_edges());
+  }
+  if (file_view.size() < tsuba::CSRTopologyFileSize(*header)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "file_view size: {} expected {}",
+        file_view.size(), tsuba::CSRTopologyFileSize(*header));
+  }
+
+  const uint64_t num_nodes = header->num_nodes;
+  const uint64_t num_edges = header->num_edges;
+  uint64_t offset = sizeof(*header);
+  const auto* in_indices_data = file_view.ptr<uint64_t>(offset);
+  offset += num_nodes * sizeof(uint64_t);
+  const auto* in_srcs_data = file_view.ptr<uint32_t>(offset);
+  offset += katana::AlignUp<uint64_t>(num_edges * sizeof(uint32_t));
+  const auto* in_edge_ids_data = file_view.ptr<uint64_t>(offset);
+
+  // The in-edges refer to the buffer rather than a copy of it. The buffer
+  // stays bound until DropInEdges or SetTopology has released them.
+  constexpr auto kInPlace = tsuba::TopologyPlacement::kInPlace;
+  auto in_indices = PlaceArray(in_indices_data, num_nodes, kInPlace);
+  auto in_srcs = PlaceArray(in_srcs_data, num_edges, kInPlace);
+  auto in_edge_ids = PlaceArray(in_edge_ids_data, num_edges, kInPlace);
+
+  topology->SetInEdges(
+      std::move(in_indices), std::move(in_srcs), std::move(in_edge_ids));
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::unique_ptr<tsuba::FileFrame>>
+WriteInEdges(const katana::GraphTopology& topology) {
+  KATANA_LOG_DEBUG_ASSERT(topology.has_in_edges());
+  auto ff = std::make_unique<tsuba::FileFrame>();
+  if (auto res = ff->Init(); !res) {
+    return res.error();
+  }
+  uint64_t num_nodes = topology.num_nodes();
+  uint64_t num_edges = topology.num_edges();
+
+  tsuba::CSRTopologyHeader header{
+      .version = 1,
+      .edge_type_size = sizeof(uint64_t),
+      .num_nodes = num_nodes,
+      .num_edges = num_edges,
+  };
+  arrow::Status aro_sts = ff->Write(&header, sizeof(header));
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+
+  auto write_array = [&ff](const auto* raw, uint64_t size) {
+    if (size == 0) {
+      return arrow::Status::OK();
+    }
+    auto buf = std::make_shared<arrow::Buffer>(
+        reinterpret_cast<const uint8_t*>(raw), size * sizeof(*raw));
+    return ff->Write(buf);
+  };
+
+  aro_sts = write_array(topology.in_indices_data(), num_nodes);
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+  aro_sts = write_array(topology.in_srcs_data(), num_edges);
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+  // in_edge_ids starts 8-byte aligned
+  uint64_t padding = katana::AlignUp<uint64_t>(num_edges * sizeof(uint32_t)) -
+                     num_edges * sizeof(uint32_t);
+  if (padding) {
+    uint8_t zeros[sizeof(uint64_t)] = {};
+    aro_sts = ff->Write(zeros, padding);
+    if (!aro_sts.ok()) {
+      return tsuba::ArrowToTsuba(aro_sts.code());
+    }
+  }
+  aro_sts = write_array(topology.in_edge_ids_data(), num_edges);
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+
+  return std::unique_ptr<tsuba::FileFrame>(std::move(ff));
+}
+
+void
+ReportPropertyLoadStats(
+    const std::string& kind,
+    const std::vector<tsuba::PropertyLoadStat>& load_stats) {
+  for (const auto& stat : load_stats) {
+    katana::ReportStatSingle(
+        "PropertyGraph", kind + "PropertyBytes_" + stat.name, stat.bytes);
+    katana::ReportStatSingle(
+        "PropertyGraph", kind + "PropertyTimeUs_" + stat.name, stat.usec);
+  }
+}
+
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
 MakePropertyGraph(
     std::unique_ptr<tsuba::RDGFile> rdg_file,
@@ -148,8 +423,13 @@ MakePropertyGraph(
     return rdg_result.error();
   }
 
+  const tsuba::RDG& rdg = rdg_result.value();
+  ReportPropertyLoadStats("Node", rdg.node_property_load_stats());
+  ReportPropertyLoadStats("Edge", rdg.edge_property_load_stats());
+
   return katana::PropertyGraph::Make(
-      std::move(rdg_file), std::move(rdg_result.value()));
+      std::move(rdg_file), std::move(rdg_result.value()),
+      opts.topology_placement);
 }
 
 /// Assumes all boolean or uint8 properties are types
@@ -351,9 +631,27 @@ katana::GraphTopology::GraphTopology(
 
 std::unique_ptr<katana::GraphTopology>
 katana::GraphTopology::Copy(const GraphTopology& that) noexcept {
-  return std::make_unique<katana::GraphTopology>(
+  auto copy = std::make_unique<katana::GraphTopology>(
       that.adj_indices_.data(), that.adj_indices_.size(), that.dests_.data(),
       that.dests_.size());
+  if (that.has_in_edges_) {
+    LargeArray<Edge> in_indices;
+    LargeArray<Node> in_srcs;
+    LargeArray<Edge> in_edge_ids;
+    in_indices.allocateInterleaved(that.in_indices_.size());
+    in_srcs.allocateInterleaved(that.in_srcs_.size());
+    in_edge_ids.allocateInterleaved(that.in_edge_ids_.size());
+    katana::ParallelSTL::copy(
+        that.in_indices_.begin(), that.in_indices_.end(), in_indices.begin());
+    katana::ParallelSTL::copy(
+        that.in_srcs_.begin(), that.in_srcs_.end(), in_srcs.begin());
+    katana::ParallelSTL::copy(
+        that.in_edge_ids_.begin(), that.in_edge_ids_.end(),
+        in_edge_ids.begin());
+    copy->SetInEdges(
+        std::move(in_indices), std::move(in_srcs), std::move(in_edge_ids));
+  }
+  return copy;
 }
 
 katana::PropertyGraph::PropertyGraph(
@@ -412,33 +710,163 @@ katana::PropertyGraph::Validate() {
   return katana::ResultSuccess();
 }
 
+void
+katana::PropertyGraph::DecompressTopology() const {
+  std::lock_guard<std::mutex> lock(decompress_mutex_);
+  if (!topology_compressed_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  katana::StatTimer timer("DecompressTopology", "PropertyGraph");
+  timer.start();
+  topology_ = compressed_topology_->Decompress();
+  timer.stop();
+  topology_compressed_.store(false, std::memory_order_release);
+  compressed_topology_.reset();
+}
+
 katana::Result<void>
 katana::PropertyGraph::DoWrite(
     tsuba::RDGHandle handle, const std::string& command_line) {
-  if (!rdg_.topology_file_storage().Valid()) {
-    auto result = WriteTopology(*topology_);
+  // A topology already on storage is reused only if it is current and has
+  // the requested encoding. rdg_ keeps the topology file at its own
+  // location, whose encoding is recorded, and copies topology_file_storage()
+  // elsewhere.
+  const tsuba::FileView& topology_storage = rdg_.topology_file_storage();
+  std::optional<tsuba::TopologyEncoding> kept_encoding =
+      stored_topology_encoding_;
+  if (tsuba::GetRDGDir(handle) != rdg_.rdg_dir()) {
+    if (!topology_storage.Valid()) {
+      kept_encoding.reset();
+    } else if (kept_encoding) {
+      kept_encoding = TopologyFileEncoding(topology_storage);
+    }
+  }
+  std::unique_ptr<tsuba::FileFrame> topology_ff;
+  if (kept_encoding != topology_encoding_) {
+    // A topology that is still compressed is written without decoding it
+    auto result =
+        compressed_topology() != nullptr &&
+                topology_encoding_ == tsuba::TopologyEncoding::kCompressedCSR
+            ? compressed_topology()->ToFileFrame()
+            : WriteTopology(topology(), topology_encoding_);
     if (!result) {
       return result.error();
     }
-    return rdg_.Store(handle, command_line, std::move(result.value()));
+    topology_ff = std::move(result.value());
   }
 
-  return rdg_.Store(handle, command_line);
+  // A topology that is still compressed has no in-edges. In-edges already in
+  // storage are current, since changing the topology drops them there.
+  std::unique_ptr<tsuba::FileFrame> transpose_ff;
+  if (topology_ && topology_->has_in_edges() && !rdg_.HasTransposeTopology()) {
+    auto result = WriteInEdges(*topology_);
+    if (!result) {
+      return result.error();
+    }
+    transpose_ff = std::move(result.value());
+  }
+
+  if (auto res = rdg_.Store(
+          handle, command_line, std::move(topology_ff),
+          std::move(transpose_ff));
+      !res) {
+    return res.error();
+  }
+  stored_topology_encoding_ = topology_encoding_;
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::PropertyGraph::PopulateInEdges() {
+  if (topology().has_in_edges()) {
+    return katana::ResultSuccess();
+  }
+
+  if (rdg_.HasTransposeTopology()) {
+    if (auto res = rdg_.BindTransposeTopologyFileStorage(); !res) {
+      return res.error();
+    }
+    return MapInEdges(rdg_.transpose_topology_file_storage(), topology_.get());
+  }
+
+  BuildInEdges(topology_.get());
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::PropertyGraph::DropInEdges() {
+  // A topology that is still compressed has no in-edges
+  if (topology_) {
+    topology_->DropInEdges();
+  }
+  return rdg_.DropTransposeTopology();
 }
 
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
 katana::PropertyGraph::Make(
-    std::unique_ptr<tsuba::RDGFile> rdg_file, tsuba::RDG&& rdg) {
-  auto topo_result = MapTopology(rdg.topology_file_storage());
+    std::unique_ptr<tsuba::RDGFile> rdg_file, tsuba::RDG&& rdg,
+    tsuba::TopologyPlacement placement) {
+  const tsuba::FileView& topology_storage = rdg.topology_file_storage();
+  tsuba::TopologyEncoding encoding = TopologyFileEncoding(topology_storage);
+
+  // A compressed topology is copied out of storage, which is released, and
+  // is only decoded when topology() is first called, whatever the placement
+  if (encoding == tsuba::TopologyEncoding::kCompressedCSR) {
+    auto compressed_res =
+        katana::CompressedGraphTopology::Make(topology_storage);
+    if (!compressed_res) {
+      return compressed_res.error();
+    }
+    std::shared_ptr<const CompressedGraphTopology> compressed =
+        katana::CompressedGraphTopology::Copy(*compressed_res.value());
+    compressed_res.value().reset();
+    if (auto res = rdg.UnbindTopologyFileStorage(); !res) {
+      return res.error();
+    }
+
+    auto pg = std::make_unique<PropertyGraph>(
+        std::move(rdg_file), std::move(rdg), nullptr);
+    pg->compressed_num_nodes_ = compressed->num_nodes();
+    pg->compressed_num_edges_ = compressed->num_edges();
+    pg->compressed_topology_ = std::move(compressed);
+    pg->topology_compressed_ = true;
+    pg->topology_encoding_ = encoding;
+    pg->stored_topology_encoding_ = encoding;
+    return std::unique_ptr<PropertyGraph>(std::move(pg));
+  }
+
+  // Before a copy, fault in the pages of the topology that were not
+  // populated when it was loaded, separately from copying it. A topology
+  // used in place takes its faults later, when it is first used.
+  katana::Timer fault_timer;
+  uint64_t faults_before = PageFaults();
+  if (placement != tsuba::TopologyPlacement::kInPlace) {
+    fault_timer.start();
+    FaultIn(topology_storage.ptr<uint8_t>(), topology_storage.size());
+    fault_timer.stop();
+  }
+  katana::ReportStatSingle(
+      "PropertyGraph", "TopologyFaultTime", fault_timer.get());
+  katana::ReportStatSingle(
+      "PropertyGraph", "TopologyPageFaults", PageFaults() - faults_before);
+
+  katana::Timer copy_timer;
+  copy_timer.start();
+  auto topo_result = MapTopology(topology_storage, placement);
+  copy_timer.stop();
   if (!topo_result) {
     return topo_result.error();
   }
+  katana::ReportStatSingle(
+      "PropertyGraph", "TopologyCopyTime", copy_timer.get());
 
   auto topo =
       std::unique_ptr<katana::GraphTopology>(std::move(topo_result.value()));
 
-  return std::make_unique<PropertyGraph>(
+  auto pg = std::make_unique<PropertyGraph>(
       std::move(rdg_file), std::move(rdg), std::move(topo));
+  pg->stored_topology_encoding_ = encoding;
+  return std::unique_ptr<PropertyGraph>(std::move(pg));
 }
 
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
@@ -530,6 +958,9 @@ katana::PropertyGraph::WriteGraph(
     return res.error();
   }
 
+  // Later commits update the new location, which now holds every part of
+  // the graph
+  rdg_.set_rdg_dir(tsuba::GetRDGDir(*new_file));
   file_ = std::move(new_file);
 
   return katana::ResultSuccess();
@@ -657,10 +1088,12 @@ katana::PropertyGraph::ReportDiff(const PropertyGraph* other) const {
 
 katana::Result<void>
 katana::PropertyGraph::Write(
-    const std::string& rdg_name, const std::string& command_line) {
+    const std::string& rdg_name, const std::string& command_line,
+    tsuba::TopologyEncoding encoding) {
   if (auto res = tsuba::Create(rdg_name); !res) {
     return res.error();
   }
+  topology_encoding_ = encoding;
   return WriteGraph(rdg_name, command_line);
 }
 
@@ -760,11 +1193,16 @@ katana::PropertyGraph::RemoveEdgeProperty(const std::string& prop_name) {
 
 katana::Result<void>
 katana::PropertyGraph::SetTopology(const katana::GraphTopology& topology) {
+  // Copy before unbinding storage; topology may be this graph's own topology,
+  // which may be backed by that storage
+  topology_ = GraphTopology::Copy(topology);
+  topology_compressed_ = false;
+  compressed_topology_.reset();
+  stored_topology_encoding_.reset();
   if (auto res = rdg_.UnbindTopologyFileStorage(); !res) {
     return res.error();
   }
-  topology_ = GraphTopology::Copy(topology);
-  return katana::ResultSuccess();
+  return rdg_.DropTransposeTopology();
 }
 
 katana::Result<void>
@@ -783,6 +1221,11 @@ katana::PropertyGraph::InformPath(const std::string& input_path) {
 
 katana::Result<std::shared_ptr<arrow::UInt64Array>>
 katana::SortAllEdgesByDest(katana::PropertyGraph* pg) {
+  // in-edges refer to out-edges by id, which sorting changes
+  if (auto res = pg->DropInEdges(); !res) {
+    return res.error();
+  }
+
   auto view_result_dests =
       katana::ConstructPropertyView<katana::UInt32Property>(
           pg->topology().out_dests.get());
@@ -864,6 +1307,10 @@ katana::FindEdgeSortedByDest(
 
 katana::Result<void>
 katana::SortNodesByDegree(katana::PropertyGraph* pg) {
+  if (auto res = pg->DropInEdges(); !res) {
+    return res.error();
+  }
+
   uint64_t num_nodes = pg->topology().num_nodes();
   uint64_t num_edges = pg->topology().num_edges();
 
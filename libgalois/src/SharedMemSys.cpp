@@ -24,6 +24,7 @@
 #include "katana/Plugin.h"
 #include "katana/SharedMem.h"
 #include "katana/Statistics.h"
+#include "katana/Trace.h"
 #include "tsuba/FileStorage.h"
 #include "tsuba/tsuba.h"
 
@@ -45,9 +46,11 @@ katana::SharedMemSys::SharedMemSys() : impl_(std::make_unique<Impl>()) {
   }
 
   katana::internal::setSysStatManager(&impl_->stat_manager);
+  katana::internal::StartTracingFromEnv();
 }
 
 katana::SharedMemSys::~SharedMemSys() {
+  katana::internal::FinishTracingFromEnv();
   katana::PrintStats();
   katana::internal::setSysStatManager(nullptr);
 
@@ -24,10 +24,14 @@
 
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <vector>
 
 #include "katana/Env.h"
+#include "katana/ErrorCode.h"
 #include "katana/Executor_OnEach.h"
+#include "katana/JSON.h"
 #include "katana/Logging.h"
 #include "katana/PerThreadStorage.h"
 #include "tsuba/file.h"
@@ -39,6 +43,20 @@ CheckPrintingThreadVals() {
   return katana::GetEnv("PRINT_PER_THREAD_STATS");
 }
 
+katana::StatFormat
+EnvStatFormat() {
+  std::string name;
+  if (!katana::GetEnv("KATANA_STAT_FORMAT", &name)) {
+    return katana::StatFormat::kText;
+  }
+  auto format = katana::ParseStatFormat(name);
+  if (!format) {
+    KATANA_LOG_WARN("ignoring KATANA_STAT_FORMAT: {}", format.error());
+    return katana::StatFormat::kText;
+  }
+  return format.value();
+}
+
 void
 PrintHeader(std::ostream& out, const char* sep) {
   out << "STAT_TYPE" << sep << "REGION" << sep << "CATEGORY" << sep;
@@ -46,6 +64,54 @@ PrintHeader(std::ostream& out, const char* sep) {
   out << "\n";
 }
 
+/// Quote a CSV field if it has a comma, quote or line break
+std::string
+CSVField(const std::string& field) {
+  if (field.find_first_of(",\"\r\n") == std::string::npos) {
+    return field;
+  }
+  std::string quoted = "\"";
+  for (char c : field) {
+    if (c == '"') {
+      quoted += '"';
+    }
+    quoted += c;
+  }
+  quoted += '"';
+  return quoted;
+}
+
+std::string
+ToString(const katana::gstl::Str& str) {
+  return std::string(str.data(), str.size());
+}
+
+nlohmann::json
+JSONValue(int64_t v) {
+  return v;
+}
+
+nlohmann::json
+JSONValue(double v) {
+  return v;
+}
+
+nlohmann::json
+JSONValue(const katana::gstl::Str& v) {
+  return ToString(v);
+}
+
+template <typename T>
+std::string
+TextValue(const T& v) {
+  std::ostringstream out;
+  out << v;
+  return out.str();
+}
+
+/// The statistics of each region for the JSON format, keyed by region name
+using RegionRecords = std::map<std::string, std::vector<nlohmann::json>>;
+
 template <typename T>
 struct StatImpl {
   using MergedStats = katana::internal::VecStatManager<T>;
@@ -125,6 +191,40 @@ struct StatImpl {
       }
     }
   }
+
+  void PrintCSV(std::ostream& out) const {
+    for (auto i = result_.cbegin(), end_i = result_.cend(); i != end_i; ++i) {
+      const auto& s = result_.stat(i);
+      std::string thread_values;
+      const char* tsep = "";
+      for (const auto& v : s.values()) {
+        thread_values += tsep + TextValue(v);
+        tsep = ";";
+      }
+      out << StatKind() << "," << CSVField(ToString(result_.region(i)))
+          << "," << CSVField(ToString(result_.category(i))) << ","
+          << katana::StatTotal::str(s.totalTy()) << ","
+          << CSVField(TextValue(s.total())) << "," << CSVField(thread_values)
+          << "\n";
+    }
+  }
+
+  void AddJSONRecords(RegionRecords* records) const {
+    for (auto i = result_.cbegin(), end_i = result_.cend(); i != end_i; ++i) {
+      const auto& s = result_.stat(i);
+      nlohmann::json thread_values = nlohmann::json::array();
+      for (const auto& v : s.values()) {
+        thread_values.push_back(JSONValue(v));
+      }
+      (*records)[ToString(result_.region(i))].push_back(nlohmann::json{
+          {"kind", StatKind()},
+          {"category", ToString(result_.category(i))},
+          {"total_type", katana::StatTotal::str(s.totalTy())},
+          {"total", JSONValue(s.total())},
+          {"thread_values", std::move(thread_values)},
+      });
+    }
+  }
 };
 
 }  // end unnamed namespace
@@ -135,6 +235,31 @@ public:
   StatImpl<double> fp_stats_;
   StatImpl<Str> str_stats_;
   std::string outfile_;
+  StatFormat format_{EnvStatFormat()};
+
+  void PrintCSV(std::ostream& out) const {
+    out << "STAT_TYPE,REGION,CATEGORY,TOTAL_TYPE,TOTAL,THREAD_VALUES\n";
+    int_stats_.PrintCSV(out);
+    fp_stats_.PrintCSV(out);
+    str_stats_.PrintCSV(out);
+  }
+
+  void PrintJSON(std::ostream& out) const {
+    RegionRecords records;
+    int_stats_.AddJSONRecords(&records);
+    fp_stats_.AddJSONRecords(&records);
+    str_stats_.AddJSONRecords(&records);
+
+    for (auto& [region, stats] : records) {
+      auto line = katana::JsonDump(
+          nlohmann::json{{"region", region}, {"stats", std::move(stats)}});
+      if (!line) {
+        KATANA_LOG_ERROR("printing stats of {}: {}", region, line.error());
+        continue;
+      }
+      out << line.value() << "\n";
+    }
+  }
 };
 
 katana::StatManager::StatManager() { impl_ = std::make_unique<Impl>(); }
@@ -146,6 +271,11 @@ katana::StatManager::SetStatFile(const std::string& outfile) {
   impl_->outfile_ = outfile;
 }
 
+void
+katana::StatManager::SetStatFormat(StatFormat format) {
+  impl_->format_ = format;
+}
+
 bool
 katana::StatManager::IsPrintingThreadVals() const {
   return CheckPrintingThreadVals();
@@ -160,6 +290,17 @@ katana::StatManager::PrintStats(std::ostream& out) {
     return;
   }
 
+  switch (impl_->format_) {
+  case StatFormat::kCSV:
+    impl_->PrintCSV(out);
+    return;
+  case StatFormat::kJSON:
+    impl_->PrintJSON(out);
+    return;
+  case StatFormat::kText:
+    break;
+  }
+
   PrintHeader(out, kSep);
   impl_->int_stats_.Print(out, kSep, kThreadSep, kThreadNameSep);
   impl_->fp_stats_.Print(out, kSep, kThreadSep, kThreadNameSep);
@@ -285,6 +426,27 @@ katana::SetStatFile(const std::string& f) {
   internal::sysStatManager()->SetStatFile(f);
 }
 
+void
+katana::SetStatFormat(StatFormat format) {
+  internal::sysStatManager()->SetStatFormat(format);
+}
+
+katana::Result<katana::StatFormat>
+katana::ParseStatFormat(const std::string& name) {
+  if (name == "text") {
+    return StatFormat::kText;
+  }
+  if (name == "csv") {
+    return StatFormat::kCSV;
+  }
+  if (name == "json") {
+    return StatFormat::kJSON;
+  }
+  return KATANA_ERROR(
+      katana::ErrorCode::InvalidArgument,
+      "unknown stat format {}; expected text, csv or json", name);
+}
+
 void
 katana::PrintStats() {
   internal::sysStatManager()->Print();
@@ -25,6 +25,7 @@
 #include "katana/Env.h"
 #include "katana/HWTopo.h"
 #include "katana/Logging.h"
+#include "katana/Trace.h"
 
 // Forward declare this to avoid including PerThreadStorage.
 // We avoid this to stress that the thread Pool MUST NOT depend on PTS.
@@ -186,6 +187,7 @@ ThreadPool::decascade() {
   auto& me = my_box;
   // nothing to wake up
   if (me.wbegin != me.wend) {
+    katana::TraceSpan span("join", "thread_pool");
     auto midpoint = me.wbegin + (1 + me.wend - me.wbegin) / 2;
     auto& c1done = signals[me.wbegin]->done;
     while (!c1done) {
@@ -211,6 +213,7 @@ ThreadPool::cascade(bool fastmode) {
     return;
   }
 
+  katana::TraceSpan span("wake", "thread_pool");
   auto midpoint = me.wbegin + (1 + me.wend - me.wbegin) / 2;
 
   auto* child1 = signals[me.wbegin];
@@ -0,0 +1,193 @@
+#include "katana/Trace.h"
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "katana/Env.h"
+#include "katana/ErrorCode.h"
+#include "katana/JSON.h"
+#include "katana/Logging.h"
+#include "katana/ThreadPool.h"
+
+std::atomic<bool> katana::Tracer::enabled_{false};
+
+namespace {
+
+struct Span {
+  const char* name;
+  const char* category;
+  uint64_t begin_ns;
+  uint64_t end_ns;
+};
+
+/// The spans of one thread. Rings are aligned to cache lines so that threads
+/// recording spans do not share lines.
+struct alignas(64) Ring {
+  std::vector<Span> spans;
+  /// Number of spans recorded; the next span goes to next % spans.size()
+  uint64_t next{0};
+};
+
+std::vector<Ring> rings;
+uint64_t origin_ns{0};
+
+std::mutex interned_mutex;
+std::unordered_set<std::string> interned;
+
+std::string trace_file;
+
+nlohmann::json
+ToEvent(const Span& span, unsigned tid) {
+  // Chrome trace times are in microseconds
+  return nlohmann::json{
+      {"name", span.name},
+      {"cat", span.category},
+      {"ph", "X"},
+      {"ts", static_cast<double>(span.begin_ns - origin_ns) / 1000},
+      {"dur", static_cast<double>(span.end_ns - span.begin_ns) / 1000},
+      {"pid", 0},
+      {"tid", tid},
+  };
+}
+
+nlohmann::json
+ThreadNameEvent(unsigned tid) {
+  return nlohmann::json{
+      {"name", "thread_name"},
+      {"ph", "M"},
+      {"pid", 0},
+      {"tid", tid},
+      {"args", {{"name", "thread " + std::to_string(tid)}}},
+  };
+}
+
+void
+WriteEvent(std::ostream& out, const nlohmann::json& event, bool* first) {
+  auto dumped = katana::JsonDump(event);
+  if (!dumped) {
+    KATANA_LOG_WARN("dropping trace event: {}", dumped.error());
+    return;
+  }
+  out << (*first ? "\n" : ",\n") << dumped.value();
+  *first = false;
+}
+
+}  // namespace
+
+uint64_t
+katana::Tracer::Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void
+katana::Tracer::Record(
+    const char* name, const char* category, uint64_t begin_ns,
+    uint64_t end_ns) {
+  if (!IsEnabled()) {
+    return;
+  }
+  unsigned tid = ThreadPool::getTID();
+  if (tid >= rings.size()) {
+    return;
+  }
+  Ring& ring = rings[tid];
+  ring.spans[ring.next % ring.spans.size()] =
+      Span{name, category, begin_ns, end_ns};
+  ++ring.next;
+}
+
+const char*
+katana::Tracer::Intern(const char* name) {
+  std::lock_guard<std::mutex> lock(interned_mutex);
+  return interned.emplace(name).first->c_str();
+}
+
+void
+katana::Tracer::Enable(size_t spans_per_thread) {
+  KATANA_LOG_ASSERT(spans_per_thread > 0);
+  enabled_.store(false, std::memory_order_relaxed);
+
+  rings = std::vector<Ring>(GetThreadPool().getMaxThreads());
+  for (Ring& ring : rings) {
+    ring.spans.resize(spans_per_thread);
+  }
+  origin_ns = Now();
+
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void
+katana::Tracer::Disable() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void
+katana::Tracer::WriteChromeTrace(std::ostream& out) {
+  bool first = true;
+  out << "{\"traceEvents\":[";
+  for (unsigned tid = 0; tid < rings.size(); ++tid) {
+    const Ring& ring = rings[tid];
+    if (ring.next == 0) {
+      continue;
+    }
+    WriteEvent(out, ThreadNameEvent(tid), &first);
+
+    uint64_t size = ring.spans.size();
+    uint64_t begin = ring.next > size ? ring.next - size : 0;
+    for (uint64_t i = begin; i < ring.next; ++i) {
+      WriteEvent(out, ToEvent(ring.spans[i % size], tid), &first);
+    }
+  }
+  out << "\n]}\n";
+}
+
+katana::Result<void>
+katana::Tracer::WriteChromeTrace(const std::string& path) {
+  std::ofstream out(path);
+  if (!out) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "cannot open trace file {}", path);
+  }
+  WriteChromeTrace(out);
+  out.close();
+  if (!out) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "cannot write trace file {}",
+        path);
+  }
+  return katana::ResultSuccess();
+}
+
+void
+katana::internal::StartTracingFromEnv() {
+  if (!GetEnv("KATANA_TRACE_FILE", &trace_file) || trace_file.empty()) {
+    trace_file.clear();
+    return;
+  }
+  int spans_per_thread = 0;
+  if (GetEnv("KATANA_TRACE_SPANS_PER_THREAD", &spans_per_thread) &&
+      spans_per_thread > 0) {
+    Tracer::Enable(spans_per_thread);
+  } else {
+    Tracer::Enable();
+  }
+}
+
+void
+katana::internal::FinishTracingFromEnv() {
+  if (trace_file.empty()) {
+    return;
+  }
+  Tracer::Disable();
+  if (auto res = Tracer::WriteChromeTrace(trace_file); !res) {
+    KATANA_LOG_ERROR("writing trace: {}", res.error());
+  }
+  trace_file.clear();
+}
@@ -0,0 +1,169 @@
+#include "katana/analytics/SortedIntersection.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define KATANA_SORTED_INTERSECTION_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/// Ranges shorter than this are merged by the scalar loop, as they do not
+/// fill a vector
+constexpr size_t kMinVectorSize = 8;
+
+using Kernel = size_t (*)(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out);
+
+template <bool kWrite>
+size_t
+ScalarIntersect(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out) {
+  size_t count = 0;
+  katana::analytics::ForEachSortedIntersection(
+      a, a_size, b, b_size, [&](size_t i, size_t) {
+        if constexpr (kWrite) {
+          out[count] = a[i];
+        }
+        ++count;
+        return true;
+      });
+  return count;
+}
+
+#ifdef KATANA_SORTED_INTERSECTION_X86
+
+// The vector kernels compare a block of a with every rotation of a block of
+// b, so each element of the block of a is compared with each element of the
+// block of b. Then the block with the smaller last element (or both) is
+// consumed: none of its elements can be in the rest of the other range. What
+// is left when either range has less than a block is merged by the scalar
+// loop.
+
+template <bool kWrite>
+__attribute__((target("avx2"))) size_t
+Avx2Intersect(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out) {
+  constexpr size_t kWidth = 8;
+  const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i + kWidth <= a_size && j + kWidth <= b_size) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    __m256i equal = _mm256_cmpeq_epi32(va, vb);
+    for (size_t r = 1; r < kWidth; ++r) {
+      vb = _mm256_permutevar8x32_epi32(vb, rotate);
+      equal = _mm256_or_si256(equal, _mm256_cmpeq_epi32(va, vb));
+    }
+    uint32_t mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+    if constexpr (kWrite) {
+      for (; mask != 0; mask &= mask - 1) {
+        out[count++] = a[i + __builtin_ctz(mask)];
+      }
+    } else {
+      count += __builtin_popcount(mask);
+    }
+    uint32_t a_last = a[i + kWidth - 1];
+    uint32_t b_last = b[j + kWidth - 1];
+    i += a_last <= b_last ? kWidth : 0;
+    j += b_last <= a_last ? kWidth : 0;
+  }
+  return count + ScalarIntersect<kWrite>(
+                     a + i, a_size - i, b + j, b_size - j, out + count);
+}
+
+template <bool kWrite>
+__attribute__((target("avx512f"))) size_t
+Avx512Intersect(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out) {
+  constexpr size_t kWidth = 16;
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i + kWidth <= a_size && j + kWidth <= b_size) {
+    __m512i va = _mm512_loadu_si512(a + i);
+    __m512i vb = _mm512_loadu_si512(b + j);
+    __mmask16 equal = _mm512_cmpeq_epi32_mask(va, vb);
+    for (size_t r = 1; r < kWidth; ++r) {
+      vb = _mm512_maskz_alignr_epi32(0xffff, vb, vb, 1);
+      equal |= _mm512_cmpeq_epi32_mask(va, vb);
+    }
+    if constexpr (kWrite) {
+      _mm512_mask_compressstoreu_epi32(out + count, equal, va);
+    }
+    count += __builtin_popcount(equal);
+    uint32_t a_last = a[i + kWidth - 1];
+    uint32_t b_last = b[j + kWidth - 1];
+    i += a_last <= b_last ? kWidth : 0;
+    j += b_last <= a_last ? kWidth : 0;
+  }
+  return count + ScalarIntersect<kWrite>(
+                     a + i, a_size - i, b + j, b_size - j, out + count);
+}
+
+#endif
+
+struct Kernels {
+  Kernel count;
+  Kernel write;
+  const char* name;
+};
+
+const Kernels&
+SelectKernels() {
+  static const Kernels kernels = [] {
+#ifdef KATANA_SORTED_INTERSECTION_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return Kernels{
+          &Avx512Intersect<false>, &Avx512Intersect<true>, "avx512"};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return Kernels{&Avx2Intersect<false>, &Avx2Intersect<true>, "avx2"};
+    }
+#endif
+    return Kernels{&ScalarIntersect<false>, &ScalarIntersect<true>, "scalar"};
+  }();
+  return kernels;
+}
+
+template <bool kWrite>
+size_t
+Intersect(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out) {
+  size_t min_size = std::min(a_size, b_size);
+  size_t max_size = std::max(a_size, b_size);
+  // Skewed pairs gallop, which ScalarIntersect does for them
+  if (min_size < kMinVectorSize ||
+      max_size >= katana::analytics::kGallopingRatio * min_size) {
+    return ScalarIntersect<kWrite>(a, a_size, b, b_size, out);
+  }
+  const Kernels& kernels = SelectKernels();
+  return (kWrite ? kernels.write : kernels.count)(a, a_size, b, b_size, out);
+}
+
+}  // namespace
+
+uint64_t
+katana::analytics::SortedIntersectionSize(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  return Intersect<false>(a, a_size, b, b_size, nullptr);
+}
+
+size_t
+katana::analytics::SortedIntersection(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out) {
+  return Intersect<true>(a, a_size, b, b_size, out);
+}
+
+const char*
+katana::analytics::SortedIntersectionInstructionSet() {
+  return SelectKernels().name;
+}
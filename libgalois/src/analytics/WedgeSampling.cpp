@@ -0,0 +1,40 @@
+#include "katana/analytics/WedgeSampling.h"
+
+#include <cmath>
+
+#include "katana/Logging.h"
+
+double
+katana::analytics::TwoSidedNormalQuantile(double confidence) {
+  KATANA_LOG_DEBUG_ASSERT(confidence > 0 && confidence < 1);
+  // P(|Z| > z) = erfc(z / sqrt(2)) decreases with z; bisect for the z where
+  // it is 1 - confidence
+  double low = 0;
+  double high = 40;
+  for (int i = 0; i < 100; ++i) {
+    double mid = (low + high) / 2;
+    if (std::erfc(mid / std::sqrt(2.0)) > 1 - confidence) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+  return (low + high) / 2;
+}
+
+katana::analytics::ProportionInterval
+katana::analytics::WilsonInterval(
+    uint64_t successes, uint64_t trials, double z) {
+  if (trials == 0) {
+    return ProportionInterval{0, 1};
+  }
+  double n = trials;
+  double p = successes / n;
+  double z2 = z * z;
+  double denominator = 1 + z2 / n;
+  double center = (p + z2 / (2 * n)) / denominator;
+  double half_width =
+      z / denominator * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n));
+  return ProportionInterval{
+      std::max(0.0, center - half_width), std::min(1.0, center + half_width)};
+}
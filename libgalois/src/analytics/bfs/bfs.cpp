@@ -19,6 +19,7 @@
 
 #include "katana/analytics/bfs/bfs.h"
 
+#include <algorithm>
 #include <deque>
 #include <type_traits>
 
@@ -37,6 +38,9 @@ namespace {
 using BfsNodeDistance = katana::PODProperty<uint32_t>;
 using BfsNodeParent = katana::PODProperty<uint32_t>;
 
+using DistanceGraph =
+    katana::TypedPropertyGraph<std::tuple<BfsNodeDistance>, std::tuple<>>;
+
 struct BfsImplementation
     : BfsSsspImplementationBase<
           katana::TypedPropertyGraph<std::tuple<BfsNodeParent>, std::tuple<>>,
@@ -273,10 +277,9 @@ SynchronousAlgo(
 template <bool CONCURRENT, typename P>
 void
 SynchronousDirectOpt(
-    const katana::PropertyGraph& graph,
-    const katana::PropertyGraph& transpose_graph,
-    katana::LargeArray<GNode>* node_data, const GNode source, const P& pushWrap,
-    const uint32_t alpha, const uint32_t beta) {
+    const katana::PropertyGraph& graph, katana::LargeArray<GNode>* node_data,
+    const GNode source, const P& pushWrap, const uint32_t alpha,
+    const uint32_t beta) {
   using Cont = typename std::conditional<
       CONCURRENT, katana::InsertBag<GNode>, katana::SerStack<GNode>>::type;
   using Loop = typename std::conditional<
@@ -317,6 +320,8 @@ SynchronousDirectOpt(
   katana::GAccumulator<uint64_t> writes_pull;
   katana::GAccumulator<uint64_t> writes_push;
 
+  const katana::GraphTopology& topology = graph.topology();
+
   while (!next_frontier->empty()) {
     std::swap(frontier, next_frontier);
     next_frontier->clear();
@@ -329,16 +334,16 @@ SynchronousDirectOpt(
         work_items.reset();
 
         loop(
-            katana::iterate(transpose_graph),
+            katana::iterate(graph),
             [&](const GNode& dst) {
               GNode& ddata = (*node_data)[dst];
               if (ddata == BfsImplementation::kDistanceInfinity) {
-                for (auto e : transpose_graph.edges(dst)) {
-                  auto src = transpose_graph.GetEdgeDest(e);
+                for (auto e : topology.in_edges(dst)) {
+                  auto src = topology.in_edge_src(e);
 
-                  if (front_bitset.test(*src)) {
+                  if (front_bitset.test(src)) {
                     // assign parents on the bfs path.
-                    ddata = *src;
+                    ddata = src;
                     next_bitset.set(dst);
                     work_items += 1;
                     break;
@@ -411,12 +416,12 @@ InitializeGraphNodeData(
 
 void
 ComputeParentFromDistance(
-    katana::PropertyGraph& transpose_graph,
-    katana::LargeArray<GNode>* node_parent,
+    const katana::PropertyGraph& graph, katana::LargeArray<GNode>* node_parent,
     const katana::LargeArray<Dist>& node_dist, const GNode source) {
+  const katana::GraphTopology& topology = graph.topology();
   (*node_parent)[source] = source;
   katana::do_all(
-      katana::iterate(transpose_graph),
+      katana::iterate(graph),
       [&](const GNode v) {
         GNode& v_parent = (*node_parent)[v];
         Dist v_dist = node_dist[v];
@@ -428,8 +433,8 @@ ComputeParentFromDistance(
           return;
         }
 
-        for (auto e : transpose_graph.edges(v)) {
-          GNode u = *(transpose_graph.GetEdgeDest(e));
+        for (auto e : topology.in_edges(v)) {
+          GNode u = topology.in_edge_src(e);
           if (node_dist[v] == node_dist[u] + 1) {
             v_parent = u;
             break;
@@ -444,7 +449,7 @@ template <bool CONCURRENT>
 katana::Result<void>
 RunAlgo(
     BfsPlan algo, Graph* graph, katana::PropertyGraph* pg,
-    katana::PropertyGraph& transpose_graph, const GNode& source) {
+    const GNode& source) {
   BfsImplementation impl{algo.edge_tile_size()};
   katana::StatTimer exec_time("BFS");
 
@@ -457,8 +462,7 @@ RunAlgo(
 
     exec_time.start();
     SynchronousDirectOpt<CONCURRENT>(
-        *pg, transpose_graph, &node_data, source, NodePushWrap(), algo.alpha(),
-        algo.beta());
+        *pg, &node_data, source, NodePushWrap(), algo.alpha(), algo.beta());
     exec_time.stop();
 
     InitializeGraphNodeData(graph, node_data);
@@ -476,7 +480,7 @@ RunAlgo(
     exec_time.start();
     AsynchronousAlgo<CONCURRENT, UpdateRequest>(
         *pg, source, &node_dist, ReqPushWrap(), OutEdgeRangeFn{graph});
-    ComputeParentFromDistance(transpose_graph, &node_parent, node_dist, source);
+    ComputeParentFromDistance(*pg, &node_parent, node_dist, source);
     exec_time.stop();
 
     InitializeGraphNodeData(graph, node_parent);
@@ -514,19 +518,224 @@ BfsImpl(
   katana::EnsurePreallocated(8, approxNodeData);
   katana::ReportPageAllocGuard page_alloc;
 
-  // TODO(lhc): due to lack of in-edge iteration, manually creates a transposed graph
-  const katana::GraphTopology& topology = pg->topology();
-  auto transpose_graph = katana::CreateTransposeGraphTopology(topology);
+  // Both algorithms pull along in-edges; reuse the stored transpose topology
+  // when there is one
+  if (auto res = pg->PopulateInEdges(); !res) {
+    return res.error();
+  }
 
-  if (auto res = RunAlgo<true>(
-          algo, &graph, pg, *(transpose_graph.value().get()), source);
-      !res) {
+  if (auto res = RunAlgo<true>(algo, &graph, pg, source); !res) {
     return res.error();
   }
 
   return katana::ResultSuccess();
 }
 
+/// The state of a multi-source BFS, reused across batches of sources. Bit i
+/// of each mask stands for the i-th source of the current batch.
+struct MultiSourceBfsState {
+  /// The sources that have reached each node
+  katana::LargeArray<uint64_t> seen;
+  /// The sources whose frontier includes each node
+  katana::LargeArray<uint64_t> visit;
+  /// The sources whose next frontier includes each node
+  katana::LargeArray<uint64_t> visit_next;
+
+  explicit MultiSourceBfsState(size_t num_nodes) {
+    seen.allocateInterleaved(num_nodes);
+    visit.allocateInterleaved(num_nodes);
+    visit_next.allocateInterleaved(num_nodes);
+  }
+};
+
+/// Search from sources[0, num_sources) together, calling record(i, node,
+/// level) once for every node reached from sources[i].
+///
+/// Each level either pushes the frontier masks along out-edges or, when the
+/// frontier is large, has each node not yet reached by every source pull the
+/// masks of its in-neighbors.
+template <typename RecordFn>
+void
+MultiSourceBfsBatch(
+    const katana::PropertyGraph& graph, const GNode* sources,
+    size_t num_sources, const uint32_t alpha, const uint32_t beta,
+    MultiSourceBfsState* state, const RecordFn& record) {
+  KATANA_LOG_DEBUG_ASSERT(
+      num_sources > 0 && num_sources <= kMultiSourceBfsBatchSize);
+  const katana::GraphTopology& topology = graph.topology();
+  uint64_t num_nodes = graph.num_nodes();
+  uint64_t num_edges = graph.num_edges();
+  const uint64_t all_sources = num_sources == kMultiSourceBfsBatchSize
+                                   ? ~uint64_t{0}
+                                   : (uint64_t{1} << num_sources) - 1;
+
+  auto& seen = state->seen;
+  auto& visit = state->visit;
+  auto& visit_next = state->visit_next;
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        seen[n] = 0;
+        visit[n] = 0;
+        visit_next[n] = 0;
+      },
+      katana::no_stats());
+  for (size_t i = 0; i < num_sources; ++i) {
+    visit_next[sources[i]] |= uint64_t{1} << i;
+  }
+
+  katana::GAccumulator<uint64_t> frontier_nodes;
+  katana::GAccumulator<uint64_t> frontier_edges;
+  bool pull = false;
+
+  for (Dist level = 0;; ++level) {
+    // Turn the masks found in the last step into the new frontier
+    frontier_nodes.reset();
+    frontier_edges.reset();
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          uint64_t next = visit_next[n] & ~seen[n];
+          visit_next[n] = 0;
+          visit[n] = next;
+          if (!next) {
+            return;
+          }
+          seen[n] |= next;
+          frontier_nodes += 1;
+          auto [begin_edge, end_edge] = topology.edge_range(n);
+          frontier_edges += end_edge - begin_edge;
+          for (uint64_t bits = next; bits; bits &= bits - 1) {
+            record(__builtin_ctzll(bits), n, level);
+          }
+        },
+        katana::steal(), katana::chunk_size<kChunkSize>(),
+        katana::loopname("MultiSourceBfs-Frontier"));
+
+    if (frontier_nodes.reduce() == 0) {
+      break;
+    }
+
+    if (!pull && frontier_edges.reduce() > num_edges / alpha) {
+      pull = true;
+    } else if (pull && frontier_nodes.reduce() < num_nodes / beta) {
+      pull = false;
+    }
+
+    if (pull) {
+      katana::do_all(
+          katana::iterate(uint64_t{0}, num_nodes),
+          [&](uint64_t dst) {
+            uint64_t unseen = all_sources & ~seen[dst];
+            if (!unseen) {
+              return;
+            }
+            uint64_t next = 0;
+            for (auto e : topology.in_edges(dst)) {
+              next |= visit[topology.in_edge_src(e)];
+              if ((next & unseen) == unseen) {
+                break;
+              }
+            }
+            visit_next[dst] = next & unseen;
+          },
+          katana::steal(), katana::chunk_size<kChunkSize>(),
+          katana::loopname("MultiSourceBfs-Pull"));
+    } else {
+      katana::do_all(
+          katana::iterate(uint64_t{0}, num_nodes),
+          [&](uint64_t src) {
+            uint64_t src_visit = visit[src];
+            if (!src_visit) {
+              return;
+            }
+            for (auto e : graph.edges(src)) {
+              auto dst = *graph.GetEdgeDest(e);
+              uint64_t unseen = src_visit & ~seen[dst];
+              // Skip the atomic when every source is already recorded
+              if (unseen &&
+                  (__atomic_load_n(&visit_next[dst], __ATOMIC_RELAXED) &
+                   unseen) != unseen) {
+                __atomic_fetch_or(&visit_next[dst], unseen, __ATOMIC_RELAXED);
+              }
+            }
+          },
+          katana::steal(), katana::chunk_size<kChunkSize>(),
+          katana::loopname("MultiSourceBfs-Push"));
+    }
+  }
+}
+
+/// Run MultiSourceBfsBatch over all of sources, calling record(i, node, level)
+/// once for every node reached from sources[i].
+template <typename RecordFn>
+katana::Result<void>
+MultiSourceBfsImpl(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    BfsPlan algo, const RecordFn& record) {
+  if (algo.algorithm() != BfsPlan::kSynchronousDirectOpt) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotImplemented, "Unsupported algorithm: {}",
+        algo.algorithm());
+  }
+  for (auto source : sources) {
+    if (source >= pg->num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "source {} out of range",
+          source);
+    }
+  }
+
+  // The pull steps follow in-edges; set them up once for all batches
+  if (auto res = pg->PopulateInEdges(); !res) {
+    return res.error();
+  }
+
+  MultiSourceBfsState state(pg->num_nodes());
+  katana::StatTimer exec_time("MultiSourceBfs");
+  exec_time.start();
+  for (size_t begin = 0; begin < sources.size();
+       begin += kMultiSourceBfsBatchSize) {
+    size_t num_sources =
+        std::min(kMultiSourceBfsBatchSize, sources.size() - begin);
+    MultiSourceBfsBatch(
+        *pg, &sources[begin], num_sources, algo.alpha(), algo.beta(), &state,
+        [&](size_t i, GNode node, Dist level) {
+          record(begin + i, node, level);
+        });
+  }
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
+/// \returns the BFS level of every node from \param source, computed serially
+katana::LargeArray<Dist>
+SerialBfsLevels(const katana::PropertyGraph& graph, GNode source) {
+  katana::LargeArray<Dist> levels;
+  levels.allocateInterleaved(graph.num_nodes());
+  katana::do_all(katana::iterate(uint64_t{0}, levels.size()), [&](size_t i) {
+    levels[i] = BfsImplementation::kDistanceInfinity;
+  });
+
+  std::vector<GNode> visited_nodes;
+  visited_nodes.reserve(graph.num_nodes());
+  levels[source] = 0;
+  visited_nodes.push_back(source);
+  for (size_t i = 0; i < visited_nodes.size(); ++i) {
+    GNode u = visited_nodes[i];
+    for (auto e : graph.edges(u)) {
+      GNode v = *graph.GetEdgeDest(e);
+      if (levels[v] == BfsImplementation::kDistanceInfinity) {
+        levels[v] = levels[u] + 1;
+        visited_nodes.push_back(v);
+      }
+    }
+  }
+  return levels;
+}
+
 }  // namespace
 
 katana::Result<void>
@@ -557,12 +766,10 @@ katana::analytics::BfsAssertValid(
 
   BfsImplementation::Graph graph = pg_result.value();
 
-  // TODO(lhc): due to lack of in-edge iteration, manually creates a transposed graph
+  if (auto res = pg->PopulateInEdges(); !res) {
+    return res.error();
+  }
   const katana::GraphTopology& topology = pg->topology();
-  katana::LargeArray<GNode> node_data;
-  node_data.allocateInterleaved(topology.num_nodes());
-  auto transpose_graph_topo = katana::CreateTransposeGraphTopology(topology);
-  const auto& transpose_graph = *(transpose_graph_topo.value().get());
 
   uint32_t num_nodes = graph.num_nodes();
   LargeArray<Dist> levels;
@@ -602,8 +809,8 @@ katana::analytics::BfsAssertValid(
       }
       bool parent_found = false;
 
-      for (auto e : transpose_graph.edges(u)) {
-        GNode v = *(transpose_graph.GetEdgeDest(e));
+      for (auto e : topology.in_edges(u)) {
+        GNode v = topology.in_edge_src(e);
         if (v == u_parent) {
           if (levels[v] != levels[u] - 1) {
             return KATANA_ERROR(
@@ -626,6 +833,90 @@ katana::analytics::BfsAssertValid(
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+katana::analytics::MultiSourceBfs(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::vector<std::string>& output_property_names, BfsPlan algo) {
+  if (output_property_names.size() != sources.size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "{} output properties given for {} sources",
+        output_property_names.size(), sources.size());
+  }
+
+  std::vector<DistanceGraph> graphs;
+  graphs.reserve(sources.size());
+  for (const auto& name : output_property_names) {
+    if (auto result =
+            ConstructNodeProperties<std::tuple<BfsNodeDistance>>(pg, {name});
+        !result) {
+      return result.error();
+    }
+    auto pg_result = DistanceGraph::Make(pg, {name}, {});
+    if (!pg_result) {
+      return pg_result.error();
+    }
+    DistanceGraph& graph = graphs.emplace_back(pg_result.value());
+    do_all(iterate(graph), [&](GNode n) {
+      graph.GetData<BfsNodeDistance>(n) = BfsImplementation::kDistanceInfinity;
+    });
+  }
+
+  return MultiSourceBfsImpl(
+      pg, sources, algo, [&](size_t i, GNode node, Dist level) {
+        graphs[i].GetData<BfsNodeDistance>(node) = level;
+      });
+}
+
+katana::Result<std::vector<std::vector<uint32_t>>>
+katana::analytics::MultiSourceBfsLevels(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources, BfsPlan algo) {
+  std::vector<std::vector<uint32_t>> levels(
+      sources.size(),
+      std::vector<uint32_t>(
+          pg->num_nodes(), BfsImplementation::kDistanceInfinity));
+
+  if (auto res = MultiSourceBfsImpl(
+          pg, sources, algo,
+          [&](size_t i, GNode node, Dist level) { levels[i][node] = level; });
+      !res) {
+    return res.error();
+  }
+  return levels;
+}
+
+katana::Result<void>
+katana::analytics::MultiSourceBfsAssertValid(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::vector<std::string>& property_names) {
+  if (property_names.size() != sources.size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "{} properties given for {} sources", property_names.size(),
+        sources.size());
+  }
+
+  for (size_t i = 0; i < sources.size(); ++i) {
+    auto pg_result = DistanceGraph::Make(pg, {property_names[i]}, {});
+    if (!pg_result) {
+      return pg_result.error();
+    }
+    DistanceGraph graph = pg_result.value();
+
+    LargeArray<Dist> levels = SerialBfsLevels(*pg, sources[i]);
+    for (GNode n : graph) {
+      if (graph.GetData<BfsNodeDistance>(n) != levels[n]) {
+        return KATANA_ERROR(
+            katana::ErrorCode::AssertionFailed,
+            "node {} has level {} from source {} but expected {}", n,
+            graph.GetData<BfsNodeDistance>(n), sources[i], levels[n]);
+      }
+    }
+  }
+
+  return katana::ResultSuccess();
+}
+
 katana::Result<BfsStatistics>
 katana::analytics::BfsStatistics::Compute(
     katana::PropertyGraph* pg, const std::string& property_name) {
@@ -0,0 +1,457 @@
+#include "katana/analytics/coarsening/coarsening.h"
+
+#include <algorithm>
+
+#include "katana/Galois.h"
+#include "katana/ParallelSTL.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+struct Cluster : public katana::PODProperty<uint64_t> {};
+
+template <typename Weight>
+using EdgeWeight = katana::PODProperty<Weight>;
+
+/// Stop matching after this many rounds; the last rounds match few nodes
+constexpr uint32_t kMaxMatchingRounds = 16;
+
+constexpr Node kUnmatched = std::numeric_limits<Node>::max();
+
+/// A pseudo-random priority for the edge between a and b to break ties
+/// between edges of the same weight. It is the same for both directions of
+/// the edge.
+uint64_t
+EdgePriority(Node a, Node b) {
+  uint64_t x = (uint64_t{std::min(a, b)} << 32) | std::max(a, b);
+  // splitmix64 finalizer
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/// An edge of a coarse node waiting to be merged with the other edges to the
+/// same coarse node
+template <typename Weight>
+struct CoarseEdge {
+  Node dest;
+  Weight weight;
+};
+
+template <typename Weight>
+katana::Result<CoarsenedGraph>
+ContractClustersImpl(
+    const katana::PropertyGraph* pg,
+    const std::string& edge_weight_property_name,
+    const std::string& cluster_property_name,
+    const std::string& output_edge_weight_property_name) {
+  katana::StatTimer timer("Timer_Contract_Clusters");
+  katana::TimerGuard timer_guard(timer);
+
+  auto weights_result =
+      pg->GetEdgePropertyTyped<Weight>(edge_weight_property_name);
+  if (!weights_result) {
+    return weights_result.error();
+  }
+  const Weight* weights = weights_result.value()->raw_values();
+
+  auto clusters_result =
+      pg->GetNodePropertyTyped<uint64_t>(cluster_property_name);
+  if (!clusters_result) {
+    return clusters_result.error();
+  }
+  const uint64_t* clusters = clusters_result.value()->raw_values();
+
+  const katana::GraphTopology& topology = pg->topology();
+  uint64_t num_nodes = topology.num_nodes();
+
+  // Number the coarse nodes in the order of the cluster ids: mark the ids in
+  // use and count them with a prefix sum
+  katana::LargeArray<uint64_t> coarse_ids;
+  coarse_ids.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { coarse_ids[n] = 0; }, katana::no_stats());
+
+  katana::GAccumulator<uint64_t> invalid;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint64_t c = clusters[n];
+        if (c == kUnassignedCluster) {
+          return;
+        }
+        if (c >= num_nodes) {
+          invalid += 1;
+          return;
+        }
+        coarse_ids[c] = 1;
+      },
+      katana::no_stats());
+  if (invalid.reduce() > 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "{} nodes have a cluster id not below the number of nodes {}",
+        invalid.reduce(), num_nodes);
+  }
+
+  katana::ParallelSTL::partial_sum(
+      coarse_ids.begin(), coarse_ids.end(), coarse_ids.begin());
+  uint64_t num_coarse_nodes = num_nodes > 0 ? coarse_ids[num_nodes - 1] : 0;
+
+  CoarsenedGraph result;
+  result.fine_to_coarse.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint64_t c = clusters[n];
+        result.fine_to_coarse[n] =
+            c == kUnassignedCluster ? kUnassignedCluster : coarse_ids[c] - 1;
+      },
+      katana::no_stats());
+  coarse_ids.destroy();
+  coarse_ids.deallocate();
+  const auto& fine_to_coarse = result.fine_to_coarse;
+
+  // Group the fine nodes by coarse node, left out nodes last
+  katana::LargeArray<Node> members;
+  members.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { members[n] = n; }, katana::no_stats());
+  katana::ParallelSTL::sort(
+      members.begin(), members.end(), [&](Node a, Node b) {
+        return fine_to_coarse[a] < fine_to_coarse[b] ||
+               (fine_to_coarse[a] == fine_to_coarse[b] && a < b);
+      });
+  uint64_t num_members =
+      std::partition_point(
+          members.begin(), members.end(),
+          [&](Node n) { return fine_to_coarse[n] != kUnassignedCluster; }) -
+      members.begin();
+
+  // members[member_begin[c]...member_begin[c + 1]) are merged into c
+  katana::LargeArray<uint64_t> member_begin;
+  member_begin.allocateBlocked(num_coarse_nodes + 1);
+  member_begin[num_coarse_nodes] = num_members;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_members),
+      [&](uint64_t i) {
+        uint64_t c = fine_to_coarse[members[i]];
+        if (i == 0 || fine_to_coarse[members[i - 1]] != c) {
+          member_begin[c] = i;
+        }
+      },
+      katana::no_stats());
+
+  // Each coarse node gets a slot in the buffer for every edge of its members
+  katana::LargeArray<uint64_t> slot_end;
+  slot_end.allocateBlocked(num_members);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_members),
+      [&](uint64_t i) {
+        auto [begin_edge, end_edge] = topology.edge_range(members[i]);
+        slot_end[i] = end_edge - begin_edge;
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      slot_end.begin(), slot_end.end(), slot_end.begin());
+  auto slot_begin = [&](uint64_t c) -> uint64_t {
+    return member_begin[c] == 0 ? 0 : slot_end[member_begin[c] - 1];
+  };
+
+  katana::LargeArray<CoarseEdge<Weight>> buffer;
+  buffer.allocateBlocked(num_members > 0 ? slot_end[num_members - 1] : 0);
+
+  // Gather the edges of each coarse node, sort them by destination and sum
+  // the weights of edges to the same destination
+  katana::LargeArray<Edge> out_indices;
+  out_indices.allocateInterleaved(num_coarse_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse_nodes),
+      [&](uint64_t c) {
+        CoarseEdge<Weight>* first = buffer.data() + slot_begin(c);
+        CoarseEdge<Weight>* last = first;
+        for (uint64_t i = member_begin[c]; i < member_begin[c + 1]; ++i) {
+          for (auto e : topology.edges(members[i])) {
+            uint64_t dest = fine_to_coarse[topology.edge_dest(e)];
+            if (dest == kUnassignedCluster) {
+              continue;
+            }
+            *last++ = CoarseEdge<Weight>{static_cast<Node>(dest), weights[e]};
+          }
+        }
+        std::sort(
+            first, last,
+            [](const CoarseEdge<Weight>& a, const CoarseEdge<Weight>& b) {
+              return a.dest < b.dest;
+            });
+
+        CoarseEdge<Weight>* merged = first;
+        for (CoarseEdge<Weight>* it = first; it != last; ++it) {
+          if (merged != first && (merged - 1)->dest == it->dest) {
+            (merged - 1)->weight += it->weight;
+          } else {
+            *merged++ = *it;
+          }
+        }
+        out_indices[c] = merged - first;
+      },
+      katana::steal(), katana::loopname("ContractClusters"));
+
+  katana::ParallelSTL::partial_sum(
+      out_indices.begin(), out_indices.end(), out_indices.begin());
+  uint64_t num_coarse_edges =
+      num_coarse_nodes > 0 ? out_indices[num_coarse_nodes - 1] : 0;
+  auto edge_begin = [&](uint64_t c) -> uint64_t {
+    return c == 0 ? 0 : out_indices[c - 1];
+  };
+
+  katana::LargeArray<Node> out_dests;
+  out_dests.allocateInterleaved(num_coarse_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse_nodes),
+      [&](uint64_t c) {
+        const CoarseEdge<Weight>* from = buffer.data() + slot_begin(c);
+        for (uint64_t e = edge_begin(c); e < out_indices[c]; ++e) {
+          out_dests[e] = (from++)->dest;
+        }
+      },
+      katana::no_stats());
+
+  // Keep the edge offsets of each coarse node to copy the weights once the
+  // topology has taken out_indices
+  katana::LargeArray<uint64_t> coarse_edge_begin;
+  coarse_edge_begin.allocateBlocked(num_coarse_nodes + 1);
+  coarse_edge_begin[num_coarse_nodes] = num_coarse_edges;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse_nodes),
+      [&](uint64_t c) { coarse_edge_begin[c] = edge_begin(c); },
+      katana::no_stats());
+
+  result.graph = std::make_unique<katana::PropertyGraph>();
+  auto topology_next = std::make_unique<katana::GraphTopology>(
+      std::move(out_indices), std::move(out_dests));
+  if (auto r = result.graph->SetTopology(std::move(topology_next)); !r) {
+    return r.error();
+  }
+
+  using EdgeData = std::tuple<EdgeWeight<Weight>>;
+  if (auto r = ConstructEdgeProperties<EdgeData>(
+          result.graph.get(), {output_edge_weight_property_name});
+      !r) {
+    return r.error();
+  }
+  auto graph_result = katana::TypedPropertyGraph<std::tuple<>, EdgeData>::Make(
+      result.graph.get(), {}, {output_edge_weight_property_name});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse_nodes),
+      [&](uint64_t c) {
+        const CoarseEdge<Weight>* from = buffer.data() + slot_begin(c);
+        for (uint64_t e = coarse_edge_begin[c]; e < coarse_edge_begin[c + 1];
+             ++e) {
+          graph.template GetEdgeData<EdgeWeight<Weight>>(e) = (from++)->weight;
+        }
+      },
+      katana::no_stats());
+
+  return CoarsenedGraph(std::move(result));
+}
+
+template <typename Weight>
+katana::Result<void>
+HeavyEdgeMatchingImpl(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name) {
+  auto weights_result =
+      pg->GetEdgePropertyTyped<Weight>(edge_weight_property_name);
+  if (!weights_result) {
+    return weights_result.error();
+  }
+  const Weight* weights = weights_result.value()->raw_values();
+
+  const katana::GraphTopology& topology = pg->topology();
+  uint64_t num_nodes = topology.num_nodes();
+
+  katana::LargeArray<Node> mate;
+  katana::LargeArray<Node> choice;
+  mate.allocateBlocked(num_nodes);
+  choice.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { mate[n] = kUnmatched; }, katana::no_stats());
+
+  uint32_t rounds = 0;
+  while (rounds < kMaxMatchingRounds) {
+    ++rounds;
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          Node best = n;
+          if (mate[n] != kUnmatched) {
+            choice[n] = best;
+            return;
+          }
+          Weight best_weight{};
+          uint64_t best_priority = 0;
+          for (auto e : topology.edges(n)) {
+            Node dest = topology.edge_dest(e);
+            if (dest == n || mate[dest] != kUnmatched) {
+              continue;
+            }
+            uint64_t priority = EdgePriority(n, dest);
+            if (best == n || weights[e] > best_weight ||
+                (weights[e] == best_weight && priority > best_priority)) {
+              best = dest;
+              best_weight = weights[e];
+              best_priority = priority;
+            }
+          }
+          choice[n] = best;
+        },
+        katana::steal(), katana::loopname("HeavyEdgeMatching"));
+
+    katana::GAccumulator<uint64_t> matched;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          Node c = choice[n];
+          if (mate[n] == kUnmatched && c != n && choice[c] == n) {
+            mate[n] = c;
+            matched += 1;
+          }
+        },
+        katana::no_stats());
+    if (matched.reduce() == 0) {
+      break;
+    }
+  }
+  katana::ReportStatSingle("HeavyEdgeMatching", "Rounds", rounds);
+
+  if (auto r = ConstructNodeProperties<std::tuple<Cluster>>(
+          pg, {output_property_name});
+      !r) {
+    return r.error();
+  }
+  auto graph_result =
+      katana::TypedPropertyGraph<std::tuple<Cluster>, std::tuple<>>::Make(
+          pg, {output_property_name}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t n) {
+        graph.GetData<Cluster>(n) =
+            mate[n] == kUnmatched ? n : std::min<Node>(n, mate[n]);
+      },
+      katana::no_stats());
+
+  return katana::ResultSuccess();
+}
+
+}  // anonymous namespace
+
+katana::Result<CoarsenedGraph>
+katana::analytics::ContractClusters(
+    const katana::PropertyGraph* pg,
+    const std::string& edge_weight_property_name,
+    const std::string& cluster_property_name,
+    const std::string& output_edge_weight_property_name) {
+  auto edge_property = pg->GetEdgeProperty(edge_weight_property_name);
+  if (!edge_property) {
+    return KATANA_ERROR(
+        katana::ErrorCode::PropertyNotFound, "no edge property {}",
+        edge_weight_property_name);
+  }
+  switch (edge_property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return ContractClustersImpl<uint32_t>(
+        pg, edge_weight_property_name, cluster_property_name,
+        output_edge_weight_property_name);
+  case arrow::Int32Type::type_id:
+    return ContractClustersImpl<int32_t>(
+        pg, edge_weight_property_name, cluster_property_name,
+        output_edge_weight_property_name);
+  case arrow::UInt64Type::type_id:
+    return ContractClustersImpl<uint64_t>(
+        pg, edge_weight_property_name, cluster_property_name,
+        output_edge_weight_property_name);
+  case arrow::Int64Type::type_id:
+    return ContractClustersImpl<int64_t>(
+        pg, edge_weight_property_name, cluster_property_name,
+        output_edge_weight_property_name);
+  case arrow::FloatType::type_id:
+    return ContractClustersImpl<float>(
+        pg, edge_weight_property_name, cluster_property_name,
+        output_edge_weight_property_name);
+  case arrow::DoubleType::type_id:
+    return ContractClustersImpl<double>(
+        pg, edge_weight_property_name, cluster_property_name,
+        output_edge_weight_property_name);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+katana::Result<void>
+katana::analytics::HeavyEdgeMatching(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name) {
+  auto edge_property = pg->GetEdgeProperty(edge_weight_property_name);
+  if (!edge_property) {
+    return KATANA_ERROR(
+        katana::ErrorCode::PropertyNotFound, "no edge property {}",
+        edge_weight_property_name);
+  }
+  switch (edge_property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return HeavyEdgeMatchingImpl<uint32_t>(
+        pg, edge_weight_property_name, output_property_name);
+  case arrow::Int32Type::type_id:
+    return HeavyEdgeMatchingImpl<int32_t>(
+        pg, edge_weight_property_name, output_property_name);
+  case arrow::UInt64Type::type_id:
+    return HeavyEdgeMatchingImpl<uint64_t>(
+        pg, edge_weight_property_name, output_property_name);
+  case arrow::Int64Type::type_id:
+    return HeavyEdgeMatchingImpl<int64_t>(
+        pg, edge_weight_property_name, output_property_name);
+  case arrow::FloatType::type_id:
+    return HeavyEdgeMatchingImpl<float>(
+        pg, edge_weight_property_name, output_property_name);
+  case arrow::DoubleType::type_id:
+    return HeavyEdgeMatchingImpl<double>(
+        pg, edge_weight_property_name, output_property_name);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+katana::Result<CoarsenedGraph>
+katana::analytics::Coarsen(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_edge_weight_property_name) {
+  TemporaryPropertyGuard matching{pg};
+  if (auto r =
+          HeavyEdgeMatching(pg, edge_weight_property_name, matching.name());
+      !r) {
+    return r.error();
+  }
+  return ContractClusters(
+      pg, edge_weight_property_name, matching.name(),
+      output_edge_weight_property_name);
+}
@@ -19,7 +19,12 @@
 
 #include "katana/analytics/connected_components/connected_components.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
 
 using namespace katana::analytics;
@@ -684,8 +689,11 @@ struct ConnectedComponentsAfforestAlgo {
     }
   };
 
-  struct NodeComponent
-      : public katana::PODProperty<uint64_t, NodeAfforest::ComponentType> {};
+  /// The component of a node is the id of its representative node, so
+  /// component ids are node ids and are meaningful after the parent array is
+  /// freed, which ConnectedComponentsBuildIndex and
+  /// ConnectedComponentsInsertEdges rely on.
+  struct NodeComponent : public katana::PODProperty<uint64_t> {};
 
   using NodeData = std::tuple<NodeComponent>;
   using EdgeData = std::tuple<>;
@@ -703,20 +711,15 @@ struct ConnectedComponentsAfforestAlgo {
     // parent_array_.allocateInterleaved(graph->size());
 
     katana::do_all(katana::iterate(*graph), [&](const GNode& node) {
-      auto& snode = graph->GetData<NodeComponent>(node);
-      new (&snode) NodeAfforest();
       new (&parent_array_[node]) NodeAfforest();
-      //snode = reinterpret_cast<ComponentType>(&snode);
     });
   }
 
   void Deallocate(Graph* graph) {
     katana::do_all(katana::iterate(*graph), [&](const GNode& node) {
       auto& sdata = graph->GetData<NodeComponent>(node);
-      auto& dataFromArr = parent_array_[node];
-      // auto component_ptr = sdata->component();
-      auto component_ptr = dataFromArr.component();
-      sdata = component_ptr;
+      auto component_ptr = parent_array_[node].component();
+      sdata = component_ptr - parent_array_.data();
     });
   }
   using ComponentType = NodeAfforest::ComponentType;
@@ -1220,6 +1223,309 @@ katana::analytics::ConnectedComponentsAssertValid(
   return katana::ResultSuccess();
 }
 
+namespace {
+
+using ComponentUnionFindNode = ConnectedComponentsAfforestAlgo::NodeAfforest;
+
+struct IndexedComponent : public katana::PODProperty<uint64_t> {};
+struct NextMember : public katana::PODProperty<uint32_t> {};
+struct ComponentSize : public katana::PODProperty<uint64_t> {};
+
+using IndexedGraph = katana::TypedPropertyGraph<
+    std::tuple<IndexedComponent, NextMember, ComponentSize>, std::tuple<>>;
+
+std::string
+NextMemberPropertyName(const std::string& index_property_prefix) {
+  return index_property_prefix + "next";
+}
+
+std::string
+ComponentSizePropertyName(const std::string& index_property_prefix) {
+  return index_property_prefix + "size";
+}
+
+katana::Result<IndexedGraph>
+MakeIndexedGraph(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    const std::string& index_property_prefix) {
+  return IndexedGraph::Make(
+      pg,
+      {property_name, NextMemberPropertyName(index_property_prefix),
+       ComponentSizePropertyName(index_property_prefix)},
+      {});
+}
+
+/// Mark the component property and its index persistent, which also makes
+/// the next store write them again after they changed
+katana::Result<void>
+MarkIndexPersistent(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    const std::string& index_property_prefix) {
+  // Properties are named by position when marking them persistent
+  std::shared_ptr<arrow::Schema> schema = pg->node_schema();
+  std::vector<std::string> persist(schema->num_fields());
+  for (const auto& name :
+       {property_name, NextMemberPropertyName(index_property_prefix),
+        ComponentSizePropertyName(index_property_prefix)}) {
+    persist[schema->GetFieldIndex(name)] = name;
+  }
+  return pg->MarkNodePropertiesPersistent(persist);
+}
+
+/// Remove the index properties after building them failed
+void
+RemoveIndex(
+    katana::PropertyGraph* pg, const std::string& index_property_prefix) {
+  for (const auto& name :
+       {NextMemberPropertyName(index_property_prefix),
+        ComponentSizePropertyName(index_property_prefix)}) {
+    if (auto r = pg->RemoveNodeProperty(name); !r) {
+      KATANA_LOG_WARN("failed to remove {}: {}", name, r.error());
+    }
+  }
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::ConnectedComponentsBuildIndex(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::string& index_property_prefix) {
+  using Node = IndexedGraph::Node;
+
+  katana::StatTimer exec_time("ConnectedComponents-BuildIndex");
+  katana::TimerGuard timer_guard(exec_time);
+
+  const std::string next_name = NextMemberPropertyName(index_property_prefix);
+  const std::string size_name =
+      ComponentSizePropertyName(index_property_prefix);
+  if (auto r = ConstructNodeProperties<std::tuple<NextMember, ComponentSize>>(
+          pg, {next_name, size_name});
+      !r) {
+    return r.error();
+  }
+  auto graph_result =
+      MakeIndexedGraph(pg, property_name, index_property_prefix);
+  if (!graph_result) {
+    RemoveIndex(pg, index_property_prefix);
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+  const size_t num_nodes = graph.size();
+
+  auto is_not_id = [&graph, num_nodes](const Node& n) {
+    uint64_t c = graph.GetData<IndexedComponent>(n);
+    return c >= num_nodes || graph.GetData<IndexedComponent>(c) != c;
+  };
+  if (auto bad =
+          katana::ParallelSTL::find_if(graph.begin(), graph.end(), is_not_id);
+      bad != graph.end()) {
+    auto error = KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "component {} of node {} is not the id of a node in it",
+        graph.GetData<IndexedComponent>(*bad), *bad);
+    RemoveIndex(pg, index_property_prefix);
+    return error;
+  }
+
+  // Sort the nodes by component, so the nodes of each component are
+  // consecutive and can be linked to the next one in parallel
+  katana::LargeArray<Node> order;
+  order.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        order[n] = n;
+        graph.GetData<ComponentSize>(n) = 0;
+      },
+      katana::no_stats());
+  katana::ParallelSTL::sort(
+      order.begin(), order.end(), [&graph](const Node& a, const Node& b) {
+        uint64_t ca = graph.GetData<IndexedComponent>(a);
+        uint64_t cb = graph.GetData<IndexedComponent>(b);
+        return ca < cb || (ca == cb && a < b);
+      });
+
+  auto component_at = [&](size_t i) {
+    return graph.GetData<IndexedComponent>(order[i]);
+  };
+
+  // The size of a component holds the position of its first node until the
+  // position of its last node is known
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) {
+        if (i == 0 || component_at(i - 1) != component_at(i)) {
+          graph.GetData<ComponentSize>(component_at(i)) = i;
+        }
+      },
+      katana::no_stats());
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) {
+        uint64_t c = component_at(i);
+        if (i + 1 < num_nodes && component_at(i + 1) == c) {
+          graph.GetData<NextMember>(order[i]) = order[i + 1];
+          return;
+        }
+        uint64_t& size = graph.GetData<ComponentSize>(c);
+        graph.GetData<NextMember>(order[i]) = order[size];
+        size = i - size + 1;
+      },
+      katana::steal(), katana::loopname("ConnectedComponents-LinkMembers"));
+
+  return MarkIndexPersistent(pg, property_name, index_property_prefix);
+}
+
+katana::Result<void>
+katana::analytics::ConnectedComponentsInsertEdges(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::string& index_property_prefix,
+    const std::vector<std::pair<uint32_t, uint32_t>>& inserted_edges) {
+  katana::StatTimer exec_time("ConnectedComponents-InsertEdges");
+  katana::TimerGuard timer_guard(exec_time);
+
+  auto graph_result =
+      MakeIndexedGraph(pg, property_name, index_property_prefix);
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+
+  // The components touched by the inserted edges, sorted so the union-find
+  // node of a component can be found by binary search
+  std::vector<uint64_t> affected;
+  for (const auto& [src, dest] : inserted_edges) {
+    if (src >= graph.size() || dest >= graph.size()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "edge ({}, {}) is not between nodes of the graph", src, dest);
+    }
+    uint64_t src_component = graph.GetData<IndexedComponent>(src);
+    uint64_t dest_component = graph.GetData<IndexedComponent>(dest);
+    if (src_component != dest_component) {
+      affected.emplace_back(src_component);
+      affected.emplace_back(dest_component);
+    }
+  }
+  std::sort(affected.begin(), affected.end());
+  affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+  if (affected.empty()) {
+    return katana::ResultSuccess();
+  }
+
+  katana::LargeArray<ComponentUnionFindNode> union_find;
+  union_find.allocateBlocked(affected.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, affected.size()),
+      [&](size_t i) { new (&union_find[i]) ComponentUnionFindNode(); },
+      katana::no_stats());
+
+  auto union_find_node = [&](uint64_t component) {
+    auto it = std::lower_bound(affected.begin(), affected.end(), component);
+    return &union_find[it - affected.begin()];
+  };
+  katana::do_all(
+      katana::iterate(inserted_edges),
+      [&](const std::pair<uint32_t, uint32_t>& edge) {
+        uint64_t src_component = graph.GetData<IndexedComponent>(edge.first);
+        uint64_t dest_component = graph.GetData<IndexedComponent>(edge.second);
+        if (src_component != dest_component) {
+          union_find_node(src_component)->link(union_find_node(dest_component));
+        }
+      },
+      katana::steal(),
+      katana::loopname("ConnectedComponents-InsertEdges-Link"));
+  katana::do_all(
+      katana::iterate(size_t{0}, affected.size()),
+      [&](size_t i) { union_find[i].compress(); }, katana::no_stats());
+
+  // Each merged component keeps the id of the largest component in it, so the
+  // fewest nodes are relabeled
+  auto root = [&](size_t i) {
+    return static_cast<size_t>(union_find[i].component() - union_find.data());
+  };
+  auto size_of = [&](size_t i) {
+    return graph.GetData<ComponentSize>(affected[i]);
+  };
+  std::vector<size_t> largest(affected.size());
+  std::iota(largest.begin(), largest.end(), size_t{0});
+  for (size_t i = 0; i < affected.size(); ++i) {
+    size_t& best = largest[root(i)];
+    if (size_of(i) > size_of(best)) {
+      best = i;
+    }
+  }
+  std::vector<std::pair<uint64_t, uint64_t>> absorbed;
+  for (size_t i = 0; i < affected.size(); ++i) {
+    uint64_t into = affected[largest[root(i)]];
+    if (affected[i] != into) {
+      absorbed.emplace_back(affected[i], into);
+    }
+  }
+
+  katana::GAccumulator<uint64_t> relabeled;
+  katana::do_all(
+      katana::iterate(absorbed),
+      [&](const std::pair<uint64_t, uint64_t>& merge) {
+        uint64_t n = merge.first;
+        do {
+          graph.GetData<IndexedComponent>(n) = merge.second;
+          n = graph.GetData<NextMember>(n);
+        } while (n != merge.first);
+        relabeled += graph.GetData<ComponentSize>(merge.first);
+      },
+      katana::steal(),
+      katana::loopname("ConnectedComponents-InsertEdges-Relabel"));
+
+  // Splice the member cycles of absorbed components into the cycle of the
+  // component they merged into
+  for (const auto& [from, into] : absorbed) {
+    std::swap(
+        graph.GetData<NextMember>(from), graph.GetData<NextMember>(into));
+    graph.GetData<ComponentSize>(into) += graph.GetData<ComponentSize>(from);
+    graph.GetData<ComponentSize>(from) = 0;
+  }
+
+  katana::ReportStatSingle(
+      "ConnectedComponents-InsertEdges", "Relabeled", relabeled.reduce());
+  katana::ReportStatSingle(
+      "ConnectedComponents-InsertEdges", "Merged", absorbed.size());
+  return MarkIndexPersistent(pg, property_name, index_property_prefix);
+}
+
+katana::Result<std::vector<uint32_t>>
+katana::analytics::ConnectedComponentMembers(
+    PropertyGraph* pg, const std::string& index_property_prefix,
+    uint64_t component) {
+  using Graph = katana::TypedPropertyGraph<
+      std::tuple<NextMember, ComponentSize>, std::tuple<>>;
+  auto graph_result = Graph::Make(
+      pg,
+      {NextMemberPropertyName(index_property_prefix),
+       ComponentSizePropertyName(index_property_prefix)},
+      {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+
+  if (component >= graph.size() ||
+      graph.GetData<ComponentSize>(component) == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "{} is not a component id",
+        component);
+  }
+  std::vector<uint32_t> members;
+  members.reserve(graph.GetData<ComponentSize>(component));
+  uint32_t n = component;
+  do {
+    members.emplace_back(n);
+    n = graph.GetData<NextMember>(n);
+  } while (n != component);
+  return members;
+}
+
 katana::Result<ConnectedComponentsStatistics>
 katana::analytics::ConnectedComponentsStatistics::Compute(
     katana::PropertyGraph* pg, const std::string& property_name) {
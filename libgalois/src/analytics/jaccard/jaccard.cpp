@@ -19,8 +19,12 @@
 
 #include "katana/analytics/jaccard/jaccard.h"
 
+#include <numeric>
+
+#include "katana/DynamicBitset.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/SortedIntersection.h"
 #include "katana/analytics/Utils.h"
 
 using namespace katana::analytics;
@@ -35,50 +39,41 @@ namespace {
 
 struct IntersectWithSortedEdgeList {
 private:
-  const GNode base_;
-  const Graph& graph_;
+  const katana::GraphTopology& topology_;
+  const GNode* base_begin_;
+  size_t base_size_;
 
 public:
   IntersectWithSortedEdgeList(const Graph& graph, GNode base)
-      : base_(base), graph_(graph) {}
+      : topology_(graph.GetPropertyGraph().topology()) {
+    auto [begin, end] = topology_.edge_dests(base);
+    base_begin_ = begin;
+    base_size_ = end - begin;
+  }
 
   uint32_t operator()(GNode n2) {
-    uint32_t intersection_size = 0;
-    // Iterate over the edges of both n2 and base in sync, based on the
-    // assumption that edges lists are sorted.
-    auto edges_n2_iter = graph_.edge_begin(n2);
-    auto edges_n2_end = graph_.edge_end(n2);
-    auto edges_base_iter = graph_.edge_begin(base_);
-    auto edges_base_end = graph_.edge_end(base_);
-    while (edges_n2_iter != edges_n2_end && edges_base_iter != edges_base_end) {
-      auto edge_n2_dst = graph_.GetEdgeDest(*edges_n2_iter);
-      auto edge_base_dst = graph_.GetEdgeDest(*edges_base_iter);
-      if (edge_n2_dst == edge_base_dst) {
-        intersection_size++;
-        edges_n2_iter++;
-        edges_base_iter++;
-      } else if (edge_n2_dst > edge_base_dst) {
-        edges_base_iter++;
-      } else if (edge_n2_dst < edge_base_dst) {
-        edges_n2_iter++;
-      }
-    }
-    return intersection_size;
+    // Intersect the edges of n2 and base, based on the assumption that edges
+    // lists are sorted.
+    auto [n2_begin, n2_end] = topology_.edge_dests(n2);
+    return katana::analytics::SortedIntersectionSize(
+        base_begin_, base_size_, n2_begin, n2_end - n2_begin);
   }
 };
 
 struct IntersectWithUnsortedEdgeList {
 private:
-  std::unordered_set<GNode> base_neighbors;
+  katana::DynamicBitset base_neighbors;
   const Graph& graph_;
 
 public:
   IntersectWithUnsortedEdgeList(const Graph& graph, GNode base)
       : graph_(graph) {
-    // Collect all the neighbors of the base node into a hash set.
+    // Collect all the neighbors of the base node into a bitset, which is
+    // cheaper to probe than a hash set.
+    base_neighbors.resize(graph.size());
     for (const auto& e : graph.edges(base)) {
       auto dest = graph.GetEdgeDest(e);
-      base_neighbors.emplace(*dest);
+      base_neighbors.set(*dest);
     }
   }
 
@@ -86,7 +81,7 @@ public:
     uint32_t intersection_size = 0;
     for (const auto& e : graph_.edges(n2)) {
       auto neighbor = graph_.GetEdgeDest(e);
-      if (base_neighbors.count(*neighbor) > 0)
+      if (base_neighbors.test(*neighbor))
         intersection_size++;
     }
     return intersection_size;
@@ -171,6 +166,190 @@ katana::analytics::Jaccard(
   return r;
 }
 
+namespace {
+
+/// The per-thread state of JaccardTopK
+struct TopKScratch {
+  /// The number of neighbors shared with the current node, by node
+  std::vector<uint32_t> intersection_sizes;
+  /// The nodes with nonzero intersection_sizes
+  std::vector<uint32_t> touched;
+  /// The similarity of each touched node
+  std::vector<std::pair<double, uint32_t>> candidates;
+};
+
+/// More similar first, and smaller nodes first among equally similar ones
+bool
+MoreSimilar(
+    const std::pair<double, uint32_t>& a,
+    const std::pair<double, uint32_t>& b) {
+  return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+/// Find the k nodes most similar to node and write them to top, most similar
+/// first. \returns how many were written, which is less than k when fewer
+/// nodes share a neighbor with node.
+size_t
+FindTopK(
+    const katana::GraphTopology& topology, uint32_t node, uint32_t k,
+    TopKScratch* scratch, std::pair<double, uint32_t>* top) {
+  if (scratch->intersection_sizes.empty()) {
+    scratch->intersection_sizes.resize(topology.num_nodes(), 0);
+  }
+  auto& sizes = scratch->intersection_sizes;
+  auto& touched = scratch->touched;
+  auto& candidates = scratch->candidates;
+
+  // Count the shared neighbors through the wedges node -> dest <- other
+  for (const auto& e : topology.edges(node)) {
+    auto dest = topology.edge_dest(e);
+    for (const auto& in_e : topology.in_edges(dest)) {
+      auto other = topology.in_edge_src(in_e);
+      if (other == node) {
+        continue;
+      }
+      if (sizes[other]++ == 0) {
+        touched.emplace_back(other);
+      }
+    }
+  }
+
+  uint64_t node_size = topology.edges(node).size();
+  candidates.clear();
+  for (auto other : touched) {
+    uint64_t intersection_size = sizes[other];
+    uint64_t union_size =
+        node_size + topology.edges(other).size() - intersection_size;
+    candidates.emplace_back(
+        static_cast<double>(intersection_size) / union_size, other);
+    sizes[other] = 0;
+  }
+  touched.clear();
+
+  size_t num_top = std::min<size_t>(k, candidates.size());
+  std::partial_sort(
+      candidates.begin(), candidates.begin() + num_top, candidates.end(),
+      MoreSimilar);
+  std::copy(candidates.begin(), candidates.begin() + num_top, top);
+  return num_top;
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::JaccardTopK(
+    katana::PropertyGraph* pg, uint32_t k,
+    const std::string& output_property_name,
+    const std::vector<uint32_t>& nodes) {
+  if (k == 0) {
+    return KATANA_ERROR(katana::ErrorCode::InvalidArgument, "k must be > 0");
+  }
+  if (pg->GetNodeProperty(output_property_name)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AlreadyExists, "property {} already exists",
+        output_property_name);
+  }
+  const uint64_t num_nodes = pg->num_nodes();
+
+  std::vector<uint32_t> batch = nodes;
+  if (batch.empty()) {
+    batch.resize(num_nodes);
+    std::iota(batch.begin(), batch.end(), 0);
+  }
+  katana::DynamicBitset in_batch;
+  in_batch.resize(num_nodes);
+  for (auto n : batch) {
+    if (n >= num_nodes || in_batch.set(n)) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "node {} is out of range or repeated", n);
+    }
+  }
+
+  if (auto res = pg->PopulateInEdges(); !res) {
+    return res.error();
+  }
+  const auto& topology = pg->topology();
+
+  katana::ReportPageAllocGuard page_alloc;
+
+  katana::StatTimer exec_time("JaccardTopK");
+  exec_time.start();
+
+  // Each node of the batch gets k slots, of which the first top_sizes[i] are
+  // filled
+  katana::LargeArray<std::pair<double, uint32_t>> top;
+  top.allocateBlocked(batch.size() * k);
+  std::vector<uint32_t> top_sizes(batch.size());
+  katana::PerThreadStorage<TopKScratch> scratch;
+
+  katana::do_all(
+      katana::iterate(size_t{0}, batch.size()),
+      [&](size_t i) {
+        top_sizes[i] = FindTopK(
+            topology, batch[i], k, scratch.getLocal(), top.data() + i * k);
+      },
+      katana::steal(), katana::loopname("JaccardTopK"));
+
+  exec_time.stop();
+
+  // Compact the slots into one list per node of the graph
+  std::vector<uint32_t> list_sizes(num_nodes, 0);
+  for (size_t i = 0; i < batch.size(); ++i) {
+    list_sizes[batch[i]] = top_sizes[i];
+  }
+  std::vector<int64_t> offsets(num_nodes + 1, 0);
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    offsets[n + 1] = offsets[n] + list_sizes[n];
+  }
+  std::vector<uint32_t> flat_nodes(offsets[num_nodes]);
+  std::vector<double> flat_similarities(offsets[num_nodes]);
+  katana::do_all(
+      katana::iterate(size_t{0}, batch.size()),
+      [&](size_t i) {
+        int64_t offset = offsets[batch[i]];
+        for (uint32_t j = 0; j < top_sizes[i]; ++j) {
+          flat_similarities[offset + j] = top[i * k + j].first;
+          flat_nodes[offset + j] = top[i * k + j].second;
+        }
+      },
+      katana::no_stats());
+
+  arrow::Int64Builder offsets_builder;
+  arrow::UInt32Builder nodes_builder;
+  arrow::DoubleBuilder similarities_builder;
+  std::shared_ptr<arrow::Array> offsets_array;
+  std::shared_ptr<arrow::Array> nodes_array;
+  std::shared_ptr<arrow::Array> similarities_array;
+  if (!offsets_builder.AppendValues(offsets).ok() ||
+      !offsets_builder.Finish(&offsets_array).ok() ||
+      !nodes_builder.AppendValues(flat_nodes).ok() ||
+      !nodes_builder.Finish(&nodes_array).ok() ||
+      !similarities_builder.AppendValues(flat_similarities).ok() ||
+      !similarities_builder.Finish(&similarities_array).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  auto entries = arrow::StructArray::Make(
+      {nodes_array, similarities_array},
+      std::vector<std::string>{
+          kJaccardTopKNodeField, kJaccardTopKSimilarityField});
+  if (!entries.ok()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "{}", entries.status().ToString());
+  }
+  auto lists = arrow::LargeListArray::FromArrays(*offsets_array, **entries);
+  if (!lists.ok()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "{}", lists.status().ToString());
+  }
+
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(output_property_name, (*lists)->type())}),
+      {*lists});
+  return pg->AddNodeProperties(table);
+}
+
 constexpr static const double EPSILON = 1e-6;
 
 katana::Result<void>
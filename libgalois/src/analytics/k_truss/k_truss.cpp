@@ -21,6 +21,7 @@
 
 #include "katana/ArrowRandomAccessBuilder.h"
 #include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/SortedIntersection.h"
 
 using namespace katana::analytics;
 
@@ -92,38 +93,24 @@ IsValidDegreeNoLessThanJ(const Graph& g, GNode n, unsigned int j) {
  */
 bool
 IsSupportNoLessThanJ(const Graph& g, GNode src, GNode dest, unsigned int j) {
-  size_t numValidEqual = 0;
-  auto srcI = g.edge_begin(src), srcE = g.edge_end(src),
-       dstI = g.edge_begin(dest), dstE = g.edge_end(dest);
-
-  while (true) {
-    //! Find the first valid edge.
-    while (srcI != srcE && (g.GetEdgeData<EdgeFlag>(srcI) & removed)) {
-      ++srcI;
-    }
-    while (dstI != dstE && (g.GetEdgeData<EdgeFlag>(dstI) & removed)) {
-      ++dstI;
-    }
-
-    if (srcI == srcE || dstI == dstE) {
-      return numValidEqual >= j;
-    }
+  const auto& topology = g.GetPropertyGraph().topology();
+  auto [src_begin, src_end] = topology.edge_dests(src);
+  auto [dst_begin, dst_end] = topology.edge_dests(dest);
+  auto srcI = g.edge_begin(src), dstI = g.edge_begin(dest);
 
-    //! Check for intersection.
-    auto sN = *g.GetEdgeDest(srcI), dN = *g.GetEdgeDest(dstI);
-    if (sN < dN) {
-      ++srcI;
-    } else if (dN < sN) {
-      ++dstI;
-    } else {
-      numValidEqual += 1;
-      if (numValidEqual >= j) {
-        return true;
-      }
-      ++srcI;
-      ++dstI;
-    }
-  }
+  //! Count the common neighbors through edges that are both valid, stopping
+  //! as soon as there are j of them.
+  size_t numValidEqual = 0;
+  katana::analytics::ForEachSortedIntersection(
+      src_begin, src_end - src_begin, dst_begin, dst_end - dst_begin,
+      [&](size_t i, size_t k) {
+        if ((g.GetEdgeData<EdgeFlag>(srcI + i) & removed) ||
+            (g.GetEdgeData<EdgeFlag>(dstI + k) & removed)) {
+          return true;
+        }
+        numValidEqual += 1;
+        return numValidEqual < j;
+      });
 
   return numValidEqual >= j;
 }
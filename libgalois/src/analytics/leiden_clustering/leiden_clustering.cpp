@@ -0,0 +1,727 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/leiden_clustering/leiden_clustering.h"
+
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/ClusteringImplementationBase.h"
+#include "katana/analytics/louvain_clustering/louvain_clustering.h"
+
+using namespace katana::analytics;
+namespace {
+
+template <typename EdgeWeightType>
+struct LeidenClusteringImplementation
+    : public katana::analytics::ClusteringImplementationBase<
+          katana::TypedPropertyGraph<
+              std::tuple<
+                  PreviousCommunityId, CurrentCommunityId,
+                  DegreeWeight<EdgeWeightType>>,
+              std::tuple<EdgeWeight<EdgeWeightType>>>,
+          EdgeWeightType, CommunityType<EdgeWeightType>> {
+  using NodeData = std::tuple<
+      PreviousCommunityId, CurrentCommunityId, DegreeWeight<EdgeWeightType>>;
+  using EdgeData = std::tuple<EdgeWeight<EdgeWeightType>>;
+  using CommTy = CommunityType<EdgeWeightType>;
+  using CommunityArray = katana::LargeArray<CommTy>;
+
+  using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+  using GNode = typename Graph::Node;
+
+  using Base = katana::analytics::ClusteringImplementationBase<
+      Graph, EdgeWeightType, CommTy>;
+
+  /**
+   * Moves nodes between clusters, starting from the clusters in initial, as
+   * long as the modularity improves by modularity_threshold_per_round.
+   * The resulting clusters are left in CurrentCommunityId.
+   */
+  katana::Result<double> LocalMove(
+      katana::PropertyGraph* pfg, const katana::LargeArray<uint64_t>& initial,
+      double lower, double modularity_threshold_per_round, uint32_t& iter) {
+    katana::StatTimer TimerLocalMove("Timer_Local_Move");
+    katana::TimerGuard TimerLocalMoveGuard(TimerLocalMove);
+
+    auto graph_result = Graph::Make(pfg);
+    if (!graph_result) {
+      return graph_result.error();
+    }
+    Graph graph = graph_result.value();
+
+    CommunityArray c_info;  // Community info
+
+    /* Variables needed for Modularity calculation */
+    double constant_for_second_term;
+    double prev_mod = lower;
+    double curr_mod = -1;
+    uint32_t num_iter = iter;
+
+    /*** Initialization ***/
+    c_info.allocateBlocked(graph.num_nodes());
+
+    /* Calculate the weighted degree sum for each vertex */
+    Base::template SumVertexDegreeWeight<EdgeWeightType>(&graph, c_info);
+
+    /* Start from the given clusters rather than from singletons */
+    katana::do_all(katana::iterate(graph), [&](GNode n) {
+      c_info[n].degree_wt = 0;
+      c_info[n].size = 0;
+    });
+    katana::do_all(katana::iterate(graph), [&](GNode n) {
+      graph.template GetData<CurrentCommunityId>(n) = initial[n];
+      graph.template GetData<PreviousCommunityId>(n) = initial[n];
+      katana::atomicAdd(
+          c_info[initial[n]].degree_wt,
+          graph.template GetData<DegreeWeight<EdgeWeightType>>(n));
+      katana::atomicAdd(c_info[initial[n]].size, (uint64_t)1);
+    });
+
+    /* Compute the total weight (2m) and 1/2m terms */
+    constant_for_second_term =
+        Base::template CalConstantForSecondTerm<EdgeWeightType>(graph);
+
+    katana::PerThreadStorage<NeighborClusterAccumulator<EdgeWeightType>>
+        cluster_accumulators;
+
+    while (true) {
+      num_iter++;
+
+      katana::do_all(
+          katana::iterate(graph),
+          [&](GNode n) {
+            auto& n_data_curr_comm_id =
+                graph.template GetData<CurrentCommunityId>(n);
+            auto& n_data_degree_wt =
+                graph.template GetData<DegreeWeight<EdgeWeightType>>(n);
+
+            if (graph.edge_begin(n) == graph.edge_end(n)) {
+              return;
+            }
+
+            // Edge weight to each neighboring cluster
+            auto& clusters = *cluster_accumulators.getLocal();
+            EdgeWeightType self_loop_wt = 0;
+            Base::template FindNeighboringClusters<EdgeWeightType>(
+                graph, n, &clusters, self_loop_wt);
+            // Find the max gain in modularity
+            uint64_t local_target = Base::MaxModularityWithoutSwaps(
+                clusters, self_loop_wt, c_info, n_data_degree_wt,
+                n_data_curr_comm_id, constant_for_second_term);
+
+            /* Update cluster info */
+            if (local_target != n_data_curr_comm_id &&
+                local_target != Base::UNASSIGNED) {
+              katana::atomicAdd(
+                  c_info[local_target].degree_wt, n_data_degree_wt);
+              katana::atomicAdd(c_info[local_target].size, (uint64_t)1);
+              katana::atomicSub(
+                  c_info[n_data_curr_comm_id].degree_wt, n_data_degree_wt);
+              katana::atomicSub(c_info[n_data_curr_comm_id].size, (uint64_t)1);
+
+              /* Set the new cluster id */
+              n_data_curr_comm_id = local_target;
+            }
+          },
+          katana::loopname("leiden algo: Local Move"));
+
+      /* Calculate the overall modularity */
+      double e_xx = 0;
+      double a2_x = 0;
+
+      curr_mod = Base::template CalModularity<EdgeWeightType>(
+          graph, c_info, e_xx, a2_x, constant_for_second_term);
+
+      if ((curr_mod - prev_mod) < modularity_threshold_per_round) {
+        prev_mod = curr_mod;
+        break;
+      }
+
+      prev_mod = curr_mod;
+    }  // End while
+
+    iter = num_iter;
+    return prev_mod;
+  }
+
+  /**
+   * Splits each cluster in CurrentCommunityId into sub-clusters that are
+   * well connected, storing the sub-cluster of each node in refined.
+   *
+   * Every node starts in a sub-cluster of its own. Within a cluster C, a node
+   * v that is still alone and well connected to the rest of C joins the
+   * neighboring sub-cluster S of C with the largest modularity gain, among
+   * those sub-clusters that are themselves well connected to the rest of C.
+   * A set X of C is well connected when the weight of the edges between X and
+   * C - X is at least a_X * (a_C - a_X) / 2m, where a is the degree weight.
+   * Clusters are refined in parallel and the nodes of a cluster serially.
+   */
+  void Refine(
+      const Graph& graph, katana::LargeArray<uint64_t>* refined,
+      double constant_for_second_term) {
+    katana::StatTimer TimerRefine("Timer_Refine");
+    katana::TimerGuard TimerRefineGuard(TimerRefine);
+
+    uint64_t num_nodes = graph.num_nodes();
+
+    std::vector<std::vector<GNode>> cluster_bags(num_nodes);
+    for (GNode n = 0; n < num_nodes; ++n) {
+      cluster_bags[graph.template GetData<CurrentCommunityId>(n)].push_back(n);
+    }
+
+    // Indexed by the node each sub-cluster started from
+    katana::LargeArray<uint64_t> sub_size;
+    katana::LargeArray<EdgeWeightType> sub_degree_wt;
+    // Weight of the edges from a sub-cluster to the rest of its cluster
+    katana::LargeArray<EdgeWeightType> sub_external_wt;
+    sub_size.allocateBlocked(num_nodes);
+    sub_degree_wt.allocateBlocked(num_nodes);
+    sub_external_wt.allocateBlocked(num_nodes);
+
+    katana::PerThreadStorage<NeighborClusterAccumulator<EdgeWeightType>>
+        accumulators;
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t c) {
+          const auto& bag = cluster_bags[c];
+          double cluster_degree_wt = 0;
+          for (GNode n : bag) {
+            (*refined)[n] = n;
+            sub_size[n] = 1;
+            sub_degree_wt[n] =
+                graph.template GetData<DegreeWeight<EdgeWeightType>>(n);
+            cluster_degree_wt += sub_degree_wt[n];
+
+            EdgeWeightType external_wt = 0;
+            for (auto ii = graph.edge_begin(n); ii != graph.edge_end(n);
+                 ++ii) {
+              auto dst = graph.GetEdgeDest(ii);
+              if (*dst != n &&
+                  graph.template GetData<CurrentCommunityId>(dst) == c) {
+                external_wt +=
+                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii);
+              }
+            }
+            sub_external_wt[n] = external_wt;
+          }
+          if (bag.size() <= 1) {
+            return;
+          }
+
+          auto& clusters = *accumulators.getLocal();
+          for (GNode n : bag) {
+            if ((*refined)[n] != n || sub_size[n] != 1) {
+              continue;
+            }
+            double n_degree_wt = sub_degree_wt[n];
+            if (sub_external_wt[n] < n_degree_wt *
+                                         (cluster_degree_wt - n_degree_wt) *
+                                         constant_for_second_term) {
+              continue;
+            }
+
+            clusters.Clear();
+            for (auto ii = graph.edge_begin(n); ii != graph.edge_end(n);
+                 ++ii) {
+              auto dst = graph.GetEdgeDest(ii);
+              if (*dst != n &&
+                  graph.template GetData<CurrentCommunityId>(dst) == c) {
+                clusters.Add(
+                    (*refined)[*dst],
+                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(
+                        ii));
+              }
+            }
+
+            uint64_t max_index = n;
+            double max_gain = 0;
+            EdgeWeightType max_wt = 0;
+            for (size_t i = 0; i < clusters.size(); ++i) {
+              uint64_t sub = clusters.cluster(i);
+              double a_sub = sub_degree_wt[sub];
+              if (sub_external_wt[sub] < a_sub *
+                                             (cluster_degree_wt - a_sub) *
+                                             constant_for_second_term) {
+                continue;
+              }
+              // Proportional to the modularity gain of the move
+              double cur_gain = clusters.weight(i) -
+                                n_degree_wt * a_sub * constant_for_second_term;
+              if ((cur_gain > max_gain) ||
+                  ((cur_gain == max_gain) && (cur_gain != 0) &&
+                   (sub < max_index))) {
+                max_gain = cur_gain;
+                max_index = sub;
+                max_wt = clusters.weight(i);
+              }
+            }
+
+            if (max_index != n) {
+              sub_external_wt[max_index] =
+                  sub_external_wt[max_index] + sub_external_wt[n] - 2 * max_wt;
+              sub_degree_wt[max_index] += sub_degree_wt[n];
+              sub_size[max_index] += 1;
+              sub_size[n] = 0;
+              (*refined)[n] = max_index;
+            }
+          }
+        },
+        katana::steal(), katana::loopname("leiden algo: Refine"));
+  }
+
+  /**
+   * Splits every cluster in CurrentCommunityId into its connected parts.
+   * Refine only merges a node into a neighboring sub-cluster, so the nodes of
+   * every level are connected and so are the clusters this leaves.
+   */
+  void SplitDisconnectedClusters(Graph* graph) {
+    uint64_t num_nodes = graph->num_nodes();
+
+    std::vector<std::vector<GNode>> cluster_bags(num_nodes);
+    for (GNode n = 0; n < num_nodes; ++n) {
+      uint64_t c = graph->template GetData<CurrentCommunityId>(n);
+      if (c != Base::UNASSIGNED) {
+        cluster_bags[c].push_back(n);
+      }
+    }
+
+    // Each part is labeled with the node it was reached from; every node is
+    // in one cluster, so the searches visit disjoint nodes
+    katana::LargeArray<uint64_t> part;
+    part.allocateBlocked(num_nodes);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](GNode n) { part[n] = Base::UNASSIGNED; });
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t c) {
+          std::vector<GNode> queue;
+          for (GNode start : cluster_bags[c]) {
+            if (part[start] != Base::UNASSIGNED) {
+              continue;
+            }
+            part[start] = start;
+            queue.assign(1, start);
+            for (size_t head = 0; head < queue.size(); ++head) {
+              for (auto ii = graph->edge_begin(queue[head]);
+                   ii != graph->edge_end(queue[head]); ++ii) {
+                auto dst = graph->GetEdgeDest(ii);
+                if (part[*dst] == Base::UNASSIGNED &&
+                    graph->template GetData<CurrentCommunityId>(dst) == c) {
+                  part[*dst] = start;
+                  queue.push_back(*dst);
+                }
+              }
+            }
+          }
+        },
+        katana::steal(),
+        katana::loopname("leiden algo: SplitDisconnectedClusters"));
+
+    katana::do_all(katana::iterate(*graph), [&](GNode n) {
+      if (part[n] != Base::UNASSIGNED) {
+        graph->template GetData<CurrentCommunityId>(n) = part[n];
+      }
+    });
+  }
+
+public:
+  katana::Result<void> LeidenClustering(
+      katana::PropertyGraph* pfg, const std::string& edge_weight_property_name,
+      const std::vector<std::string>& temp_node_property_names,
+      katana::LargeArray<uint64_t>& clusters_orig, LeidenClusteringPlan plan) {
+    /*
+     * Construct temp property graph. This graph gets coarsened as the
+     * computation proceeds.
+     */
+    auto pfg_mutable = std::make_unique<katana::PropertyGraph>();
+    katana::LargeArray<uint64_t> out_indices_next;
+    katana::LargeArray<uint32_t> out_dests_next;
+
+    out_indices_next.allocateInterleaved(pfg->topology().num_nodes());
+    out_dests_next.allocateInterleaved(pfg->topology().num_edges());
+
+    auto topo = std::make_unique<katana::GraphTopology>(
+        std::move(out_indices_next), std::move(out_dests_next));
+
+    if (auto r = pfg_mutable->SetTopology(std::move(topo)); !r) {
+      return r.error();
+    }
+    if (auto result = ConstructNodeProperties<NodeData>(
+            pfg_mutable.get(), temp_node_property_names);
+        !result) {
+      return result.error();
+    }
+    std::vector<std::string> temp_edge_property_names = {
+        "_katana_temporary_property_" + edge_weight_property_name};
+    if (auto result = ConstructEdgeProperties<EdgeData>(
+            pfg_mutable.get(), temp_edge_property_names);
+        !result) {
+      return result.error();
+    }
+
+    if (auto r = Base::CreateDuplicateGraph(
+            pfg, pfg_mutable.get(), edge_weight_property_name,
+            temp_edge_property_names[0]);
+        !r) {
+      return r.error();
+    }
+
+    if (auto result = ConstructNodeProperties<NodeData>(pfg_mutable.get());
+        !result) {
+      return result.error();
+    }
+
+    /*
+     * Each original node is a node of the first level; clusters_orig
+     * tracks the node of the current level it was merged into.
+     */
+    uint64_t num_nodes_orig = clusters_orig.size();
+    katana::do_all(
+        katana::iterate((uint64_t)0, num_nodes_orig),
+        [&](GNode n) { clusters_orig[n] = n; });
+
+    // Cluster of each node of the current level to start the local moves from
+    katana::LargeArray<uint64_t> initial;
+    initial.allocateBlocked(num_nodes_orig);
+    katana::do_all(
+        katana::iterate((uint64_t)0, num_nodes_orig),
+        [&](GNode n) { initial[n] = n; });
+
+    double prev_mod = -1;  // Previous modularity
+    double curr_mod = -1;  // Current modularity
+
+    std::unique_ptr<katana::PropertyGraph> pfg_curr = std::move(pfg_mutable);
+    uint32_t iter = 0;
+    while (true) {
+      iter++;
+
+      auto graph_result = Graph::Make(pfg_curr.get());
+      if (!graph_result) {
+        return graph_result.error();
+      }
+      Graph graph_curr = graph_result.value();
+
+      bool done = graph_curr.num_nodes() <= plan.min_graph_size();
+      if (done) {
+        katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
+          graph_curr.template GetData<CurrentCommunityId>(n) = initial[n];
+        });
+      } else {
+        auto curr_mod_result = LocalMove(
+            pfg_curr.get(), initial, curr_mod,
+            plan.modularity_threshold_per_round(), iter);
+        if (!curr_mod_result) {
+          return curr_mod_result.error();
+        }
+        curr_mod = curr_mod_result.value();
+        done = iter >= plan.max_iterations() ||
+               (curr_mod - prev_mod) <= plan.modularity_threshold_total();
+      }
+
+      katana::LargeArray<uint64_t> cluster_of;
+      cluster_of.allocateBlocked(graph_curr.num_nodes());
+      uint64_t num_refined = graph_curr.num_nodes();
+      if (!done) {
+        katana::LargeArray<uint64_t> refined;
+        refined.allocateBlocked(graph_curr.num_nodes());
+        Refine(
+            graph_curr, &refined,
+            Base::template CalConstantForSecondTerm<EdgeWeightType>(
+                graph_curr));
+
+        // Merge the sub-clusters rather than the clusters
+        katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
+          auto& n_data_curr_comm_id =
+              graph_curr.template GetData<CurrentCommunityId>(n);
+          cluster_of[n] = n_data_curr_comm_id;
+          n_data_curr_comm_id = refined[n];
+        });
+        num_refined = Base::RenumberClustersContiguously(&graph_curr);
+
+        // Refinement merged nothing, so coarsening would not either
+        if (num_refined == graph_curr.num_nodes()) {
+          katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
+            graph_curr.template GetData<CurrentCommunityId>(n) = cluster_of[n];
+          });
+          done = true;
+        }
+      }
+
+      if (done) {
+        // Local moves after the last refinement may have disconnected a
+        // cluster
+        SplitDisconnectedClusters(&graph_curr);
+        Base::RenumberClustersContiguously(&graph_curr);
+        katana::do_all(
+            katana::iterate((uint64_t)0, num_nodes_orig), [&](GNode n) {
+              KATANA_LOG_DEBUG_ASSERT(
+                  clusters_orig[n] < graph_curr.num_nodes());
+              clusters_orig[n] =
+                  graph_curr.template GetData<CurrentCommunityId>(
+                      clusters_orig[n]);
+            });
+        break;
+      }
+
+      katana::do_all(
+          katana::iterate((uint64_t)0, num_nodes_orig), [&](GNode n) {
+            KATANA_LOG_DEBUG_ASSERT(clusters_orig[n] < graph_curr.num_nodes());
+            clusters_orig[n] = graph_curr.template GetData<CurrentCommunityId>(
+                clusters_orig[n]);
+          });
+
+      // Each merged node starts in the cluster its sub-cluster was part of,
+      // renumbered densely
+      katana::LargeArray<uint64_t> initial_next;
+      initial_next.allocateBlocked(num_refined);
+      std::vector<uint64_t> cluster_local_map(
+          graph_curr.num_nodes(), Base::UNASSIGNED);
+      uint64_t num_unique_clusters = 0;
+      for (GNode n = 0; n < graph_curr.num_nodes(); ++n) {
+        auto& local = cluster_local_map[cluster_of[n]];
+        if (local == Base::UNASSIGNED) {
+          local = num_unique_clusters++;
+        }
+        initial_next[graph_curr.template GetData<CurrentCommunityId>(n)] =
+            local;
+      }
+
+      auto coarsened_graph_result =
+          Base::template GraphCoarsening<NodeData, EdgeData, EdgeWeightType>(
+              graph_curr, pfg_curr.get(), num_refined,
+              temp_node_property_names, temp_edge_property_names);
+      if (!coarsened_graph_result) {
+        return coarsened_graph_result.error();
+      }
+
+      pfg_curr = std::move(coarsened_graph_result.value());
+      initial = std::move(initial_next);
+
+      prev_mod = curr_mod;
+    }
+    return katana::ResultSuccess();
+  }
+};
+
+template <typename EdgeWeightType>
+static katana::Result<void>
+LeidenClusteringWithWrap(
+    katana::PropertyGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, LeidenClusteringPlan plan) {
+  static_assert(
+      std::is_integral_v<EdgeWeightType> ||
+      std::is_floating_point_v<EdgeWeightType>);
+
+  std::vector<TemporaryPropertyGuard> temp_node_properties(3);
+  std::generate_n(
+      temp_node_properties.begin(), temp_node_properties.size(),
+      [&]() { return TemporaryPropertyGuard{pfg}; });
+  std::vector<std::string> temp_node_property_names(
+      temp_node_properties.size());
+  std::transform(
+      temp_node_properties.begin(), temp_node_properties.end(),
+      temp_node_property_names.begin(),
+      [](const TemporaryPropertyGuard& p) { return p.name(); });
+
+  using Impl = LeidenClusteringImplementation<EdgeWeightType>;
+  if (auto result = ConstructNodeProperties<typename Impl::NodeData>(
+          pfg, temp_node_property_names);
+      !result) {
+    return result.error();
+  }
+
+  /*
+   * To keep track of communities for nodes in the original graph.
+   */
+  katana::LargeArray<uint64_t> clusters_orig;
+  clusters_orig.allocateBlocked(pfg->num_nodes());
+
+  LeidenClusteringImplementation<EdgeWeightType> impl{};
+  if (auto r = impl.LeidenClustering(
+          pfg, edge_weight_property_name, temp_node_property_names,
+          clusters_orig, plan);
+      !r) {
+    return r.error();
+  }
+
+  if (auto r = ConstructNodeProperties<std::tuple<CurrentCommunityId>>(
+          pfg, {output_property_name});
+      !r) {
+    return r.error();
+  }
+
+  auto graph_result =
+      katana::TypedPropertyGraph<std::tuple<CurrentCommunityId>, std::tuple<>>::
+          Make(pfg, {output_property_name}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t i) {
+        graph.GetData<CurrentCommunityId>(i) = clusters_orig[i];
+      },
+      katana::loopname("Add clusterIds"), katana::no_stats());
+
+  return katana::ResultSuccess();
+}
+
+}  // anonymous namespace
+
+katana::Result<void>
+katana::analytics::LeidenClustering(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, LeidenClusteringPlan plan) {
+  switch (pg->GetEdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return LeidenClusteringWithWrap<uint32_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int32Type::type_id:
+    return LeidenClusteringWithWrap<int32_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::UInt64Type::type_id:
+    return LeidenClusteringWithWrap<uint64_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int64Type::type_id:
+    return LeidenClusteringWithWrap<int64_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::FloatType::type_id:
+    return LeidenClusteringWithWrap<float>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::DoubleType::type_id:
+    return LeidenClusteringWithWrap<double>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+/// \cond DO_NOT_DOCUMENT
+katana::Result<void>
+katana::analytics::LeidenClusteringAssertValid(
+    katana::PropertyGraph* pg,
+    [[maybe_unused]] const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  auto clusters_result = pg->GetNodePropertyTyped<uint64_t>(property_name);
+  if (!clusters_result) {
+    return clusters_result.error();
+  }
+  const uint64_t* clusters = clusters_result.value()->raw_values();
+  const auto& topology = pg->topology();
+  uint64_t num_nodes = topology.num_nodes();
+
+  // Bucket the nodes by cluster; nodes without edges are in none
+  constexpr uint64_t kUnassigned =
+      LeidenClusteringImplementation<double>::UNASSIGNED;
+  std::vector<uint64_t> cluster_offsets(num_nodes + 1, 0);
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    if (clusters[n] == kUnassigned) {
+      continue;
+    }
+    if (clusters[n] >= num_nodes) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed,
+          "node {} has cluster {} but there are {} nodes", n, clusters[n],
+          num_nodes);
+    }
+    ++cluster_offsets[clusters[n] + 1];
+  }
+  std::partial_sum(
+      cluster_offsets.begin(), cluster_offsets.end(), cluster_offsets.begin());
+  std::vector<uint32_t> members(num_nodes);
+  std::vector<uint64_t> next_member(
+      cluster_offsets.begin(), cluster_offsets.end() - 1);
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    if (clusters[n] != kUnassigned) {
+      members[next_member[clusters[n]]++] = n;
+    }
+  }
+
+  // BFS each cluster from its first member through its own members only;
+  // every node is in one cluster, so the searches visit disjoint nodes
+  std::vector<uint8_t> visited(num_nodes, 0);
+  katana::GAccumulator<uint64_t> num_disconnected;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t cluster) {
+        uint64_t size = cluster_offsets[cluster + 1] - cluster_offsets[cluster];
+        if (size == 0) {
+          return;
+        }
+        std::vector<uint32_t> queue{members[cluster_offsets[cluster]]};
+        visited[queue.front()] = 1;
+        for (size_t head = 0; head < queue.size(); ++head) {
+          for (auto e : topology.edges(queue[head])) {
+            auto dest = topology.edge_dest(e);
+            if (clusters[dest] == cluster && !visited[dest]) {
+              visited[dest] = 1;
+              queue.push_back(dest);
+            }
+          }
+        }
+        if (queue.size() != size) {
+          num_disconnected += 1;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  if (num_disconnected.reduce() != 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed, "{} clusters are disconnected",
+        num_disconnected.reduce());
+  }
+  return katana::ResultSuccess();
+}
+/// \endcond
+
+void
+katana::analytics::LeidenClusteringStatistics::Print(std::ostream& os) const {
+  os << "Total number of clusters = " << n_clusters << std::endl;
+  os << "Total number of non trivial clusters = " << n_non_trivial_clusters
+     << std::endl;
+  os << "Number of nodes in the largest cluster = " << largest_cluster_size
+     << std::endl;
+  os << "Ratio of nodes in the largest cluster = " << largest_cluster_proportion
+     << std::endl;
+  os << "Leiden modularity = " << modularity << std::endl;
+}
+
+katana::Result<katana::analytics::LeidenClusteringStatistics>
+katana::analytics::LeidenClusteringStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  // The clusters are stored as Louvain stores them, so are summarized alike
+  auto stats_result = LouvainClusteringStatistics::Compute(
+      pg, edge_weight_property_name, property_name);
+  if (!stats_result) {
+    return stats_result.error();
+  }
+  auto stats = stats_result.value();
+  return LeidenClusteringStatistics{
+      stats.n_clusters, stats.n_non_trivial_clusters,
+      stats.largest_cluster_size, stats.largest_cluster_proportion,
+      stats.modularity};
+}
@@ -19,13 +19,42 @@
 
 #include "katana/analytics/local_clustering_coefficient/local_clustering_coefficient.h"
 
+#include <cmath>
+#include <random>
+
 #include "katana/AtomicHelpers.h"
+#include "katana/analytics/SortedIntersection.h"
+#include "katana/analytics/WedgeSampling.h"
 
 using namespace katana::analytics;
 
 namespace {
 constexpr static const unsigned kChunkSize = 64U;
 
+/// Call fn(v, common, num_common) for each neighbor v <= n of n, where common
+/// holds the num_common neighbors vv <= v of v that are also neighbors of n,
+/// so that each (n, v, vv) is a triangle. buffer is scratch space.
+template <typename Fn>
+void
+ForEachOrderedTriangle(
+    const katana::GraphTopology& topology, uint32_t n,
+    std::vector<uint32_t>* buffer, Fn fn) {
+  auto [n_begin, n_end] = topology.edge_dests(n);
+  for (const uint32_t* it_v = n_begin; it_v != n_end && *it_v <= n; ++it_v) {
+    uint32_t v = *it_v;
+    auto [v_begin, v_end] = topology.edge_dests(v);
+    const uint32_t* v_prefix_end = std::upper_bound(v_begin, v_end, v);
+    size_t n_prefix_size = it_v + 1 - n_begin;
+    buffer->resize(n_prefix_size);
+    size_t num_common = katana::analytics::SortedIntersection(
+        n_begin, n_prefix_size, v_begin, v_prefix_end - v_begin,
+        buffer->data());
+    if (num_common > 0) {
+      fn(v, buffer->data(), num_common);
+    }
+  }
+}
+
 struct LocalClusteringCoefficientAtomics {
   struct NodeTriangleCount : public katana::AtomicPODProperty<uint64_t> {};
 
@@ -47,32 +76,20 @@ struct LocalClusteringCoefficientAtomics {
  * triangles. It assumes that edgelist of each node
  * is sorted.
  */
-  void OrderedCountFunc(Graph* graph, Node n) {
-    for (auto it_v : graph->edges(n)) {
-      auto v = *graph->GetEdgeDest(it_v);
-      if (v > n) {
-        break;
-      }
-      Graph::edge_iterator it_n = graph->edges(n).begin();
-
-      for (auto it_vv : graph->edges(v)) {
-        auto vv = *graph->GetEdgeDest(it_vv);
-        if (vv > v) {
-          break;
-        }
-        while (*graph->GetEdgeDest(it_n) < vv) {
-          it_n++;
-        }
-        if (vv == *graph->GetEdgeDest(it_n)) {
-          katana::atomicAdd<uint64_t>(
-              graph->GetData<NodeTriangleCount>(n), (uint64_t)1);
+  void OrderedCountFunc(
+      Graph* graph, Node n, std::vector<uint32_t>* intersection) {
+    ForEachOrderedTriangle(
+        graph->GetPropertyGraph().topology(), n, intersection,
+        [&](Node v, const uint32_t* common, size_t num_common) {
           katana::atomicAdd<uint64_t>(
-              graph->GetData<NodeTriangleCount>(v), (uint64_t)1);
+              graph->GetData<NodeTriangleCount>(n), num_common);
           katana::atomicAdd<uint64_t>(
-              graph->GetData<NodeTriangleCount>(vv), (uint64_t)1);
-        }
-      }
-    }
+              graph->GetData<NodeTriangleCount>(v), num_common);
+          for (size_t i = 0; i < num_common; ++i) {
+            katana::atomicAdd<uint64_t>(
+                graph->GetData<NodeTriangleCount>(common[i]), (uint64_t)1);
+          }
+        });
   }
 
   /*
@@ -81,9 +98,12 @@ struct LocalClusteringCoefficientAtomics {
  * This uses an atomic implementation.
  */
   void OrderedCountAlgo(Graph* graph) {
+    katana::PerThreadStorage<std::vector<uint32_t>> intersections;
     katana::do_all(
         katana::iterate(*graph),
-        [&](const Node& n) { OrderedCountFunc(graph, n); },
+        [&](const Node& n) {
+          OrderedCountFunc(graph, n, intersections.getLocal());
+        },
         katana::chunk_size<kChunkSize>(), katana::steal(), katana::no_stats(),
         katana::loopname("TriangleCount_OrderedCountAlgo"));
   }
@@ -156,29 +176,17 @@ struct LocalClusteringCoefficientPerThread {
  * is sorted.
  */
   void OrderedCountFunc(
-      Graph* graph, Node n, std::vector<uint64_t>* node_triangle_count) {
-    for (auto it_v : graph->edges(n)) {
-      auto v = *graph->GetEdgeDest(it_v);
-      if (v > n) {
-        break;
-      }
-      Graph::edge_iterator it_n = graph->edges(n).begin();
-
-      for (auto it_vv : graph->edges(v)) {
-        auto vv = *graph->GetEdgeDest(it_vv);
-        if (vv > v) {
-          break;
-        }
-        while (*graph->GetEdgeDest(it_n) < vv) {
-          it_n++;
-        }
-        if (vv == *graph->GetEdgeDest(it_n)) {
-          (*node_triangle_count)[n] += 1;
-          (*node_triangle_count)[v] += 1;
-          (*node_triangle_count)[vv] += 1;
-        }
-      }
-    }
+      Graph* graph, Node n, std::vector<uint64_t>* node_triangle_count,
+      std::vector<uint32_t>* intersection) {
+    ForEachOrderedTriangle(
+        graph->GetPropertyGraph().topology(), n, intersection,
+        [&](Node v, const uint32_t* common, size_t num_common) {
+          (*node_triangle_count)[n] += num_common;
+          (*node_triangle_count)[v] += num_common;
+          for (size_t i = 0; i < num_common; ++i) {
+            (*node_triangle_count)[common[i]] += 1;
+          }
+        });
   }
 
   /*
@@ -197,11 +205,13 @@ struct LocalClusteringCoefficientPerThread {
           per_thread_node_triangle_count.getRemote(tid)->resize(num_nodes, 0);
         });
 
+    katana::PerThreadStorage<std::vector<uint32_t>> intersections;
     katana::do_all(
         katana::iterate(*graph),
         [&](const Node& n) {
           OrderedCountFunc(
-              graph, n, &(*per_thread_node_triangle_count.getLocal()));
+              graph, n, &(*per_thread_node_triangle_count.getLocal()),
+              intersections.getLocal());
         },
         katana::chunk_size<kChunkSize>(), katana::steal(),
         katana::loopname("TriangleCount_OrderedCountAlgo"));
@@ -270,6 +280,103 @@ struct LocalClusteringCoefficientPerThread {
     return katana::ResultSuccess();
   }
 };
+
+struct LocalClusteringCoefficientWedgeSampling {
+  struct NodeClusteringCoefficient : public katana::PODProperty<double> {};
+
+  using NodeData = typename std::tuple<NodeClusteringCoefficient>;
+  using EdgeData = typename std::tuple<>;
+
+  typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
+
+  typedef typename Graph::Node Node;
+
+  /**
+   * The coefficient of a node with few enough wedges to count them all: each
+   * neighbor u closes as many wedges as it has neighbors in common with n,
+   * and each closed wedge is counted from both of its ends.
+   */
+  static double ExactCoefficient(
+      const katana::GraphTopology& topology, Node n) {
+    auto [n_begin, n_end] = topology.edge_dests(n);
+    uint64_t degree = n_end - n_begin;
+    uint64_t closed = 0;
+    for (const Node* it_u = n_begin; it_u != n_end; ++it_u) {
+      auto [u_begin, u_end] = topology.edge_dests(*it_u);
+      closed += katana::analytics::SortedIntersectionSize(
+          n_begin, degree, u_begin, u_end - u_begin);
+    }
+    return ((double)closed) / (degree * (degree - 1));
+  }
+
+  katana::Result<void> operator()(
+      katana::PropertyGraph* pg, const std::string& output_property_name,
+      double absolute_error, double confidence, uint64_t seed) {
+    if (!(absolute_error > 0) || !(confidence > 0 && confidence < 1)) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "absolute error {} must be positive and confidence {} in (0, 1)",
+          absolute_error, confidence);
+    }
+
+    if (auto result = katana::analytics::ConstructNodeProperties<NodeData>(
+            pg, {output_property_name});
+        !result) {
+      return result.error();
+    }
+
+    auto graph_result = Graph::Make(pg, {output_property_name}, {});
+    if (!graph_result) {
+      return graph_result.error();
+    }
+
+    Graph graph = graph_result.value();
+    const auto& topology = pg->topology();
+
+    katana::StatTimer execTime(
+        "LocalClusteringCoefficient", "LocalClusteringCoefficient");
+    execTime.start();
+
+    // The normal approximation of the interval of a proportion is widest
+    // when the proportion is 1/2
+    double z = katana::analytics::TwoSidedNormalQuantile(confidence);
+    uint64_t num_samples =
+        std::ceil(z * z / (4 * absolute_error * absolute_error));
+
+    katana::GAccumulator<uint64_t> sampled_nodes;
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const Node& n) {
+          uint64_t degree = topology.edges(n).size();
+          double& coefficient = graph.GetData<NodeClusteringCoefficient>(n);
+          if (degree < 2) {
+            coefficient = 0.0;
+            return;
+          }
+          if (katana::analytics::NumWedges(degree) <= num_samples) {
+            coefficient = ExactCoefficient(topology, n);
+            return;
+          }
+          // Seeded by the plan and the node, so coefficients do not depend on
+          // the schedule
+          std::mt19937_64 rng(katana::analytics::WedgeSamplingSeed(seed, n));
+          uint64_t closed = 0;
+          for (uint64_t i = 0; i < num_samples; ++i) {
+            closed += katana::analytics::SampleWedgeIsClosed(topology, n, &rng);
+          }
+          coefficient = ((double)closed) / num_samples;
+          sampled_nodes += 1;
+        },
+        katana::chunk_size<kChunkSize>(), katana::steal(),
+        katana::loopname("LocalClusteringCoefficient_WedgeSampling"));
+
+    katana::ReportStatSingle(
+        "LocalClusteringCoefficient", "SampledNodes", sampled_nodes.reduce());
+
+    execTime.stop();
+    return katana::ResultSuccess();
+  }
+};
 }  // namespace
 
 template <typename Algorithm>
@@ -351,6 +458,12 @@ katana::analytics::LocalClusteringCoefficient(
     LocalClusteringCoefficientPerThread algo_per_thread;
     return algo_per_thread(pg, output_property_name);
   }
+  case LocalClusteringCoefficientPlan::kWedgeSampling: {
+    LocalClusteringCoefficientWedgeSampling algo_sampling;
+    return algo_sampling(
+        pg, output_property_name, plan.absolute_error(), plan.confidence(),
+        plan.seed());
+  }
   default:
     return katana::ErrorCode::InvalidArgument;
   }
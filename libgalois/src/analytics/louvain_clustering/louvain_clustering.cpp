@@ -87,6 +87,9 @@ struct LouvainClusteringImplementation
     constant_for_second_term =
         Base::template CalConstantForSecondTerm<EdgeWeightType>(graph);
 
+    katana::PerThreadStorage<NeighborClusterAccumulator<EdgeWeightType>>
+        cluster_accumulators;
+
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
     while (true) {
@@ -108,19 +111,16 @@ struct LouvainClusteringImplementation
             uint64_t degree =
                 std::distance(graph.edge_begin(n), graph.edge_end(n));
             uint64_t local_target = Base::UNASSIGNED;
-            std::map<uint64_t, uint64_t>
-                cluster_local_map;  // Map each neighbor's cluster to local number:
-                                    // Community --> Index
-            std::vector<EdgeWeightType>
-                counter;  // Number of edges to each unique cluster
+            // Edge weight to each neighboring cluster
+            auto& clusters = *cluster_accumulators.getLocal();
             EdgeWeightType self_loop_wt = 0;
 
             if (degree > 0) {
               Base::template FindNeighboringClusters<EdgeWeightType>(
-                  graph, n, cluster_local_map, counter, self_loop_wt);
+                  graph, n, &clusters, self_loop_wt);
               // Find the max gain in modularity
               local_target = Base::MaxModularityWithoutSwaps(
-                  cluster_local_map, counter, self_loop_wt, c_info,
+                  clusters, self_loop_wt, c_info,
                   n_data_degree_wt, n_data_curr_comm_id,
                   constant_for_second_term);
 
@@ -240,6 +240,9 @@ struct LouvainClusteringImplementation
       c_update_subtract[n].size = 0;
     });
 
+    katana::PerThreadStorage<NeighborClusterAccumulator<EdgeWeightType>>
+        cluster_accumulators;
+
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
 
@@ -260,19 +263,16 @@ struct LouvainClusteringImplementation
               uint64_t degree =
                   std::distance(graph.edge_begin(n), graph.edge_end(n));
 
-              std::map<uint64_t, uint64_t>
-                  cluster_local_map;  // Map each neighbor's cluster to local number:
-                                      // Community --> Index
-              std::vector<EdgeWeightType>
-                  counter;  // Number of edges to each unique cluster
+              // Edge weight to each neighboring cluster
+              auto& clusters = *cluster_accumulators.getLocal();
               EdgeWeightType self_loop_wt = 0;
 
               if (degree > 0) {
                 Base::template FindNeighboringClusters<EdgeWeightType>(
-                    graph, n, cluster_local_map, counter, self_loop_wt);
+                    graph, n, &clusters, self_loop_wt);
                 // Find the max gain in modularity
                 local_target[n] = Base::MaxModularityWithoutSwaps(
-                    cluster_local_map, counter, self_loop_wt, c_info,
+                    clusters, self_loop_wt, c_info,
                     n_data_degree_wt, n_data_curr_comm_id,
                     constant_for_second_term);
 
@@ -49,4 +49,9 @@ katana::Result<void> PagerankPushSynchronous(
     katana::PropertyGraph* pg, const std::string& output_property_name,
     katana::analytics::PagerankPlan plan);
 
+katana::Result<void> PagerankPushIncremental(
+    katana::PropertyGraph* pg, const std::string& rank_property_name,
+    const katana::analytics::PagerankEdgeChanges& changes,
+    katana::analytics::PagerankPlan plan);
+
 #endif
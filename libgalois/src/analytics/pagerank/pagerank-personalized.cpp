@@ -0,0 +1,176 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "pagerank-impl.h"
+
+namespace {
+
+using GNode = katana::GraphTopology::Node;
+
+/// The sparse state of one personalized query: the rank settled on each
+/// visited node and the residual still to be pushed from it
+struct PersonalizedState {
+  std::unordered_map<GNode, PRTy> rank;
+  std::unordered_map<GNode, PRTy> residual;
+};
+
+/// Forward push (Andersen, Chung and Lang) from \param seeds. A node is
+/// pushed while its residual is at least the tolerance times its out-degree,
+/// so the work is bounded by 1 / tolerance independent of the graph size.
+///
+/// \returns the number of pushes
+uint64_t
+ForwardPush(
+    const katana::GraphTopology& topology, const std::vector<uint32_t>& seeds,
+    const katana::analytics::PagerankPlan& plan, PersonalizedState* state) {
+  auto threshold = [&](GNode n) {
+    return plan.tolerance() *
+           std::max<PRTy>(topology.edges(n).size(), PRTy{1});
+  };
+
+  std::deque<GNode> queue;
+  PRTy seed_residual = PRTy{1} / seeds.size();
+  for (GNode seed : seeds) {
+    PRTy& r = state->residual[seed];
+    bool was_active = r >= threshold(seed);
+    r += seed_residual;
+    if (!was_active && r >= threshold(seed)) {
+      queue.push_back(seed);
+    }
+  }
+
+  uint64_t pushes = 0;
+  while (!queue.empty()) {
+    GNode src = queue.front();
+    queue.pop_front();
+    PRTy& src_residual = state->residual[src];
+    PRTy old_residual = src_residual;
+    if (old_residual < threshold(src)) {
+      continue;
+    }
+    src_residual = 0;
+    ++pushes;
+
+    state->rank[src] += (1 - plan.alpha()) * old_residual;
+    auto edges = topology.edges(src);
+    if (edges.empty()) {
+      continue;
+    }
+    PRTy delta = old_residual * plan.alpha() / edges.size();
+    for (auto e : edges) {
+      GNode dest = topology.edge_dest(e);
+      PRTy& dest_residual = state->residual[dest];
+      PRTy dest_threshold = threshold(dest);
+      bool was_active = dest_residual >= dest_threshold;
+      dest_residual += delta;
+      if (!was_active && dest_residual >= dest_threshold) {
+        queue.push_back(dest);
+      }
+    }
+  }
+  return pushes;
+}
+
+/// \returns the \param k nodes of \param state with the highest rank
+katana::analytics::PersonalizedPagerankResult
+TopK(const PersonalizedState& state, size_t k) {
+  std::vector<std::pair<GNode, PRTy>> entries(
+      state.rank.begin(), state.rank.end());
+  auto by_rank = [](const auto& a, const auto& b) {
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+  };
+  size_t num = std::min(k, entries.size());
+  std::partial_sort(
+      entries.begin(), entries.begin() + num, entries.end(), by_rank);
+
+  katana::analytics::PersonalizedPagerankResult result;
+  result.nodes.reserve(num);
+  result.ranks.reserve(num);
+  for (size_t i = 0; i < num; ++i) {
+    result.nodes.emplace_back(entries[i].first);
+    result.ranks.emplace_back(entries[i].second);
+  }
+  return result;
+}
+
+}  // namespace
+
+katana::Result<std::vector<katana::analytics::PersonalizedPagerankResult>>
+katana::analytics::PersonalizedPagerank(
+    PropertyGraph* pg, const std::vector<std::vector<uint32_t>>& seed_sets,
+    size_t k, PagerankPlan plan) {
+  for (const auto& seeds : seed_sets) {
+    if (seeds.empty()) {
+      return KATANA_ERROR(ErrorCode::InvalidArgument, "empty seed set");
+    }
+    for (uint32_t seed : seeds) {
+      if (seed >= pg->num_nodes()) {
+        return KATANA_ERROR(
+            ErrorCode::InvalidArgument, "seed {} is out of range for {} nodes",
+            seed, pg->num_nodes());
+      }
+    }
+  }
+  if (plan.tolerance() <= 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "tolerance must be positive: {}",
+        plan.tolerance());
+  }
+
+  const GraphTopology& topology = pg->topology();
+  std::vector<PersonalizedPagerankResult> results(seed_sets.size());
+  katana::GAccumulator<uint64_t> pushes;
+
+  katana::StatTimer exec_time("PersonalizedPagerank");
+  exec_time.start();
+
+  // Queries are independent and each touches a small part of the graph, so
+  // run them in parallel with each query serial
+  katana::do_all(
+      katana::iterate(size_t{0}, seed_sets.size()),
+      [&](size_t i) {
+        PersonalizedState state;
+        pushes += ForwardPush(topology, seed_sets[i], plan, &state);
+        results[i] = TopK(state, k);
+      },
+      katana::steal(), katana::chunk_size<1>(),
+      katana::loopname("PersonalizedPagerank"));
+
+  exec_time.stop();
+  katana::ReportStatSingle(
+      "PersonalizedPagerank", "Pushes", pushes.reduce());
+
+  return results;
+}
+
+katana::Result<katana::analytics::PersonalizedPagerankResult>
+katana::analytics::PersonalizedPagerank(
+    PropertyGraph* pg, uint32_t seed, size_t k, PagerankPlan plan) {
+  auto results = PersonalizedPagerank(pg, {{seed}}, k, plan);
+  if (!results) {
+    return results.error();
+  }
+  return std::move(results.value()[0]);
+}
@@ -17,6 +17,9 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include "katana/AtomicHelpers.h"
 #include "katana/Properties.h"
 #include "katana/TypedPropertyGraph.h"
@@ -45,6 +48,47 @@ InitializeNodeResidual(Graph& graph, katana::analytics::PagerankPlan plan) {
       katana::no_stats(), katana::loopname("Initialize"));
 }
 
+/// Push the residuals of the nodes in \param active, and of the nodes they
+/// push enough residual to, until no node has a residual larger than the
+/// tolerance in magnitude. Residuals may be negative.
+template <typename Range>
+void
+PushResidualAsynchronous(
+    Graph* graph, const Range& active,
+    katana::analytics::PagerankPlan plan) {
+  typedef katana::PerSocketChunkFIFO<
+      katana::analytics::PagerankPlan::kChunkSize>
+      WL;
+  katana::for_each(
+      active,
+      [&](const GNode& src, auto& ctx) {
+        auto& src_residual = graph->GetData<NodeResidual>(src);
+        if (std::fabs(src_residual) > plan.tolerance()) {
+          PRTy old_residual = src_residual.exchange(0.0);
+          auto& src_value = graph->GetData<NodeValue>(src);
+          src_value += old_residual;
+          int src_nout = graph->edges(src).size();
+          if (src_nout > 0) {
+            PRTy delta = old_residual * plan.alpha() / src_nout;
+            //! For each out-going neighbors.
+            for (const auto& jj : graph->edges(src)) {
+              auto dest = graph->GetEdgeDest(jj);
+              auto& dest_residual = graph->GetData<NodeResidual>(dest);
+              if (delta != 0) {
+                auto old = atomicAdd(dest_residual, delta);
+                if ((std::fabs(old) < plan.tolerance()) &&
+                    (std::fabs(old + delta) >= plan.tolerance())) {
+                  ctx.push(*dest);
+                }
+              }
+            }
+          }
+        }
+      },
+      katana::loopname("PushResidualAsynchronous"),
+      katana::disable_conflict_detection(), katana::wl<WL>());
+}
+
 }  // namespace
 
 katana::Result<void>
@@ -71,37 +115,7 @@ PagerankPushAsynchronous(
 
   InitializeNodeResidual(graph, plan);
 
-  typedef katana::PerSocketChunkFIFO<
-      katana::analytics::PagerankPlan::kChunkSize>
-      WL;
-  katana::for_each(
-      katana::iterate(graph),
-      [&](const GNode& src, auto& ctx) {
-        auto& src_residual = graph.GetData<NodeResidual>(src);
-        if (src_residual > plan.tolerance()) {
-          PRTy old_residual = src_residual.exchange(0.0);
-          auto& src_value = graph.GetData<NodeValue>(src);
-          src_value += old_residual;
-          int src_nout = graph.edges(src).size();
-          if (src_nout > 0) {
-            PRTy delta = old_residual * plan.alpha() / src_nout;
-            //! For each out-going neighbors.
-            for (const auto& jj : graph.edges(src)) {
-              auto dest = graph.GetEdgeDest(jj);
-              auto& dest_residual = graph.GetData<NodeResidual>(dest);
-              if (delta > 0) {
-                auto old = atomicAdd(dest_residual, delta);
-                if ((old < plan.tolerance()) &&
-                    (old + delta >= plan.tolerance())) {
-                  ctx.push(*dest);
-                }
-              }
-            }
-          }
-        }
-      },
-      katana::loopname("PushResidualAsynchronous"),
-      katana::disable_conflict_detection(), katana::wl<WL>());
+  PushResidualAsynchronous(&graph, katana::iterate(graph), plan);
 
   return katana::ResultSuccess();
 }
@@ -210,3 +224,124 @@ PagerankPushSynchronous(
   }
   return katana::ResultSuccess();
 }
+
+katana::Result<void>
+PagerankPushIncremental(
+    katana::PropertyGraph* pg, const std::string& rank_property_name,
+    const katana::analytics::PagerankEdgeChanges& changes,
+    katana::analytics::PagerankPlan plan) {
+  struct Change {
+    GNode src;
+    GNode dest;
+    bool inserted;
+  };
+
+  std::vector<Change> sorted_changes;
+  sorted_changes.reserve(changes.inserted.size() + changes.deleted.size());
+  for (const auto& [src, dest] : changes.inserted) {
+    sorted_changes.emplace_back(Change{src, dest, true});
+  }
+  for (const auto& [src, dest] : changes.deleted) {
+    sorted_changes.emplace_back(Change{src, dest, false});
+  }
+  for (const Change& change : sorted_changes) {
+    if (change.src >= pg->num_nodes() || change.dest >= pg->num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "edge ({}, {}) is out of range for {} nodes", change.src,
+          change.dest, pg->num_nodes());
+    }
+  }
+  std::sort(
+      sorted_changes.begin(), sorted_changes.end(),
+      [](const Change& a, const Change& b) { return a.src < b.src; });
+
+  katana::analytics::TemporaryPropertyGuard temporary_property{pg};
+
+  if (auto result =
+          katana::analytics::ConstructNodeProperties<std::tuple<NodeResidual>>(
+              pg, {temporary_property.name()});
+      !result) {
+    return result.error();
+  }
+
+  auto graph_result =
+      Graph::Make(pg, {rank_property_name, temporary_property.name()}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  Graph graph = graph_result.value();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) { graph.GetData<NodeResidual>(n) = 0; },
+      katana::no_stats(), katana::loopname("Initialize"));
+
+  // The changes of each source are the range [begin, end) of sorted_changes
+  struct Source {
+    size_t begin;
+    size_t end;
+  };
+  std::vector<Source> sources;
+  for (size_t i = 0; i < sorted_changes.size();) {
+    size_t j = i;
+    int64_t out_degree = graph.edges(sorted_changes[i].src).size();
+    for (; j < sorted_changes.size() &&
+           sorted_changes[j].src == sorted_changes[i].src;
+         ++j) {
+      out_degree += sorted_changes[j].inserted ? -1 : 1;
+    }
+    if (out_degree < 0) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "node {} has more inserted edges than out-edges",
+          sorted_changes[i].src);
+    }
+    sources.emplace_back(Source{i, j});
+    i = j;
+  }
+
+  // The ranks satisfy rank = (1 - alpha) + alpha * A * rank for the old
+  // out-edges A. Moving the share of rank each changed source passes on from
+  // its old out-edges to its new ones leaves residuals whose propagation
+  // turns the ranks into those for the new out-edges.
+  katana::InsertBag<GNode> active;
+  katana::do_all(
+      katana::iterate(sources),
+      [&](const Source& source) {
+        GNode src = sorted_changes[source.begin].src;
+        PRTy value = graph.GetData<NodeValue>(src);
+        int64_t new_out_degree = graph.edges(src).size();
+        int64_t old_out_degree = new_out_degree;
+        for (size_t i = source.begin; i < source.end; ++i) {
+          old_out_degree += sorted_changes[i].inserted ? -1 : 1;
+        }
+
+        auto add = [&](GNode dest, PRTy delta) {
+          atomicAdd(graph.GetData<NodeResidual>(dest), delta);
+          active.push(dest);
+        };
+
+        PRTy new_share =
+            new_out_degree > 0 ? value * plan.alpha() / new_out_degree : 0;
+        PRTy old_share =
+            old_out_degree > 0 ? value * plan.alpha() / old_out_degree : 0;
+        // The old out-edges are the new ones without the inserted edges and
+        // with the deleted edges
+        for (const auto& jj : graph.edges(src)) {
+          add(*graph.GetEdgeDest(jj), new_share - old_share);
+        }
+        for (size_t i = source.begin; i < source.end; ++i) {
+          const Change& change = sorted_changes[i];
+          add(change.dest, change.inserted ? old_share : -old_share);
+        }
+      },
+      katana::steal(), katana::loopname("IncrementalResiduals"));
+
+  katana::ReportStatSingle(
+      "PagerankIncremental", "ChangedSources", sources.size());
+
+  PushResidualAsynchronous(&graph, katana::iterate(active), plan);
+
+  return katana::ResultSuccess();
+}
@@ -38,6 +38,13 @@ katana::analytics::Pagerank(
   }
 }
 
+katana::Result<void>
+katana::analytics::PagerankIncremental(
+    katana::PropertyGraph* pg, const std::string& rank_property_name,
+    const PagerankEdgeChanges& changes, PagerankPlan plan) {
+  return PagerankPushIncremental(pg, rank_property_name, changes, plan);
+}
+
 /// \cond DO_NOT_DOCUMENT
 katana::Result<void>
 katana::analytics::PagerankAssertValid(
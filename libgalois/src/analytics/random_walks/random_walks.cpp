@@ -19,7 +19,12 @@
 
 #include "katana/analytics/random_walks/random_walks.h"
 
+#include <limits>
+#include <random>
+
 #include "katana/TypedPropertyGraph.h"
+#include "tsuba/ParquetWriter.h"
+#include "tsuba/WriteGroup.h"
 
 using namespace katana::analytics;
 
@@ -27,6 +32,209 @@ const int RandomWalksPlan::kChunkSize = 1;
 
 namespace {
 
+using Edge = katana::GraphTopology::Edge;
+
+/// Samples the out-edges of a node, either uniformly or in proportion to
+/// their weights, in constant time. Weighted sampling uses an alias table per
+/// node (Walker's alias method, built with Vose's algorithm): edge i of a
+/// node of degree d is picked with probability (probability_[i] + the
+/// 1 - probability_[j] of each j with alias_[j] == i) / d.
+class EdgeSampler {
+  const katana::GraphTopology& topology_;
+  /// Empty for uniform sampling; otherwise indexed by edge, with aliases as
+  /// positions in the edges of the node
+  katana::LargeArray<float> probability_;
+  katana::LargeArray<uint32_t> alias_;
+
+public:
+  explicit EdgeSampler(const katana::GraphTopology& topology)
+      : topology_(topology) {}
+
+  /// Build the alias tables for weights indexed by edge
+  template <typename Weight>
+  katana::Result<void> BuildAliasTables(const Weight* weights) {
+    if (auto bad = std::find_if(
+            weights, weights + topology_.num_edges(),
+            [](Weight w) { return !(w >= 0); });
+        bad != weights + topology_.num_edges()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "edge {} has weight {}",
+          bad - weights, *bad);
+    }
+
+    probability_.allocateBlocked(topology_.num_edges());
+    alias_.allocateBlocked(topology_.num_edges());
+
+    struct Scratch {
+      std::vector<double> scaled;
+      std::vector<uint32_t> small;
+      std::vector<uint32_t> large;
+    };
+    katana::PerThreadStorage<Scratch> scratch;
+
+    katana::do_all(
+        katana::iterate(topology_),
+        [&](const uint32_t& n) {
+          auto [begin, end] = topology_.edge_range(n);
+          uint32_t degree = end - begin;
+          double total = 0;
+          for (Edge e = begin; e != end; ++e) {
+            total += weights[e];
+          }
+
+          Scratch& s = *scratch.getLocal();
+          s.scaled.resize(degree);
+          s.small.clear();
+          s.large.clear();
+          // Scale the weights so they average 1; a node without weight picks
+          // uniformly
+          for (uint32_t i = 0; i < degree; ++i) {
+            s.scaled[i] = total > 0 ? weights[begin + i] * degree / total : 1;
+            (s.scaled[i] < 1 ? s.small : s.large).emplace_back(i);
+          }
+          // Fill the slot of each light edge up to 1 with a heavy edge
+          while (!s.small.empty() && !s.large.empty()) {
+            uint32_t light = s.small.back();
+            s.small.pop_back();
+            uint32_t heavy = s.large.back();
+            probability_[begin + light] = s.scaled[light];
+            alias_[begin + light] = heavy;
+            s.scaled[heavy] -= 1 - s.scaled[light];
+            if (s.scaled[heavy] < 1) {
+              s.large.pop_back();
+              s.small.emplace_back(heavy);
+            }
+          }
+          // What is left is 1 up to rounding
+          for (auto* rest : {&s.small, &s.large}) {
+            for (uint32_t i : *rest) {
+              probability_[begin + i] = 1;
+              alias_[begin + i] = i;
+            }
+          }
+        },
+        katana::steal(), katana::loopname("RandomWalks_AliasTables"));
+
+    return katana::ResultSuccess();
+  }
+
+  /// \returns an out-edge of n, which must have one
+  template <typename Rng>
+  Edge Sample(uint32_t n, Rng* rng) const {
+    auto [begin, end] = topology_.edge_range(n);
+    uint64_t degree = end - begin;
+    // The integer part of x picks a slot, and its fractional part picks
+    // between the edge of the slot and its alias
+    double x = std::uniform_real_distribution<double>(0.0, degree)(*rng);
+    uint64_t slot = std::min<uint64_t>(x, degree - 1);
+    if (probability_.size() == 0 || x - slot < probability_[begin + slot]) {
+      return begin + slot;
+    }
+    return begin + alias_[begin + slot];
+  }
+};
+
+/// Walks are generated in place into one buffer: each walk gets a slot of
+/// the longest possible walk, and the offset of the slot of walk idx is
+/// offsets[idx], so walks from nodes without neighbors take no room. The
+/// length of each walk is recorded in case it stops early, at a node without
+/// neighbors, so that Compact can close the gaps.
+///
+/// The slots hold a range of the walks, starting at first_walk: walk i
+/// starts at node i % num_nodes.
+struct WalkSlots {
+  katana::LargeArray<uint32_t> nodes;
+  katana::LargeArray<uint64_t> offsets;
+  katana::LargeArray<uint32_t> lengths;
+  uint64_t first_walk{};
+  uint64_t max_length{};
+
+  void Allocate(
+      uint64_t first, uint64_t total_walks, uint64_t max_walk_length,
+      const katana::LargeArray<uint64_t>& degree, uint32_t num_nodes) {
+    first_walk = first;
+    max_length = max_walk_length;
+    offsets.allocateBlocked(total_walks + 1);
+    lengths.allocateBlocked(total_walks);
+    offsets[0] = 0;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, total_walks),
+        [&](uint64_t idx) {
+          uint32_t source = (first_walk + idx) % num_nodes;
+          offsets[idx + 1] = degree[source] == 0 ? 0 : max_length;
+          lengths[idx] = 0;
+        },
+        katana::no_stats());
+    katana::ParallelSTL::partial_sum(
+        offsets.begin(), offsets.end(), offsets.begin());
+    nodes.allocateBlocked(offsets[total_walks]);
+  }
+
+  uint32_t* slot(uint64_t idx) { return nodes.data() + offsets[idx]; }
+
+  /// \returns the walks, with the gaps left by walks that stopped early
+  /// closed and the empty walks, from nodes without neighbors, left out
+  RandomWalkBuffer Compact() {
+    uint64_t total_walks = lengths.size();
+    katana::GAccumulator<uint64_t> num_walks;
+    katana::GReduceLogicalOr stopped_early;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, total_walks),
+        [&](uint64_t idx) {
+          num_walks += lengths[idx] != 0;
+          stopped_early.update(offsets[idx] + lengths[idx] != offsets[idx + 1]);
+        },
+        katana::no_stats());
+    if (!stopped_early.reduce() && num_walks.reduce() == total_walks) {
+      return RandomWalkBuffer(std::move(nodes), std::move(offsets));
+    }
+
+    // The rank of each walk among the kept walks and where it starts once
+    // compacted, from prefix sums
+    katana::LargeArray<uint64_t> ranks;
+    katana::LargeArray<uint64_t> starts;
+    ranks.allocateBlocked(total_walks + 1);
+    starts.allocateBlocked(total_walks + 1);
+    ranks[0] = 0;
+    starts[0] = 0;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, total_walks),
+        [&](uint64_t idx) {
+          ranks[idx + 1] = lengths[idx] != 0;
+          starts[idx + 1] = lengths[idx];
+        },
+        katana::no_stats());
+    katana::ParallelSTL::partial_sum(
+        ranks.begin(), ranks.end(), ranks.begin());
+    katana::ParallelSTL::partial_sum(
+        starts.begin(), starts.end(), starts.begin());
+
+    // Copying into a new buffer, rather than moving walks down in place, lets
+    // walks be copied in parallel since no walk overwrites another
+    uint64_t kept = ranks[total_walks];
+    katana::LargeArray<uint32_t> kept_nodes;
+    katana::LargeArray<uint64_t> kept_offsets;
+    kept_nodes.allocateBlocked(starts[total_walks]);
+    kept_offsets.allocateBlocked(kept + 1);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, total_walks),
+        [&](uint64_t idx) {
+          if (lengths[idx] == 0) {
+            return;
+          }
+          kept_offsets[ranks[idx]] = starts[idx];
+          const uint32_t* walk = slot(idx);
+          std::copy(walk, walk + lengths[idx], kept_nodes.data() + starts[idx]);
+        },
+        katana::steal(), katana::no_stats());
+    kept_offsets[kept] = starts[total_walks];
+    // Release the slots before the caller gets the walks
+    nodes = katana::LargeArray<uint32_t>();
+
+    return RandomWalkBuffer(std::move(kept_nodes), std::move(kept_offsets));
+  }
+};
+
 struct Node2VecAlgo {
   using NodeData = std::tuple<>;
   using EdgeData = std::tuple<>;
@@ -34,33 +242,26 @@ struct Node2VecAlgo {
   typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
   typedef typename Graph::Node GNode;
 
+  /// Node2Vec walks are independent, so they can be generated in batches
+  static constexpr bool kBatches = true;
+
+  /// The walks from each node are generated once
+  static uint64_t NumRounds(const RandomWalksPlan&) { return 1; }
+
   const RandomWalksPlan& plan_;
+  /// Kept across batches, so that each batch continues the random sequence
+  katana::PerThreadStorage<std::mt19937> generator_;
   Node2VecAlgo(const RandomWalksPlan& plan) : plan_(plan) {}
 
-  GNode FindSampleNeighbor(
-      const Graph& graph, const GNode& n,
-      const katana::LargeArray<uint64_t>& degree, double prob) {
-    if (degree[n] == 0) {
-      return graph.num_nodes();
-    }
-    double total_wt = degree[n];
-
-    uint32_t edge_index = std::floor(prob * total_wt);
-    auto edge = graph.edge_begin(n) + edge_index;
-    return *graph.GetEdgeDest(edge);
+  static katana::Result<Graph> MakeGraph(katana::PropertyGraph* pg) {
+    // Ignoring all properties.
+    return Graph::Make(pg, {}, {});
   }
 
   void GraphRandomWalk(
-      const Graph& graph, katana::InsertBag<std::vector<uint32_t>>* walks,
+      const Graph& graph, const EdgeSampler& sampler, WalkSlots* walks,
       const katana::LargeArray<uint64_t>& degree) {
-    katana::PerThreadStorage<std::mt19937> generator;
-    katana::PerThreadStorage<std::uniform_real_distribution<double>*>
-        distribution;
-
-    for (uint32_t i = 0; i < distribution.size(); i++) {
-      *distribution.getRemote(i) =
-          new std::uniform_real_distribution<double>(0.0, 1.0);
-    }
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
 
     double prob_forward = 1.0 / plan_.forward_probability();
     double prob_backward = 1.0 / plan_.backward_probability();
@@ -75,32 +276,31 @@ struct Node2VecAlgo {
     lower_bound = (lower_bound < prob_forward) ? lower_bound : prob_forward;
     lower_bound = (lower_bound < prob_backward) ? lower_bound : prob_backward;
 
-    uint64_t total_walks = graph.size() * plan_.number_of_walks();
+    uint64_t total_walks = walks->lengths.size();
 
     katana::do_all(
         katana::iterate(uint64_t(0), total_walks),
         [&](uint64_t idx) {
-          GNode n = idx % graph.size();
+          GNode n = (walks->first_walk + idx) % graph.size();
 
           //check if n has no neighbor
           if (degree[n] == 0) {
             return;
           }
 
-          std::uniform_real_distribution<double>* dist =
-              *distribution.getLocal();
+          std::mt19937* rng = generator_.getLocal();
 
-          std::vector<uint32_t> walk;
-          walk.push_back(n);
+          uint32_t* walk = walks->slot(idx);
+          uint32_t length = 0;
+          walk[length++] = n;
 
-          //random value between 0 and 1
-          double prob = (*dist)(*generator.getLocal());
-
-          //Assumption: All edges have weight 1
-          Graph::Node nbr = FindSampleNeighbor(graph, n, degree, prob);
+          //Assumption: All edges have weight 1, unless the sampler is
+          //weighted
+          Graph::edge_iterator edge(sampler.Sample(n, rng));
+          Graph::Node nbr = *graph.GetEdgeDest(edge);
           KATANA_LOG_ASSERT(nbr < graph.num_nodes());
 
-          walk.push_back(std::move(nbr));
+          walk[length++] = nbr;
 
           for (uint32_t current_walk = 2; current_walk <= plan_.walk_length();
                current_walk++) {
@@ -114,18 +314,17 @@ struct Node2VecAlgo {
             //acceptance-rejection sampling
             while (true) {
               //sample x
-              double prob = (*dist)(*generator.getLocal());
-
-              Graph::Node nbr = FindSampleNeighbor(graph, curr, degree, prob);
+              Graph::edge_iterator nbr_edge(sampler.Sample(curr, rng));
+              Graph::Node nbr = *graph.GetEdgeDest(nbr_edge);
               KATANA_LOG_ASSERT(nbr < graph.num_nodes());
 
               //sample y
-              double y = (*dist)(*generator.getLocal());
+              double y = dist(*rng);
               y = y * upper_bound;
 
               if (y <= lower_bound) {
                 //accept this sample
-                walk.push_back(std::move(nbr));
+                walk[length++] = nbr;
                 break;
               } else {
                 //compute transition probability
@@ -145,27 +344,23 @@ struct Node2VecAlgo {
 
                 if (y <= alpha) {
                   //accept y
-                  walk.push_back(std::move(nbr));
+                  walk[length++] = nbr;
                   break;
                 }
               }
             }
           }
 
-          walks->push(std::move(walk));
+          walks->lengths[idx] = length;
         },
         katana::steal(), katana::chunk_size<RandomWalksPlan::kChunkSize>(),
         katana::loopname("Node2vec walks"), katana::no_stats());
-
-    for (uint32_t i = 0; i < distribution.size(); i++) {
-      delete (*distribution.getRemote(i));
-    }
   }
 
   void operator()(
-      const Graph& graph, katana::InsertBag<std::vector<uint32_t>>* walks,
+      const Graph& graph, const EdgeSampler& sampler, WalkSlots* walks,
       const katana::LargeArray<uint64_t>& degree) {
-    GraphRandomWalk(graph, walks, degree);
+    GraphRandomWalk(graph, sampler, walks, degree);
   }
 };
 
@@ -178,9 +373,28 @@ struct Edge2VecAlgo {
   typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
   typedef typename Graph::Node GNode;
 
+  /// Each Edge2Vec iteration learns from all the walks of the previous one,
+  /// so they are generated at once
+  static constexpr bool kBatches = false;
+
+  /// Each iteration generates walks from every node, and the walks of all
+  /// iterations are returned
+  static uint64_t NumRounds(const RandomWalksPlan& plan) {
+    return plan.max_iterations();
+  }
+
   const RandomWalksPlan& plan_;
+  katana::PerThreadStorage<std::mt19937> generator_;
   Edge2VecAlgo(const RandomWalksPlan& plan) : plan_(plan) {}
 
+  static katana::Result<Graph> MakeGraph(katana::PropertyGraph* pg) {
+    // TODO(amp): This is incorrect. This needs to be:
+    //    Graph::Make(pg, {}, {edge_type_property_name})
+    //  The current version requires the input to have exactly the properties
+    //  expected by the algorithm implementation.
+    return Graph::Make(pg);
+  }
+
   //transition matrix
   std::vector<std::vector<double>> transition_matrix_;
 
@@ -194,33 +408,12 @@ struct Edge2VecAlgo {
     }
   }
 
-  std::pair<GNode, EdgeType::ViewType::value_type> FindSampleNeighbor(
-      const Graph& graph, const GNode& n,
-      const katana::LargeArray<uint64_t>& degree, double prob) {
-    if (degree[n] == 0) {
-      return std::make_pair(graph.num_nodes(), 1);
-    }
-    double total_wt = degree[n];
-    prob = prob * total_wt;
-
-    uint32_t edge_index = std::floor(prob);
-    auto edge = graph.edge_begin(n) + edge_index;
-    return std::make_pair(
-        *graph.GetEdgeDest(edge), graph.GetEdgeData<EdgeType>(edge));
-  }
-
+  /// Generate the walks of slots [begin, end)
   void GraphRandomWalk(
-      const Graph& graph, katana::InsertBag<std::vector<uint32_t>>* walks,
-      katana::InsertBag<std::vector<uint32_t>>* types_walks,
+      const Graph& graph, const EdgeSampler& sampler, WalkSlots* walks,
+      uint64_t begin, uint64_t end, katana::LargeArray<uint32_t>* types,
       const katana::LargeArray<uint64_t>& degree) {
-    katana::PerThreadStorage<std::mt19937> generator;
-    katana::PerThreadStorage<std::uniform_real_distribution<double>*>
-        distribution;
-
-    for (uint32_t i = 0; i < distribution.size(); i++) {
-      *distribution.getRemote(i) =
-          new std::uniform_real_distribution<double>(0.0, 1.0);
-    }
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
 
     double prob_forward = 1.0 / plan_.forward_probability();
     double prob_backward = 1.0 / plan_.backward_probability();
@@ -230,61 +423,57 @@ struct Edge2VecAlgo {
     upper_bound = (upper_bound > prob_forward) ? upper_bound : prob_forward;
     upper_bound = (upper_bound > prob_backward) ? upper_bound : prob_backward;
 
-    uint64_t total_walks = graph.size() * plan_.number_of_walks();
-
     katana::do_all(
-        katana::iterate(uint64_t(0), total_walks),
+        katana::iterate(begin, end),
         [&](uint64_t idx) {
-          GNode n = idx % graph.size();
+          GNode n = (walks->first_walk + idx) % graph.size();
 
           //check if n has no neighbor
           if (degree[n] == 0) {
             return;
           }
 
-          std::uniform_real_distribution<double>* dist =
-              *distribution.getLocal();
+          std::mt19937* rng = generator_.getLocal();
 
-          std::vector<uint32_t> walk;
-          std::vector<uint32_t> types_vec;
+          // The type of the edge into walk[i] is types_vec[i - 1]
+          uint32_t* walk = walks->slot(idx);
+          uint32_t* types_vec = types->data() + walks->offsets[idx];
+          uint32_t length = 0;
 
-          walk.push_back(n);
+          walk[length++] = n;
 
-          //random value between 0 and 1
-          double prob = (*dist)(*generator.getLocal());
+          //Assumption: All edges have weight 1, unless the sampler is
+          //weighted
+          Graph::edge_iterator edge(sampler.Sample(n, rng));
+          KATANA_LOG_ASSERT(*graph.GetEdgeDest(edge) < graph.num_nodes());
 
-          //Assumption: All edges have weight 1
-          auto nbr_pair = FindSampleNeighbor(graph, n, degree, prob);
-          KATANA_LOG_ASSERT(nbr_pair.first < graph.num_nodes());
-
-          walk.push_back(std::move(nbr_pair.first));
-          types_vec.push_back(nbr_pair.second);
+          walk[length] = *graph.GetEdgeDest(edge);
+          types_vec[length - 1] = graph.GetEdgeData<EdgeType>(edge);
+          length++;
 
           for (uint32_t current_walk = 2; current_walk <= plan_.walk_length();
                current_walk++) {
-            uint32_t curr = walk[walk.size() - 1];
+            uint32_t curr = walk[length - 1];
             //check if n has no neighbor
             if (degree[curr] == 0) {
-              return;
+              break;
             }
-            uint32_t prev = walk[walk.size() - 2];
+            uint32_t prev = walk[length - 2];
 
-            uint32_t p1 = types_vec.back();  //last element of types_vec
+            uint32_t p1 = types_vec[length - 2];  //last element of types_vec
 
             //acceptance-rejection sampling
             while (true) {
               //sample x
-              double prob = (*dist)(*generator.getLocal());
+              Graph::edge_iterator nbr_edge(sampler.Sample(curr, rng));
 
-              auto nbr_type_pair =
-                  FindSampleNeighbor(graph, curr, degree, prob);
-              KATANA_LOG_ASSERT(nbr_pair.first < graph.num_nodes());
-
-              Graph::Node nbr = nbr_type_pair.first;
-              EdgeType::ViewType::value_type p2 = nbr_type_pair.second;
+              Graph::Node nbr = *graph.GetEdgeDest(nbr_edge);
+              KATANA_LOG_ASSERT(nbr < graph.num_nodes());
+              EdgeType::ViewType::value_type p2 =
+                  graph.GetEdgeData<EdgeType>(nbr_edge);
 
               //sample y
-              double y = (*dist)(*generator.getLocal());
+              double y = dist(*rng);
               y = y * upper_bound;
 
               //compute transition probability
@@ -305,66 +494,48 @@ struct Edge2VecAlgo {
               alpha = alpha * transition_matrix_[p1][p2];
               if (alpha >= y) {
                 //accept y
-                walk.push_back(std::move(nbr));
-                types_vec.push_back(p2);
+                walk[length] = nbr;
+                types_vec[length - 1] = p2;
+                length++;
                 break;
               }
             }  //end while
 
           }  //end for
 
-          (*walks).push(std::move(walk));
-          (*types_walks).push(std::move(types_vec));
+          walks->lengths[idx] = length;
         },
         katana::steal(), katana::chunk_size<RandomWalksPlan::kChunkSize>(),
         katana::loopname("Edge2vec walks"), katana::no_stats());
   }
 
-  //compute the histogram of edge types for each walk
-  std::vector<std::vector<uint32_t>> ComputeNumEdgeTypeVectors(
-      const katana::InsertBag<std::vector<uint32_t>>& types_walks) {
-    std::vector<std::vector<uint32_t>> num_edge_types_walks;
-
-    katana::PerThreadStorage<std::vector<std::vector<uint32_t>>>
-        per_thread_num_edge_types_walks;
-    katana::do_all(
-        katana::iterate(types_walks),
-        [&](const std::vector<uint32_t>& types_walk) {
-          std::vector<uint32_t> num_edge_types(
-              plan_.number_of_edge_types() + 1, 0);
-
-          for (auto type : types_walk) {
-            num_edge_types[type]++;
-          }
-
-          per_thread_num_edge_types_walks.getLocal()->emplace_back(
-              std::move(num_edge_types));
-        });
-
-    for (unsigned j = 0; j < katana::getActiveThreads(); ++j) {
-      for (auto num_edge_types :
-           *per_thread_num_edge_types_walks.getRemote(j)) {
-        num_edge_types_walks.push_back(std::move(num_edge_types));
+  //compute the histogram of edge types for each walk of slots [begin, end),
+  //transposed: entry j holds the number of edges of type j in each nonempty
+  //walk
+  std::vector<std::vector<uint32_t>> ComputeTransformedNumEdgeTypes(
+      const WalkSlots& walks, uint64_t begin, uint64_t end,
+      const katana::LargeArray<uint32_t>& types) {
+    std::vector<uint64_t> rows;
+    for (uint64_t idx = begin; idx < end; ++idx) {
+      if (walks.lengths[idx] > 0) {
+        rows.emplace_back(idx);
       }
     }
 
-    return num_edge_types_walks;
-  }
-
-  std::vector<std::vector<uint32_t>> TransformVectors(
-      const std::vector<std::vector<uint32_t>>& num_edge_types_walks) {
-    uint32_t rows = num_edge_types_walks.size();
-    std::vector<std::vector<uint32_t>> transformed_num_edge_types_walks;
-    transformed_num_edge_types_walks.resize(plan_.number_of_edge_types() + 1);
+    std::vector<std::vector<uint32_t>> transformed_num_edge_types_walks(
+        plan_.number_of_edge_types() + 1,
+        std::vector<uint32_t>(rows.size(), 0));
 
     katana::do_all(
-        katana::iterate(uint32_t(0), plan_.number_of_edge_types() + 1),
-        [&](uint32_t j) {
-          for (uint32_t i = 0; i < rows; i++) {
-            transformed_num_edge_types_walks[j].push_back(
-                num_edge_types_walks[i][j]);
+        katana::iterate(size_t{0}, rows.size()),
+        [&](size_t r) {
+          uint64_t idx = rows[r];
+          const uint32_t* types_walk = types.data() + walks.offsets[idx];
+          for (uint32_t i = 0; i + 1 < walks.lengths[idx]; ++i) {
+            transformed_num_edge_types_walks[types_walk[i]][r]++;
           }
-        });
+        },
+        katana::no_stats());
 
     return transformed_num_edge_types_walks;
   }
@@ -437,24 +608,29 @@ struct Edge2VecAlgo {
   }
 
   void operator()(
-      const Graph& graph, katana::InsertBag<std::vector<uint32_t>>* walks,
+      const Graph& graph, const EdgeSampler& sampler, WalkSlots* walks,
       const katana::LargeArray<uint64_t>& degree) {
     uint32_t iterations = plan_.max_iterations();
 
     Initialize();
 
+    // The types of the edges of each walk, at the offsets of the walk
+    katana::LargeArray<uint32_t> types;
+    types.allocateBlocked(walks->nodes.size());
+
+    // Each iteration fills its own range of the slots, so the walks of every
+    // iteration are kept
+    uint64_t walks_per_iteration = walks->lengths.size() / iterations;
     for (uint32_t iter = 0; iter < iterations; iter++) {
-      //E step; generate walks
-      katana::InsertBag<std::vector<uint32_t>> types_walks;
+      uint64_t begin = iter * walks_per_iteration;
+      uint64_t end = begin + walks_per_iteration;
 
-      GraphRandomWalk(graph, walks, &types_walks, degree);
+      //E step; generate walks
+      GraphRandomWalk(graph, sampler, walks, begin, end, &types, degree);
 
       //Update transition matrix
-      std::vector<std::vector<uint32_t>> num_edge_types_walks =
-          ComputeNumEdgeTypeVectors(types_walks);
-
       std::vector<std::vector<uint32_t>> transformed_num_edge_types_walks =
-          TransformVectors(num_edge_types_walks);
+          ComputeTransformedNumEdgeTypes(*walks, begin, end, types);
 
       std::vector<double> means =
           ComputeMeans(transformed_num_edge_types_walks);
@@ -476,61 +652,279 @@ InitializeDegrees(const Graph& graph, katana::LargeArray<uint64_t>* degree) {
 
 }  //namespace
 
+template <typename Weight>
+katana::Result<void>
+BuildAliasTablesForProperty(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    EdgeSampler* sampler) {
+  auto weights = pg->GetEdgePropertyTyped<Weight>(edge_weight_property_name);
+  if (!weights) {
+    return weights.error();
+  }
+  return sampler->BuildAliasTables(weights.value()->raw_values());
+}
+
 template <typename Algorithm>
-static katana::Result<std::vector<std::vector<uint32_t>>>
-RandomWalksWithWrap(katana::PropertyGraph* pg, RandomWalksPlan plan) {
+static katana::Result<void>
+RandomWalksWithWrap(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan, uint64_t walks_per_batch,
+    const RandomWalksBatchCallback& callback) {
   katana::ReportPageAllocGuard page_alloc;
 
+  if (walks_per_batch == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "batches must hold at least one walk");
+  }
+
   if (auto res = katana::SortAllEdgesByDest(pg); !res) {
     return res.error();
   }
 
-  // TODO(amp): This is incorrect. For Node2vec this needs to be:
-  //    Algorithm::Graph::Make(pg, {}, {}) // Ignoring all properties.
-  //  For Edge2vec this needs to be:
-  //    Algorithm::Graph::Make(pg, {}, {edge_type_property_name})
-  //  The current version requires the input to have exactly the properties
-  //  expected by the algorithm implementation.
-  auto pg_result = Algorithm::Graph::Make(pg);
+  auto pg_result = Algorithm::MakeGraph(pg);
   if (!pg_result) {
     return pg_result.error();
   }
 
   auto graph = pg_result.value();
 
+  // Sorting permuted the edge properties with the edges, so the weights are
+  // read after it
+  EdgeSampler sampler(pg->topology());
+  if (!edge_weight_property_name.empty()) {
+    auto edge_property = pg->GetEdgeProperty(edge_weight_property_name);
+    if (!edge_property) {
+      return KATANA_ERROR(
+          katana::ErrorCode::PropertyNotFound, "no edge property {}",
+          edge_weight_property_name);
+    }
+    katana::Result<void> res = katana::ResultSuccess();
+    switch (edge_property->type()->id()) {
+    case arrow::UInt32Type::type_id:
+      res = BuildAliasTablesForProperty<uint32_t>(
+          pg, edge_weight_property_name, &sampler);
+      break;
+    case arrow::Int32Type::type_id:
+      res = BuildAliasTablesForProperty<int32_t>(
+          pg, edge_weight_property_name, &sampler);
+      break;
+    case arrow::UInt64Type::type_id:
+      res = BuildAliasTablesForProperty<uint64_t>(
+          pg, edge_weight_property_name, &sampler);
+      break;
+    case arrow::Int64Type::type_id:
+      res = BuildAliasTablesForProperty<int64_t>(
+          pg, edge_weight_property_name, &sampler);
+      break;
+    case arrow::FloatType::type_id:
+      res = BuildAliasTablesForProperty<float>(
+          pg, edge_weight_property_name, &sampler);
+      break;
+    case arrow::DoubleType::type_id:
+      res = BuildAliasTablesForProperty<double>(
+          pg, edge_weight_property_name, &sampler);
+      break;
+    default:
+      return katana::ErrorCode::TypeError;
+    }
+    if (!res) {
+      return res.error();
+    }
+  }
+
   Algorithm algo(plan);
 
   katana::LargeArray<uint64_t> degree;
   degree.allocateBlocked(graph.size());
   InitializeDegrees<typename Algorithm::Graph>(graph, &degree);
 
+  uint64_t total_walks = uint64_t{graph.size()} * plan.number_of_walks() *
+                         Algorithm::NumRounds(plan);
+  if (!Algorithm::kBatches && walks_per_batch < total_walks) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "this algorithm needs all {} walks in one batch", total_walks);
+  }
+
+  // A walk of walk_length steps visits walk_length + 1 nodes, and it takes
+  // at least one step
+  uint64_t max_length = std::max<uint64_t>(plan.walk_length(), 1) + 1;
+
   katana::StatTimer execTime("RandomWalks");
-  execTime.start();
-  katana::InsertBag<std::vector<uint32_t>> walks;
-  algo(graph, &walks, degree);
-  execTime.stop();
-
-  degree.destroy();
-  degree.deallocate();
-
-  std::vector<std::vector<uint32_t>> walks_in_vector;
-  walks_in_vector.reserve(plan.number_of_walks());
-  std::move(walks.begin(), walks.end(), std::back_inserter(walks_in_vector));
-  return walks_in_vector;
+  for (uint64_t first = 0; first < total_walks; first += walks_per_batch) {
+    WalkSlots walks;
+    walks.Allocate(
+        first, std::min(walks_per_batch, total_walks - first), max_length,
+        degree, graph.size());
+
+    execTime.start();
+    algo(graph, sampler, &walks, degree);
+    execTime.stop();
+
+    if (auto res = callback(walks.Compact()); !res) {
+      return res.error();
+    }
+  }
+
+  return katana::ResultSuccess();
 }
 
-katana::Result<std::vector<std::vector<uint32_t>>>
+katana::Result<RandomWalkBuffer>
 katana::analytics::RandomWalks(PropertyGraph* pg, RandomWalksPlan plan) {
+  return RandomWalks(pg, "", plan);
+}
+
+katana::Result<RandomWalkBuffer>
+katana::analytics::RandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan) {
+  RandomWalkBuffer walks;
+  auto res = RandomWalks(
+      pg, edge_weight_property_name, plan,
+      std::numeric_limits<uint64_t>::max(),
+      [&walks](RandomWalkBuffer&& batch) -> katana::Result<void> {
+        walks = std::move(batch);
+        return katana::ResultSuccess();
+      });
+  if (!res) {
+    return res.error();
+  }
+  return RandomWalkBuffer(std::move(walks));
+}
+
+katana::Result<void>
+katana::analytics::RandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan, uint64_t walks_per_batch,
+    const RandomWalksBatchCallback& callback) {
   switch (plan.algorithm()) {
   case RandomWalksPlan::kNode2Vec:
-    return RandomWalksWithWrap<Node2VecAlgo>(pg, plan);
+    return RandomWalksWithWrap<Node2VecAlgo>(
+        pg, edge_weight_property_name, plan, walks_per_batch, callback);
   case RandomWalksPlan::kEdge2Vec:
-    return RandomWalksWithWrap<Edge2VecAlgo>(pg, plan);
+    return RandomWalksWithWrap<Edge2VecAlgo>(
+        pg, edge_weight_property_name, plan, walks_per_batch, callback);
   default:
     return ErrorCode::InvalidArgument;
   }
 }
 
+katana::Result<uint64_t>
+katana::analytics::RandomWalksToParquet(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan, const std::string& uri_prefix,
+    uint64_t walks_per_batch) {
+  auto uri_res = katana::Uri::Make(uri_prefix);
+  if (!uri_res) {
+    return uri_res.error();
+  }
+  katana::Uri uri = std::move(uri_res.value());
+
+  // The write of the previous batch, which runs while the next batch is
+  // generated
+  std::unique_ptr<tsuba::WriteGroup> pending;
+  uint64_t num_files = 0;
+
+  auto write_batch = [&](RandomWalkBuffer&& batch) -> katana::Result<void> {
+    auto array_res = batch.ToArrow();
+    if (!array_res) {
+      return array_res.error();
+    }
+    // The arrow copy is all that is written
+    batch = RandomWalkBuffer();
+
+    auto writer_res = tsuba::ParquetWriter::Make(
+        std::make_shared<arrow::ChunkedArray>(array_res.value()),
+        kRandomWalksColumnName);
+    if (!writer_res) {
+      return writer_res.error().WithContext("making walk writer");
+    }
+
+    // Wait for the previous batch, so that at most two are in memory
+    if (pending) {
+      auto res = pending->Finish();
+      pending.reset();
+      if (!res) {
+        return res.error().WithContext("writing walks");
+      }
+    }
+
+    auto group_res = tsuba::WriteGroup::Make();
+    if (!group_res) {
+      return group_res.error();
+    }
+    pending = std::move(group_res.value());
+    auto res = writer_res.value()->WriteToUri(
+        uri + fmt::format(".{:06}", num_files), pending.get());
+    if (!res) {
+      return res.error().WithContext("writing walks");
+    }
+    ++num_files;
+    return katana::ResultSuccess();
+  };
+
+  auto res = RandomWalks(
+      pg, edge_weight_property_name, plan, walks_per_batch, write_batch);
+  // The pending write refers to its group, so it is waited for even after
+  // an error
+  if (pending) {
+    auto finish_res = pending->Finish();
+    if (!finish_res) {
+      if (!res) {
+        KATANA_LOG_ERROR("multiple errors, masking: {}", finish_res.error());
+        return res.error();
+      }
+      return finish_res.error().WithContext("writing walks");
+    }
+  }
+  if (!res) {
+    return res.error();
+  }
+  return num_files;
+}
+
+katana::Result<std::shared_ptr<arrow::LargeListArray>>
+katana::analytics::RandomWalkBuffer::ToArrow() const {
+  uint64_t num_nodes = num_walks() == 0 ? 0 : offsets_[num_walks()];
+  arrow::Int64Builder offsets_builder;
+  arrow::UInt32Builder nodes_builder;
+  std::shared_ptr<arrow::Array> offsets_array;
+  std::shared_ptr<arrow::Array> nodes_array;
+  if (!offsets_builder.Resize(num_walks() + 1).ok() ||
+      !nodes_builder.AppendValues(nodes_.data(), num_nodes).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  offsets_builder.UnsafeAppend(0);
+  for (size_t i = 0; i < num_walks(); ++i) {
+    offsets_builder.UnsafeAppend(offsets_[i + 1]);
+  }
+  if (!offsets_builder.Finish(&offsets_array).ok() ||
+      !nodes_builder.Finish(&nodes_array).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  auto lists = arrow::LargeListArray::FromArrays(*offsets_array, *nodes_array);
+  if (!lists.ok()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "{}", lists.status().ToString());
+  }
+  return *lists;
+}
+
+std::vector<std::vector<uint32_t>>
+katana::analytics::RandomWalkBuffer::ToVectors() const {
+  std::vector<std::vector<uint32_t>> walks(num_walks());
+  katana::do_all(
+      katana::iterate(size_t{0}, num_walks()),
+      [&](size_t i) {
+        auto [begin, end] = walk(i);
+        walks[i].assign(begin, end);
+      },
+      katana::no_stats());
+  return walks;
+}
+
 /// \cond DO_NOT_DOCUMENT
 katana::Result<void>
 katana::analytics::RandomWalksAssertValid([
@@ -19,6 +19,11 @@
 
 #include "katana/analytics/sssp/sssp.h"
 
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <unordered_map>
+
 #include "katana/Reduction.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
@@ -125,6 +130,103 @@ struct SsspImplementation : public katana::analytics::BfsSsspImplementationBase<
     }
   }
 
+  /// Run DeltaStepAlgo with the worklist OBIMTy rebuilt for chunks of
+  /// \param chunk_size items
+  template <typename T, typename OBIMTy, typename P, typename R>
+  static void DeltaStepWithChunkSize(
+      unsigned chunk_size, katana::LargeArray<std::atomic<Weight>>* node_data,
+      katana::LargeArray<Weight>* edge_data, Graph* graph,
+      const typename Graph::Node& source, const P& pushWrap, const R& edgeRange,
+      unsigned stepShift) {
+    switch (chunk_size) {
+    case 16:
+      DeltaStepAlgo<
+          T, typename OBIMTy::template with_container<
+                 katana::PerSocketChunkFIFO<16>>::type>(
+          node_data, edge_data, graph, source, pushWrap, edgeRange, stepShift);
+      break;
+    case 256:
+      DeltaStepAlgo<
+          T, typename OBIMTy::template with_container<
+                 katana::PerSocketChunkFIFO<256>>::type>(
+          node_data, edge_data, graph, source, pushWrap, edgeRange, stepShift);
+      break;
+    default:
+      KATANA_LOG_DEBUG_ASSERT(chunk_size == kChunkSize);
+      DeltaStepAlgo<T, OBIMTy>(
+          node_data, edge_data, graph, source, pushWrap, edgeRange, stepShift);
+      break;
+    }
+  }
+
+  /// Resolve the automatic plan for \param graph. The algorithm is chosen as
+  /// by SsspPlan(const PropertyGraph*). Delta follows Meyer and Sanders: about
+  /// the largest edge weight over the average degree, using a high percentile
+  /// of a sample of the weights as the largest one so that a few outliers do
+  /// not inflate it. The chunk size is chosen to hold about the same number of
+  /// edges whatever the degree.
+  static SsspPlan AutomaticPlan(const Graph& graph) {
+    constexpr uint64_t kSampleNodes = 1024;
+    constexpr uint64_t kMaxSampleEdgesPerNode = 16;
+    constexpr double kWeightPercentile = 0.9;
+    constexpr double kEdgesPerChunk = 1024;
+    constexpr unsigned kMaxDelta = 30;
+
+    const katana::GraphTopology& topology = graph.GetPropertyGraph().topology();
+    uint64_t num_nodes = topology.num_nodes();
+
+    // Use a fixed seed so that a graph always gets the same plan
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<uint64_t> pick_node(0, num_nodes - 1);
+    uint64_t sampled_degrees = 0;
+    std::vector<Weight> weights;
+    for (uint64_t i = 0; i < kSampleNodes; ++i) {
+      auto [begin_edge, end_edge] = topology.edge_range(pick_node(gen));
+      sampled_degrees += end_edge - begin_edge;
+      end_edge = std::min(end_edge, begin_edge + kMaxSampleEdgesPerNode);
+      for (auto e = begin_edge; e < end_edge; ++e) {
+        weights.push_back(graph.template GetEdgeData<EdgeWeight>(
+            typename Graph::edge_iterator(e)));
+      }
+    }
+
+    double average_degree =
+        static_cast<double>(sampled_degrees) / kSampleNodes;
+    double max_weight = 0;
+    if (!weights.empty()) {
+      auto nth = weights.begin() +
+                 static_cast<size_t>(kWeightPercentile * (weights.size() - 1));
+      std::nth_element(weights.begin(), nth, weights.end());
+      max_weight = static_cast<double>(*nth);
+    }
+
+    double delta = max_weight / std::max(average_degree, 1.0);
+    unsigned step_shift = 0;
+    while (step_shift < kMaxDelta &&
+           static_cast<double>(uint64_t{2} << step_shift) <= delta) {
+      ++step_shift;
+    }
+
+    double edges_per_node = std::max(average_degree, 1.0);
+    unsigned chunk_size = kChunkSize;
+    if (kEdgesPerChunk / edges_per_node >= 128) {
+      chunk_size = 256;
+    } else if (kEdgesPerChunk / edges_per_node < 32) {
+      chunk_size = 16;
+    }
+
+    SsspPlan plan = SsspPlan(&graph.GetPropertyGraph()).algorithm() ==
+                            SsspPlan::kDeltaStep
+                        ? SsspPlan::DeltaStep(step_shift, chunk_size)
+                        : SsspPlan::DeltaStepBarrier(step_shift, chunk_size);
+
+    katana::ReportStatSingle(
+        "SSSP", "AutomaticAlgorithm", static_cast<int64_t>(plan.algorithm()));
+    katana::ReportStatSingle("SSSP", "AutomaticDelta", plan.delta());
+    katana::ReportStatSingle("SSSP", "AutomaticChunkSize", plan.chunk_size());
+    return plan;
+  }
+
   static void DeltaStepFusionAlgo(
       katana::LargeArray<std::atomic<Weight>>* node_data,
       katana::LargeArray<Weight>* edge_data, Graph* graph,
@@ -406,6 +508,13 @@ public:
       return katana::ErrorCode::InvalidArgument;
     }
 
+    if (plan.chunk_size() != 16 && plan.chunk_size() != kChunkSize &&
+        plan.chunk_size() != 256) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "unsupported chunk size {}",
+          plan.chunk_size());
+    }
+
     auto it = graph.begin();
     std::advance(it, start_node);
     typename Graph::Node source = *it;
@@ -440,24 +549,24 @@ public:
     execTime.start();
 
     if (plan.algorithm() == SsspPlan::kAutomatic) {
-      plan = SsspPlan(&graph.GetPropertyGraph());
+      plan = AutomaticPlan(graph);
     }
 
     switch (plan.algorithm()) {
     case SsspPlan::kDeltaTile:
-      DeltaStepAlgo<SrcEdgeTile>(
-          &node_data, &edge_data, &graph, source,
+      DeltaStepWithChunkSize<SrcEdgeTile, OBIM>(
+          plan.chunk_size(), &node_data, &edge_data, &graph, source,
           SrcEdgeTilePushWrap{&graph, *this}, TileRangeFn(), plan.delta());
       break;
     case SsspPlan::kDeltaStep:
-      DeltaStepAlgo<UpdateRequest>(
-          &node_data, &edge_data, &graph, source, ReqPushWrap(),
-          OutEdgeRangeFn{&graph}, plan.delta());
+      DeltaStepWithChunkSize<UpdateRequest, OBIM>(
+          plan.chunk_size(), &node_data, &edge_data, &graph, source,
+          ReqPushWrap(), OutEdgeRangeFn{&graph}, plan.delta());
       break;
     case SsspPlan::kDeltaStepBarrier:
-      DeltaStepAlgo<UpdateRequest, OBIMBarrier>(
-          &node_data, &edge_data, &graph, source, ReqPushWrap(),
-          OutEdgeRangeFn{&graph}, plan.delta());
+      DeltaStepWithChunkSize<UpdateRequest, OBIMBarrier>(
+          plan.chunk_size(), &node_data, &edge_data, &graph, source,
+          ReqPushWrap(), OutEdgeRangeFn{&graph}, plan.delta());
       break;
     case SsspPlan::kDeltaStepFusion:
       DeltaStepFusionAlgo(&node_data, &edge_data, &graph, source, plan.delta());
@@ -639,6 +748,802 @@ katana::analytics::SsspAssertValid(
 
 namespace {
 
+/// A delta-stepping search that is advanced one bucket at a time: the
+/// tentative distances from the node it starts at and per-thread buckets of
+/// nodes whose out-going (or, backward, in-coming) edges need relaxing.
+/// Optionally, it also records the node each tentative distance came from.
+template <typename Weight>
+struct SearchFrontier {
+  using Node = katana::GraphTopology::Node;
+  using Bucket = katana::gstl::Vector<Node>;
+  using Buckets = katana::gstl::Vector<Bucket>;
+
+  static constexpr Weight kDistanceInfinity =
+      SsspImplementation<Weight>::kDistanceInfinity;
+  static constexpr size_t kNoBucket = std::numeric_limits<size_t>::max();
+  /// Larger distances share the last bucket, which is relaxed until it
+  /// settles, so that large weights cannot grow the buckets without bound
+  static constexpr size_t kMaxBuckets = 4096;
+
+  /// Set in a parent while a thread updates it
+  static constexpr uint64_t kParentLocked = uint64_t{1} << 63;
+
+  katana::LargeArray<std::atomic<Weight>> dist;
+  /// The neighbor that the distance of each node was last lowered from; empty
+  /// unless the search tracks parents
+  katana::LargeArray<std::atomic<uint64_t>> parent;
+  katana::PerThreadStorage<Buckets> buckets;
+  unsigned step_shift;
+  /// The lowest bucket that may hold nodes, or kNoBucket when the search is
+  /// done
+  size_t cur_bucket{0};
+
+  SearchFrontier(
+      size_t num_nodes, Node origin, unsigned shift, bool track_parents)
+      : step_shift(shift) {
+    dist.allocateInterleaved(num_nodes);
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t n) { dist.constructAt(n, kDistanceInfinity); },
+        katana::no_stats());
+    dist[origin] = 0;
+    if (track_parents) {
+      parent.allocateInterleaved(num_nodes);
+      katana::do_all(
+          katana::iterate(size_t{0}, num_nodes),
+          [&](size_t n) { parent.constructAt(n, n); }, katana::no_stats());
+    }
+    Push(origin, 0);
+  }
+
+  size_t BucketIndex(Weight d) const {
+    return std::min<size_t>(d / (size_t{1} << step_shift), kMaxBuckets - 1);
+  }
+
+  void Push(Node n, Weight d) {
+    Buckets& b = *buckets.getLocal();
+    size_t idx = BucketIndex(d);
+    if (idx >= b.size()) {
+      b.resize(idx + 1);
+    }
+    b[idx].push_back(n);
+  }
+
+  /// Record that the distance of \param n was lowered to \param d from
+  /// \param from. A later relaxation may lower it again and record its own
+  /// parent concurrently; the lock makes sure the parent stored last is that
+  /// of the lowest distance.
+  void SetParent(Node n, Node from, Weight d) {
+    std::atomic<uint64_t>& p = parent[n];
+    uint64_t cur = p.load() & ~kParentLocked;
+    while (!p.compare_exchange_weak(cur, cur | kParentLocked)) {
+      cur &= ~kParentLocked;
+    }
+    p.store(dist[n].load() == d ? from : cur);
+  }
+
+  bool done() const { return cur_bucket == kNoBucket; }
+
+  /// \returns a lower bound on the distance of any node whose distance may
+  /// still change
+  double radius() const {
+    return static_cast<double>(cur_bucket) *
+           static_cast<double>(size_t{1} << step_shift);
+  }
+};
+
+template <typename Weight>
+using WeightedGraph = katana::TypedPropertyGraph<
+    std::tuple<>, std::tuple<SsspEdgeWeight<Weight>>>;
+
+/// \returns a function that calls its second argument with each out-neighbor
+/// of its first argument and the weight of the edge to it
+template <typename Weight>
+auto
+OutNeighbors(const WeightedGraph<Weight>& graph) {
+  using Node = katana::GraphTopology::Node;
+  return [&graph](Node n, const auto& fn) {
+    for (auto e : graph.edges(n)) {
+      fn(*graph.GetEdgeDest(e),
+         graph.template GetEdgeData<SsspEdgeWeight<Weight>>(e));
+    }
+  };
+}
+
+/// \returns a function that calls its second argument with each in-neighbor
+/// of its first argument and the weight of the edge from it. The in-edges of
+/// \param topology must be populated.
+template <typename Weight>
+auto
+InNeighbors(
+    const WeightedGraph<Weight>& graph, const katana::GraphTopology& topology) {
+  using Node = katana::GraphTopology::Node;
+  return [&graph, &topology](Node n, const auto& fn) {
+    for (auto e : topology.in_edges(n)) {
+      typename WeightedGraph<Weight>::edge_iterator edge(
+          topology.in_edge_to_edge(e));
+      fn(topology.in_edge_src(e),
+         graph.template GetEdgeData<SsspEdgeWeight<Weight>>(edge));
+    }
+  };
+}
+
+/// The best path length found so far and the node on which the forward and
+/// backward searches met for it
+template <typename Weight>
+using PointToPointMeeting = std::pair<Weight, katana::GraphTopology::Node>;
+
+/// Relax the nodes of the current bucket of \param frontier until it is empty,
+/// then move on to the next non-empty bucket. \param for_each_neighbor calls
+/// its second argument with each neighbor of a node in the direction of the
+/// search and the weight of the edge to it.
+///
+/// If \param other is not null, it is the search from the other end of a
+/// bidirectional query and the nodes reached by both are recorded in \param
+/// meetings.
+template <typename Weight, typename NeighborFn>
+void
+RelaxBucket(
+    SearchFrontier<Weight>* frontier, const SearchFrontier<Weight>* other,
+    katana::PerThreadStorage<PointToPointMeeting<Weight>>* meetings,
+    const NeighborFn& for_each_neighbor, const char* loopname) {
+  using Node = katana::GraphTopology::Node;
+  using Buckets = typename SearchFrontier<Weight>::Buckets;
+  constexpr Weight kDistanceInfinity =
+      SearchFrontier<Weight>::kDistanceInfinity;
+
+  size_t cur = frontier->cur_bucket;
+  katana::InsertBag<Node> wl;
+  auto gather = [&]() {
+    katana::on_each([&](unsigned, unsigned) {
+      Buckets& b = *frontier->buckets.getLocal();
+      if (cur >= b.size()) {
+        return;
+      }
+      for (Node n : b[cur]) {
+        wl.push(n);
+      }
+      b[cur].clear();
+    });
+  };
+
+  gather();
+  while (!wl.empty()) {
+    katana::do_all(
+        katana::iterate(wl),
+        [&](Node n) {
+          Weight sdist = frontier->dist[n];
+          // Skip nodes that have since moved to a lower bucket
+          if (frontier->BucketIndex(sdist) != cur) {
+            return;
+          }
+          for_each_neighbor(n, [&](Node m, Weight w) {
+            Weight new_dist = sdist + w;
+            Weight old_dist = katana::atomicMin(frontier->dist[m], new_dist);
+            if (new_dist >= old_dist) {
+              return;
+            }
+            if (frontier->parent.size() != 0) {
+              frontier->SetParent(m, n, new_dist);
+            }
+            frontier->Push(m, new_dist);
+            if (other == nullptr) {
+              return;
+            }
+            Weight other_dist = other->dist[m];
+            if (other_dist != kDistanceInfinity) {
+              auto& best = *meetings->getLocal();
+              if (new_dist + other_dist < best.first) {
+                best = {new_dist + other_dist, m};
+              }
+            }
+          });
+        },
+        katana::steal(), katana::loopname(loopname));
+    wl.clear();
+    gather();
+  }
+
+  katana::GReduceMin<size_t> least_bucket;
+  katana::on_each([&](unsigned, unsigned) {
+    Buckets& b = *frontier->buckets.getLocal();
+    for (size_t idx = cur + 1; idx < b.size(); ++idx) {
+      if (!b[idx].empty()) {
+        least_bucket.update(idx);
+        break;
+      }
+    }
+  });
+  frontier->cur_bucket = least_bucket.reduce();
+}
+
+/// Follow the parents recorded by \param frontier from \param from back to
+/// the origin of the search.
+///
+/// \returns the nodes visited, from the origin to \param from
+template <typename Weight>
+katana::Result<std::vector<katana::GraphTopology::Node>>
+ParentPath(
+    const SearchFrontier<Weight>& frontier, katana::GraphTopology::Node from) {
+  using Node = katana::GraphTopology::Node;
+
+  std::vector<Node> path{from};
+  while (frontier.parent[path.back()] != path.back()) {
+    // A distance is only lowered from a node at a lower or equal distance, so
+    // the parents cannot form a cycle
+    if (path.size() > frontier.parent.size()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed,
+          "parents of node {} form a cycle", from);
+    }
+    path.push_back(frontier.parent[path.back()]);
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+/// \returns the delta of \param plan if it is a delta-stepping plan and
+/// SsspPlan::kDefaultDelta otherwise
+unsigned
+SearchStepShift(const SsspPlan& plan) {
+  switch (plan.algorithm()) {
+  case SsspPlan::kDeltaTile:
+  case SsspPlan::kDeltaStep:
+  case SsspPlan::kDeltaStepBarrier:
+  case SsspPlan::kDeltaStepFusion:
+  case SsspPlan::kSerialDeltaTile:
+  case SsspPlan::kSerialDelta:
+    return plan.delta();
+  default:
+    return SsspPlan::kDefaultDelta;
+  }
+}
+
+template <typename Weight>
+katana::Result<SsspPath>
+SsspPointToPointImpl(
+    katana::PropertyGraph* pg, size_t start_node, size_t target_node,
+    const std::string& edge_weight_property_name, SsspPlan plan) {
+  using Node = katana::GraphTopology::Node;
+  using Graph = WeightedGraph<Weight>;
+  using Frontier = SearchFrontier<Weight>;
+  constexpr Weight kDistanceInfinity = Frontier::kDistanceInfinity;
+
+  if (start_node >= pg->num_nodes() || target_node >= pg->num_nodes()) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  if (start_node == target_node) {
+    return SsspPath{true, 0, {static_cast<Node>(start_node)}};
+  }
+
+  auto graph_result = Graph::Make(pg, {}, {edge_weight_property_name});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  Graph graph = graph_result.value();
+
+  // The backward search follows in-edges
+  if (auto res = pg->PopulateInEdges(); !res) {
+    return res.error();
+  }
+  const katana::GraphTopology& topology = pg->topology();
+
+  auto out_neighbors = OutNeighbors<Weight>(graph);
+  auto in_neighbors = InNeighbors<Weight>(graph, topology);
+
+  unsigned step_shift = SearchStepShift(plan);
+
+  katana::StatTimer exec_time("SSSP-PointToPoint");
+  exec_time.start();
+
+  Frontier forward(pg->num_nodes(), start_node, step_shift, true);
+  Frontier backward(pg->num_nodes(), target_node, step_shift, true);
+  katana::PerThreadStorage<PointToPointMeeting<Weight>> meetings;
+  katana::on_each([&](unsigned, unsigned) {
+    *meetings.getLocal() = {kDistanceInfinity, 0};
+  });
+
+  PointToPointMeeting<Weight> best{kDistanceInfinity, 0};
+  auto update_best = [&]() {
+    for (unsigned i = 0; i < meetings.size(); ++i) {
+      const auto& meeting = *meetings.getRemote(i);
+      if (meeting.first < best.first) {
+        best = meeting;
+      }
+    }
+  };
+
+  // Grow the search with the smaller radius until no unsettled node can be
+  // on a path shorter than the best one found
+  size_t rounds = 0;
+  while (!forward.done() && !backward.done() &&
+         forward.radius() + backward.radius() <
+             static_cast<double>(best.first)) {
+    ++rounds;
+    if (forward.radius() <= backward.radius()) {
+      RelaxBucket(
+          &forward, &backward, &meetings, out_neighbors, "SSSP-PointToPoint");
+    } else {
+      RelaxBucket(
+          &backward, &forward, &meetings, in_neighbors, "SSSP-PointToPoint");
+    }
+    update_best();
+  }
+
+  exec_time.stop();
+  katana::ReportStatSingle("SSSP-PointToPoint", "rounds", rounds);
+
+  if (best.first == kDistanceInfinity) {
+    return SsspPath{};
+  }
+
+  auto to_meeting = ParentPath(forward, best.second);
+  if (!to_meeting) {
+    return to_meeting.error();
+  }
+  auto from_meeting = ParentPath(backward, best.second);
+  if (!from_meeting) {
+    return from_meeting.error();
+  }
+
+  SsspPath path{true, static_cast<double>(best.first), {}};
+  path.nodes = std::move(to_meeting.value());
+  path.nodes.insert(
+      path.nodes.end(), from_meeting.value().rbegin() + 1,
+      from_meeting.value().rend());
+  return path;
+}
+
+}  // namespace
+
+katana::Result<SsspPath>
+katana::analytics::SsspPointToPoint(
+    PropertyGraph* pg, size_t start_node, size_t target_node,
+    const std::string& edge_weight_property_name, SsspPlan plan) {
+  switch (pg->GetEdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return SsspPointToPointImpl<uint32_t>(
+        pg, start_node, target_node, edge_weight_property_name, plan);
+  case arrow::Int32Type::type_id:
+    return SsspPointToPointImpl<int32_t>(
+        pg, start_node, target_node, edge_weight_property_name, plan);
+  case arrow::UInt64Type::type_id:
+    return SsspPointToPointImpl<uint64_t>(
+        pg, start_node, target_node, edge_weight_property_name, plan);
+  case arrow::Int64Type::type_id:
+    return SsspPointToPointImpl<int64_t>(
+        pg, start_node, target_node, edge_weight_property_name, plan);
+  case arrow::FloatType::type_id:
+    return SsspPointToPointImpl<float>(
+        pg, start_node, target_node, edge_weight_property_name, plan);
+  case arrow::DoubleType::type_id:
+    return SsspPointToPointImpl<double>(
+        pg, start_node, target_node, edge_weight_property_name, plan);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+namespace {
+
+constexpr const char* kLandmarkFrom = "from";
+constexpr const char* kLandmarkTo = "to";
+
+/// \returns the name of the property holding the distances from (\param
+/// direction kLandmarkFrom) or to (kLandmarkTo) landmark \param landmark
+std::string
+LandmarkPropertyName(
+    const std::string& prefix, const char* direction, uint32_t landmark) {
+  return prefix + direction + "_" + std::to_string(landmark);
+}
+
+template <typename Weight>
+using LandmarkDistanceGraph = katana::TypedPropertyGraph<
+    std::tuple<SsspNodeDistance<Weight>>, std::tuple<>>;
+
+/// Run the search of \param frontier until every reachable node is settled
+template <typename Weight, typename NeighborFn>
+void
+RelaxAll(
+    SearchFrontier<Weight>* frontier, const NeighborFn& for_each_neighbor,
+    const char* loopname) {
+  while (!frontier->done()) {
+    RelaxBucket<Weight>(
+        frontier, nullptr, nullptr, for_each_neighbor, loopname);
+  }
+}
+
+/// Store the distances of \param frontier in a new node property of \param pg
+/// named \param name
+template <typename Weight>
+katana::Result<void>
+StoreDistances(
+    katana::PropertyGraph* pg, const std::string& name,
+    const SearchFrontier<Weight>& frontier) {
+  if (auto r = ConstructNodeProperties<std::tuple<SsspNodeDistance<Weight>>>(
+          pg, {name});
+      !r) {
+    return r.error();
+  }
+  auto graph_result = LandmarkDistanceGraph<Weight>::Make(pg, {name}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const typename LandmarkDistanceGraph<Weight>::Node& n) {
+        graph.template GetData<SsspNodeDistance<Weight>>(n) =
+            frontier.dist[n].load(std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+template <typename Weight>
+katana::Result<void>
+SsspBuildLandmarkIndexImpl(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    uint32_t num_landmarks, const std::string& index_property_prefix,
+    SsspPlan plan) {
+  using Node = katana::GraphTopology::Node;
+  using Frontier = SearchFrontier<Weight>;
+  constexpr Weight kDistanceInfinity = Frontier::kDistanceInfinity;
+
+  if (num_landmarks == 0 || num_landmarks > pg->num_nodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "cannot pick {} landmarks among {} nodes", num_landmarks,
+        pg->num_nodes());
+  }
+
+  auto graph_result =
+      WeightedGraph<Weight>::Make(pg, {}, {edge_weight_property_name});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  WeightedGraph<Weight> graph = graph_result.value();
+
+  // Distances to the landmarks are found by searching along in-edges
+  if (auto res = pg->PopulateInEdges(); !res) {
+    return res.error();
+  }
+  const katana::GraphTopology& topology = pg->topology();
+
+  auto out_neighbors = OutNeighbors<Weight>(graph);
+  auto in_neighbors = InNeighbors<Weight>(graph, topology);
+  unsigned step_shift = SearchStepShift(plan);
+
+  katana::StatTimer exec_time("SSSP-BuildLandmarkIndex");
+  exec_time.start();
+
+  // The distance to each node from the nearest landmark picked so far
+  katana::LargeArray<Weight> nearest;
+  nearest.allocateInterleaved(pg->num_nodes());
+  katana::do_all(
+      katana::iterate(size_t{0}, pg->num_nodes()),
+      [&](size_t n) { nearest[n] = kDistanceInfinity; }, katana::no_stats());
+  std::vector<bool> is_landmark(pg->num_nodes());
+
+  // Start from a random node and then repeatedly take the node farthest from
+  // the landmarks picked so far, preferring nodes none of them reach. This
+  // spreads the landmarks to the fringes of the graph, from where their
+  // bounds are tightest.
+  std::mt19937 gen(0);
+  Node landmark =
+      std::uniform_int_distribution<Node>(0, pg->num_nodes() - 1)(gen);
+  std::vector<std::string> names;
+  for (uint32_t i = 0; i < num_landmarks; ++i) {
+    is_landmark[landmark] = true;
+
+    Frontier from(pg->num_nodes(), landmark, step_shift, false);
+    RelaxAll(&from, out_neighbors, "SSSP-BuildLandmarkIndex");
+    names.emplace_back(
+        LandmarkPropertyName(index_property_prefix, kLandmarkFrom, i));
+    if (auto res = StoreDistances(pg, names.back(), from); !res) {
+      return res.error();
+    }
+
+    Frontier to(pg->num_nodes(), landmark, step_shift, false);
+    RelaxAll(&to, in_neighbors, "SSSP-BuildLandmarkIndex");
+    names.emplace_back(
+        LandmarkPropertyName(index_property_prefix, kLandmarkTo, i));
+    if (auto res = StoreDistances(pg, names.back(), to); !res) {
+      return res.error();
+    }
+
+    if (i + 1 == num_landmarks) {
+      break;
+    }
+
+    katana::PerThreadStorage<std::pair<Weight, Node>> farthest;
+    katana::on_each([&](unsigned, unsigned) {
+      *farthest.getLocal() = {0, std::numeric_limits<Node>::max()};
+    });
+    katana::do_all(
+        katana::iterate(size_t{0}, pg->num_nodes()),
+        [&](size_t n) {
+          Weight d = std::min<Weight>(nearest[n], from.dist[n]);
+          nearest[n] = d;
+          if (is_landmark[n]) {
+            return;
+          }
+          auto& best = *farthest.getLocal();
+          if (d > best.first || (d == best.first && n < best.second)) {
+            best = {d, static_cast<Node>(n)};
+          }
+        },
+        katana::no_stats());
+
+    std::pair<Weight, Node> best{0, std::numeric_limits<Node>::max()};
+    for (unsigned t = 0; t < farthest.size(); ++t) {
+      const auto& candidate = *farthest.getRemote(t);
+      if (candidate.first > best.first ||
+          (candidate.first == best.first && candidate.second < best.second)) {
+        best = candidate;
+      }
+    }
+    KATANA_LOG_ASSERT(best.second < pg->num_nodes());
+    landmark = best.second;
+  }
+
+  // Properties are named by position when marking them persistent
+  std::shared_ptr<arrow::Schema> schema = pg->node_schema();
+  std::vector<std::string> persist(schema->num_fields());
+  for (const auto& name : names) {
+    persist[schema->GetFieldIndex(name)] = name;
+  }
+  if (auto res = pg->MarkNodePropertiesPersistent(persist); !res) {
+    return res.error();
+  }
+
+  exec_time.stop();
+  katana::ReportStatSingle(
+      "SSSP-BuildLandmarkIndex", "landmarks", num_landmarks);
+  return katana::ResultSuccess();
+}
+
+/// The state of a node reached by SsspLandmarkQuery
+template <typename Weight>
+struct LandmarkLabel {
+  Weight dist{SsspImplementation<Weight>::kDistanceInfinity};
+  /// Lower bound on the distance from the node to the target
+  double potential{0};
+  katana::GraphTopology::Node parent{0};
+  bool settled{false};
+};
+
+template <typename Weight>
+katana::Result<SsspPath>
+SsspLandmarkQueryImpl(
+    katana::PropertyGraph* pg, size_t start_node, size_t target_node,
+    const std::string& edge_weight_property_name,
+    const std::string& index_property_prefix) {
+  using Node = katana::GraphTopology::Node;
+  using DistanceGraph = LandmarkDistanceGraph<Weight>;
+  using NodeDistance = SsspNodeDistance<Weight>;
+  constexpr Weight kDistanceInfinity =
+      SsspImplementation<Weight>::kDistanceInfinity;
+  constexpr double kUnreachable = std::numeric_limits<double>::infinity();
+
+  if (start_node >= pg->num_nodes() || target_node >= pg->num_nodes()) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  if (start_node == target_node) {
+    return SsspPath{true, 0, {static_cast<Node>(start_node)}};
+  }
+
+  auto graph_result =
+      WeightedGraph<Weight>::Make(pg, {}, {edge_weight_property_name});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  WeightedGraph<Weight> graph = graph_result.value();
+  auto out_neighbors = OutNeighbors<Weight>(graph);
+
+  std::vector<DistanceGraph> from_graphs;
+  std::vector<DistanceGraph> to_graphs;
+  for (uint32_t i = 0; pg->HasNodeProperty(LandmarkPropertyName(
+           index_property_prefix, kLandmarkFrom, i));
+       ++i) {
+    auto from_result = DistanceGraph::Make(
+        pg, {LandmarkPropertyName(index_property_prefix, kLandmarkFrom, i)},
+        {});
+    if (!from_result) {
+      return from_result.error();
+    }
+    auto to_result = DistanceGraph::Make(
+        pg, {LandmarkPropertyName(index_property_prefix, kLandmarkTo, i)}, {});
+    if (!to_result) {
+      return to_result.error();
+    }
+    from_graphs.emplace_back(std::move(from_result.value()));
+    to_graphs.emplace_back(std::move(to_result.value()));
+  }
+  if (from_graphs.empty()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::PropertyNotFound, "no landmark index named {}",
+        index_property_prefix);
+  }
+  size_t num_landmarks = from_graphs.size();
+
+  std::vector<Weight> from_target(num_landmarks);
+  std::vector<Weight> to_target(num_landmarks);
+  for (size_t i = 0; i < num_landmarks; ++i) {
+    from_target[i] = from_graphs[i].template GetData<NodeDistance>(target_node);
+    to_target[i] = to_graphs[i].template GetData<NodeDistance>(target_node);
+  }
+
+  // By the triangle inequality, d(n, t) >= d(L, t) - d(L, n) and d(n, t) >=
+  // d(n, L) - d(t, L) for every landmark L. Infinite distances instead show
+  // that n cannot reach t when L reaches n but not t, or t reaches L but n
+  // does not.
+  auto potential = [&](Node n) {
+    double bound = 0;
+    for (size_t i = 0; i < num_landmarks; ++i) {
+      Weight from_n = from_graphs[i].template GetData<NodeDistance>(n);
+      Weight to_n = to_graphs[i].template GetData<NodeDistance>(n);
+      if (from_n != kDistanceInfinity) {
+        if (from_target[i] == kDistanceInfinity) {
+          return kUnreachable;
+        }
+        bound = std::max(
+            bound, static_cast<double>(from_target[i]) -
+                       static_cast<double>(from_n));
+      }
+      if (to_target[i] != kDistanceInfinity) {
+        if (to_n == kDistanceInfinity) {
+          return kUnreachable;
+        }
+        bound = std::max(
+            bound,
+            static_cast<double>(to_n) - static_cast<double>(to_target[i]));
+      }
+    }
+    return bound;
+  };
+
+  katana::StatTimer exec_time("SSSP-LandmarkQuery");
+  exec_time.start();
+
+  // A* search: the landmark bounds are consistent, so a node is settled the
+  // first time it leaves the queue
+  using QueueEntry = std::pair<double, Node>;
+  std::priority_queue<
+      QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>
+      queue;
+  std::unordered_map<Node, LandmarkLabel<Weight>> labels;
+
+  LandmarkLabel<Weight>& start = labels[start_node];
+  start.dist = 0;
+  start.potential = potential(start_node);
+  if (start.potential != kUnreachable) {
+    queue.emplace(start.potential, start_node);
+  }
+
+  size_t settled = 0;
+  while (!queue.empty()) {
+    Node n = queue.top().second;
+    queue.pop();
+    LandmarkLabel<Weight>& label = labels[n];
+    if (label.settled) {
+      continue;
+    }
+    label.settled = true;
+    ++settled;
+    if (n == target_node) {
+      break;
+    }
+
+    Weight ndist = label.dist;
+    out_neighbors(n, [&](Node m, Weight w) {
+      auto [it, inserted] = labels.try_emplace(m);
+      LandmarkLabel<Weight>& neighbor = it->second;
+      if (inserted) {
+        neighbor.potential = potential(m);
+      }
+      Weight new_dist = ndist + w;
+      if (neighbor.settled || neighbor.potential == kUnreachable ||
+          new_dist >= neighbor.dist) {
+        return;
+      }
+      neighbor.dist = new_dist;
+      neighbor.parent = n;
+      queue.emplace(static_cast<double>(new_dist) + neighbor.potential, m);
+    });
+  }
+
+  exec_time.stop();
+  katana::ReportStatSingle("SSSP-LandmarkQuery", "settled", settled);
+
+  auto target = labels.find(target_node);
+  if (target == labels.end() || !target->second.settled) {
+    return SsspPath{};
+  }
+
+  SsspPath path{true, static_cast<double>(target->second.dist), {}};
+  for (Node n = target_node; n != start_node; n = labels[n].parent) {
+    path.nodes.push_back(n);
+  }
+  path.nodes.push_back(start_node);
+  std::reverse(path.nodes.begin(), path.nodes.end());
+  return path;
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::SsspBuildLandmarkIndex(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    uint32_t num_landmarks, const std::string& index_property_prefix,
+    SsspPlan plan) {
+  switch (pg->GetEdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return SsspBuildLandmarkIndexImpl<uint32_t>(
+        pg, edge_weight_property_name, num_landmarks, index_property_prefix,
+        plan);
+  case arrow::Int32Type::type_id:
+    return SsspBuildLandmarkIndexImpl<int32_t>(
+        pg, edge_weight_property_name, num_landmarks, index_property_prefix,
+        plan);
+  case arrow::UInt64Type::type_id:
+    return SsspBuildLandmarkIndexImpl<uint64_t>(
+        pg, edge_weight_property_name, num_landmarks, index_property_prefix,
+        plan);
+  case arrow::Int64Type::type_id:
+    return SsspBuildLandmarkIndexImpl<int64_t>(
+        pg, edge_weight_property_name, num_landmarks, index_property_prefix,
+        plan);
+  case arrow::FloatType::type_id:
+    return SsspBuildLandmarkIndexImpl<float>(
+        pg, edge_weight_property_name, num_landmarks, index_property_prefix,
+        plan);
+  case arrow::DoubleType::type_id:
+    return SsspBuildLandmarkIndexImpl<double>(
+        pg, edge_weight_property_name, num_landmarks, index_property_prefix,
+        plan);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+katana::Result<SsspPath>
+katana::analytics::SsspLandmarkQuery(
+    PropertyGraph* pg, size_t start_node, size_t target_node,
+    const std::string& edge_weight_property_name,
+    const std::string& index_property_prefix) {
+  switch (pg->GetEdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return SsspLandmarkQueryImpl<uint32_t>(
+        pg, start_node, target_node, edge_weight_property_name,
+        index_property_prefix);
+  case arrow::Int32Type::type_id:
+    return SsspLandmarkQueryImpl<int32_t>(
+        pg, start_node, target_node, edge_weight_property_name,
+        index_property_prefix);
+  case arrow::UInt64Type::type_id:
+    return SsspLandmarkQueryImpl<uint64_t>(
+        pg, start_node, target_node, edge_weight_property_name,
+        index_property_prefix);
+  case arrow::Int64Type::type_id:
+    return SsspLandmarkQueryImpl<int64_t>(
+        pg, start_node, target_node, edge_weight_property_name,
+        index_property_prefix);
+  case arrow::FloatType::type_id:
+    return SsspLandmarkQueryImpl<float>(
+        pg, start_node, target_node, edge_weight_property_name,
+        index_property_prefix);
+  case arrow::DoubleType::type_id:
+    return SsspLandmarkQueryImpl<double>(
+        pg, start_node, target_node, edge_weight_property_name,
+        index_property_prefix);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+namespace {
+
 template <typename Weight>
 static katana::Result<SsspStatistics>
 ComputeStatistics(
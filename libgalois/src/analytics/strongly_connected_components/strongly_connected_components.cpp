@@ -0,0 +1,504 @@
+#include "katana/analytics/strongly_connected_components/strongly_connected_components.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+constexpr uint64_t kUnassigned = std::numeric_limits<uint64_t>::max();
+
+struct NodeComponent : public katana::AtomicPODProperty<uint64_t> {};
+
+using Graph =
+    katana::TypedPropertyGraph<std::tuple<NodeComponent>, std::tuple<>>;
+
+/// Tarjan's algorithm with an explicit stack, storing the root of each
+/// component (the first node of it visited) as its id with set_component
+template <typename SetComponent>
+void
+SerialScc(const katana::GraphTopology& topology, SetComponent set_component) {
+  constexpr Node kNotVisited = std::numeric_limits<Node>::max();
+  const size_t num_nodes = topology.num_nodes();
+
+  std::vector<Node> index(num_nodes, kNotVisited);
+  std::vector<Node> lowlink(num_nodes);
+  std::vector<bool> on_stack(num_nodes);
+  std::vector<Node> stack;
+  std::vector<std::pair<Node, Edge>> call_stack;
+  Node next_index = 0;
+
+  auto visit = [&](Node v) {
+    index[v] = lowlink[v] = next_index++;
+    stack.emplace_back(v);
+    on_stack[v] = true;
+    call_stack.emplace_back(v, *topology.edges(v).begin());
+  };
+
+  for (Node root = 0; root < num_nodes; ++root) {
+    if (index[root] != kNotVisited) {
+      continue;
+    }
+    visit(root);
+    while (!call_stack.empty()) {
+      auto [v, e] = call_stack.back();
+      if (e < *topology.edges(v).end()) {
+        ++call_stack.back().second;
+        Node w = topology.edge_dest(e);
+        if (index[w] == kNotVisited) {
+          visit(w);
+        } else if (on_stack[w]) {
+          lowlink[v] = std::min(lowlink[v], index[w]);
+        }
+        continue;
+      }
+
+      if (lowlink[v] == index[v]) {
+        Node w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          on_stack[w] = false;
+          set_component(w, v);
+        } while (w != v);
+      }
+      call_stack.pop_back();
+      if (!call_stack.empty()) {
+        Node u = call_stack.back().first;
+        lowlink[u] = std::min(lowlink[u], lowlink[v]);
+      }
+    }
+  }
+}
+
+/// The parallel algorithms, which remove the nodes of each component from
+/// the graph as it is found. A node is removed once its component is set.
+class ParallelScc {
+  const katana::GraphTopology& topology_;
+  Graph* graph_;
+
+  std::atomic<uint64_t>& component(Node n) {
+    return graph_->GetData<NodeComponent>(n);
+  }
+
+  bool IsActive(Node n) {
+    return component(n).load(std::memory_order_relaxed) == kUnassigned;
+  }
+
+  /// Claim n for component c, returning false if it was already claimed
+  bool Claim(Node n, uint64_t c) {
+    uint64_t expected = kUnassigned;
+    return component(n).compare_exchange_strong(
+        expected, c, std::memory_order_relaxed);
+  }
+
+  template <typename Fn>
+  void ForOutNeighbors(Node n, Fn fn) {
+    for (auto e : topology_.edges(n)) {
+      fn(topology_.edge_dest(e));
+    }
+  }
+
+  template <typename Fn>
+  void ForInNeighbors(Node n, Fn fn) {
+    for (auto e : topology_.in_edges(n)) {
+      fn(topology_.in_edge_src(e));
+    }
+  }
+
+public:
+  ParallelScc(const katana::GraphTopology& topology, Graph* graph)
+      : topology_(topology), graph_(graph) {}
+
+  void Initialize() {
+    katana::do_all(
+        katana::iterate(topology_),
+        [&](Node n) { component(n).store(kUnassigned); }, katana::no_stats());
+  }
+
+  /// Remove nodes with no in-edges or no out-edges from other remaining
+  /// nodes, which are components on their own. Removing a node may expose
+  /// others, which a later pass (or a later node in the same pass) picks
+  /// up. The number of passes is bounded, so a long chain may be left to
+  /// coloring, which is no faster on it: when ids ascend along the chain,
+  /// each round of coloring only settles its first node.
+  void Trim(uint32_t rounds) {
+    katana::GAccumulator<uint64_t> trimmed;
+    for (uint32_t round = 0; round < rounds; ++round) {
+      katana::GAccumulator<uint64_t> round_trimmed;
+      katana::do_all(
+          katana::iterate(topology_),
+          [&](Node n) {
+            if (!IsActive(n)) {
+              return;
+            }
+            bool has_out = false;
+            ForOutNeighbors(n, [&](Node dest) {
+              has_out |= dest != n && IsActive(dest);
+            });
+            bool has_in = false;
+            if (has_out) {
+              ForInNeighbors(n, [&](Node src) {
+                has_in |= src != n && IsActive(src);
+              });
+            }
+            if (!has_in || !has_out) {
+              component(n).store(n, std::memory_order_relaxed);
+              round_trimmed += 1;
+            }
+          },
+          katana::steal(), katana::loopname("SCC-Trim"));
+      uint64_t num_trimmed = round_trimmed.reduce();
+      trimmed += num_trimmed;
+      if (num_trimmed == 0) {
+        break;
+      }
+    }
+    katana::ReportStatSingle("SCC", "Trimmed", trimmed.reduce());
+  }
+
+  /// Find the component of the remaining node with the most in-edges times
+  /// out-edges, the one most likely to be in the giant component, as the
+  /// intersection of the nodes it reaches and the nodes that reach it
+  void ForwardBackward() {
+    katana::PerThreadStorage<std::pair<uint64_t, Node>> best_per_thread;
+    katana::on_each([&](unsigned, unsigned) {
+      *best_per_thread.getLocal() = {0, 0};
+    });
+    katana::GReduceLogicalOr any_active;
+    katana::do_all(
+        katana::iterate(topology_),
+        [&](Node n) {
+          if (!IsActive(n)) {
+            return;
+          }
+          any_active.update(true);
+          auto [out_begin, out_end] = topology_.edge_range(n);
+          auto in_edges = topology_.in_edges(n);
+          uint64_t score = (out_end - out_begin + 1) *
+                           (*in_edges.end() - *in_edges.begin() + 1);
+          auto& best = *best_per_thread.getLocal();
+          if (score > best.first) {
+            best = {score, n};
+          }
+        },
+        katana::no_stats());
+    if (!any_active.reduce()) {
+      return;
+    }
+    std::pair<uint64_t, Node> best{0, 0};
+    for (unsigned t = 0; t < best_per_thread.size(); ++t) {
+      best = std::max(best, *best_per_thread.getRemote(t));
+    }
+    const Node pivot = best.second;
+
+    katana::DynamicBitset forward;
+    forward.resize(topology_.num_nodes());
+    forward.set(pivot);
+    auto current = std::make_unique<katana::InsertBag<Node>>();
+    auto next = std::make_unique<katana::InsertBag<Node>>();
+    next->emplace(pivot);
+    while (!next->empty()) {
+      std::swap(current, next);
+      next->clear();
+      katana::do_all(
+          katana::iterate(*current),
+          [&](Node n) {
+            ForOutNeighbors(n, [&](Node dest) {
+              if (IsActive(dest) && !forward.set(dest)) {
+                next->emplace(dest);
+              }
+            });
+          },
+          katana::steal(), katana::loopname("SCC-Forward"));
+    }
+
+    katana::GAccumulator<uint64_t> size;
+    Claim(pivot, pivot);
+    size += 1;
+    next->emplace(pivot);
+    while (!next->empty()) {
+      std::swap(current, next);
+      next->clear();
+      katana::do_all(
+          katana::iterate(*current),
+          [&](Node n) {
+            ForInNeighbors(n, [&](Node src) {
+              if (forward.test(src) && Claim(src, pivot)) {
+                size += 1;
+                next->emplace(src);
+              }
+            });
+          },
+          katana::steal(), katana::loopname("SCC-Backward"));
+    }
+    katana::ReportStatSingle("SCC", "ForwardBackwardSize", size.reduce());
+  }
+
+  /// Find the components of all remaining nodes by rounds of coloring
+  void Coloring() {
+    katana::LargeArray<std::atomic<Node>> color;
+    color.allocateBlocked(topology_.num_nodes());
+
+    auto active = std::make_unique<katana::InsertBag<Node>>();
+    katana::do_all(
+        katana::iterate(topology_),
+        [&](Node n) {
+          color.constructAt(n, n);
+          if (IsActive(n)) {
+            active->emplace(n);
+          }
+        },
+        katana::no_stats());
+
+    auto current = std::make_unique<katana::InsertBag<Node>>();
+    auto next = std::make_unique<katana::InsertBag<Node>>();
+    uint64_t rounds = 0;
+    while (!active->empty()) {
+      ++rounds;
+
+      // Propagate the smallest color forward, starting from every node
+      katana::do_all(
+          katana::iterate(*active),
+          [&](Node n) {
+            color[n].store(n, std::memory_order_relaxed);
+            next->emplace(n);
+          },
+          katana::no_stats());
+      while (!next->empty()) {
+        std::swap(current, next);
+        next->clear();
+        katana::do_all(
+            katana::iterate(*current),
+            [&](Node n) {
+              Node c = color[n].load(std::memory_order_relaxed);
+              ForOutNeighbors(n, [&](Node dest) {
+                if (IsActive(dest) && katana::atomicMin(color[dest], c) > c) {
+                  next->emplace(dest);
+                }
+              });
+            },
+            katana::steal(), katana::loopname("SCC-Color"));
+      }
+
+      // The nodes that kept their own color are roots; the component of a
+      // root is the nodes of its color that reach it
+      katana::do_all(
+          katana::iterate(*active),
+          [&](Node n) {
+            if (color[n].load(std::memory_order_relaxed) == n) {
+              Claim(n, n);
+              next->emplace(n);
+            }
+          },
+          katana::no_stats());
+      while (!next->empty()) {
+        std::swap(current, next);
+        next->clear();
+        katana::do_all(
+            katana::iterate(*current),
+            [&](Node n) {
+              Node c = color[n].load(std::memory_order_relaxed);
+              ForInNeighbors(n, [&](Node src) {
+                if (color[src].load(std::memory_order_relaxed) == c &&
+                    Claim(src, c)) {
+                  next->emplace(src);
+                }
+              });
+            },
+            katana::steal(), katana::loopname("SCC-ColorBackward"));
+      }
+
+      auto remaining = std::make_unique<katana::InsertBag<Node>>();
+      katana::do_all(
+          katana::iterate(*active),
+          [&](Node n) {
+            if (IsActive(n)) {
+              remaining->emplace(n);
+            }
+          },
+          katana::no_stats());
+      std::swap(active, remaining);
+    }
+    katana::ReportStatSingle("SCC", "ColoringRounds", rounds);
+  }
+};
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::StronglyConnectedComponents(
+    PropertyGraph* pg, const std::string& output_property_name,
+    StronglyConnectedComponentsPlan plan) {
+  if (plan.algorithm() != StronglyConnectedComponentsPlan::kSerial) {
+    if (auto res = pg->PopulateInEdges(); !res) {
+      return res.error();
+    }
+  }
+
+  katana::EnsurePreallocated(
+      2, pg->topology().num_nodes() * (sizeof(uint64_t) + sizeof(Node)));
+  katana::ReportPageAllocGuard page_alloc;
+
+  if (auto r = ConstructNodeProperties<std::tuple<NodeComponent>>(
+          pg, {output_property_name});
+      !r) {
+    return r.error();
+  }
+  auto pg_result = Graph::Make(pg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+  const auto& topology = pg->topology();
+
+  katana::StatTimer exec_time("SCC");
+  katana::TimerGuard timer_guard(exec_time);
+
+  switch (plan.algorithm()) {
+  case StronglyConnectedComponentsPlan::kSerial:
+    SerialScc(topology, [&graph](Node n, uint64_t c) {
+      graph.GetData<NodeComponent>(n).store(c, std::memory_order_relaxed);
+    });
+    return katana::ResultSuccess();
+  case StronglyConnectedComponentsPlan::kColoring: {
+    ParallelScc algo(topology, &graph);
+    algo.Initialize();
+    algo.Trim(plan.trim_rounds());
+    algo.Coloring();
+    return katana::ResultSuccess();
+  }
+  case StronglyConnectedComponentsPlan::kForwardBackward: {
+    ParallelScc algo(topology, &graph);
+    algo.Initialize();
+    algo.Trim(plan.trim_rounds());
+    algo.ForwardBackward();
+    algo.Coloring();
+    return katana::ResultSuccess();
+  }
+  default:
+    return ErrorCode::InvalidArgument;
+  }
+}
+
+katana::Result<void>
+katana::analytics::StronglyConnectedComponentsAssertValid(
+    PropertyGraph* pg, const std::string& property_name) {
+  auto pg_result = katana::TypedPropertyGraph<
+      std::tuple<katana::PODProperty<uint64_t>>,
+      std::tuple<>>::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+  const size_t num_nodes = graph.size();
+
+  katana::LargeArray<uint64_t> expected;
+  expected.allocateBlocked(num_nodes);
+  SerialScc(pg->topology(), [&expected](Node n, uint64_t c) {
+    expected[n] = c;
+  });
+
+  // Both are ids of nodes in the component, so the components are the same
+  // if each id is in the component of the other
+  auto is_bad = [&](const Node& n) {
+    uint64_t c = graph.GetData<katana::PODProperty<uint64_t>>(n);
+    if (c >= num_nodes || expected[c] != expected[n] ||
+        graph.GetData<katana::PODProperty<uint64_t>>(expected[n]) != c) {
+      KATANA_LOG_DEBUG(
+          "node {} has component {} but is in the component of {}", n, c,
+          expected[n]);
+      return true;
+    }
+    return false;
+  };
+  if (katana::ParallelSTL::find_if(graph.begin(), graph.end(), is_bad) !=
+      graph.end()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<StronglyConnectedComponentsStatistics>
+katana::analytics::StronglyConnectedComponentsStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto pg_result = katana::TypedPropertyGraph<
+      std::tuple<katana::PODProperty<uint64_t>>,
+      std::tuple<>>::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+  const size_t num_nodes = graph.size();
+
+  katana::LargeArray<std::atomic<uint64_t>> sizes;
+  sizes.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(graph), [&](const Node& n) { sizes.constructAt(n, 0); },
+      katana::no_stats());
+
+  katana::GReduceLogicalOr bad_component;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        uint64_t c = graph.GetData<katana::PODProperty<uint64_t>>(n);
+        if (c >= num_nodes) {
+          bad_component.update(true);
+          return;
+        }
+        katana::atomicAdd(sizes[c], uint64_t{1});
+      },
+      katana::no_stats());
+  if (bad_component.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "component ids must be node ids");
+  }
+
+  katana::GAccumulator<uint64_t> total;
+  katana::GAccumulator<uint64_t> non_trivial;
+  katana::GReduceMax<uint64_t> largest;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        uint64_t size = sizes[n].load(std::memory_order_relaxed);
+        if (size > 0) {
+          total += 1;
+        }
+        if (size > 1) {
+          non_trivial += 1;
+        }
+        largest.update(size);
+      },
+      katana::no_stats());
+
+  uint64_t largest_size = num_nodes > 0 ? largest.reduce() : 0;
+  double largest_ratio = 0;
+  if (num_nodes > 0) {
+    largest_ratio = double(largest_size) / num_nodes;
+  }
+  return StronglyConnectedComponentsStatistics{
+      total.reduce(), non_trivial.reduce(), largest_size, largest_ratio};
+}
+
+void
+katana::analytics::StronglyConnectedComponentsStatistics::Print(
+    std::ostream& os) const {
+  os << "Total number of components = " << total_components << std::endl;
+  os << "Total number of non trivial components = "
+     << total_non_trivial_components << std::endl;
+  os << "Number of nodes in the largest component = " << largest_component_size
+     << std::endl;
+  os << "Ratio of nodes in the largest component = " << largest_component_ratio
+     << std::endl;
+}
@@ -19,7 +19,13 @@
 
 #include "katana/analytics/triangle_count/triangle_count.h"
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "katana/analytics/SortedIntersection.h"
 #include "katana/analytics/Utils.h"
+#include "katana/analytics/WedgeSampling.h"
 
 using namespace katana::analytics;
 
@@ -57,31 +63,6 @@ LowerBound(Iterator first, Iterator last, Compare comp) {
   return first;
 }
 
-/**
- * std::set_intersection over edge_iterators.
- */
-template <typename G>
-size_t
-CountEqual(
-    const G& g, typename G::edge_iterator aa, typename G::edge_iterator ea,
-    typename G::edge_iterator bb, typename G::edge_iterator eb) {
-  size_t retval = 0;
-  while (aa != ea && bb != eb) {
-    typename G::Node a = *g.GetEdgeDest(aa);
-    typename G::Node b = *g.GetEdgeDest(bb);
-    if (a < b) {
-      ++aa;
-    } else if (b < a) {
-      ++bb;
-    } else {
-      retval += 1;
-      ++aa;
-      ++bb;
-    }
-  }
-  return retval;
-}
-
 template <typename G>
 struct LessThan {
   const G& g;
@@ -174,26 +155,17 @@ NodeIteratingAlgo(katana::PropertyGraph* graph) {
 void
 OrderedCountFunc(
     PropertyGraph* graph, Node n, katana::GAccumulator<size_t>& numTriangles) {
+  const auto& topology = graph->topology();
+  auto [n_begin, n_end] = topology.edge_dests(n);
   size_t numTriangles_local = 0;
-  for (auto it_v : graph->edges(n)) {
-    auto v = *graph->GetEdgeDest(it_v);
-    if (v > n) {
-      break;
-    }
-    PropertyGraph::edge_iterator it_n = graph->edges(n).begin();
-
-    for (auto it_vv : graph->edges(v)) {
-      auto vv = *graph->GetEdgeDest(it_vv);
-      if (vv > v) {
-        break;
-      }
-      while (*graph->GetEdgeDest(it_n) < vv) {
-        it_n++;
-      }
-      if (vv == *graph->GetEdgeDest(it_n)) {
-        numTriangles_local += 1;
-      }
-    }
+  // Count the triangles (n, v, vv) with vv <= v <= n: the neighbors of n up
+  // to v that are also neighbors of v up to v
+  for (const Node* it_v = n_begin; it_v != n_end && *it_v <= n; ++it_v) {
+    Node v = *it_v;
+    auto [v_begin, v_end] = topology.edge_dests(v);
+    const Node* v_prefix_end = std::upper_bound(v_begin, v_end, v);
+    numTriangles_local += katana::analytics::SortedIntersectionSize(
+        n_begin, it_v + 1 - n_begin, v_begin, v_prefix_end - v_begin);
   }
   numTriangles += numTriangles_local;
 }
@@ -254,21 +226,17 @@ EdgeIteratingAlgo(PropertyGraph* graph) {
       [&](const WorkItem& w) {
         // Compute intersection of range (w.src, w.dst) in neighbors of
         // w.src and w.dst
-        PropertyGraph::edge_iterator abegin = graph->edges(w.src).begin();
-        PropertyGraph::edge_iterator aend = graph->edges(w.src).end();
-        PropertyGraph::edge_iterator bbegin = graph->edges(w.dst).begin();
-        PropertyGraph::edge_iterator bend = graph->edges(w.dst).end();
+        const auto& topology = graph->topology();
+        auto [abegin, aend] = topology.edge_dests(w.src);
+        auto [bbegin, bend] = topology.edge_dests(w.dst);
 
-        PropertyGraph::edge_iterator aa = LowerBound(
-            abegin, aend, GreaterThanOrEqual<PropertyGraph>(*graph, w.src));
-        PropertyGraph::edge_iterator ea =
-            LowerBound(abegin, aend, LessThan<PropertyGraph>(*graph, w.dst));
-        PropertyGraph::edge_iterator bb = LowerBound(
-            bbegin, bend, GreaterThanOrEqual<PropertyGraph>(*graph, w.src));
-        PropertyGraph::edge_iterator eb =
-            LowerBound(bbegin, bend, LessThan<PropertyGraph>(*graph, w.dst));
+        const Node* aa = std::upper_bound(abegin, aend, w.src);
+        const Node* ea = std::lower_bound(aa, aend, w.dst);
+        const Node* bb = std::upper_bound(bbegin, bend, w.src);
+        const Node* eb = std::lower_bound(bb, bend, w.dst);
 
-        numTriangles += CountEqual(*graph, aa, ea, bb, eb);
+        numTriangles += katana::analytics::SortedIntersectionSize(
+            aa, ea - aa, bb, eb - bb);
       },
       katana::loopname("TriangleCount_EdgeIteratingAlgo"),
       katana::chunk_size<kChunkSize>(), katana::steal());
@@ -276,9 +244,153 @@ EdgeIteratingAlgo(PropertyGraph* graph) {
   return numTriangles.reduce();
 }
 
+namespace {
+
+/// Wedges are sampled in blocks, each with its own generator seeded by the
+/// seed of the plan and the position of the block, so estimates do not depend
+/// on the number of threads
+constexpr uint64_t kSamplesPerBlock = 4096;
+constexpr uint64_t kInitialSamples = 1 << 16;
+
+TriangleCountEstimate
+WedgeSamplingAlgo(
+    PropertyGraph* graph, double relative_error, double confidence,
+    uint64_t seed) {
+  const auto& topology = graph->topology();
+  const uint64_t num_nodes = topology.num_nodes();
+
+  // The number of wedges centered at each node and the nodes before it
+  katana::LargeArray<uint64_t> wedge_prefix;
+  wedge_prefix.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(topology),
+      [&](const Node& n) {
+        wedge_prefix[n] = NumWedges(topology.edges(n).size());
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      wedge_prefix.begin(), wedge_prefix.end(), wedge_prefix.begin());
+  const uint64_t num_wedges = num_nodes == 0 ? 0 : wedge_prefix[num_nodes - 1];
+  if (num_wedges == 0) {
+    return TriangleCountEstimate{0, 0, 0, 0, 0};
+  }
+
+  // Counting exactly costs about a pass over the wedges, so past a fraction
+  // of them it is cheaper than sampling on. That happens when few wedges are
+  // closed, since the interval must then be narrow in absolute terms.
+  const uint64_t max_samples = std::max(kInitialSamples, num_wedges / 4);
+
+  const double z = TwoSidedNormalQuantile(confidence);
+  uint64_t num_samples = 0;
+  uint64_t num_closed = 0;
+  ProportionInterval interval{0, 1};
+  for (uint64_t target = kInitialSamples;; target = 2 * num_samples) {
+    uint64_t first_block = num_samples / kSamplesPerBlock;
+    uint64_t end_block = (target + kSamplesPerBlock - 1) / kSamplesPerBlock;
+    katana::GAccumulator<uint64_t> closed;
+    katana::do_all(
+        katana::iterate(first_block, end_block),
+        [&](uint64_t block) {
+          std::mt19937_64 rng(WedgeSamplingSeed(seed, block));
+          std::uniform_int_distribution<uint64_t> wedge_dist(
+              0, num_wedges - 1);
+          uint64_t local_closed = 0;
+          for (uint64_t i = 0; i < kSamplesPerBlock; ++i) {
+            // The center of a uniform wedge is the node whose range of the
+            // prefix holds it
+            auto it = std::upper_bound(
+                wedge_prefix.begin(), wedge_prefix.end(), wedge_dist(rng));
+            Node center = it - wedge_prefix.begin();
+            local_closed += SampleWedgeIsClosed(topology, center, &rng);
+          }
+          closed += local_closed;
+        },
+        katana::steal(), katana::loopname("TriangleCount_WedgeSampling"));
+    num_samples = end_block * kSamplesPerBlock;
+    num_closed += closed.reduce();
+
+    interval = WilsonInterval(num_closed, num_samples, z);
+    double fraction = static_cast<double>(num_closed) / num_samples;
+    if (interval.upper - interval.lower <= 2 * relative_error * fraction ||
+        num_samples >= num_wedges) {
+      break;
+    }
+    if (2 * num_samples > max_samples) {
+      katana::StatTimer exact_timer(
+          "TriangleCount_WedgeSamplingExact", "TriangleCount");
+      exact_timer.start();
+      double triangles = OrderedCountAlgo(graph);
+      exact_timer.stop();
+      return TriangleCountEstimate{
+          triangles, triangles, triangles, 3 * triangles / num_wedges,
+          num_samples, true};
+    }
+  }
+
+  // Each triangle closes three wedges
+  double triangles_per_fraction = num_wedges / 3.0;
+  double fraction = static_cast<double>(num_closed) / num_samples;
+  return TriangleCountEstimate{
+      fraction * triangles_per_fraction,
+      interval.lower * triangles_per_fraction,
+      interval.upper * triangles_per_fraction, fraction, num_samples};
+}
+
+}  // namespace
+
+katana::Result<TriangleCountEstimate>
+katana::analytics::ApproximateTriangleCount(
+    katana::PropertyGraph* pg, TriangleCountPlan plan) {
+  if (plan.algorithm() != TriangleCountPlan::kWedgeSampling) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "approximate triangle counting needs a wedge sampling plan");
+  }
+  if (!(plan.relative_error() > 0) ||
+      !(plan.confidence() > 0 && plan.confidence() < 1)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "relative error {} must be positive and confidence {} in (0, 1)",
+        plan.relative_error(), plan.confidence());
+  }
+
+  katana::StatTimer timer_graph_read("GraphReadingTime", "TriangleCount");
+  timer_graph_read.start();
+  std::unique_ptr<katana::PropertyGraph> mutable_pfg;
+  if (!plan.edges_sorted()) {
+    // Copy the graph so we don't mutate the users graph.
+    auto mutable_pfg_result = pg->Copy({}, {});
+    if (!mutable_pfg_result) {
+      return mutable_pfg_result.error();
+    }
+    mutable_pfg = std::move(mutable_pfg_result.value());
+    pg = mutable_pfg.get();
+    if (auto r = katana::SortAllEdgesByDest(pg); !r) {
+      return r.error();
+    }
+  }
+  timer_graph_read.stop();
+
+  katana::StatTimer execTime("TriangleCount", "TriangleCount");
+  execTime.start();
+  TriangleCountEstimate estimate = WedgeSamplingAlgo(
+      pg, plan.relative_error(), plan.confidence(), plan.seed());
+  execTime.stop();
+
+  return estimate;
+}
+
 katana::Result<uint64_t>
 katana::analytics::TriangleCount(
     katana::PropertyGraph* pg, TriangleCountPlan plan) {
+  if (plan.algorithm() == TriangleCountPlan::kWedgeSampling) {
+    auto estimate = ApproximateTriangleCount(pg, plan);
+    if (!estimate) {
+      return estimate.error();
+    }
+    return std::llround(estimate.value().estimate);
+  }
+
   katana::StatTimer timer_graph_read("GraphReadingTime", "TriangleCount");
   katana::StatTimer timer_auto_algo("AutoRelabel", "TriangleCount");
 
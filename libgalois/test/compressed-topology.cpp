@@ -0,0 +1,215 @@
+#include <boost/filesystem.hpp>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/CompressedGraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Uri.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+std::string command_line;
+
+void
+TestCoding() {
+  for (int64_t val : {int64_t{0}, int64_t{1}, int64_t{-1}, int64_t{63},
+                      int64_t{-64}, int64_t{1} << 40, -(int64_t{1} << 40)}) {
+    uint64_t encoded = katana::CompressedGraphTopology::ZigZagEncode(val);
+    KATANA_LOG_ASSERT(
+        katana::CompressedGraphTopology::ZigZagDecode(encoded) == val);
+
+    uint8_t buf[10];
+    uint8_t* write_pos = buf;
+    katana::CompressedGraphTopology::WriteVarint(encoded, &write_pos);
+    KATANA_LOG_ASSERT(
+        static_cast<uint64_t>(write_pos - buf) ==
+        katana::CompressedGraphTopology::VarintSize(encoded));
+
+    const uint8_t* read_pos = buf;
+    KATANA_LOG_ASSERT(
+        katana::CompressedGraphTopology::ReadVarint(&read_pos) == encoded);
+    KATANA_LOG_ASSERT(read_pos == write_pos);
+  }
+}
+
+void
+CheckEdges(
+    const katana::CompressedGraphTopology& compressed,
+    const katana::GraphTopology& topology) {
+  KATANA_LOG_ASSERT(compressed.num_nodes() == topology.num_nodes());
+  KATANA_LOG_ASSERT(compressed.num_edges() == topology.num_edges());
+
+  for (auto n : compressed) {
+    auto expected = topology.edges(n).begin();
+    for (const auto& edge : compressed.edges(n)) {
+      KATANA_LOG_VASSERT(
+          edge.id == *expected, "node {} edge {} expected {}", n, edge.id,
+          *expected);
+      KATANA_LOG_VASSERT(
+          edge.dest == topology.edge_dest(*expected),
+          "node {} edge {} dest {} expected {}", n, edge.id, edge.dest,
+          topology.edge_dest(*expected));
+      ++expected;
+    }
+    KATANA_LOG_ASSERT(expected == topology.edges(n).end());
+  }
+}
+
+size_t
+NumTopologyFiles(const std::string& rdg_dir) {
+  size_t num_files = 0;
+  for (const auto& entry : fs::directory_iterator(rdg_dir)) {
+    num_files += entry.path().filename().string().rfind("topology", 0) == 0;
+  }
+  return num_files;
+}
+
+void
+TestCompress(size_t num_nodes, Policy* policy) {
+  auto g = MakeFileGraph<uint32_t>(num_nodes, 0, policy);
+  const katana::GraphTopology& topology = g->topology();
+
+  auto compressed = katana::CompressedGraphTopology::Make(topology);
+  CheckEdges(*compressed, topology);
+
+  auto decompressed = compressed->Decompress();
+  KATANA_LOG_ASSERT(decompressed->Equals(topology));
+}
+
+void
+TestSmallerForLocalEdges() {
+  LinePolicy policy{4};
+  auto g = MakeFileGraph<uint32_t>(1000, 0, &policy);
+  auto compressed = katana::CompressedGraphTopology::Make(g->topology());
+  KATANA_LOG_VASSERT(
+      compressed->num_dest_bytes() < g->num_edges() * sizeof(uint32_t),
+      "{} bytes for {} edges", compressed->num_dest_bytes(), g->num_edges());
+}
+
+void
+TestRoundTrip() {
+  RandomPolicy policy{3};
+  auto g = MakeFileGraph<uint32_t>(1000, 0, &policy);
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/compressedtopology");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  auto write_result = g->Write(
+      rdg_dir, command_line, tsuba::TopologyEncoding::kCompressedCSR);
+  if (!write_result) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  auto make_result = katana::PropertyGraph::Make(rdg_dir);
+  if (!make_result) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_result.value());
+
+  // The loaded topology stays compressed and can be iterated as is
+  const katana::CompressedGraphTopology* compressed =
+      g2->compressed_topology();
+  KATANA_LOG_ASSERT(compressed != nullptr);
+  KATANA_LOG_ASSERT(
+      g2->num_nodes() == g->num_nodes() && g2->num_edges() == g->num_edges());
+  CheckEdges(*compressed, g->topology());
+
+  // Writing it elsewhere keeps it compressed
+  auto copy_uri_res = katana::Uri::MakeRand("/tmp/compressedtopology");
+  KATANA_LOG_ASSERT(copy_uri_res);
+  std::string copy_rdg_dir(copy_uri_res.value().path());
+  write_result = g2->Write(
+      copy_rdg_dir, command_line, tsuba::TopologyEncoding::kCompressedCSR);
+  if (!write_result) {
+    fs::remove_all(rdg_dir);
+    fs::remove_all(copy_rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+  KATANA_LOG_ASSERT(g2->compressed_topology() != nullptr);
+  make_result = katana::PropertyGraph::Make(copy_rdg_dir);
+  fs::remove_all(copy_rdg_dir);
+  if (!make_result) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+  KATANA_LOG_ASSERT(make_result.value()->topology().Equals(g->topology()));
+
+  // Decoding frees the compressed topology
+  KATANA_LOG_ASSERT(g2->topology().Equals(g->topology()));
+  KATANA_LOG_ASSERT(g2->compressed_topology() == nullptr);
+  KATANA_LOG_ASSERT(
+      g2->num_nodes() == g->num_nodes() && g2->num_edges() == g->num_edges());
+
+  // Commits keep the compressed topology written by Write
+  size_t num_topology_files = NumTopologyFiles(rdg_dir);
+  for (int i = 0; i < 2; ++i) {
+    auto commit_result = g->Commit(command_line);
+    if (!commit_result) {
+      fs::remove_all(rdg_dir);
+      KATANA_LOG_FATAL("committing result: {}", commit_result.error());
+    }
+  }
+  KATANA_LOG_VASSERT(
+      NumTopologyFiles(rdg_dir) == num_topology_files,
+      "{} topology files after commits, {} before", NumTopologyFiles(rdg_dir),
+      num_topology_files);
+
+  // Rewriting as plain CSR must give the same graph back
+  auto csr_uri_res = katana::Uri::MakeRand("/tmp/compressedtopology");
+  KATANA_LOG_ASSERT(csr_uri_res);
+  std::string csr_rdg_dir(csr_uri_res.value().path());
+
+  write_result =
+      g2->Write(csr_rdg_dir, command_line, tsuba::TopologyEncoding::kCSR);
+  if (!write_result) {
+    fs::remove_all(rdg_dir);
+    fs::remove_all(csr_rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  make_result = katana::PropertyGraph::Make(csr_rdg_dir);
+  if (!make_result) {
+    fs::remove_all(rdg_dir);
+    fs::remove_all(csr_rdg_dir);
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+  KATANA_LOG_ASSERT(make_result.value()->topology().Equals(g->topology()));
+
+  fs::remove_all(rdg_dir);
+  fs::remove_all(csr_rdg_dir);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  katana::SharedMemSys sys;
+
+  std::ostringstream cmdout;
+  for (int i = 0; i < argc; ++i) {
+    cmdout << argv[i];
+    if (i != argc - 1)
+      cmdout << " ";
+  }
+  command_line = cmdout.str();
+
+  TestCoding();
+
+  LinePolicy line{3};
+  RandomPolicy random{5};
+  TestCompress(0, &line);
+  TestCompress(1, &line);
+  TestCompress(65, &line);
+  TestCompress(1000, &line);
+  TestCompress(1000, &random);
+
+  TestSmallerForLocalEdges();
+  TestRoundTrip();
+
+  return 0;
+}
@@ -0,0 +1,230 @@
+#include <numeric>
+
+#include <boost/filesystem.hpp>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Uri.h"
+#include "katana/analytics/connected_components/connected_components.h"
+
+namespace {
+
+using Edges = std::vector<std::pair<uint32_t, uint32_t>>;
+
+/// The given edges, each added in both directions
+class EdgeListPolicy : public Policy {
+  std::vector<std::vector<uint32_t>> neighbors_;
+
+public:
+  EdgeListPolicy(size_t num_nodes, const Edges& edges) : neighbors_(num_nodes) {
+    for (const auto& [a, b] : edges) {
+      neighbors_[a].emplace_back(b);
+      neighbors_[b].emplace_back(a);
+    }
+  }
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, [[maybe_unused]] size_t num_nodes) override {
+    return neighbors_[node_id];
+  }
+};
+
+Edges
+RandomEdges(size_t num_nodes, size_t num_edges) {
+  auto& gen = katana::GetGenerator();
+  std::uniform_int_distribution<uint32_t> dist(0, num_nodes - 1);
+  Edges edges;
+  for (size_t i = 0; i < num_edges; ++i) {
+    edges.emplace_back(dist(gen), dist(gen));
+  }
+  return edges;
+}
+
+/// The smallest node of the component of each node with a serial union-find
+std::vector<uint32_t>
+ExpectedComponents(size_t num_nodes, const std::vector<const Edges*>& edges) {
+  std::vector<uint32_t> parent(num_nodes);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&](uint32_t n) {
+    while (parent[n] != n) {
+      n = parent[n] = parent[parent[n]];
+    }
+    return n;
+  };
+  for (const Edges* list : edges) {
+    for (const auto& [a, b] : *list) {
+      uint32_t ra = find(a);
+      uint32_t rb = find(b);
+      parent[std::max(ra, rb)] = std::min(ra, rb);
+    }
+  }
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    parent[n] = find(n);
+  }
+  return parent;
+}
+
+const uint64_t*
+Components(katana::PropertyGraph* g) {
+  auto array = std::dynamic_pointer_cast<arrow::UInt64Array>(
+      g->GetNodeProperty("component")->chunk(0));
+  KATANA_LOG_ASSERT(array);
+  return array->raw_values();
+}
+
+/// Check that the components of g and the index are those of expected
+void
+CheckComponents(
+    katana::PropertyGraph* g, const std::vector<uint32_t>& expected) {
+  const uint64_t* components = Components(g);
+  size_t num_nodes = expected.size();
+  std::vector<uint64_t> component_of(num_nodes, num_nodes);
+  std::vector<size_t> sizes(num_nodes);
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    uint64_t& c = component_of[expected[n]];
+    if (c == num_nodes) {
+      c = components[n];
+    }
+    KATANA_LOG_VASSERT(
+        components[n] == c, "node {} has component {} instead of {}", n,
+        components[n], c);
+    ++sizes[expected[n]];
+  }
+
+  size_t num_members = 0;
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    if (sizes[n] == 0) {
+      continue;
+    }
+    auto members_result = katana::analytics::ConnectedComponentMembers(
+        g, "index_", component_of[n]);
+    KATANA_LOG_ASSERT(members_result);
+    const auto& members = members_result.value();
+    KATANA_LOG_ASSERT(members.size() == sizes[n]);
+    for (uint32_t m : members) {
+      KATANA_LOG_ASSERT(expected[m] == n);
+    }
+    num_members += members.size();
+  }
+  KATANA_LOG_ASSERT(num_members == num_nodes);
+}
+
+void
+TestInsertEdges(size_t num_nodes, size_t num_edges, size_t num_inserted) {
+  Edges edges = RandomEdges(num_nodes, num_edges);
+  EdgeListPolicy policy(num_nodes, edges);
+  auto g = MakeFileGraph<uint32_t>(num_nodes, 0, &policy);
+
+  KATANA_LOG_ASSERT(katana::analytics::ConnectedComponents(
+      g.get(), "component",
+      katana::analytics::ConnectedComponentsPlan::Afforest()));
+  KATANA_LOG_ASSERT(katana::analytics::ConnectedComponentsBuildIndex(
+      g.get(), "component", "index_"));
+  CheckComponents(g.get(), ExpectedComponents(num_nodes, {&edges}));
+
+  Edges first = RandomEdges(num_nodes, num_inserted);
+  KATANA_LOG_ASSERT(katana::analytics::ConnectedComponentsInsertEdges(
+      g.get(), "component", "index_", first));
+  CheckComponents(g.get(), ExpectedComponents(num_nodes, {&edges, &first}));
+
+  Edges second = RandomEdges(num_nodes, num_inserted);
+  KATANA_LOG_ASSERT(katana::analytics::ConnectedComponentsInsertEdges(
+      g.get(), "component", "index_", second));
+  CheckComponents(
+      g.get(), ExpectedComponents(num_nodes, {&edges, &first, &second}));
+
+  KATANA_LOG_ASSERT(!katana::analytics::ConnectedComponentsInsertEdges(
+      g.get(), "component", "index_",
+      {{0, static_cast<uint32_t>(num_nodes)}}));
+  KATANA_LOG_ASSERT(!katana::analytics::ConnectedComponentMembers(
+      g.get(), "index_", num_nodes));
+}
+
+std::unique_ptr<katana::PropertyGraph>
+Reload(const std::string& rdg_dir) {
+  auto make_result = katana::PropertyGraph::Make(rdg_dir);
+  if (!make_result) {
+    boost::filesystem::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+  return std::move(make_result.value());
+}
+
+/// The components and the index stay current in storage after inserting
+/// edges into a loaded graph
+void
+TestPersistence(size_t num_nodes, size_t num_edges, size_t num_inserted) {
+  Edges edges = RandomEdges(num_nodes, num_edges);
+  EdgeListPolicy policy(num_nodes, edges);
+  auto g = MakeFileGraph<uint32_t>(num_nodes, 0, &policy);
+
+  KATANA_LOG_ASSERT(katana::analytics::ConnectedComponents(
+      g.get(), "component",
+      katana::analytics::ConnectedComponentsPlan::Afforest()));
+  KATANA_LOG_ASSERT(katana::analytics::ConnectedComponentsBuildIndex(
+      g.get(), "component", "index_"));
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/connectedcomponentsindex");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+  if (auto res = g->Write(rdg_dir, "connected-components-index"); !res) {
+    boost::filesystem::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+
+  auto loaded = Reload(rdg_dir);
+  CheckComponents(loaded.get(), ExpectedComponents(num_nodes, {&edges}));
+
+  Edges inserted = RandomEdges(num_nodes, num_inserted);
+  KATANA_LOG_ASSERT(katana::analytics::ConnectedComponentsInsertEdges(
+      loaded.get(), "component", "index_", inserted));
+  if (auto res = loaded->Commit("connected-components-index"); !res) {
+    boost::filesystem::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("committing result: {}", res.error());
+  }
+
+  auto reloaded = Reload(rdg_dir);
+  boost::filesystem::remove_all(rdg_dir);
+  CheckComponents(
+      reloaded.get(), ExpectedComponents(num_nodes, {&edges, &inserted}));
+}
+
+void
+TestInvalidComponents() {
+  Edges edges = RandomEdges(100, 50);
+  EdgeListPolicy policy(100, edges);
+  auto g = MakeFileGraph<uint32_t>(100, 0, &policy);
+
+  // Node 0 is put in the component of a node outside the graph
+  arrow::UInt64Builder builder;
+  for (auto n : *g) {
+    KATANA_LOG_ASSERT(builder.Append(n == 0 ? 100 : n).ok());
+  }
+  std::shared_ptr<arrow::Array> components;
+  KATANA_LOG_ASSERT(builder.Finish(&components).ok());
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("component", components->type())}),
+      {components});
+  KATANA_LOG_ASSERT(g->AddNodeProperties(table));
+
+  KATANA_LOG_ASSERT(!katana::analytics::ConnectedComponentsBuildIndex(
+      g.get(), "component", "index_"));
+  KATANA_LOG_ASSERT(g->node_schema()->GetFieldIndex("index_next") == -1);
+  KATANA_LOG_ASSERT(g->node_schema()->GetFieldIndex("index_size") == -1);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestInsertEdges(1000, 300, 50);
+  TestInsertEdges(1000, 900, 200);
+  TestPersistence(1000, 300, 100);
+  TestInvalidComponents();
+
+  return 0;
+}
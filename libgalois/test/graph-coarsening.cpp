@@ -0,0 +1,227 @@
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/coarsening/coarsening.h"
+
+namespace {
+
+/// A ring with edges in both directions
+class SymmetricRingPolicy : public Policy {
+public:
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, size_t num_nodes) override {
+    return {
+        static_cast<uint32_t>((node_id + num_nodes - 1) % num_nodes),
+        static_cast<uint32_t>((node_id + 1) % num_nodes)};
+  }
+};
+
+/// Random edges, each added in both directions
+class RandomPairsPolicy : public Policy {
+  std::vector<std::vector<uint32_t>> neighbors_;
+
+public:
+  RandomPairsPolicy(size_t num_nodes, size_t num_pairs)
+      : neighbors_(num_nodes) {
+    auto& gen = katana::GetGenerator();
+    std::uniform_int_distribution<uint32_t> dist(0, num_nodes - 1);
+    for (size_t i = 0; i < num_pairs; ++i) {
+      uint32_t a = dist(gen);
+      uint32_t b = dist(gen);
+      neighbors_[a].emplace_back(b);
+      neighbors_[b].emplace_back(a);
+    }
+  }
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, [[maybe_unused]] size_t num_nodes) override {
+    return neighbors_[node_id];
+  }
+};
+
+/// \returns a table with a single column \param name holding \param values
+template <typename T>
+std::shared_ptr<arrow::Table>
+MakeColumn(const std::string& name, const std::vector<T>& values) {
+  typename arrow::CTypeTraits<T>::BuilderType builder;
+  KATANA_LOG_ASSERT(builder.AppendValues(values).ok());
+  std::shared_ptr<arrow::Array> array;
+  KATANA_LOG_ASSERT(builder.Finish(&array).ok());
+  return arrow::Table::Make(
+      arrow::schema({arrow::field(name, array->type())}), {array});
+}
+
+std::unique_ptr<katana::PropertyGraph>
+MakeWeightedGraph(size_t num_nodes, Policy* policy) {
+  auto g = MakeFileGraph<uint32_t>(num_nodes, 0, policy);
+  std::vector<uint32_t> ones(g->num_edges(), 1);
+  KATANA_LOG_ASSERT(g->AddEdgeProperties(MakeColumn("weight", ones)));
+  return g;
+}
+
+void
+SetClusters(katana::PropertyGraph* g, const std::vector<uint64_t>& clusters) {
+  KATANA_LOG_ASSERT(g->AddNodeProperties(MakeColumn("cluster", clusters)));
+}
+
+const uint32_t*
+Weights(const katana::PropertyGraph& g, const std::string& property) {
+  auto weights = g.GetEdgePropertyTyped<uint32_t>(property);
+  KATANA_LOG_ASSERT(weights);
+  return weights.value()->raw_values();
+}
+
+uint64_t
+TotalWeight(katana::PropertyGraph* g, const std::string& property) {
+  const uint32_t* weights = Weights(*g, property);
+  return std::accumulate(weights, weights + g->num_edges(), uint64_t{0});
+}
+
+/// Check that the out-edges of every node are sorted by destination without
+/// duplicates
+void
+CheckSortedUnique(const katana::PropertyGraph& g) {
+  const auto& topology = g.topology();
+  for (auto n : g) {
+    bool first = true;
+    uint32_t prev = 0;
+    for (auto e : topology.edges(n)) {
+      uint32_t dest = topology.edge_dest(e);
+      KATANA_LOG_VASSERT(
+          first || prev < dest, "node {} dest {} after {}", n, dest, prev);
+      first = false;
+      prev = dest;
+    }
+  }
+}
+
+void
+TestContractPairs() {
+  SymmetricRingPolicy policy;
+  auto g = MakeWeightedGraph(8, &policy);
+  SetClusters(g.get(), {0, 0, 2, 2, 4, 4, 6, 6});
+
+  auto res = katana::analytics::ContractClusters(
+      g.get(), "weight", "cluster", "coarse_weight");
+  KATANA_LOG_ASSERT(res);
+  auto& coarse = res.value();
+
+  KATANA_LOG_ASSERT(coarse.graph->num_nodes() == 4);
+  for (uint64_t n = 0; n < 8; ++n) {
+    KATANA_LOG_ASSERT(coarse.fine_to_coarse[n] == n / 2);
+  }
+
+  // Each pair becomes a node with a self loop of the two edges inside the
+  // pair and edges of weight 1 to the neighboring pairs
+  const auto& topology = coarse.graph->topology();
+  const uint32_t* weights = Weights(*coarse.graph, "coarse_weight");
+  for (auto c : *coarse.graph) {
+    auto [begin_edge, end_edge] = topology.edge_range(c);
+    KATANA_LOG_ASSERT(end_edge - begin_edge == 3);
+    for (auto e : topology.edges(c)) {
+      uint32_t dest = topology.edge_dest(e);
+      uint32_t expected = dest == c ? 2 : 1;
+      KATANA_LOG_VASSERT(
+          weights[e] == expected, "edge {} -> {} weight {}", c, dest,
+          weights[e]);
+    }
+  }
+  CheckSortedUnique(*coarse.graph);
+  KATANA_LOG_ASSERT(
+      TotalWeight(coarse.graph.get(), "coarse_weight") ==
+      TotalWeight(g.get(), "weight"));
+}
+
+void
+TestContractUnassigned() {
+  SymmetricRingPolicy policy;
+  auto g = MakeWeightedGraph(6, &policy);
+  SetClusters(
+      g.get(), {katana::analytics::kUnassignedCluster, 3, 3, 5, 5, 5});
+
+  auto res = katana::analytics::ContractClusters(
+      g.get(), "weight", "cluster", "coarse_weight");
+  KATANA_LOG_ASSERT(res);
+  auto& coarse = res.value();
+
+  KATANA_LOG_ASSERT(coarse.graph->num_nodes() == 2);
+  KATANA_LOG_ASSERT(
+      coarse.fine_to_coarse[0] == katana::analytics::kUnassignedCluster);
+  KATANA_LOG_ASSERT(coarse.fine_to_coarse[1] == 0);
+  KATANA_LOG_ASSERT(coarse.fine_to_coarse[5] == 1);
+  // The two edges in each direction of node 0 are left out
+  KATANA_LOG_ASSERT(
+      TotalWeight(coarse.graph.get(), "coarse_weight") ==
+      TotalWeight(g.get(), "weight") - 4);
+  CheckSortedUnique(*coarse.graph);
+}
+
+void
+TestContractInvalid() {
+  SymmetricRingPolicy policy;
+  auto g = MakeWeightedGraph(4, &policy);
+  SetClusters(g.get(), {0, 1, 2, 4});
+
+  auto res = katana::analytics::ContractClusters(
+      g.get(), "weight", "cluster", "coarse_weight");
+  KATANA_LOG_ASSERT(!res);
+}
+
+void
+TestCoarsen(size_t num_nodes) {
+  RandomPairsPolicy policy(num_nodes, 4 * num_nodes);
+  auto g = MakeWeightedGraph(num_nodes, &policy);
+
+  auto res = katana::analytics::Coarsen(g.get(), "weight", "coarse_weight");
+  KATANA_LOG_ASSERT(res);
+  auto& coarse = res.value();
+
+  // The matching property is temporary
+  KATANA_LOG_ASSERT(g->GetNodePropertyNames().empty());
+
+  // Nodes are merged in adjacent pairs
+  std::vector<std::vector<uint32_t>> members(coarse.graph->num_nodes());
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    uint64_t c = coarse.fine_to_coarse[n];
+    KATANA_LOG_ASSERT(c < coarse.graph->num_nodes());
+    members[c].emplace_back(n);
+  }
+  const auto& topology = g->topology();
+  for (const auto& m : members) {
+    KATANA_LOG_ASSERT(m.size() == 1 || m.size() == 2);
+    if (m.size() == 2) {
+      bool adjacent = false;
+      for (auto e : topology.edges(m[0])) {
+        adjacent |= topology.edge_dest(e) == m[1];
+      }
+      KATANA_LOG_VASSERT(adjacent, "{} and {} are not adjacent", m[0], m[1]);
+    }
+  }
+  KATANA_LOG_VASSERT(
+      coarse.graph->num_nodes() < 3 * num_nodes / 4,
+      "{} nodes coarsened to {}", num_nodes, coarse.graph->num_nodes());
+
+  KATANA_LOG_ASSERT(
+      TotalWeight(coarse.graph.get(), "coarse_weight") ==
+      TotalWeight(g.get(), "weight"));
+  CheckSortedUnique(*coarse.graph);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestContractPairs();
+  TestContractUnassigned();
+  TestContractInvalid();
+  TestCoarsen(1000);
+
+  return 0;
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+
+#include "katana/GraphGenerators.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Threads.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+std::unique_ptr<katana::PropertyGraph>
+Unwrap(katana::Result<std::unique_ptr<katana::PropertyGraph>> res) {
+  KATANA_LOG_VASSERT(res, "generating graph failed: {}", res.error());
+  return std::move(res.value());
+}
+
+bool
+HasEdge(const katana::GraphTopology& topology, Node src, Node dst) {
+  auto [begin, end] = topology.edge_range(src);
+  for (auto e = begin; e != end; ++e) {
+    if (topology.edge_dest(e) == dst) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Check that edges are sorted without self loops or duplicates, that
+/// symmetric graphs have every reverse edge, and that weights are symmetric
+/// and in range
+void
+CheckGraph(katana::PropertyGraph* pg, bool symmetric) {
+  const katana::GraphTopology& topology = pg->topology();
+  auto weights_res = pg->GetEdgePropertyTyped<uint32_t>("weight");
+  KATANA_LOG_ASSERT(weights_res);
+  auto weights = weights_res.value();
+
+  for (Node src = 0; src < topology.num_nodes(); ++src) {
+    auto [begin, end] = topology.edge_range(src);
+    for (auto e = begin; e != end; ++e) {
+      Node dst = topology.edge_dest(e);
+      KATANA_LOG_ASSERT(dst != src);
+      KATANA_LOG_ASSERT(e == begin || topology.edge_dest(e - 1) < dst);
+      KATANA_LOG_ASSERT(weights->Value(e) >= 1 && weights->Value(e) <= 255);
+      if (!symmetric) {
+        continue;
+      }
+      KATANA_LOG_VASSERT(
+          HasEdge(topology, dst, src), "missing {} -> {}", dst, src);
+      auto [dst_begin, dst_end] = topology.edge_range(dst);
+      for (auto r = dst_begin; r != dst_end; ++r) {
+        if (topology.edge_dest(r) == src) {
+          KATANA_LOG_ASSERT(weights->Value(r) == weights->Value(e));
+        }
+      }
+    }
+  }
+}
+
+void
+TestGrid() {
+  auto pg = Unwrap(katana::GenerateGridGraph(3, 4));
+  const auto& topology = pg->topology();
+  KATANA_LOG_ASSERT(topology.num_nodes() == 12);
+  // 3 rows of 3 horizontal edges and 2 rows of 4 vertical edges, both ways
+  KATANA_LOG_ASSERT(topology.num_edges() == 2 * (3 * 3 + 2 * 4));
+  KATANA_LOG_ASSERT(HasEdge(topology, 0, 1) && HasEdge(topology, 0, 4));
+  KATANA_LOG_ASSERT(HasEdge(topology, 5, 1) && !HasEdge(topology, 3, 4));
+  CheckGraph(pg.get(), true);
+
+  katana::GraphGeneratorOptions directed;
+  directed.symmetric = false;
+  pg = Unwrap(katana::GenerateGridGraph(3, 4, directed));
+  KATANA_LOG_ASSERT(pg->topology().num_edges() == 3 * 3 + 2 * 4);
+  KATANA_LOG_ASSERT(!HasEdge(pg->topology(), 1, 0));
+  CheckGraph(pg.get(), false);
+}
+
+void
+TestRandom() {
+  auto rmat = Unwrap(katana::GenerateRmatGraph(10, 8));
+  KATANA_LOG_ASSERT(rmat->topology().num_nodes() == 1024);
+  KATANA_LOG_ASSERT(rmat->topology().num_edges() > 1024);
+  KATANA_LOG_ASSERT(rmat->topology().num_edges() <= 2 * 8 * 1024);
+  CheckGraph(rmat.get(), true);
+
+  // With the same seed, the Kronecker graph is the R-MAT graph with its nodes
+  // permuted
+  auto kronecker = Unwrap(katana::GenerateKroneckerGraph(10, 8));
+  CheckGraph(kronecker.get(), true);
+  KATANA_LOG_ASSERT(
+      kronecker->topology().num_edges() == rmat->topology().num_edges());
+  KATANA_LOG_ASSERT(!kronecker->topology().Equals(rmat->topology()));
+
+  katana::GraphGeneratorOptions directed;
+  directed.symmetric = false;
+  auto uniform = Unwrap(katana::GenerateUniformGraph(100, 1000, directed));
+  KATANA_LOG_ASSERT(uniform->topology().num_nodes() == 100);
+  KATANA_LOG_ASSERT(uniform->topology().num_edges() <= 1000);
+  CheckGraph(uniform.get(), false);
+}
+
+void
+TestDeterministic() {
+  katana::GraphGeneratorOptions options;
+  options.seed = 7;
+
+  katana::setActiveThreads(1);
+  auto serial = Unwrap(katana::GenerateKroneckerGraph(12, 4, options));
+  katana::setActiveThreads(4);
+  auto parallel = Unwrap(katana::GenerateKroneckerGraph(12, 4, options));
+  KATANA_LOG_ASSERT(serial->topology().Equals(parallel->topology()));
+  KATANA_LOG_ASSERT(serial->GetEdgeProperty("weight")->Equals(
+      *parallel->GetEdgeProperty("weight")));
+
+  options.seed = 8;
+  auto other = Unwrap(katana::GenerateKroneckerGraph(12, 4, options));
+  KATANA_LOG_ASSERT(!serial->topology().Equals(other->topology()));
+}
+
+void
+TestInvalid() {
+  KATANA_LOG_ASSERT(!katana::GenerateRmatGraph(32, 1));
+  KATANA_LOG_ASSERT(
+      !katana::GenerateRmatGraph(4, 1, katana::RmatParameters{0.5, 0.3, 0.3}));
+  KATANA_LOG_ASSERT(!katana::GenerateUniformGraph(0, 10));
+
+  katana::GraphGeneratorOptions options;
+  options.max_weight = 0;
+  KATANA_LOG_ASSERT(!katana::GenerateGridGraph(2, 2, options));
+  options.edge_weight_property_name = "";
+  auto pg = Unwrap(katana::GenerateGridGraph(2, 2, options));
+  KATANA_LOG_ASSERT(pg->GetEdgePropertyNum() == 0);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  TestGrid();
+  TestRandom();
+  TestDeterministic();
+  TestInvalid();
+
+  return 0;
+}
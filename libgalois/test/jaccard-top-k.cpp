@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <set>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/jaccard/jaccard.h"
+
+namespace {
+
+/// Random directed edges without duplicates
+class RandomSetPolicy : public Policy {
+  std::vector<std::vector<uint32_t>> neighbors_;
+
+public:
+  RandomSetPolicy(size_t num_nodes, size_t max_degree) : neighbors_(num_nodes) {
+    auto& gen = katana::GetGenerator();
+    std::uniform_int_distribution<uint32_t> node_dist(0, num_nodes - 1);
+    std::uniform_int_distribution<size_t> degree_dist(0, max_degree);
+    for (auto& neighbors : neighbors_) {
+      std::set<uint32_t> dests;
+      for (size_t i = degree_dist(gen); i > 0; --i) {
+        dests.emplace(node_dist(gen));
+      }
+      neighbors.assign(dests.begin(), dests.end());
+    }
+  }
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, [[maybe_unused]] size_t num_nodes) override {
+    return neighbors_[node_id];
+  }
+};
+
+using Entry = std::pair<double, uint32_t>;
+
+/// The top k of node computed from the neighbor sets of every node
+std::vector<Entry>
+BruteForceTopK(const katana::PropertyGraph& g, uint32_t node, uint32_t k) {
+  const auto& topology = g.topology();
+  auto neighbors = [&](uint32_t n) {
+    std::set<uint32_t> dests;
+    for (auto e : topology.edges(n)) {
+      dests.emplace(topology.edge_dest(e));
+    }
+    return dests;
+  };
+  std::set<uint32_t> node_neighbors = neighbors(node);
+  std::vector<Entry> entries;
+  for (auto other : g) {
+    if (other == node) {
+      continue;
+    }
+    std::set<uint32_t> other_neighbors = neighbors(other);
+    std::vector<uint32_t> common;
+    std::set_intersection(
+        node_neighbors.begin(), node_neighbors.end(), other_neighbors.begin(),
+        other_neighbors.end(), std::back_inserter(common));
+    if (common.empty()) {
+      continue;
+    }
+    uint64_t union_size =
+        node_neighbors.size() + other_neighbors.size() - common.size();
+    entries.emplace_back(
+        static_cast<double>(common.size()) / union_size, other);
+  }
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+  });
+  entries.resize(std::min<size_t>(k, entries.size()));
+  return entries;
+}
+
+std::vector<Entry>
+GetTopK(
+    const katana::PropertyGraph& g, const std::string& name, uint32_t node) {
+  auto lists = std::dynamic_pointer_cast<arrow::LargeListArray>(
+      g.GetNodeProperty(name)->chunk(0));
+  KATANA_LOG_ASSERT(lists);
+  auto entries = std::static_pointer_cast<arrow::StructArray>(lists->values());
+  auto nodes = std::static_pointer_cast<arrow::UInt32Array>(
+      entries->GetFieldByName(katana::analytics::kJaccardTopKNodeField));
+  auto similarities = std::static_pointer_cast<arrow::DoubleArray>(
+      entries->GetFieldByName(katana::analytics::kJaccardTopKSimilarityField));
+  std::vector<Entry> ret;
+  for (int64_t i = lists->value_offset(node);
+       i < lists->value_offset(node + 1); ++i) {
+    ret.emplace_back(similarities->Value(i), nodes->Value(i));
+  }
+  return ret;
+}
+
+void
+TestAllNodes(uint32_t k) {
+  constexpr size_t kNumNodes = 300;
+  RandomSetPolicy policy(kNumNodes, 12);
+  auto g = MakeFileGraph<uint32_t>(kNumNodes, 0, &policy);
+
+  auto res = katana::analytics::JaccardTopK(g.get(), k, "top");
+  KATANA_LOG_VASSERT(res, "JaccardTopK failed: {}", res.error());
+
+  for (auto n : *g) {
+    auto expected = BruteForceTopK(*g, n, k);
+    auto actual = GetTopK(*g, "top", n);
+    KATANA_LOG_VASSERT(
+        actual == expected, "node {}: {} entries, expected {}", n,
+        actual.size(), expected.size());
+  }
+}
+
+void
+TestBatch() {
+  constexpr size_t kNumNodes = 100;
+  RandomSetPolicy policy(kNumNodes, 8);
+  auto g = MakeFileGraph<uint32_t>(kNumNodes, 0, &policy);
+
+  std::vector<uint32_t> batch{7, 3, 42};
+  auto res = katana::analytics::JaccardTopK(g.get(), 5, "top", batch);
+  KATANA_LOG_VASSERT(res, "JaccardTopK failed: {}", res.error());
+
+  for (auto n : *g) {
+    auto actual = GetTopK(*g, "top", n);
+    if (std::find(batch.begin(), batch.end(), n) == batch.end()) {
+      KATANA_LOG_ASSERT(actual.empty());
+    } else {
+      KATANA_LOG_ASSERT(actual == BruteForceTopK(*g, n, 5));
+    }
+  }
+
+  KATANA_LOG_ASSERT(
+      !katana::analytics::JaccardTopK(g.get(), 5, "repeated", {1, 1}));
+  KATANA_LOG_ASSERT(
+      !katana::analytics::JaccardTopK(g.get(), 5, "out_of_range", {100}));
+  KATANA_LOG_ASSERT(!katana::analytics::JaccardTopK(g.get(), 0, "zero"));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestAllNodes(1);
+  TestAllNodes(10);
+  TestBatch();
+
+  return 0;
+}
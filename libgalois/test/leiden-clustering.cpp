@@ -0,0 +1,199 @@
+#include <set>
+#include <string>
+#include <vector>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/leiden_clustering/leiden_clustering.h"
+#include "katana/analytics/louvain_clustering/louvain_clustering.h"
+
+namespace {
+
+constexpr size_t kNumCliques = 8;
+constexpr size_t kCliqueSize = 8;
+
+/// Cliques joined into a ring by one edge between consecutive cliques,
+/// stored in both directions
+class CliqueRingPolicy : public Policy {
+public:
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, size_t num_nodes) override {
+    size_t first = node_id / kCliqueSize * kCliqueSize;
+    std::vector<uint32_t> neighbors;
+    for (size_t n = first; n < first + kCliqueSize; ++n) {
+      if (n != node_id) {
+        neighbors.emplace_back(n);
+      }
+    }
+    if (node_id == first) {
+      neighbors.emplace_back((first + num_nodes - 1) % num_nodes);
+    }
+    if (node_id == first + kCliqueSize - 1) {
+      neighbors.emplace_back((node_id + 1) % num_nodes);
+    }
+    return neighbors;
+  }
+};
+
+/// Random undirected edges without self loops or duplicates, stored in both
+/// directions
+class RandomSymmetricPolicy : public Policy {
+  std::vector<std::set<uint32_t>> neighbors_;
+
+public:
+  RandomSymmetricPolicy(size_t num_nodes, size_t num_pairs)
+      : neighbors_(num_nodes) {
+    auto& gen = katana::GetGenerator();
+    std::uniform_int_distribution<uint32_t> dist(0, num_nodes - 1);
+    for (size_t i = 0; i < num_pairs; ++i) {
+      uint32_t a = dist(gen);
+      uint32_t b = dist(gen);
+      if (a != b) {
+        neighbors_[a].emplace(b);
+        neighbors_[b].emplace(a);
+      }
+    }
+  }
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, [[maybe_unused]] size_t num_nodes) override {
+    return {neighbors_[node_id].begin(), neighbors_[node_id].end()};
+  }
+};
+
+std::unique_ptr<katana::PropertyGraph>
+MakeWeightedGraph(size_t num_nodes, Policy* policy) {
+  auto g = MakeFileGraph<uint32_t>(num_nodes, 0, policy);
+
+  arrow::UInt32Builder builder;
+  std::vector<uint32_t> ones(g->num_edges(), 1);
+  KATANA_LOG_ASSERT(builder.AppendValues(ones).ok());
+  std::shared_ptr<arrow::Array> weights;
+  KATANA_LOG_ASSERT(builder.Finish(&weights).ok());
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("weight", weights->type())}), {weights});
+  KATANA_LOG_ASSERT(g->AddEdgeProperties(table));
+  return g;
+}
+
+/// Cluster g with Leiden and Louvain, check the Leiden clusters and
+/// \returns their statistics
+katana::analytics::LeidenClusteringStatistics
+ClusterAndCompare(katana::PropertyGraph* g) {
+  auto leiden = katana::analytics::LeidenClustering(g, "weight", "leiden");
+  KATANA_LOG_VASSERT(leiden, "LeidenClustering failed: {}", leiden.error());
+  auto valid =
+      katana::analytics::LeidenClusteringAssertValid(g, "weight", "leiden");
+  KATANA_LOG_VASSERT(valid, "invalid clusters: {}", valid.error());
+
+  auto louvain = katana::analytics::LouvainClustering(g, "weight", "louvain");
+  KATANA_LOG_VASSERT(louvain, "LouvainClustering failed: {}", louvain.error());
+
+  auto leiden_stats = katana::analytics::LeidenClusteringStatistics::Compute(
+      g, "weight", "leiden");
+  KATANA_LOG_ASSERT(leiden_stats);
+  auto louvain_stats = katana::analytics::LouvainClusteringStatistics::Compute(
+      g, "weight", "louvain");
+  KATANA_LOG_ASSERT(louvain_stats);
+
+  // Refinement may only split clusters that Louvain would keep, which costs
+  // little modularity
+  double leiden_modularity = leiden_stats.value().modularity;
+  double louvain_modularity = louvain_stats.value().modularity;
+  KATANA_LOG_VASSERT(
+      leiden_modularity >= louvain_modularity - 0.02,
+      "Leiden modularity {} Louvain modularity {}", leiden_modularity,
+      louvain_modularity);
+  return leiden_stats.value();
+}
+
+void
+TestCliqueRing() {
+  CliqueRingPolicy policy;
+  auto g = MakeWeightedGraph(kNumCliques * kCliqueSize, &policy);
+
+  auto stats = ClusterAndCompare(g.get());
+  KATANA_LOG_VASSERT(
+      stats.n_clusters == kNumCliques, "{} clusters", stats.n_clusters);
+  KATANA_LOG_VASSERT(stats.modularity > 0.8, "modularity {}", stats.modularity);
+}
+
+void
+TestRandom() {
+  RandomSymmetricPolicy policy(1000, 4000);
+  auto g = MakeWeightedGraph(1000, &policy);
+
+  ClusterAndCompare(g.get());
+}
+
+/// Stopping right after a local move skips the refinement of that level, and
+/// on a sparse graph some of those moves take a node that bridges two parts
+/// of its cluster elsewhere
+void
+TestEarlyStop() {
+  RandomSymmetricPolicy policy(1000, 1500);
+  auto g = MakeWeightedGraph(1000, &policy);
+
+  using Plan = katana::analytics::LeidenClusteringPlan;
+  std::vector<Plan> plans = {
+      Plan::DoAll(
+          Plan::kDefaultModularityThresholdPerRound,
+          Plan::kDefaultModularityThresholdTotal, 1),
+      Plan::DoAll(
+          Plan::kDefaultModularityThresholdPerRound,
+          Plan::kDefaultModularityThresholdTotal, 2),
+      Plan::DoAll(
+          Plan::kDefaultModularityThresholdPerRound,
+          Plan::kDefaultModularityThresholdTotal,
+          Plan::kDefaultMaxIterations, 500),
+      Plan::DoAll(Plan::kDefaultModularityThresholdPerRound, 1.0),
+  };
+  for (size_t i = 0; i < plans.size(); ++i) {
+    std::string name = "early_stop_" + std::to_string(i);
+    auto leiden =
+        katana::analytics::LeidenClustering(g.get(), "weight", name, plans[i]);
+    KATANA_LOG_VASSERT(leiden, "LeidenClustering failed: {}", leiden.error());
+    auto valid = katana::analytics::LeidenClusteringAssertValid(
+        g.get(), "weight", name);
+    KATANA_LOG_VASSERT(
+        valid, "plan {}: invalid clusters: {}", i, valid.error());
+  }
+}
+
+void
+TestDisconnectedCluster() {
+  CliqueRingPolicy policy;
+  auto g = MakeWeightedGraph(kNumCliques * kCliqueSize, &policy);
+
+  // Cliques 0 and 2 share a cluster but no edge
+  arrow::UInt64Builder builder;
+  for (auto n : *g) {
+    uint64_t clique = n / kCliqueSize;
+    KATANA_LOG_ASSERT(builder.Append(clique == 2 ? 0 : clique).ok());
+  }
+  std::shared_ptr<arrow::Array> clusters;
+  KATANA_LOG_ASSERT(builder.Finish(&clusters).ok());
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("clusters", clusters->type())}), {clusters});
+  KATANA_LOG_ASSERT(g->AddNodeProperties(table));
+
+  KATANA_LOG_ASSERT(!katana::analytics::LeidenClusteringAssertValid(
+      g.get(), "weight", "clusters"));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  TestCliqueRing();
+  TestRandom();
+  TestEarlyStop();
+  TestDisconnectedCluster();
+
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include <map>
+#include <random>
+
+#include "katana/Logging.h"
+#include "katana/analytics/ClusteringImplementationBase.h"
+
+namespace {
+
+using Accumulator = katana::analytics::NeighborClusterAccumulator<uint64_t>;
+
+/// Add \param num_adds random clusters among \param num_clusters and compare
+/// against a std::map
+void
+TestAgainstMap(Accumulator* acc, size_t num_adds, uint64_t num_clusters) {
+  std::mt19937 gen(num_adds);
+  std::uniform_int_distribution<uint64_t> cluster_dist(0, num_clusters - 1);
+  std::uniform_int_distribution<uint64_t> weight_dist(0, 100);
+
+  acc->Clear();
+  std::map<uint64_t, uint64_t> expected;
+  std::vector<uint64_t> order;
+  for (size_t i = 0; i < num_adds; ++i) {
+    // Spread the ids so that they collide in the table
+    uint64_t cluster = cluster_dist(gen) * 1024;
+    uint64_t weight = weight_dist(gen);
+    if (!expected.count(cluster)) {
+      order.push_back(cluster);
+    }
+    expected[cluster] += weight;
+    acc->Add(cluster, weight);
+  }
+
+  KATANA_LOG_ASSERT(acc->size() == expected.size());
+  for (size_t i = 0; i < acc->size(); ++i) {
+    KATANA_LOG_ASSERT(acc->cluster(i) == order[i]);
+    KATANA_LOG_ASSERT(acc->weight(i) == expected[order[i]]);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  Accumulator acc;
+  KATANA_LOG_ASSERT(acc.size() == 0);
+
+  // Reuse the same accumulator across sizes, as per-thread accumulators are
+  TestAgainstMap(&acc, 1, 1);
+  TestAgainstMap(&acc, 100, 10);
+  TestAgainstMap(&acc, 10000, 5000);
+  TestAgainstMap(&acc, 10, 1000);
+  TestAgainstMap(&acc, 0, 1);
+
+  return 0;
+}
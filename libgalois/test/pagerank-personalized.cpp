@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/pagerank/pagerank.h"
+
+namespace {
+
+using Adjacency = std::vector<std::vector<uint32_t>>;
+using katana::analytics::PagerankPlan;
+
+constexpr uint32_t kNumNodes = 20;
+
+class AdjacencyPolicy : public Policy {
+  const Adjacency& adjacency_;
+
+public:
+  AdjacencyPolicy(const Adjacency& adjacency) : adjacency_(adjacency) {}
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, [[maybe_unused]] size_t num_nodes) override {
+    return adjacency_[node_id];
+  }
+};
+
+/// A ring with two chords from each node, except for node 0, which has no
+/// out-edges when \param dangling is set
+Adjacency
+MakeAdjacency(bool dangling) {
+  Adjacency adjacency(kNumNodes);
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    if (n == 0 && dangling) {
+      continue;
+    }
+    adjacency[n] = {
+        (n + 1) % kNumNodes, (n * 3 + 2) % kNumNodes, (n * 7 + 5) % kNumNodes};
+  }
+  return adjacency;
+}
+
+/// \returns the personalized Page Rank of each node for \param seeds by power
+/// iteration: the expected number of visits of a walk that stops with
+/// probability 1 - alpha after each step, and at nodes without out-edges,
+/// times 1 - alpha
+std::vector<double>
+ExactRanks(
+    const Adjacency& adjacency, const std::vector<uint32_t>& seeds,
+    double alpha) {
+  std::vector<double> start(adjacency.size());
+  for (uint32_t seed : seeds) {
+    start[seed] += 1.0 / seeds.size();
+  }
+
+  // Each iteration shrinks the error by alpha
+  std::vector<double> visits = start;
+  for (int i = 0; i < 500; ++i) {
+    std::vector<double> next = start;
+    for (size_t n = 0; n < adjacency.size(); ++n) {
+      for (uint32_t dest : adjacency[n]) {
+        next[dest] += alpha * visits[n] / adjacency[n].size();
+      }
+    }
+    visits = std::move(next);
+  }
+
+  for (double& v : visits) {
+    v *= 1 - alpha;
+  }
+  return visits;
+}
+
+/// \returns the rank of every node from \param result, with 0 for the nodes
+/// it does not list
+std::vector<double>
+Ranks(const katana::analytics::PersonalizedPagerankResult& result) {
+  std::vector<double> ranks(kNumNodes);
+  KATANA_LOG_ASSERT(result.nodes.size() == result.ranks.size());
+  for (size_t i = 0; i < result.nodes.size(); ++i) {
+    ranks[result.nodes.at(i)] = result.ranks[i];
+    KATANA_LOG_ASSERT(i == 0 || result.ranks[i - 1] >= result.ranks[i]);
+  }
+  return ranks;
+}
+
+/// Forward push leaves a residual below the tolerance times the out-degree
+/// (at least 1) at each node, and the rank it misses at each node is at most
+/// the total residual
+void
+CheckForwardPush(bool dangling, const std::vector<uint32_t>& seeds) {
+  Adjacency adjacency = MakeAdjacency(dangling);
+  AdjacencyPolicy policy(adjacency);
+  auto pg = MakeFileGraph<uint32_t>(kNumNodes, 0, &policy);
+
+  for (float tolerance : {1.0e-3f, 1.0e-6f}) {
+    auto plan = PagerankPlan::PushAsynchronous(tolerance);
+    auto result = katana::analytics::PersonalizedPagerank(
+        pg.get(), {seeds}, kNumNodes, plan);
+    KATANA_LOG_VASSERT(
+        result, "PersonalizedPagerank failed: {}", result.error());
+    std::vector<double> ranks = Ranks(result.value()[0]);
+    std::vector<double> exact = ExactRanks(adjacency, seeds, plan.alpha());
+
+    double max_residual = 0;
+    for (const auto& edges : adjacency) {
+      max_residual += tolerance * std::max<size_t>(edges.size(), 1);
+    }
+    // Ranks are accumulated in single precision
+    constexpr double kRoundoff = 1.0e-5;
+    double missing = 0;
+    for (uint32_t n = 0; n < kNumNodes; ++n) {
+      double error = exact[n] - ranks[n];
+      KATANA_LOG_VASSERT(
+          error > -kRoundoff && error < max_residual + kRoundoff,
+          "tolerance {} node {}: rank {} exact {}", tolerance, n, ranks[n],
+          exact[n]);
+      missing += error;
+    }
+    KATANA_LOG_VASSERT(
+        missing < max_residual + kRoundoff,
+        "tolerance {}: missing rank {} above residual bound {}", tolerance,
+        missing, max_residual);
+
+    // Without nodes that end walks early, the residual is exactly the rank
+    // that was not pushed yet
+    if (!dangling) {
+      double total = 0;
+      for (double rank : ranks) {
+        total += rank;
+      }
+      KATANA_LOG_VASSERT(
+          1 - total < max_residual + kRoundoff,
+          "tolerance {}: residual {} above {}", tolerance, 1 - total,
+          max_residual);
+    }
+  }
+}
+
+void
+TestTopK() {
+  Adjacency adjacency = MakeAdjacency(false);
+  AdjacencyPolicy policy(adjacency);
+  auto pg = MakeFileGraph<uint32_t>(kNumNodes, 0, &policy);
+
+  auto plan = PagerankPlan::PushAsynchronous(1.0e-6);
+  auto all = katana::analytics::PersonalizedPagerank(
+      pg.get(), uint32_t{3}, kNumNodes, plan);
+  KATANA_LOG_ASSERT(all);
+  auto top = katana::analytics::PersonalizedPagerank(
+      pg.get(), uint32_t{3}, 5, plan);
+  KATANA_LOG_ASSERT(top);
+
+  KATANA_LOG_ASSERT(top.value().nodes.size() == 5);
+  for (size_t i = 0; i < 5; ++i) {
+    KATANA_LOG_ASSERT(top.value().nodes[i] == all.value().nodes[i]);
+    KATANA_LOG_ASSERT(top.value().ranks[i] == all.value().ranks[i]);
+  }
+}
+
+void
+TestInvalidSeeds() {
+  Adjacency adjacency = MakeAdjacency(false);
+  AdjacencyPolicy policy(adjacency);
+  auto pg = MakeFileGraph<uint32_t>(kNumNodes, 0, &policy);
+
+  KATANA_LOG_ASSERT(!katana::analytics::PersonalizedPagerank(
+      pg.get(), {std::vector<uint32_t>{}}, 5));
+  KATANA_LOG_ASSERT(
+      !katana::analytics::PersonalizedPagerank(pg.get(), kNumNodes, 5));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  CheckForwardPush(false, {0});
+  CheckForwardPush(false, {1, 7, 12});
+  CheckForwardPush(true, {5});
+  CheckForwardPush(true, {4, 9});
+  TestTopK();
+  TestInvalidSeeds();
+
+  return 0;
+}
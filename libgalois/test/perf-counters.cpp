@@ -0,0 +1,78 @@
+#include <algorithm>
+
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/PerfCounters.h"
+#include "katana/Profile.h"
+
+namespace {
+
+void
+TestParse() {
+  auto events = katana::ParsePerfEvents("Cycles,LLCMisses");
+  KATANA_LOG_ASSERT(events);
+  KATANA_LOG_ASSERT(
+      events.value() == std::vector<katana::PerfEvent>(
+                            {katana::PerfEvent::kCycles,
+                             katana::PerfEvent::kLLCMisses}));
+
+  for (katana::PerfEvent event : katana::AllPerfEvents()) {
+    auto parsed = katana::ParsePerfEvents(katana::PerfEventName(event));
+    KATANA_LOG_ASSERT(parsed && parsed.value().front() == event);
+  }
+
+  KATANA_LOG_ASSERT(!katana::ParsePerfEvents("Cycles,"));
+  KATANA_LOG_ASSERT(!katana::ParsePerfEvents("cycles"));
+}
+
+void
+TestCount() {
+  // Counters may not be available, e.g., in virtual machines without a
+  // virtual PMU, in which case no events are counted
+  katana::PerfCounters counters(
+      {katana::PerfEvent::kInstructions, katana::PerfEvent::kCycles});
+
+  std::vector<uint64_t> vec(1 << 20);
+  counters.Start();
+  katana::do_all(katana::iterate(size_t{0}, vec.size()), [&](size_t i) {
+    vec[i] = i;
+  });
+  counters.Stop();
+
+  const auto& events = counters.events();
+  auto it = std::find(
+      events.begin(), events.end(), katana::PerfEvent::kInstructions);
+  if (it == events.end()) {
+    return;
+  }
+  size_t index = it - events.begin();
+  uint64_t instructions = 0;
+  for (unsigned tid = 0; tid < katana::getActiveThreads(); ++tid) {
+    instructions += counters.value(tid, index);
+  }
+  KATANA_LOG_VASSERT(
+      instructions >= vec.size(), "{} instructions", instructions);
+
+  counters.Report("perf-counters");
+}
+
+void
+TestProfile() {
+  bool ran = false;
+  katana::profilePerf([&]() { ran = true; }, "profile-perf");
+  KATANA_LOG_ASSERT(ran);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(2);
+
+  TestParse();
+  TestCount();
+  TestProfile();
+
+  return 0;
+}
@@ -242,6 +242,101 @@ TestTopologyAccess() {
   }
   KATANA_LOG_ASSERT(n_nodes == 10);
 }
+
+void
+TestTopologyLoadOptions() {
+  RandomPolicy policy{3};
+  auto g = MakeFileGraph<uint32_t>(100, 0, &policy);
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  if (auto res = g->Write(rdg_dir, command_line); !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+
+  for (auto populate :
+       {tsuba::TopologyPopulateMode::kRead,
+        tsuba::TopologyPopulateMode::kMapPopulate,
+        tsuba::TopologyPopulateMode::kMapLazy}) {
+    for (auto placement :
+         {tsuba::TopologyPlacement::kInPlace,
+          tsuba::TopologyPlacement::kInterleaved,
+          tsuba::TopologyPlacement::kBlocked,
+          tsuba::TopologyPlacement::kLocal}) {
+      tsuba::RDGLoadOptions opts;
+      opts.topology_populate = populate;
+      opts.topology_placement = placement;
+      opts.topology_huge_pages = true;
+
+      auto make_result = katana::PropertyGraph::Make(rdg_dir, opts);
+      if (!make_result) {
+        fs::remove_all(rdg_dir);
+        KATANA_LOG_FATAL("making result: {}", make_result.error());
+      }
+      std::unique_ptr<katana::PropertyGraph> g2 =
+          std::move(make_result.value());
+      KATANA_LOG_VASSERT(
+          g2->topology().Equals(g->topology()),
+          "populate {} placement {}", static_cast<int>(populate),
+          static_cast<int>(placement));
+
+      // A graph that replaces its topology with a copy of itself must not
+      // depend on the storage the original was loaded into
+      auto set_result = g2->SetTopology(g2->topology());
+      KATANA_LOG_ASSERT(set_result);
+      KATANA_LOG_ASSERT(g2->topology().Equals(g->topology()));
+    }
+  }
+
+  fs::remove_all(rdg_dir);
+}
+
+void
+TestBoundedPropertyLoads() {
+  constexpr size_t test_length = 10;
+  constexpr size_t num_props = 5;
+
+  RandomPolicy policy{1};
+  auto g = MakeFileGraph<uint32_t>(test_length, 0, &policy);
+
+  std::vector<std::string> persist_names;
+  for (size_t i = 0; i < num_props; ++i) {
+    std::string name = fmt::format("node-{}", i);
+    auto add_result =
+        g->AddNodeProperties(MakeProps<int32_t>(name, test_length));
+    KATANA_LOG_ASSERT(add_result);
+    persist_names.emplace_back(name);
+  }
+  KATANA_LOG_ASSERT(g->MarkNodePropertiesPersistent(persist_names));
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  if (auto res = g->Write(rdg_dir, command_line); !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+
+  // Loading one property at a time must still load all of them, in order
+  tsuba::RDGLoadOptions opts;
+  opts.max_concurrent_property_loads = 1;
+  auto make_result = katana::PropertyGraph::Make(rdg_dir, opts);
+  fs::remove_all(rdg_dir);
+  if (!make_result) {
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_result.value());
+
+  KATANA_LOG_ASSERT(
+      static_cast<size_t>(g2->node_properties()->num_columns()) == num_props);
+  for (size_t i = 0; i < num_props; ++i) {
+    KATANA_LOG_ASSERT(g2->node_schema()->field(i)->name() == persist_names[i]);
+  }
+}
 }  // namespace
 
 int
@@ -260,6 +355,8 @@ main(int argc, char** argv) {
   TestGarbageMetadata();
   TestSimplePGs();
   TestTopologyAccess();
+  TestTopologyLoadOptions();
+  TestBoundedPropertyLoads();
 
   return 0;
 }
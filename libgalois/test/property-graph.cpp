@@ -1,10 +1,12 @@
 #include <arrow/api.h>
 #include <arrow/type.h>
 #include <arrow/type_traits.h>
+#include <boost/filesystem.hpp>
 
 #include "TestTypedPropertyGraph.h"
 #include "katana/Logging.h"
 #include "katana/Properties.h"
+#include "katana/Uri.h"
 
 using DataType = int64_t;
 
@@ -126,6 +128,138 @@ TestError1(size_t num_nodes, size_t line_width) {
       "Should return PropertyNotFound when node property doesn't exist.");
 }
 
+/// Test that typed accessors refuse a property with several chunks, which
+/// they could only return a copy of
+void
+TestError2(size_t num_nodes, size_t line_width) {
+  LinePolicy policy{line_width};
+
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 0, &policy);
+
+  arrow::ArrayVector chunks;
+  for (size_t begin = 0; begin < num_nodes; begin += num_nodes / 2) {
+    arrow::UInt32Builder builder;
+    size_t end = std::min(num_nodes, begin + num_nodes / 2);
+    for (size_t n = begin; n < end; ++n) {
+      KATANA_LOG_ASSERT(builder.Append(n).ok());
+    }
+    chunks.emplace_back(builder.Finish().ValueOrDie());
+  }
+  auto chunked = std::make_shared<arrow::ChunkedArray>(chunks);
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("chunked", chunked->type())}), {chunked});
+  KATANA_LOG_ASSERT(g->AddNodeProperties(table));
+
+  auto r = g->GetNodePropertyTyped<uint32_t>("chunked");
+  KATANA_LOG_VASSERT(
+      !r && r.error() == katana::ErrorCode::NotImplemented,
+      "Should return NotImplemented for a property with several chunks.");
+}
+
+/// Test that in-edges are exactly the reversed out-edges, ordered by edge id
+void
+CheckInEdges(const katana::GraphTopology& topo) {
+  KATANA_LOG_ASSERT(topo.has_in_edges());
+
+  size_t num_in_edges = 0;
+  for (auto dst : topo) {
+    bool first = true;
+    uint64_t prev = 0;
+    for (auto in_e : topo.in_edges(dst)) {
+      auto e = topo.in_edge_to_edge(in_e);
+      KATANA_LOG_VASSERT(
+          topo.edge_dest(e) == dst, "{} != {}", topo.edge_dest(e), dst);
+      auto src_edges = topo.edges(topo.in_edge_src(in_e));
+      KATANA_LOG_ASSERT(*src_edges.begin() <= e && e < *src_edges.end());
+      KATANA_LOG_VASSERT(
+          first || prev < e, "node {} in-edge {} after {}", dst, e, prev);
+      first = false;
+      prev = e;
+      ++num_in_edges;
+    }
+  }
+  KATANA_LOG_VASSERT(
+      num_in_edges == topo.num_edges(), "{} != {}", num_in_edges,
+      topo.num_edges());
+}
+
+void
+TestInEdges(size_t num_nodes, size_t line_width) {
+  RandomPolicy policy{line_width};
+
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  KATANA_LOG_ASSERT(!g->topology().has_in_edges());
+  auto r = g->PopulateInEdges();
+  KATANA_LOG_VASSERT(r, "could not populate in-edges: {}", r.error());
+  CheckInEdges(g->topology());
+
+  auto copy = katana::GraphTopology::Copy(g->topology());
+  KATANA_LOG_ASSERT(copy->has_in_edges());
+
+  // The in-edges are written with the graph and mapped back from storage
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertygraph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+  if (auto res = g->Write(rdg_dir, "property-graph"); !res) {
+    boost::filesystem::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+
+  // Commits reuse the stored in-edges
+  for (int i = 0; i < 2; ++i) {
+    if (auto res = g->Commit("property-graph"); !res) {
+      boost::filesystem::remove_all(rdg_dir);
+      KATANA_LOG_FATAL("committing result: {}", res.error());
+    }
+  }
+  size_t num_transpose_files = 0;
+  for (const auto& entry : boost::filesystem::directory_iterator(rdg_dir)) {
+    num_transpose_files +=
+        entry.path().filename().string().rfind("transpose_topology", 0) == 0;
+  }
+  if (num_transpose_files != 1) {
+    boost::filesystem::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("{} transpose topology files", num_transpose_files);
+  }
+
+  auto make_result = katana::PropertyGraph::Make(rdg_dir);
+  if (!make_result) {
+    boost::filesystem::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_result.value());
+  r = g2->PopulateInEdges();
+  boost::filesystem::remove_all(rdg_dir);
+  KATANA_LOG_VASSERT(r, "could not map in-edges: {}", r.error());
+
+  const katana::GraphTopology& topo = g->topology();
+  const katana::GraphTopology& topo2 = g2->topology();
+  CheckInEdges(topo2);
+  for (auto dst : topo) {
+    auto in_edges = topo.in_edges(dst);
+    auto in_edges2 = topo2.in_edges(dst);
+    KATANA_LOG_ASSERT(
+        *in_edges.begin() == *in_edges2.begin() &&
+        *in_edges.end() == *in_edges2.end());
+    for (auto in_e : in_edges) {
+      KATANA_LOG_ASSERT(
+          topo.in_edge_src(in_e) == topo2.in_edge_src(in_e) &&
+          topo.in_edge_to_edge(in_e) == topo2.in_edge_to_edge(in_e));
+    }
+  }
+
+  r = g2->DropInEdges();
+  KATANA_LOG_VASSERT(r, "could not drop in-edges: {}", r.error());
+  KATANA_LOG_ASSERT(!g2->topology().has_in_edges());
+
+  r = g->DropInEdges();
+  KATANA_LOG_VASSERT(r, "could not drop in-edges: {}", r.error());
+  KATANA_LOG_ASSERT(!g->topology().has_in_edges());
+}
+
 int
 main() {
   katana::SharedMemSys S;
@@ -134,6 +268,8 @@ main() {
   TestIterate3(10, 3);
   TestIterate4(10, 3);
   TestError1(10, 3);
+  TestError2(10, 3);
+  TestInEdges(10, 3);
 
   return 0;
 }
@@ -0,0 +1,322 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <set>
+
+#include <arrow/api.h>
+#include <boost/filesystem.hpp>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Uri.h"
+#include "katana/analytics/random_walks/random_walks.h"
+#include "tsuba/ParquetReader.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+/// Random undirected edges without self loops or duplicates, stored in both
+/// directions. The last node is left without neighbors.
+class RandomSymmetricPolicy : public Policy {
+  std::vector<std::set<uint32_t>> neighbors_;
+
+public:
+  RandomSymmetricPolicy(size_t num_nodes, size_t num_pairs)
+      : neighbors_(num_nodes) {
+    auto& gen = katana::GetGenerator();
+    std::uniform_int_distribution<uint32_t> dist(0, num_nodes - 2);
+    for (size_t i = 0; i < num_pairs; ++i) {
+      uint32_t a = dist(gen);
+      uint32_t b = dist(gen);
+      if (a != b) {
+        neighbors_[a].emplace(b);
+        neighbors_[b].emplace(a);
+      }
+    }
+  }
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, [[maybe_unused]] size_t num_nodes) override {
+    return {neighbors_[node_id].begin(), neighbors_[node_id].end()};
+  }
+};
+
+/// Edges between node 0 and every other node
+class StarPolicy : public Policy {
+public:
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, size_t num_nodes) override {
+    if (node_id != 0) {
+      return {0};
+    }
+    std::vector<uint32_t> neighbors(num_nodes - 1);
+    std::iota(neighbors.begin(), neighbors.end(), 1);
+    return neighbors;
+  }
+};
+
+bool
+IsEdge(const katana::PropertyGraph& g, uint32_t src, uint32_t dst) {
+  auto [begin, end] = g.topology().edge_dests(src);
+  return std::find(begin, end, dst) != end;
+}
+
+void
+TestUniform() {
+  constexpr size_t kNumNodes = 500;
+  constexpr uint32_t kWalkLength = 8;
+  constexpr uint32_t kNumWalks = 3;
+  RandomSymmetricPolicy policy(kNumNodes, 3000);
+  auto g = MakeFileGraph<uint32_t>(kNumNodes, 0, &policy);
+
+  size_t num_sources = 0;
+  for (auto n : *g) {
+    num_sources += g->topology().edges(n).size() != 0;
+  }
+
+  auto plan = katana::analytics::RandomWalksPlan::Node2Vec(
+      kWalkLength, kNumWalks, 2.0, 0.5);
+  auto res = katana::analytics::RandomWalks(g.get(), plan);
+  KATANA_LOG_VASSERT(res, "RandomWalks failed: {}", res.error());
+  const auto& walks = res.value();
+
+  KATANA_LOG_VASSERT(
+      walks.num_walks() == num_sources * kNumWalks, "{} walks, expected {}",
+      walks.num_walks(), num_sources * kNumWalks);
+  std::vector<size_t> walks_from(kNumNodes);
+  for (size_t i = 0; i < walks.num_walks(); ++i) {
+    auto [begin, end] = walks.walk(i);
+    // Every node on a symmetric graph with neighbors can go back, so no walk
+    // stops early
+    KATANA_LOG_ASSERT(end - begin == kWalkLength + 1);
+    ++walks_from[*begin];
+    for (auto node = begin + 1; node != end; ++node) {
+      KATANA_LOG_VASSERT(
+          IsEdge(*g, node[-1], node[0]), "walk {} takes {} -> {}", i,
+          node[-1], node[0]);
+    }
+  }
+  for (auto n : *g) {
+    bool has_neighbors = g->topology().edges(n).size() != 0;
+    KATANA_LOG_ASSERT(walks_from[n] == (has_neighbors ? kNumWalks : 0));
+  }
+
+  auto vectors = walks.ToVectors();
+  KATANA_LOG_ASSERT(vectors.size() == walks.num_walks());
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    auto [begin, end] = walks.walk(i);
+    KATANA_LOG_ASSERT(std::equal(begin, end, vectors[i].begin()));
+  }
+}
+
+/// A star whose edge from the center to leaf i has weight i - 1, so the
+/// first leaf is never picked
+template <typename Weight>
+void
+TestWeighted() {
+  constexpr size_t kNumNodes = 5;
+  constexpr uint32_t kNumWalks = 60000;
+  StarPolicy policy;
+  auto g = MakeFileGraph<uint32_t>(kNumNodes, 0, &policy);
+
+  typename arrow::CTypeTraits<Weight>::BuilderType builder;
+  for (auto n : *g) {
+    for (auto e : g->topology().edges(n)) {
+      uint32_t dst = g->topology().edge_dest(e);
+      KATANA_LOG_ASSERT(builder.Append(n == 0 ? dst - 1 : 1).ok());
+    }
+  }
+  std::shared_ptr<arrow::Array> weights;
+  KATANA_LOG_ASSERT(builder.Finish(&weights).ok());
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("weight", weights->type())}), {weights});
+  KATANA_LOG_ASSERT(g->AddEdgeProperties(table));
+
+  auto plan = katana::analytics::RandomWalksPlan::Node2Vec(1, kNumWalks);
+  auto res = katana::analytics::RandomWalks(g.get(), "weight", plan);
+  KATANA_LOG_VASSERT(res, "RandomWalks failed: {}", res.error());
+  const auto& walks = res.value();
+  KATANA_LOG_ASSERT(walks.num_walks() == kNumNodes * kNumWalks);
+
+  std::vector<size_t> steps_to(kNumNodes);
+  for (size_t i = 0; i < walks.num_walks(); ++i) {
+    auto [begin, end] = walks.walk(i);
+    KATANA_LOG_ASSERT(end - begin == 2);
+    KATANA_LOG_ASSERT(IsEdge(*g, begin[0], begin[1]));
+    if (begin[0] == 0) {
+      ++steps_to[begin[1]];
+    }
+  }
+  KATANA_LOG_VASSERT(steps_to[1] == 0, "{} steps of weight 0", steps_to[1]);
+  double total_weight = 0 + 1 + 2 + 3;
+  for (uint32_t leaf = 2; leaf < kNumNodes; ++leaf) {
+    double expected = (leaf - 1) / total_weight;
+    double actual = static_cast<double>(steps_to[leaf]) / kNumWalks;
+    // Several standard deviations, which are at most 0.002
+    KATANA_LOG_VASSERT(
+        std::abs(actual - expected) < 0.01, "leaf {}: {} expected {}", leaf,
+        actual, expected);
+  }
+
+  KATANA_LOG_ASSERT(!katana::analytics::RandomWalks(g.get(), "missing", plan));
+}
+
+/// Walks as vectors, from a list or large list column
+std::vector<std::vector<uint32_t>>
+ColumnToVectors(const arrow::ChunkedArray& column) {
+  std::vector<std::vector<uint32_t>> walks;
+  auto append = [&walks](const auto& lists) {
+    auto nodes = std::static_pointer_cast<arrow::UInt32Array>(lists.values());
+    for (int64_t i = 0; i < lists.length(); ++i) {
+      walks.emplace_back(
+          nodes->raw_values() + lists.value_offset(i),
+          nodes->raw_values() + lists.value_offset(i + 1));
+    }
+  };
+  for (const auto& chunk : column.chunks()) {
+    if (chunk->type_id() == arrow::Type::LARGE_LIST) {
+      append(static_cast<const arrow::LargeListArray&>(*chunk));
+    } else {
+      KATANA_LOG_ASSERT(chunk->type_id() == arrow::Type::LIST);
+      append(static_cast<const arrow::ListArray&>(*chunk));
+    }
+  }
+  return walks;
+}
+
+void
+TestBatches() {
+  constexpr size_t kNumNodes = 300;
+  constexpr uint32_t kWalkLength = 5;
+  constexpr uint32_t kNumWalks = 4;
+  constexpr uint64_t kWalksPerBatch = 250;
+  RandomSymmetricPolicy policy(kNumNodes, 1000);
+  auto g = MakeFileGraph<uint32_t>(kNumNodes, 0, &policy);
+
+  auto plan =
+      katana::analytics::RandomWalksPlan::Node2Vec(kWalkLength, kNumWalks);
+  auto all = katana::analytics::RandomWalks(g.get(), plan);
+  KATANA_LOG_ASSERT(all);
+
+  // The batches hold the same walks as one buffer would, in the same order,
+  // though not the same random steps
+  std::vector<std::vector<uint32_t>> batched;
+  size_t num_batches = 0;
+  auto res = katana::analytics::RandomWalks(
+      g.get(), "", plan, kWalksPerBatch,
+      [&](katana::analytics::RandomWalkBuffer&& batch) -> katana::Result<void> {
+        KATANA_LOG_ASSERT(batch.num_walks() <= kWalksPerBatch);
+        auto walks = batch.ToVectors();
+        batched.insert(batched.end(), walks.begin(), walks.end());
+        ++num_batches;
+        return katana::ResultSuccess();
+      });
+  KATANA_LOG_VASSERT(res, "RandomWalks failed: {}", res.error());
+  KATANA_LOG_ASSERT(
+      num_batches == (kNumNodes * kNumWalks + kWalksPerBatch - 1) /
+                         kWalksPerBatch);
+  KATANA_LOG_ASSERT(batched.size() == all.value().num_walks());
+  for (size_t i = 0; i < batched.size(); ++i) {
+    auto [begin, end] = all.value().walk(i);
+    KATANA_LOG_ASSERT(batched[i].front() == *begin);
+    KATANA_LOG_ASSERT(batched[i].size() == static_cast<size_t>(end - begin));
+    for (size_t j = 1; j < batched[i].size(); ++j) {
+      KATANA_LOG_ASSERT(IsEdge(*g, batched[i][j - 1], batched[i][j]));
+    }
+  }
+
+  // An error from the callback stops the walks
+  size_t calls = 0;
+  res = katana::analytics::RandomWalks(
+      g.get(), "", plan, kWalksPerBatch,
+      [&](katana::analytics::RandomWalkBuffer&&) -> katana::Result<void> {
+        ++calls;
+        return katana::ErrorCode::InvalidArgument;
+      });
+  KATANA_LOG_ASSERT(!res);
+  KATANA_LOG_ASSERT(calls == 1);
+
+  KATANA_LOG_ASSERT(!katana::analytics::RandomWalks(
+      g.get(), "", plan, 0,
+      [](katana::analytics::RandomWalkBuffer&&) -> katana::Result<void> {
+        return katana::ResultSuccess();
+      }));
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/randomwalks");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string dir(uri_res.value().path());
+  fs::create_directories(dir);
+  std::string prefix = dir + "/walks";
+
+  auto files = katana::analytics::RandomWalksToParquet(
+      g.get(), "", plan, prefix, kWalksPerBatch);
+  if (!files) {
+    fs::remove_all(dir);
+    KATANA_LOG_FATAL("RandomWalksToParquet failed: {}", files.error());
+  }
+  KATANA_LOG_ASSERT(files.value() == num_batches);
+
+  auto reader = tsuba::ParquetReader::Make();
+  KATANA_LOG_ASSERT(reader);
+  std::vector<std::vector<uint32_t>> written;
+  for (uint64_t i = 0; i < files.value(); ++i) {
+    auto file_uri = katana::Uri::Make(prefix + fmt::format(".{:06}", i));
+    KATANA_LOG_ASSERT(file_uri);
+    auto table = reader.value()->ReadTable(file_uri.value());
+    if (!table) {
+      fs::remove_all(dir);
+      KATANA_LOG_FATAL("reading walks: {}", table.error());
+    }
+    auto column = table.value()->GetColumnByName(
+        katana::analytics::kRandomWalksColumnName);
+    KATANA_LOG_ASSERT(column);
+    auto walks = ColumnToVectors(*column);
+    written.insert(written.end(), walks.begin(), walks.end());
+  }
+  fs::remove_all(dir);
+
+  KATANA_LOG_ASSERT(written.size() == batched.size());
+  for (size_t i = 0; i < written.size(); ++i) {
+    KATANA_LOG_ASSERT(written[i].front() == batched[i].front());
+    KATANA_LOG_ASSERT(written[i].size() == batched[i].size());
+    for (size_t j = 1; j < written[i].size(); ++j) {
+      KATANA_LOG_ASSERT(IsEdge(*g, written[i][j - 1], written[i][j]));
+    }
+  }
+}
+
+void
+TestNegativeWeight() {
+  StarPolicy policy;
+  auto g = MakeFileGraph<uint32_t>(3, 0, &policy);
+
+  arrow::Int32Builder builder;
+  KATANA_LOG_ASSERT(
+      builder.AppendValues(std::vector<int32_t>(g->num_edges(), -1)).ok());
+  std::shared_ptr<arrow::Array> weights;
+  KATANA_LOG_ASSERT(builder.Finish(&weights).ok());
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("weight", arrow::int32())}), {weights});
+  KATANA_LOG_ASSERT(g->AddEdgeProperties(table));
+
+  KATANA_LOG_ASSERT(!katana::analytics::RandomWalks(g.get(), "weight"));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestUniform();
+  TestWeighted<uint32_t>();
+  TestWeighted<int64_t>();
+  TestWeighted<double>();
+  TestBatches();
+  TestNegativeWeight();
+
+  return 0;
+}
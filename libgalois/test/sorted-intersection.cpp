@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "katana/Logging.h"
+#include "katana/analytics/SortedIntersection.h"
+
+namespace {
+
+std::vector<uint32_t>
+RandomSortedSet(std::mt19937* gen, size_t size, uint32_t max_value) {
+  std::uniform_int_distribution<uint32_t> dist(0, max_value);
+  std::set<uint32_t> values;
+  while (values.size() < size) {
+    values.emplace(dist(*gen));
+  }
+  return {values.begin(), values.end()};
+}
+
+void
+CheckIntersection(
+    const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+  std::vector<uint32_t> expected;
+  std::set_intersection(
+      a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+  uint64_t size = katana::analytics::SortedIntersectionSize(
+      a.data(), a.size(), b.data(), b.size());
+  KATANA_LOG_VASSERT(
+      size == expected.size(), "{} x {}: size {} expected {}", a.size(),
+      b.size(), size, expected.size());
+
+  std::vector<uint32_t> out(std::min(a.size(), b.size()));
+  size_t written = katana::analytics::SortedIntersection(
+      a.data(), a.size(), b.data(), b.size(), out.data());
+  out.resize(written);
+  KATANA_LOG_VASSERT(
+      out == expected, "{} x {}: wrote {} expected {}", a.size(), b.size(),
+      written, expected.size());
+
+  size_t visited = 0;
+  katana::analytics::ForEachSortedIntersection(
+      a.data(), a.size(), b.data(), b.size(), [&](size_t i, size_t j) {
+        KATANA_LOG_ASSERT(a[i] == b[j]);
+        KATANA_LOG_ASSERT(a[i] == expected[visited]);
+        ++visited;
+        return true;
+      });
+  KATANA_LOG_ASSERT(visited == expected.size());
+}
+
+void
+TestRandom() {
+  std::mt19937 gen(1);
+  for (size_t t = 0; t < 5000; ++t) {
+    uint32_t max_value = 1 + gen() % 2000;
+    size_t a_size = std::min<size_t>(gen() % 200, max_value);
+    // Every third pair is skewed, so that it gallops
+    size_t b_size =
+        std::min<size_t>(gen() % (t % 3 == 0 ? 10000 : 200), max_value);
+    CheckIntersection(
+        RandomSortedSet(&gen, a_size, max_value),
+        RandomSortedSet(&gen, b_size, max_value));
+  }
+}
+
+void
+TestEarlyStop() {
+  std::vector<uint32_t> a{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  size_t visited = 0;
+  katana::analytics::ForEachSortedIntersection(
+      a.data(), a.size(), a.data(), a.size(), [&](size_t, size_t) {
+        ++visited;
+        return visited < 3;
+      });
+  KATANA_LOG_ASSERT(visited == 3);
+}
+
+}  // namespace
+
+int
+main() {
+  KATANA_LOG_DEBUG(
+      "intersecting with {}",
+      katana::analytics::SortedIntersectionInstructionSet());
+
+  CheckIntersection({}, {});
+  CheckIntersection({1, 2, 3}, {});
+  TestRandom();
+  TestEarlyStop();
+
+  return 0;
+}
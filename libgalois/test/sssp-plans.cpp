@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "katana/GraphGenerators.h"
+#include "katana/Logging.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Statistics.h"
+#include "katana/analytics/sssp/sssp.h"
+
+namespace {
+
+using katana::analytics::SsspPlan;
+
+/// Collects the statistics of the runtime in place of the system manager
+/// while it is alive
+class ScopedStatManager : public katana::StatManager {
+  katana::StatManager* saved_;
+
+public:
+  ScopedStatManager() : saved_(katana::internal::sysStatManager()) {
+    katana::internal::setSysStatManager(nullptr);
+    katana::internal::setSysStatManager(this);
+  }
+
+  ~ScopedStatManager() {
+    katana::internal::setSysStatManager(nullptr);
+    katana::internal::setSysStatManager(saved_);
+  }
+
+  /// \returns the total of each statistic of region by category
+  std::map<std::string, std::string> Region(const std::string& region) {
+    SetStatFormat(katana::StatFormat::kCSV);
+    std::ostringstream out;
+    PrintStats(out);
+
+    std::map<std::string, std::string> stats;
+    std::istringstream in(out.str());
+    for (std::string line; std::getline(in, line);) {
+      std::vector<std::string> fields;
+      std::istringstream fields_in(line);
+      for (std::string field; std::getline(fields_in, field, ',');) {
+        fields.emplace_back(field);
+      }
+      if (fields.size() > 4 && fields[0] == "STAT" && fields[1] == region) {
+        stats[fields[2]] = fields[4];
+      }
+    }
+    return stats;
+  }
+};
+
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph(uint32_t num_nodes, uint64_t num_edges, uint32_t max_weight) {
+  katana::GraphGeneratorOptions options;
+  options.max_weight = max_weight;
+  auto res = katana::GenerateUniformGraph(num_nodes, num_edges, options);
+  KATANA_LOG_VASSERT(res, "generating graph failed: {}", res.error());
+  return std::move(res.value());
+}
+
+void
+RunAndCheck(katana::PropertyGraph* pg, SsspPlan plan) {
+  auto res = katana::analytics::Sssp(pg, 0, "weight", "distance", plan);
+  KATANA_LOG_VASSERT(res, "sssp failed: {}", res.error());
+  auto valid =
+      katana::analytics::SsspAssertValid(pg, 0, "weight", "distance");
+  KATANA_LOG_VASSERT(valid, "invalid distances: {}", valid.error());
+  KATANA_LOG_ASSERT(pg->RemoveNodeProperty("distance"));
+}
+
+/// Run the automatic plan on pg, check its distances and \returns the delta
+/// and chunk size it chose
+std::pair<unsigned, unsigned>
+RunAutomatic(katana::PropertyGraph* pg) {
+  ScopedStatManager stats;
+  RunAndCheck(pg, SsspPlan());
+
+  auto sssp_stats = stats.Region("SSSP");
+  KATANA_LOG_ASSERT(
+      sssp_stats.count("AutomaticDelta") == 1 &&
+      sssp_stats.count("AutomaticChunkSize") == 1);
+  return {
+      std::stoul(sssp_stats["AutomaticDelta"]),
+      std::stoul(sssp_stats["AutomaticChunkSize"])};
+}
+
+void
+TestAutomaticDelta() {
+  // Delta is about the largest weight over the average degree, which is
+  // about 16 here
+  auto light = MakeGraph(1 << 10, 8 << 10, 1);
+  auto [light_delta, light_chunk] = RunAutomatic(light.get());
+  KATANA_LOG_VASSERT(light_delta == 0, "delta {}", light_delta);
+
+  auto heavy = MakeGraph(1 << 10, 8 << 10, 1 << 16);
+  auto [heavy_delta, heavy_chunk] = RunAutomatic(heavy.get());
+  KATANA_LOG_VASSERT(
+      heavy_delta >= 10 && heavy_delta <= 12, "delta {}", heavy_delta);
+
+  KATANA_LOG_ASSERT(light_chunk == 64 && heavy_chunk == 64);
+}
+
+void
+TestAutomaticChunkSize() {
+  // A chunk holds about 1024 edges, so sparse graphs get larger chunks
+  auto grid_res = katana::GenerateGridGraph(32, 32);
+  KATANA_LOG_ASSERT(grid_res);
+  unsigned grid_chunk = RunAutomatic(grid_res.value().get()).second;
+  KATANA_LOG_VASSERT(grid_chunk == 256, "chunk size {}", grid_chunk);
+
+  auto dense = MakeGraph(1 << 8, 64 << 8, 255);
+  unsigned dense_chunk = RunAutomatic(dense.get()).second;
+  KATANA_LOG_VASSERT(dense_chunk == 16, "chunk size {}", dense_chunk);
+}
+
+void
+TestChunkSizes() {
+  auto pg = MakeGraph(1 << 10, 8 << 10, 255);
+  for (unsigned chunk_size : {16, 64, 256}) {
+    RunAndCheck(pg.get(), SsspPlan::DeltaStep(4, chunk_size));
+    RunAndCheck(pg.get(), SsspPlan::DeltaStepBarrier(4, chunk_size));
+    RunAndCheck(
+        pg.get(), SsspPlan::DeltaTile(
+                      4, SsspPlan::kDefaultEdgeTileSize, chunk_size));
+  }
+
+  KATANA_LOG_ASSERT(!katana::analytics::Sssp(
+      pg.get(), 0, "weight", "distance", SsspPlan::DeltaStep(4, 32)));
+}
+
+/// Point-to-point paths must follow edges of the graph and add up to the
+/// distances of a full search
+void
+TestPointToPoint() {
+  auto pg = MakeGraph(1 << 10, 4 << 10, 1 << 12);
+  auto res = katana::analytics::Sssp(pg.get(), 0, "weight", "distance");
+  KATANA_LOG_VASSERT(res, "sssp failed: {}", res.error());
+  auto dist_res = pg->GetNodePropertyTyped<uint32_t>("distance");
+  KATANA_LOG_ASSERT(dist_res);
+  const uint32_t* dist = dist_res.value()->raw_values();
+  auto weight_res = pg->GetEdgePropertyTyped<uint32_t>("weight");
+  KATANA_LOG_ASSERT(weight_res);
+  const uint32_t* weight = weight_res.value()->raw_values();
+  const katana::GraphTopology& topology = pg->topology();
+  // Distance of the nodes Sssp does not reach
+  constexpr uint32_t kInfinity = std::numeric_limits<uint32_t>::max() / 4;
+
+  for (uint32_t target = 1; target < pg->num_nodes(); target += 37) {
+    for (unsigned delta : {0, 4, 10}) {
+      auto path_res = katana::analytics::SsspPointToPoint(
+          pg.get(), 0, target, "weight", SsspPlan::DeltaStep(delta));
+      KATANA_LOG_VASSERT(path_res, "path failed: {}", path_res.error());
+      const auto& path = path_res.value();
+      KATANA_LOG_ASSERT(path.reachable == (dist[target] != kInfinity));
+      if (!path.reachable) {
+        continue;
+      }
+      KATANA_LOG_ASSERT(path.nodes.front() == 0 && path.nodes.back() == target);
+
+      uint64_t length = 0;
+      for (size_t i = 1; i < path.nodes.size(); ++i) {
+        uint64_t best = UINT64_MAX;
+        for (auto e : topology.edges(path.nodes[i - 1])) {
+          if (topology.edge_dest(e) == path.nodes[i]) {
+            best = std::min<uint64_t>(best, weight[e]);
+          }
+        }
+        KATANA_LOG_VASSERT(
+            best != UINT64_MAX, "no edge from {} to {}", path.nodes[i - 1],
+            path.nodes[i]);
+        length += best;
+      }
+      KATANA_LOG_VASSERT(
+          length == dist[target] && path.distance == dist[target],
+          "target {}: path length {} reported {} distance {}", target, length,
+          path.distance, dist[target]);
+    }
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  TestAutomaticDelta();
+  TestAutomaticChunkSize();
+  TestChunkSizes();
+  TestPointToPoint();
+
+  return 0;
+}
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/Statistics.h"
+
+namespace {
+
+/// Exposes the printed statistics of a manager other than the system one
+class TestStatManager : public katana::StatManager {
+public:
+  std::string Render(katana::StatFormat format) {
+    SetStatFormat(format);
+    std::ostringstream out;
+    PrintStats(out);
+    return out.str();
+  }
+};
+
+std::vector<std::string>
+Lines(const std::string& text) {
+  std::vector<std::string> lines;
+  std::istringstream in(text);
+  for (std::string line; std::getline(in, line);) {
+    lines.emplace_back(line);
+  }
+  return lines;
+}
+
+bool
+Contains(const std::string& text, const std::string& part) {
+  return text.find(part) != std::string::npos;
+}
+
+void
+TestFormats() {
+  unsigned num_threads = katana::getActiveThreads();
+
+  TestStatManager manager;
+  katana::on_each([&](unsigned tid, unsigned) {
+    manager.AddInt("loop", "Iterations", tid + 1, katana::StatTotal::TSUM);
+  });
+  manager.AddFP("loop", "Ratio", 0.5, katana::StatTotal::SINGLE);
+  manager.AddParam("run, \"quoted\"", "Input", "a.gr");
+
+  std::string text = manager.Render(katana::StatFormat::kText);
+  KATANA_LOG_ASSERT(Contains(text, "STAT, loop, Iterations, TSUM, "));
+
+  uint64_t total = uint64_t{num_threads} * (num_threads + 1) / 2;
+
+  auto csv = Lines(manager.Render(katana::StatFormat::kCSV));
+  KATANA_LOG_ASSERT(csv.size() == 4);
+  KATANA_LOG_ASSERT(
+      csv[0] == "STAT_TYPE,REGION,CATEGORY,TOTAL_TYPE,TOTAL,THREAD_VALUES");
+  KATANA_LOG_VASSERT(
+      Contains(csv[1], fmt::format("STAT,loop,Iterations,TSUM,{},1", total)),
+      "{}", csv[1]);
+  KATANA_LOG_ASSERT(
+      std::count(csv[1].begin(), csv[1].end(), ';') ==
+      static_cast<int>(num_threads) - 1);
+  KATANA_LOG_ASSERT(csv[2] == "STAT,loop,Ratio,SINGLE,0.5,0.5");
+  KATANA_LOG_VASSERT(
+      csv[3] == "PARAM,\"run, \"\"quoted\"\"\",Input,SINGLE,a.gr,a.gr", "{}",
+      csv[3]);
+
+  auto json = Lines(manager.Render(katana::StatFormat::kJSON));
+  KATANA_LOG_ASSERT(json.size() == 2);
+  // Regions are sorted by name, and keys are sorted too
+  KATANA_LOG_VASSERT(
+      Contains(
+          json[0],
+          "{\"region\":\"loop\",\"stats\":[{\"category\":\"Iterations\","
+          "\"kind\":\"STAT\",\"thread_values\":[1"),
+      "{}", json[0]);
+  std::string iterations_total =
+      fmt::format("\"total\":{},\"total_type\":\"TSUM\"}}", total);
+  KATANA_LOG_VASSERT(Contains(json[0], iterations_total), "{}", json[0]);
+  KATANA_LOG_ASSERT(Contains(
+      json[0],
+      "{\"category\":\"Ratio\",\"kind\":\"STAT\",\"thread_values\":[0.5],"
+      "\"total\":0.5,\"total_type\":\"SINGLE\"}"));
+  KATANA_LOG_VASSERT(
+      json[1] ==
+          "{\"region\":\"run, \\\"quoted\\\"\",\"stats\":[{\"category\":"
+          "\"Input\",\"kind\":\"PARAM\",\"thread_values\":[\"a.gr\"],"
+          "\"total\":\"a.gr\",\"total_type\":\"SINGLE\"}]}",
+      "{}", json[1]);
+}
+
+void
+TestParse() {
+  KATANA_LOG_ASSERT(
+      katana::ParseStatFormat("json").value() == katana::StatFormat::kJSON);
+  KATANA_LOG_ASSERT(
+      katana::ParseStatFormat("csv").value() == katana::StatFormat::kCSV);
+  KATANA_LOG_ASSERT(
+      katana::ParseStatFormat("text").value() == katana::StatFormat::kText);
+  KATANA_LOG_ASSERT(!katana::ParseStatFormat("xml"));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  TestFormats();
+  TestParse();
+
+  return 0;
+}
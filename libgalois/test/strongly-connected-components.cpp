@@ -0,0 +1,101 @@
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/strongly_connected_components/strongly_connected_components.h"
+
+namespace {
+
+using katana::analytics::StronglyConnectedComponentsPlan;
+
+/// Cycles of cycle_size nodes, each with an edge to the next cycle, so each
+/// cycle is a component and the components form a chain
+class ChainOfCyclesPolicy : public Policy {
+  size_t cycle_size_;
+
+public:
+  ChainOfCyclesPolicy(size_t cycle_size) : cycle_size_(cycle_size) {}
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, size_t num_nodes) override {
+    size_t first = node_id - node_id % cycle_size_;
+    std::vector<uint32_t> r{
+        static_cast<uint32_t>(first + (node_id + 1 - first) % cycle_size_)};
+    if (first + cycle_size_ < num_nodes) {
+      r.emplace_back(first + cycle_size_);
+    }
+    return r;
+  }
+};
+
+std::vector<StronglyConnectedComponentsPlan>
+Plans() {
+  return {
+      StronglyConnectedComponentsPlan::Serial(),
+      StronglyConnectedComponentsPlan::Coloring(),
+      StronglyConnectedComponentsPlan::Coloring(0),
+      StronglyConnectedComponentsPlan::ForwardBackward(),
+      StronglyConnectedComponentsPlan::ForwardBackward(0),
+  };
+}
+
+katana::analytics::StronglyConnectedComponentsStatistics
+Run(katana::PropertyGraph* g, StronglyConnectedComponentsPlan plan) {
+  auto r = katana::analytics::StronglyConnectedComponents(g, "scc", plan);
+  KATANA_LOG_ASSERT(r);
+  KATANA_LOG_VASSERT(
+      katana::analytics::StronglyConnectedComponentsAssertValid(g, "scc"),
+      "algorithm {}", static_cast<int>(plan.algorithm()));
+
+  auto stats_result =
+      katana::analytics::StronglyConnectedComponentsStatistics::Compute(
+          g, "scc");
+  KATANA_LOG_ASSERT(stats_result);
+  KATANA_LOG_ASSERT(g->RemoveNodeProperty("scc"));
+  return stats_result.value();
+}
+
+void
+TestChainOfCycles(size_t num_nodes, size_t cycle_size) {
+  ChainOfCyclesPolicy policy(cycle_size);
+  auto g = MakeFileGraph<uint32_t>(num_nodes, 0, &policy);
+
+  for (const auto& plan : Plans()) {
+    auto stats = Run(g.get(), plan);
+    size_t expected = (num_nodes + cycle_size - 1) / cycle_size;
+    KATANA_LOG_VASSERT(
+        stats.total_components == expected,
+        "algorithm {}: {} components, expected {}",
+        static_cast<int>(plan.algorithm()), stats.total_components, expected);
+    KATANA_LOG_ASSERT(stats.largest_component_size == cycle_size);
+  }
+}
+
+void
+TestRandom(size_t num_nodes, size_t width) {
+  RandomPolicy policy(width);
+  auto g = MakeFileGraph<uint32_t>(num_nodes, 0, &policy);
+
+  uint64_t expected_components = 0;
+  for (const auto& plan : Plans()) {
+    auto stats = Run(g.get(), plan);
+    if (plan.algorithm() == StronglyConnectedComponentsPlan::kSerial) {
+      expected_components = stats.total_components;
+    }
+    KATANA_LOG_ASSERT(stats.total_components == expected_components);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestChainOfCycles(1000, 4);
+  TestChainOfCycles(1001, 1);
+  TestRandom(2000, 1);
+  TestRandom(2000, 3);
+
+  return 0;
+}
@@ -0,0 +1,133 @@
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/Trace.h"
+
+namespace {
+
+nlohmann::json
+TraceEvents() {
+  std::ostringstream out;
+  katana::Tracer::WriteChromeTrace(out);
+  auto trace = nlohmann::json::parse(out.str());
+  return trace.at("traceEvents");
+}
+
+/// Number of spans, by name, of a loop
+std::map<std::string, size_t>
+CountSpans(const nlohmann::json& events, const std::string& category) {
+  std::map<std::string, size_t> counts;
+  for (const auto& event : events) {
+    if (event.at("ph") != "X" || event.at("cat") != category) {
+      continue;
+    }
+    KATANA_LOG_ASSERT(event.at("dur").get<double>() >= 0);
+    counts[event.at("name").get<std::string>()] += 1;
+  }
+  return counts;
+}
+
+void
+TestLoops() {
+  katana::Tracer::Enable();
+
+  {
+    // Loop names need not outlive the loop
+    std::string name = "trace-do-all";
+    katana::do_all(
+        katana::iterate(0, 10000), [](int) {}, katana::steal(),
+        katana::chunk_size<16>(), katana::loopname(name.c_str()));
+    name = "overwritten";
+  }
+  katana::do_all(
+      katana::iterate(0, 100), [](int) {}, katana::no_stats(),
+      katana::loopname("trace-do-all-no-steal"));
+  katana::for_each(
+      katana::iterate(0, 100),
+      [](int i, auto& ctx) {
+        if (i < 1000) {
+          ctx.push(i + 100);
+        }
+      },
+      katana::loopname("trace-for-each"));
+
+  katana::Tracer::Disable();
+
+  // Spans after disabling are not recorded
+  katana::do_all(
+      katana::iterate(0, 100), [](int) {}, katana::loopname("trace-disabled"));
+
+  auto events = TraceEvents();
+
+  auto do_all = CountSpans(events, "trace-do-all");
+  KATANA_LOG_VASSERT(do_all["chunk"] >= 10000 / 16, "{}", do_all["chunk"]);
+  KATANA_LOG_ASSERT(do_all["steal"] > 0);
+  KATANA_LOG_ASSERT(do_all["barrier"] == katana::getActiveThreads());
+
+  auto no_steal = CountSpans(events, "trace-do-all-no-steal");
+  KATANA_LOG_ASSERT(no_steal["chunk"] == katana::getActiveThreads());
+
+  auto for_each = CountSpans(events, "trace-for-each");
+  KATANA_LOG_ASSERT(for_each["work"] > 0);
+  KATANA_LOG_ASSERT(for_each["term"] > 0);
+  KATANA_LOG_ASSERT(for_each["barrier"] >= katana::getActiveThreads());
+
+  KATANA_LOG_ASSERT(CountSpans(events, "trace-disabled").empty());
+  if (katana::getActiveThreads() > 1) {
+    KATANA_LOG_ASSERT(CountSpans(events, "thread_pool")["wake"] > 0);
+  }
+
+  size_t thread_names = 0;
+  for (const auto& event : events) {
+    thread_names += event.at("ph") == "M";
+  }
+  KATANA_LOG_ASSERT(thread_names == katana::getActiveThreads());
+}
+
+void
+TestRingOverwrite() {
+  constexpr size_t kSpansPerThread = 4;
+  katana::Tracer::Enable(kSpansPerThread);
+  katana::do_all(
+      katana::iterate(0, 10000), [](int) {}, katana::steal(),
+      katana::chunk_size<1>(), katana::loopname("trace-overwrite"));
+  katana::Tracer::Disable();
+
+  std::map<unsigned, size_t> spans_by_thread;
+  double last_ts = 0;
+  unsigned last_tid = 0;
+  for (const auto& event : TraceEvents()) {
+    if (event.at("ph") != "X") {
+      continue;
+    }
+    unsigned tid = event.at("tid").get<unsigned>();
+    double ts = event.at("ts").get<double>();
+    // The newest spans of each thread are kept, oldest first
+    KATANA_LOG_ASSERT(tid != last_tid || ts >= last_ts);
+    last_tid = tid;
+    last_ts = ts;
+    spans_by_thread[tid] += 1;
+  }
+  for (const auto& [tid, count] : spans_by_thread) {
+    KATANA_LOG_VASSERT(
+        count == kSpansPerThread, "thread {}: {} spans", tid, count);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  TestLoops();
+  TestRingOverwrite();
+
+  return 0;
+}
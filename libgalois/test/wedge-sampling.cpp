@@ -0,0 +1,189 @@
+#include <cmath>
+#include <numeric>
+#include <set>
+#include <string>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/WedgeSampling.h"
+#include "katana/analytics/local_clustering_coefficient/local_clustering_coefficient.h"
+#include "katana/analytics/triangle_count/triangle_count.h"
+
+namespace {
+
+/// Random undirected edges without self loops or duplicates, stored in both
+/// directions
+class RandomSymmetricPolicy : public Policy {
+  std::vector<std::set<uint32_t>> neighbors_;
+
+public:
+  RandomSymmetricPolicy(size_t num_nodes, size_t num_pairs)
+      : neighbors_(num_nodes) {
+    auto& gen = katana::GetGenerator();
+    std::uniform_int_distribution<uint32_t> dist(0, num_nodes - 1);
+    for (size_t i = 0; i < num_pairs; ++i) {
+      uint32_t a = dist(gen);
+      uint32_t b = dist(gen);
+      if (a != b) {
+        neighbors_[a].emplace(b);
+        neighbors_[b].emplace(a);
+      }
+    }
+  }
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, [[maybe_unused]] size_t num_nodes) override {
+    return {neighbors_[node_id].begin(), neighbors_[node_id].end()};
+  }
+};
+
+/// Edges between node 0 and every other node
+class StarPolicy : public Policy {
+public:
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, size_t num_nodes) override {
+    if (node_id != 0) {
+      return {0};
+    }
+    std::vector<uint32_t> neighbors(num_nodes - 1);
+    std::iota(neighbors.begin(), neighbors.end(), 1);
+    return neighbors;
+  }
+};
+
+void
+TestNormalQuantile() {
+  KATANA_LOG_ASSERT(
+      std::abs(katana::analytics::TwoSidedNormalQuantile(0.95) - 1.95996) <
+      1e-4);
+  KATANA_LOG_ASSERT(
+      std::abs(katana::analytics::TwoSidedNormalQuantile(0.99) - 2.57583) <
+      1e-4);
+}
+
+void
+TestTriangleCount() {
+  RandomSymmetricPolicy policy(2000, 50000);
+  auto g = MakeFileGraph<uint32_t>(2000, 0, &policy);
+
+  auto exact = katana::analytics::TriangleCount(g.get());
+  KATANA_LOG_ASSERT(exact);
+
+  auto plan = katana::analytics::TriangleCountPlan::WedgeSampling(0.05, 0.999);
+  auto res = katana::analytics::ApproximateTriangleCount(g.get(), plan);
+  KATANA_LOG_VASSERT(res, "ApproximateTriangleCount failed: {}", res.error());
+  const auto& estimate = res.value();
+  KATANA_LOG_ASSERT(!estimate.exact);
+  KATANA_LOG_VASSERT(
+      estimate.lower_bound <= exact.value() &&
+          exact.value() <= estimate.upper_bound,
+      "{} triangles, estimated {} in [{}, {}]", exact.value(),
+      estimate.estimate, estimate.lower_bound, estimate.upper_bound);
+  KATANA_LOG_VASSERT(
+      estimate.upper_bound - estimate.lower_bound <=
+          2 * 0.05 * estimate.estimate,
+      "interval [{}, {}] is wider than requested", estimate.lower_bound,
+      estimate.upper_bound);
+
+  auto rounded = katana::analytics::TriangleCount(g.get(), plan);
+  KATANA_LOG_ASSERT(rounded);
+  KATANA_LOG_ASSERT(rounded.value() == std::llround(estimate.estimate));
+
+  KATANA_LOG_ASSERT(!katana::analytics::ApproximateTriangleCount(
+      g.get(), katana::analytics::TriangleCountPlan::OrderedCount()));
+}
+
+void
+TestTriangleFree() {
+  // A star has wedges, but no triangles. With more wedges than the first
+  // round of samples, the interval never narrows and the count is exact.
+  StarPolicy policy;
+  auto g = MakeFileGraph<uint32_t>(1000, 0, &policy);
+
+  auto res = katana::analytics::ApproximateTriangleCount(g.get());
+  KATANA_LOG_ASSERT(res);
+  const auto& estimate = res.value();
+  KATANA_LOG_ASSERT(estimate.exact);
+  KATANA_LOG_ASSERT(estimate.num_samples < 999 * 998 / 2);
+  KATANA_LOG_ASSERT(
+      estimate.estimate == 0 && estimate.lower_bound == 0 &&
+      estimate.upper_bound == 0);
+  KATANA_LOG_ASSERT(estimate.closed_wedge_fraction == 0);
+}
+
+void
+TestSeed() {
+  RandomSymmetricPolicy policy(2000, 50000);
+  auto g = MakeFileGraph<uint32_t>(2000, 0, &policy);
+
+  using Plan = katana::analytics::TriangleCountPlan;
+  auto estimate = [&](uint64_t seed) {
+    auto res = katana::analytics::ApproximateTriangleCount(
+        g.get(), Plan::WedgeSampling(0.05, 0.95, false, seed));
+    KATANA_LOG_ASSERT(res);
+    return res.value().estimate;
+  };
+
+  KATANA_LOG_ASSERT(estimate(1) == estimate(1));
+  KATANA_LOG_ASSERT(estimate(1) != estimate(2));
+}
+
+void
+TestLocalClusteringCoefficient() {
+  RandomSymmetricPolicy policy(2000, 100000);
+  auto g = MakeFileGraph<uint32_t>(2000, 0, &policy);
+
+  using Plan = katana::analytics::LocalClusteringCoefficientPlan;
+  auto r = katana::analytics::LocalClusteringCoefficient(
+      g.get(), "exact", Plan::OrderedCountPerThread(false, Plan::kNoRelabel));
+  KATANA_LOG_ASSERT(r);
+  constexpr double kError = 0.05;
+  r = katana::analytics::LocalClusteringCoefficient(
+      g.get(), "sampled", Plan::WedgeSampling(kError, 0.95, true));
+  KATANA_LOG_VASSERT(r, "sampling failed: {}", r.error());
+
+  auto exact = std::static_pointer_cast<arrow::DoubleArray>(
+      g->GetNodeProperty("exact")->chunk(0));
+  auto sampled = std::static_pointer_cast<arrow::DoubleArray>(
+      g->GetNodeProperty("sampled")->chunk(0));
+  // About 5% of the nodes may be outside their interval, but none by much
+  size_t outside = 0;
+  for (auto n : *g) {
+    double error = std::abs(exact->Value(n) - sampled->Value(n));
+    KATANA_LOG_VASSERT(
+        error < 2 * kError, "node {}: exact {} sampled {}", n, exact->Value(n),
+        sampled->Value(n));
+    outside += error > kError;
+  }
+  KATANA_LOG_VASSERT(outside < g->num_nodes() / 10, "{} outside", outside);
+
+  // The coefficients follow the seed of the plan
+  for (uint64_t seed : {1, 2}) {
+    r = katana::analytics::LocalClusteringCoefficient(
+        g.get(), "seed_" + std::to_string(seed),
+        Plan::WedgeSampling(kError, 0.95, true, seed));
+    KATANA_LOG_VASSERT(r, "sampling failed: {}", r.error());
+  }
+  auto seed_1 = std::static_pointer_cast<arrow::DoubleArray>(
+      g->GetNodeProperty("seed_1")->chunk(0));
+  auto seed_2 = std::static_pointer_cast<arrow::DoubleArray>(
+      g->GetNodeProperty("seed_2")->chunk(0));
+  KATANA_LOG_ASSERT(!seed_1->Equals(*seed_2));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestNormalQuantile();
+  TestTriangleCount();
+  TestTriangleFree();
+  TestSeed();
+  TestLocalClusteringCoefficient();
+
+  return 0;
+}
@@ -26,6 +26,8 @@ public:
   katana::Result<void> Finish();
   /// wait for the op at the head of the list, return true if there was one
   bool FinishOne();
+  /// number of ops that have been added but not finished
+  size_t num_pending() const { return pending_ops_.size(); }
 
 private:
   std::list<AsyncOp> pending_ops_;
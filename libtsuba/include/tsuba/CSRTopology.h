@@ -35,6 +35,44 @@ CSRTopologyFileSize(const CSRTopologyHeader& header) {
          (header.num_edges * header.edge_type_size);
 }
 
+/// The version of CSR files whose edge destinations are compressed
+constexpr uint64_t kCompressedCSRVersion = 3;
+
+/// Compressed CSR files share the header and out index array of other CSR
+/// files. Those are followed by this struct, a sparse index holding the byte
+/// offset of the destinations of every nodes_per_block-th node, and the encoded
+/// destinations (padded to 8 bytes). There is no edge data.
+///
+/// The destinations of a node are stored in edge order, each as the
+/// difference from the previous destination (from the node itself for the
+/// first one), zigzag encoded and written as a LEB128 varint.
+struct CompressedCSRTopologyHeader {
+  uint64_t nodes_per_block{0};
+  uint64_t dests_size{0};
+};
+
+constexpr uint64_t
+CompressedCSRTopologyNumBlocks(
+    const CSRTopologyHeader& header,
+    const CompressedCSRTopologyHeader& compressed_header) {
+  if (compressed_header.nodes_per_block == 0) {
+    return 0;
+  }
+  return (header.num_nodes + compressed_header.nodes_per_block - 1) /
+         compressed_header.nodes_per_block;
+}
+
+constexpr uint64_t
+CompressedCSRTopologyFileSize(
+    const CSRTopologyHeader& header,
+    const CompressedCSRTopologyHeader& compressed_header) {
+  return sizeof(header) + (header.num_nodes * sizeof(uint64_t)) +
+         sizeof(compressed_header) +
+         (CompressedCSRTopologyNumBlocks(header, compressed_header) *
+          sizeof(uint64_t)) +
+         katana::AlignUp<uint64_t>(compressed_header.dests_size);
+}
+
 }  // namespace tsuba
 
 #endif
@@ -60,6 +60,15 @@ public:
   virtual katana::Result<void> Delete(
       const std::string& directory,
       const std::unordered_set<std::string>& files) = 0;
+
+  /// Map the first \param size bytes of the file at \param uri over
+  /// \param addr, which must be page aligned and already reserved by the
+  /// caller. Modifications to the mapping are private to this process. If
+  /// \param populate is true, all pages are faulted in before returning.
+  /// Storage that cannot map files returns ErrorCode::NotImplemented, and
+  /// callers should read the file instead.
+  virtual katana::Result<void> MapFile(
+      const std::string& uri, uint64_t size, uint8_t* addr, bool populate);
 };
 
 /// RegisterFileStorage adds a file storage backend to the tsuba library. File
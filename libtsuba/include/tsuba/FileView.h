@@ -15,6 +15,21 @@
 namespace tsuba {
 
 class KATANA_EXPORT FileView : public arrow::io::RandomAccessFile {
+public:
+  /// Controls how the memory behind a FileView is provided. By default, bound
+  /// regions are read from storage into anonymous memory.
+  struct MapOptions {
+    /// Map the file itself when its storage supports it. All of the file is
+    /// then available through ptr() regardless of the bound region.
+    bool map_file{false};
+    /// When mapping the file, fault in all of its pages during Bind rather
+    /// than on first access
+    bool populate{true};
+    /// Advise the kernel to back this view with transparent huge pages
+    bool huge_pages{false};
+  };
+
+private:
   struct FillingRange {
     uint64_t first_page;
     uint64_t last_page;
@@ -30,6 +45,10 @@ class KATANA_EXPORT FileView : public arrow::io::RandomAccessFile {
   bool valid_{false};
   std::vector<uint64_t> filling_;
   std::unique_ptr<std::vector<FillingRange>> fetches_;
+  MapOptions map_options_;
+
+  // Largest number of pages fetched from storage by a single request
+  static constexpr uint64_t kFetchChunkPages = 64;
 
 public:
   FileView() = default;
@@ -45,7 +64,8 @@ public:
         filename_(std::move(other.filename_)),
         valid_(other.valid_),
         filling_(std::move(other.filling_)),
-        fetches_(std::move(other.fetches_)) {
+        fetches_(std::move(other.fetches_)),
+        map_options_(other.map_options_) {
     other.valid_ = false;
   }
 
@@ -64,6 +84,7 @@ public:
       filling_ = std::move(other.filling_);
       fetches_ =
           std::unique_ptr<std::vector<FillingRange>>(std::move(other.fetches_));
+      map_options_ = other.map_options_;
       other.valid_ = false;
     }
     return *this;
@@ -93,6 +114,12 @@ public:
 
   katana::Result<void> Fill(uint64_t begin, uint64_t end, bool resolve);
 
+  /// Set how memory is provided by subsequent calls to Bind
+  void set_map_options(const MapOptions& map_options) {
+    map_options_ = map_options;
+  }
+  const MapOptions& map_options() const { return map_options_; }
+
   bool Valid() const { return valid_; }
 
   katana::Result<void> Unbind();
@@ -164,6 +191,10 @@ private:
   katana::Result<void> MarkFilled(
       uint64_t* bitmap, uint64_t begin, uint64_t end);
 
+  // Replace the reserved range with a mapping of the whole file; returns
+  // false if the storage backing the file cannot map it
+  katana::Result<bool> MapWholeFile();
+
   // Resolve all outstanding reads that overlap with the range [cursor_, nbytes]
   katana::Result<void> Resolve(int64_t start, int64_t size);
 
@@ -27,6 +27,42 @@ class RDGMeta;
 class RDGCore;
 struct PropStorageInfo;
 
+/// How the topology file of an RDG is brought into memory
+enum class TopologyPopulateMode {
+  /// Read the whole file into anonymous memory while loading
+  kRead,
+  /// Map the file and fault in all of its pages while loading
+  kMapPopulate,
+  /// Map the file and fault in its pages on first access
+  kMapLazy,
+};
+
+/// Where the topology of a loaded RDG lives in memory once it is used as a
+/// graph; see katana::PropertyGraph::Make
+enum class TopologyPlacement {
+  /// Use the loaded file in place without copying it. Its pages stay on
+  /// whichever NUMA nodes they were read or faulted in on; only the copying
+  /// placements control that.
+  kInPlace,
+  /// Copy it, interleaving pages across NUMA nodes
+  kInterleaved,
+  /// Copy it, giving each thread a contiguous block of pages
+  kBlocked,
+  /// Copy it into memory local to the loading thread
+  kLocal,
+};
+
+/// How the topology of an RDG is encoded on storage; see
+/// katana::PropertyGraph::Write
+enum class TopologyEncoding {
+  /// Plain CSR with 32-bit destinations
+  kCSR,
+  /// CSR with delta and varint coded destinations, which a loaded
+  /// katana::PropertyGraph keeps compressed until its topology is first
+  /// used. See CompressedCSRTopologyHeader.
+  kCompressedCSR,
+};
+
 struct KATANA_EXPORT RDGLoadOptions {
   /// Which partition of the RDG on storage should be loaded
   /// nullopt means the partition associated with the current host's ID will be
@@ -38,6 +74,30 @@ struct KATANA_EXPORT RDGLoadOptions {
   /// List of edge properties that should be loaded
   /// nullptr means all edge properties will be loaded
   const std::vector<std::string>* edge_properties{nullptr};
+  /// How the topology is brought into memory. Storage that cannot map files
+  /// (e.g., object stores) always reads them.
+  TopologyPopulateMode topology_populate{TopologyPopulateMode::kRead};
+  /// Where the topology lives once loaded
+  TopologyPlacement topology_placement{TopologyPlacement::kInterleaved};
+  /// Advise the kernel to back the loaded topology with transparent huge
+  /// pages. This is only a hint: a topology that is read (kRead) lives in
+  /// anonymous memory and can get them, but a mapped file only does on file
+  /// systems whose page cache uses huge pages, such as tmpfs. A copy placed
+  /// by topology_placement is not affected.
+  bool topology_huge_pages{false};
+  /// Maximum number of property files read from storage at once, or
+  /// ReadGroup::kUnboundedOutstandingOps (0) for no limit
+  uint32_t max_concurrent_property_loads{ReadGroup::kUnboundedOutstandingOps};
+};
+
+/// What it cost to load one property of an RDG
+struct KATANA_EXPORT PropertyLoadStat {
+  /// name of the property
+  std::string name;
+  /// size of the property in memory once loaded
+  uint64_t bytes{0};
+  /// time spent reading and decoding the property
+  uint64_t usec{0};
 };
 
 class KATANA_EXPORT RDG {
@@ -57,11 +117,13 @@ public:
   bool Equals(const RDG& other) const;
 
   /// Store this RDG at \param handle; if \param ff is not null, it is persisted
-  /// as the topology for this RDG. Add \param command_line to metadata to aid
-  /// in tracking lineage
+  /// as the topology for this RDG. If \param transpose_ff is not null, it is
+  /// persisted as the transpose (CSC) topology for this RDG. Add
+  /// \param command_line to metadata to aid in tracking lineage
   katana::Result<void> Store(
       RDGHandle handle, const std::string& command_line,
-      std::unique_ptr<FileFrame> ff = nullptr);
+      std::unique_ptr<FileFrame> ff = nullptr,
+      std::unique_ptr<FileFrame> transpose_ff = nullptr);
 
   katana::Result<void> AddNodeProperties(
       const std::shared_ptr<arrow::Table>& props);
@@ -93,6 +155,18 @@ public:
 
   katana::Result<void> UnbindTopologyFileStorage();
 
+  /// \returns true if this RDG has a transpose (CSC) topology in storage
+  bool HasTransposeTopology() const;
+
+  /// Map the transpose topology into memory. The transpose topology is not
+  /// loaded by Make; callers that need in-edges bind it on demand.
+  /// \returns NotFound if this RDG does not have a transpose topology
+  katana::Result<void> BindTransposeTopologyFileStorage();
+
+  /// Forget the transpose topology, e.g., because the topology it was derived
+  /// from changed. It will not be persisted by subsequent stores.
+  katana::Result<void> DropTransposeTopology();
+
   /// Inform this RDG that it's topology is in storage at this location
   /// without loading it into memory. \param new_top must exist and be in
   /// the correct directory for this RDG
@@ -181,12 +255,27 @@ public:
 
   const FileView& topology_file_storage() const;
 
+  const FileView& transpose_topology_file_storage() const;
+
+  /// \returns what it cost to load each node property, in the order they
+  /// finished loading
+  const std::vector<PropertyLoadStat>& node_property_load_stats() const {
+    return node_property_load_stats_;
+  }
+
+  /// \returns what it cost to load each edge property, in the order they
+  /// finished loading
+  const std::vector<PropertyLoadStat>& edge_property_load_stats() const {
+    return edge_property_load_stats_;
+  }
+
 private:
   RDG(std::unique_ptr<RDGCore>&& core);
 
   void InitEmptyTables();
 
-  katana::Result<void> DoMake(const katana::Uri& metadata_dir);
+  katana::Result<void> DoMake(
+      const katana::Uri& metadata_dir, const RDGLoadOptions& opts);
 
   static katana::Result<RDG> Make(
       const RDGMeta& meta, const RDGLoadOptions& opts);
@@ -222,6 +311,9 @@ private:
   uint32_t partition_id_{std::numeric_limits<uint32_t>::max()};
   // How this graph was derived from the previous version
   RDGLineage lineage_;
+
+  std::vector<PropertyLoadStat> node_property_load_stats_;
+  std::vector<PropertyLoadStat> edge_property_load_stats_;
 };
 
 }  // namespace tsuba
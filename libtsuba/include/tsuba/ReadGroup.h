@@ -14,11 +14,27 @@ namespace tsuba {
 /// that they have all completed
 class ReadGroup {
 public:
+  /// A bound on outstanding operations that means there is none, which is the
+  /// default
+  static constexpr uint64_t kUnboundedOutstandingOps = 0;
+
   static katana::Result<std::unique_ptr<ReadGroup>> Make();
 
   /// Wait until all operations this descriptor knows about have completed
   katana::Result<void> Finish();
 
+  /// Bound the number of operations that may be outstanding at once, or
+  /// remove the bound with kUnboundedOutstandingOps; see WaitForRoom
+  void set_max_outstanding_ops(uint64_t max_outstanding_ops) {
+    max_outstanding_ops_ = max_outstanding_ops;
+  }
+
+  /// Block until one more operation can be started without exceeding the bound
+  /// on outstanding operations, completing the oldest operations (in FIFO
+  /// order) as needed. Callers that start their operations eagerly should
+  /// call this before starting each operation they add to this group.
+  void WaitForRoom();
+
   /// Add future to the list of futures this ReadGroup will wait for, note
   /// the file name for debugging. `on_complete` is guaranteed to be called
   /// in FIFO order
@@ -56,6 +72,7 @@ public:
 
 private:
   AsyncOpGroup async_op_group_;
+  uint64_t max_outstanding_ops_{kUnboundedOutstandingOps};
 };
 
 }  // namespace tsuba
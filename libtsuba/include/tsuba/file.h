@@ -85,6 +85,13 @@ FileGet(const StrType& uri, T* obj) {
 KATANA_EXPORT std::future<katana::Result<void>> FileGetAsync(
     const std::string& uri, void* result_buffer, uint64_t begin, uint64_t size);
 
+/// Map the first \param size bytes of the file at \param uri over the page
+/// aligned, caller reserved range at \param addr; see FileStorage::MapFile.
+/// Returns ErrorCode::NotImplemented if the storage of \param uri cannot map
+/// files.
+KATANA_EXPORT katana::Result<void> FileMap(
+    const std::string& uri, uint64_t size, void* addr, bool populate);
+
 /// List the set of files in a directory
 /// \param directory is URI whose contents are listed. It can be
 /// Async return type allows this function to be called repeatedly (and
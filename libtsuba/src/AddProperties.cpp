@@ -6,12 +6,42 @@
 #include <arrow/chunked_array.h>
 
 #include "katana/Result.h"
+#include "katana/Time.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FileView.h"
 #include "tsuba/ParquetReader.h"
 
 namespace {
 
+uint64_t
+ArrayDataBytes(const arrow::ArrayData& data) {
+  uint64_t bytes = 0;
+  for (const auto& buffer : data.buffers) {
+    if (buffer) {
+      bytes += buffer->size();
+    }
+  }
+  for (const auto& child : data.child_data) {
+    bytes += ArrayDataBytes(*child);
+  }
+  if (data.dictionary) {
+    bytes += ArrayDataBytes(*data.dictionary);
+  }
+  return bytes;
+}
+
+/// \returns the number of bytes of memory referenced by \param table
+uint64_t
+TableBytes(const arrow::Table& table) {
+  uint64_t bytes = 0;
+  for (const auto& column : table.columns()) {
+    for (const auto& chunk : column->chunks()) {
+      bytes += ArrayDataBytes(*chunk->data());
+    }
+  }
+  return bytes;
+}
+
 katana::Result<std::shared_ptr<arrow::Table>>
 DoLoadProperties(
     const std::string& expected_name, const katana::Uri& file_path,
@@ -78,24 +108,40 @@ tsuba::AddProperties(
     const katana::Uri& uri,
     const std::vector<tsuba::PropStorageInfo>& properties, ReadGroup* grp,
     const std::function<katana::Result<void>(std::shared_ptr<arrow::Table>)>&
-        add_fn) {
+        add_fn,
+    std::vector<PropertyLoadStat>* load_stats) {
   for (const tsuba::PropStorageInfo& prop : properties) {
     const std::string& name = prop.name;
     const katana::Uri& path = uri.Join(prop.path);
+    if (grp) {
+      grp->WaitForRoom();
+    }
+    // written by the load before its future is ready
+    auto load_usec = std::make_shared<uint64_t>(0);
     std::future<katana::Result<std::shared_ptr<arrow::Table>>> future =
         std::async(
             std::launch::async,
-            [name, path]() -> katana::Result<std::shared_ptr<arrow::Table>> {
+            [name, path,
+             load_usec]() -> katana::Result<std::shared_ptr<arrow::Table>> {
+              auto start = katana::Now();
               auto load_result = LoadProperties(name, path);
+              *load_usec = katana::UsSince(start);
               if (!load_result) {
                 return load_result.error().WithContext(
                     "error loading {}", path);
               }
               return load_result.value();
             });
-    auto on_complete = [add_fn,
-                        name](const std::shared_ptr<arrow::Table>& props)
+    auto on_complete = [add_fn, name, load_usec,
+                        load_stats](const std::shared_ptr<arrow::Table>& props)
         -> katana::Result<void> {
+      if (load_stats) {
+        load_stats->emplace_back(PropertyLoadStat{
+            .name = name,
+            .bytes = TableBytes(*props),
+            .usec = *load_usec,
+        });
+      }
       auto add_result = add_fn(props);
       if (!add_result) {
         return add_result.error().WithContext("adding {}", std::quoted(name));
@@ -132,6 +178,9 @@ tsuba::AddPropertySlice(
   for (const tsuba::PropStorageInfo& prop : properties) {
     const std::string& name = prop.name;
     const katana::Uri& path = dir.Join(prop.path);
+    if (grp) {
+      grp->WaitForRoom();
+    }
     std::future<katana::Result<std::shared_ptr<arrow::Table>>> future =
         std::async(
             std::launch::async,
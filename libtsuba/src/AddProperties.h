@@ -6,6 +6,7 @@
 #include "RDGPartHeader.h"
 #include "katana/Result.h"
 #include "katana/Uri.h"
+#include "tsuba/RDG.h"
 #include "tsuba/ReadGroup.h"
 
 namespace tsuba {
@@ -17,11 +18,18 @@ KATANA_EXPORT katana::Result<std::shared_ptr<arrow::Table>> LoadPropertySlice(
     const std::string& expected_name, const katana::Uri& file_path,
     int64_t offset, int64_t length);
 
+/// Load \param properties from \param uri and pass each loaded property to
+/// \param add_fn. If \param grp is not null, properties are loaded
+/// asynchronously, at most as many at once as \param grp allows, and
+/// \param add_fn is called when \param grp completes the load. If
+/// \param load_stats is not null, what it cost to load each property is
+/// appended to it.
 KATANA_EXPORT katana::Result<void> AddProperties(
     const katana::Uri& uri,
     const std::vector<tsuba::PropStorageInfo>& properties, ReadGroup* grp,
     const std::function<katana::Result<void>(std::shared_ptr<arrow::Table>)>&
-        add_fn);
+        add_fn,
+    std::vector<PropertyLoadStat>* load_stats = nullptr);
 
 KATANA_EXPORT katana::Result<void> AddPropertySlice(
     const katana::Uri& dir,
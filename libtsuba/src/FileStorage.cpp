@@ -1,9 +1,15 @@
 #include "tsuba/FileStorage.h"
 
 #include "FileStorage_internal.h"
+#include "tsuba/Errors.h"
 
 tsuba::FileStorage::~FileStorage() = default;
 
+katana::Result<void>
+tsuba::FileStorage::MapFile(const std::string&, uint64_t, uint8_t*, bool) {
+  return ErrorCode::NotImplemented;
+}
+
 std::vector<tsuba::FileStorage*>&
 tsuba::GetRegisteredFileStorages() {
   static std::vector<FileStorage*> fs;
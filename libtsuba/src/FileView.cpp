@@ -30,6 +30,31 @@
  * somehow and also tell users to not modify our files?
  */
 
+namespace {
+
+/// Unmaps a reservation of address space when it goes out of scope, unless
+/// Release has handed it over to its owner
+class ReservationGuard {
+public:
+  ReservationGuard(void* start, uint64_t size) : start_(start), size_(size) {}
+  ReservationGuard(const ReservationGuard&) = delete;
+  ReservationGuard& operator=(const ReservationGuard&) = delete;
+
+  ~ReservationGuard() {
+    if (start_ != nullptr && munmap(start_, size_) != 0) {
+      KATANA_LOG_ERROR("unmapping reservation: {}", katana::ResultErrno());
+    }
+  }
+
+  void Release() { start_ = nullptr; }
+
+private:
+  void* start_;
+  uint64_t size_;
+};
+
+}  // namespace
+
 namespace tsuba {
 
 FileView::~FileView() {
@@ -84,6 +109,7 @@ FileView::Bind(
   if (tmp == MAP_FAILED) {
     return KATANA_ERROR(katana::ResultErrno(), "reserving contiguous range");
   }
+  ReservationGuard reservation(tmp, buf.size);
 
   if (auto res = Unbind(); !res) {
     return res.error().WithContext("resetting for new content");
@@ -94,10 +120,43 @@ FileView::Bind(
   filling_.resize(page_number(buf.size) / 64 + 1, 0);
   file_size_ = buf.size;
   fetches_ = std::make_unique<std::vector<FillingRange>>();
-  if (auto res = Fill(begin, in_end, resolve); !res) {
-    return res.error().WithContext("reading content");
+
+  bool mapped = false;
+  if (map_options_.map_file) {
+    auto map_res = MapWholeFile();
+    if (!map_res) {
+      map_start_ = nullptr;
+      return map_res.error().WithContext("mapping content");
+    }
+    mapped = map_res.value();
+  }
+
+#ifdef MADV_HUGEPAGE
+  // Huge pages are only a hint; the kernel may not support them for this
+  // mapping, so failing to get them is not an error
+  if (map_options_.huge_pages &&
+      madvise(map_start_, file_size_, MADV_HUGEPAGE) != 0) {
+    KATANA_LOG_DEBUG(
+        "madvise(MADV_HUGEPAGE) {}: {}", filename_,
+        katana::ResultErrno().message());
+  }
+#endif
+
+  if (!mapped) {
+    if (auto res = Fill(begin, in_end, resolve); !res) {
+      // Reads already started write into the reservation, so it can only be
+      // released once they are done
+      if (auto resolve_res = Resolve(0, file_size_); !resolve_res) {
+        KATANA_LOG_ERROR(
+            "resolving after failed fill: {}", resolve_res.error());
+        reservation.Release();
+      }
+      map_start_ = nullptr;
+      return res.error().WithContext("reading content");
+    }
   }
 
+  reservation.Release();
   cursor_ = 0;
   valid_ = true;
   return katana::ResultSuccess();
@@ -138,11 +197,22 @@ FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
         return KATANA_ERROR(katana::ResultErrno(), "mprotecting buffer");
       }
 
-      auto peek_fut =
-          FileGetAsync(filename_, map_start_ + file_off, file_off, map_size);
-      KATANA_LOG_ASSERT(peek_fut.valid());
-      FillingRange fetch = {first_page, last_page, std::move(peek_fut)};
-      fetches_->push_back(std::move(fetch));
+      // Fetch in chunks so that readers of the beginning of the region only
+      // wait for the chunks they need while the rest is still in flight
+      for (uint64_t chunk_first = first_page; chunk_first <= last_page;
+           chunk_first += kFetchChunkPages) {
+        uint64_t chunk_last =
+            std::min(chunk_first + kFetchChunkPages - 1, last_page);
+        uint64_t chunk_off = chunk_first * (1UL << page_shift_);
+        uint64_t chunk_size = std::min(
+            (chunk_last + 1) * (1UL << page_shift_) - chunk_off,
+            file_size_ - chunk_off);
+        auto peek_fut = FileGetAsync(
+            filename_, map_start_ + chunk_off, chunk_off, chunk_size);
+        KATANA_LOG_ASSERT(peek_fut.valid());
+        FillingRange fetch = {chunk_first, chunk_last, std::move(peek_fut)};
+        fetches_->push_back(std::move(fetch));
+      }
       if (auto res = MarkFilled(&filling_[0], first_page, last_page); !res) {
         return res.error().WithContext("updating bookkeeping data");
       }
@@ -450,6 +520,23 @@ FileView::MarkFilled(uint64_t* bitmap, uint64_t begin, uint64_t end) {
   return katana::ResultSuccess();
 }
 
+katana::Result<bool>
+FileView::MapWholeFile() {
+  if (auto res =
+          FileMap(filename_, file_size_, map_start_, map_options_.populate);
+      !res) {
+    if (res.error() == ErrorCode::NotImplemented) {
+      return false;
+    }
+    return res.error();
+  }
+  if (auto res = MarkFilled(&filling_[0], 0, page_number(file_size_)); !res) {
+    return res.error().WithContext("updating bookkeeping data");
+  }
+  mem_start_ = 0;
+  return true;
+}
+
 katana::Result<void>
 FileView::Resolve(int64_t start, int64_t size) {
   // This loop could do less work by sorting the vector or storing an
@@ -457,7 +544,7 @@ FileView::Resolve(int64_t start, int64_t size) {
   // bottleneck
   for (auto it = fetches_->begin(); it != fetches_->end();) {
     auto fetch = it;
-    if (fetch->first_page <= page_number(start + size) ||
+    if (fetch->first_page <= page_number(start + size) &&
         fetch->last_page >= page_number(start)) {
       // Complete the remaining work if there is some
       if (fetch->work.valid()) {
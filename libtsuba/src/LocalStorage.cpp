@@ -107,6 +107,32 @@ tsuba::LocalStorage::ReadFile(
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+tsuba::LocalStorage::MapFile(
+    const std::string& uri, uint64_t size, uint8_t* addr, bool populate) {
+  std::string filename = uri;
+  CleanUri(&filename);
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return KATANA_ERROR(katana::ResultErrno(), "opening {}", filename);
+  }
+
+  int flags = MAP_PRIVATE | MAP_FIXED;
+#ifdef MAP_POPULATE
+  if (populate) {
+    flags |= MAP_POPULATE;
+  }
+#endif
+  void* mapped = mmap(addr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+  // the mapping holds its own reference to the file
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    return KATANA_ERROR(katana::ResultErrno(), "mapping {}", filename);
+  }
+  return katana::ResultSuccess();
+}
+
 katana::Result<void>
 tsuba::LocalStorage::Stat(const std::string& uri, StatBuf* s_buf) {
   std::string filename = uri;
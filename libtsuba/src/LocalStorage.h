@@ -80,6 +80,10 @@ public:
   katana::Result<void> Delete(
       const std::string& directory,
       const std::unordered_set<std::string>& files) override;
+
+  katana::Result<void> MapFile(
+      const std::string& uri, uint64_t size, uint8_t* addr,
+      bool populate) override;
 };
 
 }  // namespace tsuba
@@ -357,6 +357,22 @@ tsuba::RDG::DoStore(
     core_->part_header().set_topology_path(t_path.BaseName());
   }
 
+  if (core_->part_header().transpose_topology_path().empty() &&
+      core_->transpose_topology_file_storage().Valid()) {
+    katana::Uri t_path =
+        handle.impl_->rdg_meta().dir().RandFile("transpose_topology");
+
+    TSUBA_PTP(internal::FaultSensitivity::Normal);
+
+    // depends on `transpose_topology_file_storage_` outliving writes
+    write_group->StartStore(
+        t_path.string(),
+        core_->transpose_topology_file_storage().ptr<uint8_t>(),
+        core_->transpose_topology_file_storage().size());
+    TSUBA_PTP(internal::FaultSensitivity::Normal);
+    core_->part_header().set_transpose_topology_path(t_path.BaseName());
+  }
+
   auto node_write_result = WriteProperties(
       *core_->node_properties(), core_->part_header().node_prop_info_list(),
       handle.impl_->rdg_meta().dir(), write_group.get());
@@ -408,13 +424,19 @@ tsuba::RDG::DoStore(
 }
 
 katana::Result<void>
-tsuba::RDG::DoMake(const katana::Uri& metadata_dir) {
+tsuba::RDG::DoMake(
+    const katana::Uri& metadata_dir, const RDGLoadOptions& opts) {
   ReadGroup grp;
+  grp.set_max_outstanding_ops(opts.max_concurrent_property_loads);
+
+  node_property_load_stats_.clear();
+  edge_property_load_stats_.clear();
   auto node_result = AddProperties(
       metadata_dir, core_->part_header().node_prop_info_list(), &grp,
       [rdg = this](const std::shared_ptr<arrow::Table>& props) {
         return rdg->core_->AddNodeProperties(props);
-      });
+      },
+      &node_property_load_stats_);
   if (!node_result) {
     return node_result.error().WithContext("populating node properties");
   }
@@ -423,11 +445,19 @@ tsuba::RDG::DoMake(const katana::Uri& metadata_dir) {
       metadata_dir, core_->part_header().edge_prop_info_list(), &grp,
       [rdg = this](const std::shared_ptr<arrow::Table>& props) {
         return rdg->core_->AddEdgeProperties(props);
-      });
+      },
+      &edge_property_load_stats_);
   if (!edge_result) {
     return edge_result.error().WithContext("populating edge properties");
   }
 
+  FileView::MapOptions map_options;
+  map_options.map_file = opts.topology_populate != TopologyPopulateMode::kRead;
+  map_options.populate =
+      opts.topology_populate != TopologyPopulateMode::kMapLazy;
+  map_options.huge_pages = opts.topology_huge_pages;
+  core_->topology_file_storage().set_map_options(map_options);
+
   katana::Uri t_path = metadata_dir.Join(core_->part_header().topology_path());
   if (auto res = core_->topology_file_storage().Bind(t_path.string(), true);
       !res) {
@@ -516,7 +546,7 @@ tsuba::RDG::Make(const RDGMeta& meta, const RDGLoadOptions& opts) {
     return res.error();
   }
 
-  if (auto res = rdg.DoMake(meta.dir()); !res) {
+  if (auto res = rdg.DoMake(meta.dir(), opts); !res) {
     return res.error();
   }
 
@@ -550,7 +580,7 @@ tsuba::RDG::Make(RDGHandle handle, const RDGLoadOptions& opts) {
 katana::Result<void>
 tsuba::RDG::Store(
     RDGHandle handle, const std::string& command_line,
-    std::unique_ptr<FileFrame> ff) {
+    std::unique_ptr<FileFrame> ff, std::unique_ptr<FileFrame> transpose_ff) {
   if (!handle.impl_->AllowsWrite()) {
     return KATANA_ERROR(
         ErrorCode::InvalidArgument, "handle does not allow write");
@@ -564,6 +594,14 @@ tsuba::RDG::Store(
       handle.impl_->rdg_meta().policy_id(), tsuba::Comm()->Num,
       core_->part_header().metadata().policy_id_);
   if (handle.impl_->rdg_meta().dir() != rdg_dir_) {
+    // The transpose topology is bound lazily; make sure it is in memory so
+    // that it can be copied to the new location
+    if (!transpose_ff && HasTransposeTopology() &&
+        !core_->transpose_topology_file_storage().Valid()) {
+      if (auto res = BindTransposeTopologyFileStorage(); !res) {
+        return res.error().WithContext("copying transpose topology");
+      }
+    }
     core_->part_header().UnbindFromStorage();
   }
 
@@ -584,6 +622,17 @@ tsuba::RDG::Store(
     core_->part_header().set_topology_path(t_path.BaseName());
   }
 
+  if (transpose_ff) {
+    katana::Uri t_path =
+        handle.impl_->rdg_meta().dir().RandFile("transpose_topology");
+
+    transpose_ff->Bind(t_path.string());
+    TSUBA_PTP(internal::FaultSensitivity::Normal);
+    desc->StartStore(std::move(transpose_ff));
+    TSUBA_PTP(internal::FaultSensitivity::Normal);
+    core_->part_header().set_transpose_topology_path(t_path.BaseName());
+  }
+
   return DoStore(handle, command_line, std::move(desc));
 }
 
@@ -714,6 +763,42 @@ tsuba::RDG::UnbindTopologyFileStorage() {
   return core_->topology_file_storage().Unbind();
 }
 
+const tsuba::FileView&
+tsuba::RDG::transpose_topology_file_storage() const {
+  return core_->transpose_topology_file_storage();
+}
+
+bool
+tsuba::RDG::HasTransposeTopology() const {
+  return core_->transpose_topology_file_storage().Valid() ||
+         !core_->part_header().transpose_topology_path().empty();
+}
+
+katana::Result<void>
+tsuba::RDG::BindTransposeTopologyFileStorage() {
+  if (core_->transpose_topology_file_storage().Valid()) {
+    return katana::ResultSuccess();
+  }
+  const std::string& path = core_->part_header().transpose_topology_path();
+  if (path.empty() || rdg_dir_.empty()) {
+    return KATANA_ERROR(
+        ErrorCode::NotFound, "RDG does not have a transpose topology");
+  }
+  katana::Uri t_path = rdg_dir_.Join(path);
+  if (auto res =
+          core_->transpose_topology_file_storage().Bind(t_path.string(), true);
+      !res) {
+    return res.error().WithContext("binding transpose topology {}", t_path);
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+tsuba::RDG::DropTransposeTopology() {
+  core_->part_header().set_transpose_topology_path("");
+  return core_->transpose_topology_file_storage().Unbind();
+}
+
 katana::Result<void>
 tsuba::RDG::SetTopologyFile(const katana::Uri& new_top) {
   katana::Uri dir = new_top.DirName();
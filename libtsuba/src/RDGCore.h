@@ -72,6 +72,13 @@ public:
     topology_file_storage_ = std::move(topology_file_storage);
   }
 
+  const FileView& transpose_topology_file_storage() const {
+    return transpose_topology_file_storage_;
+  }
+  FileView& transpose_topology_file_storage() {
+    return transpose_topology_file_storage_;
+  }
+
   const RDGPartHeader& part_header() const { return part_header_; }
   RDGPartHeader& part_header() { return part_header_; }
   void set_part_header(RDGPartHeader&& part_header) {
@@ -80,6 +87,11 @@ public:
 
   katana::Result<void> RegisterTopologyFile(const std::string& new_top) {
     part_header_.set_topology_path(new_top);
+    // a transpose of the old topology is no longer meaningful
+    part_header_.set_transpose_topology_path("");
+    if (auto res = transpose_topology_file_storage_.Unbind(); !res) {
+      return res.error();
+    }
     return topology_file_storage_.Unbind();
   }
 
@@ -94,6 +106,8 @@ private:
   std::shared_ptr<arrow::Table> edge_properties_;
 
   FileView topology_file_storage_;
+  /// Bound lazily, only once someone asks for in-edges
+  FileView transpose_topology_file_storage_;
 
   RDGPartHeader part_header_;
 };
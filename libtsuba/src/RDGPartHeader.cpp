@@ -15,6 +15,7 @@ namespace {
 
 // TODO (witchel) these key are deprecated as part of parquet
 const char* kTopologyPathKey = "kg.v1.topology.path";
+const char* kTransposeTopologyPathKey = "kg.v1.transpose_topology.path";
 const char* kNodePropertyPathKey = "kg.v1.node_property.path";
 const char* kNodePropertyNameKey = "kg.v1.node_property.name";
 const char* kEdgePropertyPathKey = "kg.v1.edge_property.path";
@@ -306,6 +307,12 @@ RDGPartHeader::Validate() const {
         ErrorCode::InvalidArgument,
         "topology_path doesn't contain a slash (/): {}", topology_path_);
   }
+  if (transpose_topology_path_.find('/') != std::string::npos) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "transpose_topology_path doesn't contain a slash (/): {}",
+        transpose_topology_path_);
+  }
   return katana::ResultSuccess();
 }
 
@@ -372,6 +379,7 @@ RDGPartHeader::UnbindFromStorage() {
     prop.path = "";
   }
   topology_path_ = "";
+  transpose_topology_path_ = "";
 }
 
 }  // namespace tsuba
@@ -391,6 +399,7 @@ void
 tsuba::to_json(json& j, const tsuba::RDGPartHeader& header) {
   j = json{
       {kTopologyPathKey, header.topology_path_},
+      {kTransposeTopologyPathKey, header.transpose_topology_path_},
       {kNodePropertyKey, header.node_prop_info_list_},
       {kEdgePropertyKey, header.edge_prop_info_list_},
       {kPartPropertyFilesKey, header.part_prop_info_list_},
@@ -401,6 +410,10 @@ tsuba::to_json(json& j, const tsuba::RDGPartHeader& header) {
 void
 tsuba::from_json(const json& j, tsuba::RDGPartHeader& header) {
   j.at(kTopologyPathKey).get_to(header.topology_path_);
+  // optional; older graphs do not have a transpose topology
+  if (auto it = j.find(kTransposeTopologyPathKey); it != j.end()) {
+    it->get_to(header.transpose_topology_path_);
+  }
   j.at(kNodePropertyKey).get_to(header.node_prop_info_list_);
   j.at(kEdgePropertyKey).get_to(header.edge_prop_info_list_);
   j.at(kPartPropertyFilesKey).get_to(header.part_prop_info_list_);
@@ -94,6 +94,15 @@ public:
   const std::string& topology_path() const { return topology_path_; }
   void set_topology_path(std::string path) { topology_path_ = std::move(path); }
 
+  /// The transpose (CSC) topology is optional; an empty path means this
+  /// partition does not have one in storage
+  const std::string& transpose_topology_path() const {
+    return transpose_topology_path_;
+  }
+  void set_transpose_topology_path(std::string path) {
+    transpose_topology_path_ = std::move(path);
+  }
+
   const std::vector<PropStorageInfo>& node_prop_info_list() const {
     return node_prop_info_list_;
   }
@@ -137,6 +146,7 @@ private:
   PartitionMetadata metadata_;
 
   std::string topology_path_;
+  std::string transpose_topology_path_;
 };
 
 void to_json(nlohmann::json& j, const RDGPartHeader& header);
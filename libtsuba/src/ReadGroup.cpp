@@ -11,3 +11,15 @@ katana::Result<void>
 tsuba::ReadGroup::Finish() {
   return async_op_group_.Finish();
 }
+
+void
+tsuba::ReadGroup::WaitForRoom() {
+  if (max_outstanding_ops_ == kUnboundedOutstandingOps) {
+    return;
+  }
+  while (async_op_group_.num_pending() >= max_outstanding_ops_) {
+    if (!async_op_group_.FinishOne()) {
+      break;
+    }
+  }
+}
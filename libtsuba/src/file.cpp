@@ -46,6 +46,12 @@ tsuba::FileGetAsync(
       uri, begin, size, static_cast<uint8_t*>(result_buffer));
 }
 
+katana::Result<void>
+tsuba::FileMap(
+    const std::string& uri, uint64_t size, void* addr, bool populate) {
+  return FS(uri)->MapFile(uri, size, static_cast<uint8_t*>(addr), populate);
+}
+
 katana::Result<void>
 tsuba::FileRemoteCopy(
     const std::string& source_uri, const std::string& dest_uri, uint64_t begin,
@@ -17,7 +17,9 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <algorithm>
 #include <iostream>
+#include <unordered_set>
 
 #include <katana/analytics/bfs/bfs.h>
 
@@ -70,6 +72,13 @@ static cll::opt<unsigned int> beta(
     "beta", cll::desc("Beta for direction optimization (default value: 18)"),
     cll::init(18));
 
+static cll::opt<bool> multiSource(
+    "multiSource",
+    cll::desc("If enabled, search from all sources together in batches of "
+              "64 rather than one at a time; distances from all sources are "
+              "persisted (default false)"),
+    cll::init(false));
+
 static cll::opt<bool> thread_spin(
     "threadSpin",
     cll::desc("If enabled, threads busy-wait for rather than use "
@@ -103,6 +112,48 @@ AlgorithmName(BfsPlan::Algorithm algorithm) {
   }
 }
 
+void
+RunMultiSource(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& startNodes,
+    const BfsPlan& plan) {
+  std::vector<std::string> node_distance_props;
+  for (auto start_node : startNodes) {
+    node_distance_props.emplace_back("level-" + std::to_string(start_node));
+  }
+
+  if (auto r = MultiSourceBfs(pg, startNodes, node_distance_props, plan); !r) {
+    KATANA_LOG_FATAL("Failed to run multi-source bfs {}", r.error());
+  }
+
+  for (size_t i = 0; i < startNodes.size(); ++i) {
+    auto r = pg->GetNodePropertyTyped<uint32_t>(node_distance_props[i]);
+    if (!r) {
+      KATANA_LOG_FATAL("Failed to get node property {}", r.error());
+    }
+    auto results = r.value();
+
+    std::cout << "Node " << reportNode << " has distance "
+              << results->Value(reportNode) << " from " << startNodes[i]
+              << "\n";
+
+    if (output) {
+      std::string output_filename =
+          "output-" + std::to_string(startNodes[i]);
+      writeOutput(
+          outputLocation, results->raw_values(), results->length(),
+          output_filename);
+    }
+  }
+
+  if (!skipVerify) {
+    if (MultiSourceBfsAssertValid(pg, startNodes, node_distance_props)) {
+      std::cout << "Verification successful.\n";
+    } else {
+      KATANA_LOG_FATAL("verification failed");
+    }
+  }
+}
+
 int
 main(int argc, char** argv) {
   std::unique_ptr<katana::SharedMemSys> G =
@@ -157,9 +208,28 @@ main(int argc, char** argv) {
         startNodes.end(), std::istream_iterator<uint32_t>{str},
         std::istream_iterator<uint32_t>{});
   }
+  // Each source gets its own property, named after it, so run each once
+  std::unordered_set<uint32_t> seen;
+  auto duplicates = std::remove_if(
+      startNodes.begin(), startNodes.end(),
+      [&seen](uint32_t n) { return !seen.insert(n).second; });
+  if (duplicates != startNodes.end()) {
+    KATANA_LOG_WARN(
+        "ignoring {} repeated start nodes", startNodes.end() - duplicates);
+    startNodes.erase(duplicates, startNodes.end());
+  }
   uint32_t num_sources = startNodes.size();
   std::cout << "Running BFS for " << num_sources << " sources\n";
 
+  if (multiSource) {
+    if (algo != BfsPlan::kSynchronousDirectOpt) {
+      KATANA_LOG_FATAL("-multiSource requires -algo=SyncDO");
+    }
+    RunMultiSource(pg.get(), startNodes, plan);
+    totalTime.stop();
+    return 0;
+  }
+
   for (auto start_node : startNodes) {
     if (start_node >= pg->topology().num_nodes()) {
       KATANA_LOG_FATAL("failed to set source: {}", start_node);
@@ -45,6 +45,13 @@ static cll::opt<unsigned int> report_node(
     cll::desc("Node to report the similarity of (default value 1)"),
     cll::init(1));
 
+static cll::opt<unsigned int> top_k(
+    "topK",
+    cll::desc(
+        "If nonzero, find this many most similar nodes for every node "
+        "instead of comparing to baseNode (default value 0)"),
+    cll::init(0));
+
 using NodeValue = katana::PODProperty<double>;
 
 using NodeData = std::tuple<NodeValue>;
@@ -76,6 +83,25 @@ main(int argc, char** argv) {
     abort();
   }
 
+  if (top_k > 0) {
+    if (auto r = katana::analytics::JaccardTopK(
+            pg.get(), top_k, output_property_name);
+        !r) {
+      KATANA_LOG_FATAL("JaccardTopK failed: {}", r.error());
+    }
+    auto lists = std::static_pointer_cast<arrow::LargeListArray>(
+        pg->GetNodeProperty(output_property_name)->chunk(0));
+    std::cout << "Most similar nodes to node " << report_node << ":\n";
+    auto entries = lists->value_slice(report_node);
+    for (int64_t i = 0; i < entries->length(); ++i) {
+      auto entry = entries->GetScalar(i);
+      KATANA_LOG_ASSERT(entry.ok());
+      std::cout << "  " << (*entry)->ToString() << "\n";
+    }
+    totalTime.stop();
+    return 0;
+  }
+
   if (auto r = katana::analytics::Jaccard(
           pg.get(), base_node, output_property_name,
           katana::analytics::JaccardPlan());
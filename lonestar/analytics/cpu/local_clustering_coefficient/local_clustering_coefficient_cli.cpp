@@ -40,8 +40,23 @@ static cll::opt<LocalClusteringCoefficientPlan::Algorithm> algo(
         LocalClusteringCoefficientPlan::kOrderedCountPerThread,
         "orderedCountPerThread",
         "Ordered Simple Count using PerThreadStorage (default)")),
+    cll::values(clEnumValN(
+        LocalClusteringCoefficientPlan::kWedgeSampling, "wedgeSampling",
+        "Estimate high degree nodes by sampling wedges")),
     cll::init(LocalClusteringCoefficientPlan::kOrderedCountPerThread));
 
+static cll::opt<double> absolute_error(
+    "absoluteError",
+    cll::desc("Target half-width of the confidence interval of the "
+              "coefficient of each node for wedgeSampling (default value "
+              "0.01)"),
+    cll::init(LocalClusteringCoefficientPlan::kDefaultAbsoluteError));
+static cll::opt<double> confidence(
+    "confidence",
+    cll::desc("Confidence of the interval of each node for wedgeSampling "
+              "(default value 0.95)"),
+    cll::init(LocalClusteringCoefficientPlan::kDefaultConfidence));
+
 static cll::opt<bool> relabel(
     "relabel",
     cll::desc("Relabel nodes of the graph (default value of false => "
@@ -80,6 +95,10 @@ main(int argc, char** argv) {
     plan =
         LocalClusteringCoefficientPlan::OrderedCountPerThread(relabeling_flag);
     break;
+  case LocalClusteringCoefficientPlan::kWedgeSampling:
+    plan = LocalClusteringCoefficientPlan::WedgeSampling(
+        absolute_error, confidence);
+    break;
   default:
     std::cerr << "Unknown algo: " << algo << "\n";
   }
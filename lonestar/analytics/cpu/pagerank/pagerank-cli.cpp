@@ -17,6 +17,13 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <sstream>
+
 #include "Lonestar/BoilerPlate.h"
 #include "katana/analytics/pagerank/pagerank.h"
 
@@ -50,12 +57,166 @@ static cll::opt<PagerankPlan::Algorithm> algo(
         clEnumValN(PagerankPlan::kPushAsynchronous, "PushAsync", "PushAsync")),
     cll::init(PagerankPlan::kPushAsynchronous));
 
+static cll::opt<std::string> seedsString(
+    "seeds",
+    cll::desc("String containing whitespace separated list of seed nodes; if "
+              "set, compute the personalized page rank of each seed instead "
+              "of the global page rank"));
+static cll::opt<unsigned int> topK(
+    "topK",
+    cll::desc("Number of nodes to report per seed for personalized page rank "
+              "(default value 10)"),
+    cll::init(10));
+
+static cll::opt<uint32_t> numEdgeChanges(
+    "numEdgeChanges",
+    cll::desc("If set, apply a random batch of this many edge changes, half "
+              "insertions and half deletions, after computing the page rank "
+              "and update it incrementally (push algorithms only)"),
+    cll::init(0));
+
 //! Flag that forces user to be aware that they should be passing in a
 //! transposed graph.
 static cll::opt<bool> transposedGraph(
     "transposedGraph", cll::desc("Specify that the input graph is transposed"),
     cll::init(false));
 
+static void
+RunPersonalized(katana::PropertyGraph* pg, const PagerankPlan& plan) {
+  std::istringstream str(seedsString);
+  std::vector<std::vector<uint32_t>> seed_sets;
+  for (auto it = std::istream_iterator<uint32_t>{str};
+       it != std::istream_iterator<uint32_t>{}; ++it) {
+    seed_sets.push_back({*it});
+  }
+  std::cout << "Running personalized page rank for " << seed_sets.size()
+            << " seeds\n";
+
+  auto results = PersonalizedPagerank(pg, seed_sets, topK, plan);
+  if (!results) {
+    KATANA_LOG_FATAL("Failed to run PersonalizedPagerank {}", results.error());
+  }
+
+  for (size_t i = 0; i < seed_sets.size(); ++i) {
+    const PersonalizedPagerankResult& result = results.value()[i];
+    std::cout << "Seed " << seed_sets[i][0] << ":";
+    for (size_t j = 0; j < result.nodes.size(); ++j) {
+      std::cout << " " << result.nodes[j] << " (" << result.ranks[j] << ")";
+    }
+    std::cout << "\n";
+
+    if (skipVerify) {
+      continue;
+    }
+    if (!std::is_sorted(
+            result.ranks.begin(), result.ranks.end(), std::greater<float>()) ||
+        (!result.ranks.empty() && result.ranks.back() < 0)) {
+      KATANA_LOG_FATAL("verification failed for seed {}", seed_sets[i][0]);
+    }
+  }
+  if (!skipVerify) {
+    std::cout << "Verification successful.\n";
+  }
+}
+
+/// Replace the topology of pg by one with numEdgeChanges random edge changes
+/// and \returns the changes
+static PagerankEdgeChanges
+ApplyRandomEdgeChanges(katana::PropertyGraph* pg) {
+  const katana::GraphTopology& topology = pg->topology();
+  uint32_t num_nodes = topology.num_nodes();
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<uint32_t> node_dist(0, num_nodes - 1);
+
+  PagerankEdgeChanges changes;
+  std::vector<bool> deleted(topology.num_edges());
+  for (uint32_t i = 0; i < numEdgeChanges / 2 && topology.num_edges() > 0;) {
+    uint32_t src = node_dist(gen);
+    auto edges = topology.edges(src);
+    if (edges.empty()) {
+      continue;
+    }
+    std::uniform_int_distribution<uint64_t> edge_dist(
+        *edges.begin(), *edges.end() - 1);
+    uint64_t edge = edge_dist(gen);
+    if (!deleted[edge]) {
+      deleted[edge] = true;
+      changes.deleted.emplace_back(src, topology.edge_dest(edge));
+      ++i;
+    }
+  }
+  std::vector<std::vector<uint32_t>> inserted(num_nodes);
+  for (uint32_t i = changes.deleted.size(); i < numEdgeChanges; ++i) {
+    uint32_t src = node_dist(gen);
+    uint32_t dest = node_dist(gen);
+    inserted[src].emplace_back(dest);
+    changes.inserted.emplace_back(src, dest);
+  }
+
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> dests;
+  indices.reserve(num_nodes);
+  dests.reserve(topology.num_edges() + changes.inserted.size());
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    for (auto e : topology.edges(n)) {
+      if (!deleted[e]) {
+        dests.emplace_back(topology.edge_dest(e));
+      }
+    }
+    dests.insert(dests.end(), inserted[n].begin(), inserted[n].end());
+    indices.emplace_back(dests.size());
+  }
+
+  // Edge properties do not survive the change of topology
+  pg->DropEdgeProperties();
+  if (auto r = pg->SetTopology(std::make_unique<katana::GraphTopology>(
+          indices.data(), indices.size(), dests.data(), dests.size()));
+      !r) {
+    KATANA_LOG_FATAL("Failed to change the topology {}", r.error());
+  }
+  return changes;
+}
+
+static void
+RunIncremental(katana::PropertyGraph* pg, const PagerankPlan& plan) {
+  PagerankEdgeChanges changes = ApplyRandomEdgeChanges(pg);
+  std::cout << "Updating page rank after " << changes.inserted.size()
+            << " edge insertions and " << changes.deleted.size()
+            << " edge deletions\n";
+
+  katana::StatTimer incremental_time("TimerIncremental");
+  incremental_time.start();
+  if (auto r = PagerankIncremental(pg, "rank", changes, plan); !r) {
+    KATANA_LOG_FATAL("Failed to run PagerankIncremental {}", r.error());
+  }
+  incremental_time.stop();
+
+  if (skipVerify) {
+    return;
+  }
+  // The update and a full computation each stop within the tolerance, so
+  // report how far apart they are
+  if (auto r = Pagerank(pg, "recomputed_rank", plan); !r) {
+    KATANA_LOG_FATAL("Failed to run Pagerank {}", r.error());
+  }
+  auto updated = pg->GetNodePropertyTyped<float>("rank");
+  auto recomputed = pg->GetNodePropertyTyped<float>("recomputed_rank");
+  if (!updated || !recomputed) {
+    KATANA_LOG_FATAL("Failed to get the ranks");
+  }
+  float max_difference = 0;
+  for (uint32_t n = 0; n < pg->num_nodes(); ++n) {
+    max_difference = std::max(
+        max_difference,
+        std::abs(updated.value()->Value(n) - recomputed.value()->Value(n)));
+  }
+  std::cout << "Largest difference from recomputed rank: " << max_difference
+            << "\n";
+  if (auto r = pg->RemoveNodeProperty("recomputed_rank"); !r) {
+    KATANA_LOG_FATAL("Failed to remove node property {}", r.error());
+  }
+}
+
 int
 main(int argc, char** argv) {
   std::unique_ptr<katana::SharedMemSys> G =
@@ -69,6 +230,10 @@ main(int argc, char** argv) {
         " please use the -transposedGraph flag "
         " to indicate the input is a transposed graph.");
   }
+  if (numEdgeChanges > 0 && algo != PagerankPlan::kPushAsynchronous &&
+      algo != PagerankPlan::kPushSynchronous) {
+    KATANA_DIE("-numEdgeChanges requires a push algorithm");
+  }
 
   katana::StatTimer totalTime("TimerTotal");
   totalTime.start();
@@ -87,10 +252,20 @@ main(int argc, char** argv) {
 
   PagerankPlan plan{kCPU, algo, tolerance, maxIterations, kAlpha};
 
+  if (!seedsString.empty()) {
+    RunPersonalized(pg.get(), plan);
+    totalTime.stop();
+    return 0;
+  }
+
   if (auto r = Pagerank(pg.get(), "rank", plan); !r) {
     KATANA_LOG_FATAL("Failed to run Pagerank {}", r.error());
   }
 
+  if (numEdgeChanges > 0) {
+    RunIncremental(pg.get(), plan);
+  }
+
   auto stats_result = PagerankStatistics::Compute(pg.get(), "rank");
   if (!stats_result) {
     KATANA_LOG_FATAL("Failed to compute stats {}", stats_result.error());
@@ -18,6 +18,7 @@
  */
 
 #include <iostream>
+#include <limits>
 
 #include "Lonestar/BoilerPlate.h"
 #include "katana/analytics/random_walks/random_walks.h"
@@ -69,6 +70,27 @@ static cll::opt<uint32_t> numberOfEdgeTypes(
     "numberOfEdgeTypes", cll::desc("Number of edge types (only for Edge2Vec)"),
     cll::init(1));
 
+static cll::opt<bool> weighted(
+    "weighted",
+    cll::desc(
+        "Pick each step with probability proportional to the edge property "
+        "given by -edgePropertyName (only for Node2Vec)"),
+    cll::init(false));
+
+static cll::opt<uint64_t> walksPerBatch(
+    "walksPerBatch",
+    cll::desc(
+        "Number of walks generated and written at a time with -output; "
+        "bounds the memory used by walks (only for Node2Vec)"),
+    cll::init(kDefaultRandomWalksPerBatch));
+
+static cll::opt<bool> parquetOutput(
+    "parquetOutput",
+    cll::desc(
+        "Write the walks to Parquet files named after -outputFile, one per "
+        "batch, instead of a text file"),
+    cll::init(false));
+
 std::string
 AlgorithmName(RandomWalksPlan::Algorithm algorithm) {
   switch (algorithm) {
@@ -82,16 +104,13 @@ AlgorithmName(RandomWalksPlan::Algorithm algorithm) {
 }
 
 void
-PrintWalks(
-    const std::vector<std::vector<uint32_t>>& walks,
-    const std::string& output_file) {
-  std::ofstream f(output_file);
-
-  for (auto walk : walks) {
-    for (auto node : walk) {
-      f << node << " ";
+PrintWalks(const RandomWalkBuffer& walks, std::ofstream& f) {
+  for (size_t i = 0; i < walks.num_walks(); ++i) {
+    auto [begin, end] = walks.walk(i);
+    for (auto node = begin; node != end; ++node) {
+      f << *node << " ";
     }
-    f << std::endl;
+    f << "\n";
   }
 }
 
@@ -134,15 +153,48 @@ main(int argc, char** argv) {
     KATANA_LOG_FATAL("Invalid algorithm");
   }
 
-  auto walks_result = RandomWalks(pg.get(), plan);
-  if (!walks_result) {
-    KATANA_LOG_FATAL("Failed to run RandomWalks: {}", walks_result.error());
+  if (weighted && algo != RandomWalksPlan::kNode2Vec) {
+    KATANA_LOG_FATAL("-weighted is only supported by Node2Vec");
+  }
+  std::string weight_property_name;
+  if (weighted) {
+    weight_property_name = edge_property_name;
   }
 
-  if (output) {
-    std::string output_file = outputLocation + "/" + outputFile;
-    katana::gInfo("Writing random walks to a file: ", output_file);
-    PrintWalks(walks_result.value(), output_file);
+  if (!output) {
+    auto walks_result = RandomWalks(pg.get(), weight_property_name, plan);
+    if (!walks_result) {
+      KATANA_LOG_FATAL("Failed to run RandomWalks: {}", walks_result.error());
+    }
+    return 0;
+  }
+
+  // Edge2Vec learns from all the walks at once
+  uint64_t walks_per_batch = algo == RandomWalksPlan::kNode2Vec
+                                 ? walksPerBatch
+                                 : std::numeric_limits<uint64_t>::max();
+  std::string output_file = outputLocation + "/" + outputFile;
+  katana::gInfo("Writing random walks to a file: ", output_file);
+
+  if (parquetOutput) {
+    auto files_result = RandomWalksToParquet(
+        pg.get(), weight_property_name, plan, output_file, walks_per_batch);
+    if (!files_result) {
+      KATANA_LOG_FATAL("Failed to run RandomWalks: {}", files_result.error());
+    }
+    std::cout << "Wrote " << files_result.value() << " files\n";
+    return 0;
+  }
+
+  std::ofstream f(output_file);
+  auto walks_result = RandomWalks(
+      pg.get(), weight_property_name, plan, walks_per_batch,
+      [&f](RandomWalkBuffer&& batch) -> katana::Result<void> {
+        PrintWalks(batch, f);
+        return katana::ResultSuccess();
+      });
+  if (!walks_result) {
+    KATANA_LOG_FATAL("Failed to run RandomWalks: {}", walks_result.error());
   }
 
   return 0;
@@ -57,10 +57,27 @@ static cll::opt<bool> persistAllDistances(
 static cll::opt<unsigned int> reportNode(
     "reportNode", cll::desc("Node to report distance to(default value 1)"),
     cll::init(1));
+static cll::opt<bool> pointToPoint(
+    "pointToPoint",
+    cll::desc("If enabled, only compute the shortest path from each source to "
+              "-reportNode and do not persist distances (default false)"),
+    cll::init(false));
+static cll::opt<unsigned int> landmarks(
+    "landmarks",
+    cll::desc("With -pointToPoint, first build a landmark index with this "
+              "many landmarks and answer the queries with it (default value "
+              "0, no index)"),
+    cll::init(0));
 static cll::opt<unsigned int> stepShift(
     "delta", cll::desc("Shift value for the deltastep (default value 13)"),
     cll::init(13));
 
+static cll::opt<unsigned int> chunkSize(
+    "chunkSize",
+    cll::desc("Worklist chunk size for delta stepping: 16, 64 or 256 "
+              "(default value 64)"),
+    cll::init(SsspPlan::kDefaultChunkSize));
+
 static cll::opt<SsspPlan::Algorithm> algo(
     "algo", cll::desc("Choose an algorithm (default value auto):"),
     cll::values(
@@ -98,6 +115,8 @@ static cll::opt<bool> thread_spin(
 //! [withnumaalloc]
 //! [withnumaalloc]
 
+const std::string kLandmarkIndexPrefix = "landmark-";
+
 std::string
 AlgorithmName(SsspPlan::Algorithm algorithm) {
   switch (algorithm) {
@@ -146,6 +165,75 @@ OutputResults(
       output_filename);
 }
 
+void
+RunPointToPoint(
+    katana::PropertyGraph* pg, uint32_t startNode, const SsspPlan& plan) {
+  auto path_result =
+      landmarks > 0
+          ? SsspLandmarkQuery(
+                pg, startNode, reportNode, edge_property_name,
+                kLandmarkIndexPrefix)
+          : SsspPointToPoint(
+                pg, startNode, reportNode, edge_property_name, plan);
+  if (!path_result) {
+    KATANA_LOG_FATAL("Failed to run SSSP: {}", path_result.error());
+  }
+  const SsspPath& path = path_result.value();
+  if (!path.reachable) {
+    std::cout << "Node " << reportNode << " is not reachable from "
+              << startNode << "\n";
+  } else {
+    std::cout << "Node " << reportNode << " has distance " << path.distance
+              << " from " << startNode << " over " << path.nodes.size() - 1
+              << " edges\n";
+  }
+
+  if (skipVerify) {
+    return;
+  }
+
+  // Check the distance against a full single-source search
+  std::string node_distance_prop = "distance-" + std::to_string(startNode);
+  if (auto r = Sssp(
+          pg, startNode, edge_property_name, node_distance_prop,
+          SsspPlan::Dijkstra());
+      !r) {
+    KATANA_LOG_FATAL("Failed to run SSSP: {}", r.error());
+  }
+  auto stats_result = SsspStatistics::Compute(pg, node_distance_prop);
+  if (!stats_result) {
+    KATANA_LOG_FATAL("Computing statistics: {}", stats_result.error());
+  }
+  auto distances = pg->GetNodeProperty(node_distance_prop);
+  auto expected_result = distances->GetScalar(reportNode);
+  if (!expected_result.ok()) {
+    KATANA_LOG_FATAL(
+        "Failed to get distance: {}", expected_result.status().ToString());
+  }
+  auto expected = expected_result.ValueOrDie();
+  auto cast_result = expected->CastTo(arrow::float64());
+  if (!cast_result.ok()) {
+    KATANA_LOG_FATAL(
+        "Failed to cast distance: {}", cast_result.status().ToString());
+  }
+  double expected_distance =
+      std::static_pointer_cast<arrow::DoubleScalar>(cast_result.ValueOrDie())
+          ->value;
+  // Unreached nodes have a distance above that of any reached node
+  bool expected_reachable =
+      expected_distance <= stats_result.value().max_distance;
+  if (path.reachable != expected_reachable ||
+      (path.reachable && path.distance != expected_distance)) {
+    KATANA_LOG_FATAL(
+        "verification failed: distance {} expected {}", path.distance,
+        expected_distance);
+  }
+  if (auto r = pg->RemoveNodeProperty(node_distance_prop); !r) {
+    KATANA_LOG_FATAL("Failed to remove property: {}", r.error());
+  }
+  std::cout << "Verification successful.\n";
+}
+
 }  // namespace
 
 int
@@ -202,13 +290,14 @@ main(int argc, char** argv) {
   SsspPlan plan;
   switch (algo) {
   case SsspPlan::kDeltaTile:
-    plan = SsspPlan::DeltaTile(stepShift);
+    plan = SsspPlan::DeltaTile(
+        stepShift, SsspPlan::kDefaultEdgeTileSize, chunkSize);
     break;
   case SsspPlan::kDeltaStep:
-    plan = SsspPlan::DeltaStep(stepShift);
+    plan = SsspPlan::DeltaStep(stepShift, chunkSize);
     break;
   case SsspPlan::kDeltaStepBarrier:
-    plan = SsspPlan::DeltaStepBarrier(stepShift);
+    plan = SsspPlan::DeltaStepBarrier(stepShift, chunkSize);
     break;
   case SsspPlan::kDeltaStepFusion:
     plan = SsspPlan::DeltaStepFusion(stepShift);
@@ -238,11 +327,25 @@ main(int argc, char** argv) {
     KATANA_LOG_FATAL("Invalid algorithm selected");
   }
 
+  if (pointToPoint && landmarks > 0) {
+    if (auto r = SsspBuildLandmarkIndex(
+            pg.get(), edge_property_name, landmarks, kLandmarkIndexPrefix,
+            plan);
+        !r) {
+      KATANA_LOG_FATAL("Failed to build landmark index: {}", r.error());
+    }
+  }
+
   for (auto startNode : startNodes) {
     if (startNode >= pg->topology().num_nodes()) {
       KATANA_LOG_FATAL("failed to set source: {}", startNode);
     }
 
+    if (pointToPoint) {
+      RunPointToPoint(pg.get(), startNode, plan);
+      continue;
+    }
+
     std::string node_distance_prop = "distance-" + std::to_string(startNode);
     auto pg_result =
         Sssp(pg.get(), startNode, edge_property_name, node_distance_prop, plan);
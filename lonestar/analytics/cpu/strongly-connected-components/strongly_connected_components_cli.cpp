@@ -0,0 +1,123 @@
+#include <iostream>
+
+#include "Lonestar/BoilerPlate.h"
+#include "katana/analytics/strongly_connected_components/strongly_connected_components.h"
+
+using namespace katana::analytics;
+
+namespace cll = llvm::cl;
+
+const char* name = "Strongly Connected Components";
+const char* desc = "Computes the strongly connected components of a graph";
+static const char* url = "strongly_connected_components";
+
+static cll::opt<std::string> inputFile(
+    cll::Positional, cll::desc("<input file>"), cll::Required);
+
+static cll::opt<StronglyConnectedComponentsPlan::Algorithm> algo(
+    "algo", cll::desc("Choose an algorithm (default value ForwardBackward):"),
+    cll::values(
+        clEnumValN(
+            StronglyConnectedComponentsPlan::kSerial, "Serial",
+            "Serial algorithm"),
+        clEnumValN(
+            StronglyConnectedComponentsPlan::kColoring, "Coloring",
+            "Coloring algorithm"),
+        clEnumValN(
+            StronglyConnectedComponentsPlan::kForwardBackward,
+            "ForwardBackward",
+            "Forward-backward search followed by coloring")),
+    cll::init(StronglyConnectedComponentsPlan::kForwardBackward));
+
+static cll::opt<uint32_t> trimRounds(
+    "trimRounds",
+    cll::desc("(For parallel algos) maximum number of passes trimming nodes "
+              "without in-edges or out-edges (default 4)"),
+    cll::init(StronglyConnectedComponentsPlan::kDefaultTrimRounds));
+
+std::string
+AlgorithmName(StronglyConnectedComponentsPlan::Algorithm algorithm) {
+  switch (algorithm) {
+  case StronglyConnectedComponentsPlan::kSerial:
+    return "Serial";
+  case StronglyConnectedComponentsPlan::kColoring:
+    return "Coloring";
+  case StronglyConnectedComponentsPlan::kForwardBackward:
+    return "ForwardBackward";
+  default:
+    return "Unknown";
+  }
+}
+
+int
+main(int argc, char** argv) {
+  std::unique_ptr<katana::SharedMemSys> G =
+      LonestarStart(argc, argv, name, desc, url, &inputFile);
+
+  katana::StatTimer totalTime("TimerTotal");
+  totalTime.start();
+
+  std::cout << "Reading from file: " << inputFile << "\n";
+  std::unique_ptr<katana::PropertyGraph> pg =
+      MakeFileGraph(inputFile, edge_property_name);
+
+  std::cout << "Read " << pg->topology().num_nodes() << " nodes, "
+            << pg->topology().num_edges() << " edges\n";
+
+  std::cout << "Running " << AlgorithmName(algo) << " algorithm\n";
+
+  StronglyConnectedComponentsPlan plan;
+  switch (algo) {
+  case StronglyConnectedComponentsPlan::kSerial:
+    plan = StronglyConnectedComponentsPlan::Serial();
+    break;
+  case StronglyConnectedComponentsPlan::kColoring:
+    plan = StronglyConnectedComponentsPlan::Coloring(trimRounds);
+    break;
+  case StronglyConnectedComponentsPlan::kForwardBackward:
+    plan = StronglyConnectedComponentsPlan::ForwardBackward(trimRounds);
+    break;
+  default:
+    std::cerr << "Invalid algorithm\n";
+    abort();
+  }
+
+  if (auto r = StronglyConnectedComponents(pg.get(), "component", plan); !r) {
+    KATANA_LOG_FATAL(
+        "Failed to run StronglyConnectedComponents: {}", r.error());
+  }
+
+  auto stats_result =
+      StronglyConnectedComponentsStatistics::Compute(pg.get(), "component");
+  if (!stats_result) {
+    KATANA_LOG_FATAL(
+        "Failed to compute StronglyConnectedComponents statistics: {}",
+        stats_result.error());
+  }
+  auto stats = stats_result.value();
+  stats.Print();
+
+  if (!skipVerify) {
+    if (StronglyConnectedComponentsAssertValid(pg.get(), "component")) {
+      std::cout << "Verification successful.\n";
+    } else {
+      KATANA_LOG_FATAL("verification failed");
+    }
+  }
+
+  if (output) {
+    auto r = pg->GetNodePropertyTyped<uint64_t>("component");
+    if (!r) {
+      KATANA_LOG_FATAL("Failed to get node property {}", r.error());
+    }
+    auto results = r.value();
+    KATANA_LOG_DEBUG_ASSERT(
+        uint64_t(results->length()) == pg->topology().num_nodes());
+
+    writeOutput(outputLocation, results->raw_values(), results->length());
+  }
+
+  totalTime.stop();
+
+  return 0;
+}
@@ -0,0 +1,389 @@
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Lonestar/BoilerPlate.h"
+#include "katana/GraphGenerators.h"
+#include "katana/JSON.h"
+#include "katana/Timer.h"
+#include "katana/Version.h"
+#include "katana/analytics/bfs/bfs.h"
+#include "katana/analytics/connected_components/connected_components.h"
+#include "katana/analytics/k_core/k_core.h"
+#include "katana/analytics/louvain_clustering/louvain_clustering.h"
+#include "katana/analytics/pagerank/pagerank.h"
+#include "katana/analytics/sssp/sssp.h"
+#include "katana/analytics/triangle_count/triangle_count.h"
+
+using namespace katana::analytics;
+
+constexpr static const char* const name = "Synthetic Benchmark";
+constexpr static const char* const desc =
+    "Generates synthetic graphs at the given scales and times analytics "
+    "algorithms on them with the given numbers of threads.";
+constexpr static const char* const url = nullptr;
+
+/*******************************************************************************
+ * Declaration of command line arguments
+ ******************************************************************************/
+namespace cll = llvm::cl;
+
+enum Generator { kKronecker, kRmat, kUniform, kGrid };
+
+enum Algorithm {
+  kBfs,
+  kSssp,
+  kPagerank,
+  kConnectedComponents,
+  kTriangleCount,
+  kKCore,
+  kLouvain,
+};
+
+static cll::opt<Generator> generator(
+    "generator",
+    cll::desc("Choose a graph generator (default value kronecker):"),
+    cll::values(
+        clEnumValN(kKronecker, "kronecker", "Graph500 Kronecker graph"),
+        clEnumValN(kRmat, "rmat", "R-MAT graph"),
+        clEnumValN(kUniform, "uniform", "Uniform random graph"),
+        clEnumValN(kGrid, "grid", "Two-dimensional grid")),
+    cll::init(kKronecker));
+
+static cll::list<uint32_t> scales(
+    "scales",
+    cll::desc("Comma separated list of scales: each graph has 2^scale nodes "
+              "(default value 16)"),
+    cll::CommaSeparated);
+
+static cll::opt<uint32_t> edgeFactor(
+    "edgeFactor",
+    cll::desc("Number of edges sampled per node, ignored by the grid "
+              "generator (default value 16)"),
+    cll::init(16));
+
+static cll::opt<uint64_t> seed(
+    "seed", cll::desc("Seed of the graph generator (default value 0)"),
+    cll::init(0));
+
+static cll::list<unsigned> threadCounts(
+    "threadCounts",
+    cll::desc("Comma separated list of thread counts to run with (default "
+              "value is the -t value)"),
+    cll::CommaSeparated);
+
+static cll::list<Algorithm> algorithms(
+    "algorithms",
+    cll::desc("Comma separated list of algorithms to run (default value all):"),
+    cll::values(
+        clEnumValN(kBfs, "bfs", "Breadth first search"),
+        clEnumValN(kSssp, "sssp", "Single source shortest paths"),
+        clEnumValN(kPagerank, "pagerank", "PageRank"),
+        clEnumValN(kConnectedComponents, "cc", "Connected components"),
+        clEnumValN(kTriangleCount, "tc", "Triangle counting"),
+        clEnumValN(kKCore, "kcore", "K-core decomposition"),
+        clEnumValN(kLouvain, "louvain", "Louvain clustering")),
+    cll::CommaSeparated);
+
+static cll::opt<uint32_t> repetitions(
+    "repetitions",
+    cll::desc("Number of times to run each algorithm (default value 3)"),
+    cll::init(3));
+
+static cll::opt<uint32_t> kCoreNumber(
+    "kCoreNumber", cll::desc("k of the k-core algorithm (default value 10)"),
+    cll::init(10));
+
+static cll::opt<std::string> jsonOutput(
+    "jsonOutput",
+    cll::desc("File to write the JSON results to (default value is standard "
+              "output)"),
+    cll::init(""));
+
+namespace {
+
+constexpr const char* kWeightProperty = "weight";
+constexpr const char* kOutputProperty = "synthetic-benchmark-output";
+
+std::string
+GeneratorName(Generator gen) {
+  switch (gen) {
+  case kKronecker:
+    return "kronecker";
+  case kRmat:
+    return "rmat";
+  case kUniform:
+    return "uniform";
+  case kGrid:
+    return "grid";
+  default:
+    return "unknown";
+  }
+}
+
+std::string
+AlgorithmName(Algorithm algorithm) {
+  switch (algorithm) {
+  case kBfs:
+    return "bfs";
+  case kSssp:
+    return "sssp";
+  case kPagerank:
+    return "pagerank";
+  case kConnectedComponents:
+    return "cc";
+  case kTriangleCount:
+    return "tc";
+  case kKCore:
+    return "kcore";
+  case kLouvain:
+    return "louvain";
+  default:
+    return "unknown";
+  }
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+Generate(uint32_t scale) {
+  katana::GraphGeneratorOptions options;
+  options.seed = seed;
+  options.edge_weight_property_name = kWeightProperty;
+
+  switch (generator) {
+  case kKronecker:
+    return katana::GenerateKroneckerGraph(scale, edgeFactor, options);
+  case kRmat:
+    return katana::GenerateRmatGraph(scale, edgeFactor, {}, options);
+  case kUniform:
+    if (scale > 31) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "scale {} is too large", scale);
+    }
+    return katana::GenerateUniformGraph(
+        uint32_t{1} << scale, uint64_t{edgeFactor} << scale, options);
+  case kGrid:
+    if (scale > 31) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "scale {} is too large", scale);
+    }
+    return katana::GenerateGridGraph(
+        uint32_t{1} << (scale / 2), uint32_t{1} << (scale - scale / 2),
+        options);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "unknown generator");
+  }
+}
+
+/// \returns the node of highest degree, as a source of traversals that
+/// reaches much of the graph
+uint32_t
+MaxDegreeNode(const katana::GraphTopology& topology) {
+  uint32_t source = 0;
+  uint64_t max_degree = 0;
+  for (uint32_t node = 0; node < topology.num_nodes(); ++node) {
+    uint64_t degree = topology.edges(node).size();
+    if (degree > max_degree) {
+      source = node;
+      max_degree = degree;
+    }
+  }
+  return source;
+}
+
+/// Run algorithm once, storing its output, if any, in kOutputProperty
+katana::Result<void>
+Run(katana::PropertyGraph* pg, Algorithm algorithm, uint32_t source) {
+  switch (algorithm) {
+  case kBfs:
+    return Bfs(pg, source, kOutputProperty);
+  case kSssp:
+    return Sssp(pg, source, kWeightProperty, kOutputProperty);
+  case kPagerank:
+    return Pagerank(pg, kOutputProperty);
+  case kConnectedComponents:
+    return ConnectedComponents(pg, kOutputProperty);
+  case kTriangleCount:
+    // Generated edges are already sorted by destination
+    if (auto r = TriangleCount(pg, TriangleCountPlan::OrderedCount(true));
+        !r) {
+      return r.error();
+    }
+    return katana::ResultSuccess();
+  case kKCore:
+    return KCore(pg, kCoreNumber, kOutputProperty);
+  case kLouvain:
+    return LouvainClustering(pg, kWeightProperty, kOutputProperty);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "unknown algorithm");
+  }
+}
+
+/// Check the output of Run, for the algorithms that have a checker
+katana::Result<void>
+Verify(katana::PropertyGraph* pg, Algorithm algorithm, uint32_t source) {
+  switch (algorithm) {
+  case kBfs:
+    return BfsAssertValid(pg, source, kOutputProperty);
+  case kSssp:
+    return SsspAssertValid(pg, source, kWeightProperty, kOutputProperty);
+  case kPagerank:
+    return PagerankAssertValid(pg, kOutputProperty);
+  case kConnectedComponents:
+    return ConnectedComponentsAssertValid(pg, kOutputProperty);
+  case kKCore:
+    return KCoreAssertValid(pg, kCoreNumber, kOutputProperty);
+  default:
+    return katana::ResultSuccess();
+  }
+}
+
+double
+Seconds(const katana::Timer& timer) {
+  return timer.get_usec() / 1e6;
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  // Keep standard output for the JSON results only: everything else, like the
+  // banner and the statistics printed at exit, goes to standard error so that
+  // the results can be piped to a JSON tool
+  int results_fd = dup(STDOUT_FILENO);
+  if (results_fd < 0 || dup2(STDERR_FILENO, STDOUT_FILENO) < 0) {
+    KATANA_LOG_FATAL("Failed to redirect standard output");
+  }
+
+  std::unique_ptr<katana::SharedMemSys> G =
+      LonestarStart(argc, argv, name, desc, url, nullptr);
+
+  std::vector<uint32_t> scale_list(scales.begin(), scales.end());
+  if (scale_list.empty()) {
+    scale_list.emplace_back(16);
+  }
+  std::vector<unsigned> thread_list(threadCounts.begin(), threadCounts.end());
+  if (thread_list.empty()) {
+    thread_list.emplace_back(numThreads);
+  }
+  std::vector<Algorithm> algorithm_list(algorithms.begin(), algorithms.end());
+  if (algorithm_list.empty()) {
+    algorithm_list = {
+        kBfs,           kSssp,  kPagerank, kConnectedComponents,
+        kTriangleCount, kKCore, kLouvain,
+    };
+  }
+
+  char hostname[256];
+  gethostname(hostname, sizeof(hostname));
+
+  nlohmann::json results = {
+      {"version", katana::getVersion()},
+      {"hostname", hostname},
+      {"generator", GeneratorName(generator)},
+      {"edge_factor", static_cast<uint32_t>(edgeFactor)},
+      {"seed", static_cast<uint64_t>(seed)},
+      {"graphs", nlohmann::json::array()},
+      {"runs", nlohmann::json::array()},
+  };
+
+  for (uint32_t scale : scale_list) {
+    katana::setActiveThreads(numThreads);
+
+    katana::Timer generate_timer;
+    generate_timer.start();
+    auto pg_res = Generate(scale);
+    generate_timer.stop();
+    if (!pg_res) {
+      KATANA_LOG_FATAL("Failed to generate graph: {}", pg_res.error());
+    }
+    std::unique_ptr<katana::PropertyGraph> pg = std::move(pg_res.value());
+    const katana::GraphTopology& topology = pg->topology();
+
+    std::cerr << "Generated scale " << scale << ": " << topology.num_nodes()
+              << " nodes, " << topology.num_edges() << " edges\n";
+
+    results["graphs"].push_back({
+        {"scale", scale},
+        {"nodes", topology.num_nodes()},
+        {"edges", topology.num_edges()},
+        {"threads", katana::getActiveThreads()},
+        {"seconds", Seconds(generate_timer)},
+    });
+
+    uint32_t source = MaxDegreeNode(topology);
+
+    for (unsigned requested_threads : thread_list) {
+      unsigned threads = katana::setActiveThreads(requested_threads);
+
+      for (Algorithm algorithm : algorithm_list) {
+        for (uint32_t rep = 0; rep < repetitions; ++rep) {
+          std::cerr << "Running " << AlgorithmName(algorithm) << " with "
+                    << threads << " threads\n";
+
+          katana::Timer timer;
+          timer.start();
+          auto r = Run(pg.get(), algorithm, source);
+          timer.stop();
+          if (!r) {
+            KATANA_LOG_FATAL(
+                "Failed to run {}: {}", AlgorithmName(algorithm), r.error());
+          }
+
+          // Checking every repetition would only repeat the same work
+          if (!skipVerify && rep == 0) {
+            if (auto v = Verify(pg.get(), algorithm, source); !v) {
+              KATANA_LOG_FATAL(
+                  "Verification of {} failed: {}", AlgorithmName(algorithm),
+                  v.error());
+            }
+          }
+
+          if (pg->HasNodeProperty(kOutputProperty)) {
+            if (auto rm = pg->RemoveNodeProperty(kOutputProperty); !rm) {
+              KATANA_LOG_FATAL("Failed to remove output: {}", rm.error());
+            }
+          }
+
+          results["runs"].push_back({
+              {"scale", scale},
+              {"nodes", topology.num_nodes()},
+              {"edges", topology.num_edges()},
+              {"threads", threads},
+              {"algorithm", AlgorithmName(algorithm)},
+              {"repetition", rep},
+              {"seconds", Seconds(timer)},
+          });
+        }
+      }
+    }
+  }
+
+  auto json_res = katana::JsonDump(results);
+  if (!json_res) {
+    KATANA_LOG_FATAL("Failed to serialize results: {}", json_res.error());
+  }
+
+  if (jsonOutput.empty()) {
+    std::string json = json_res.value() + "\n";
+    if (write(results_fd, json.data(), json.size()) !=
+        static_cast<ssize_t>(json.size())) {
+      KATANA_LOG_FATAL("Failed to write results: {}", std::strerror(errno));
+    }
+  } else {
+    std::ofstream out(jsonOutput);
+    out << json_res.value() << "\n";
+    if (!out) {
+      KATANA_LOG_FATAL("Failed to write {}", jsonOutput);
+    }
+  }
+  close(results_fd);
+
+  return 0;
+}
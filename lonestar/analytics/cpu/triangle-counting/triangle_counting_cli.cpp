@@ -40,9 +40,23 @@ static cll::opt<TriangleCountPlan::Algorithm> algo(
             TriangleCountPlan::kEdgeIteration, "edgeiterator", "Edge Iterator"),
         clEnumValN(
             TriangleCountPlan::kOrderedCount, "orderedCount",
-            "Ordered Simple Count (default)")),
+            "Ordered Simple Count (default)"),
+        clEnumValN(
+            TriangleCountPlan::kWedgeSampling, "wedgeSampling",
+            "Estimate by sampling wedges")),
     cll::init(TriangleCountPlan::kOrderedCount));
 
+static cll::opt<double> relative_error(
+    "relativeError",
+    cll::desc("Target half-width of the confidence interval of "
+              "wedgeSampling, relative to the estimate (default value 0.01)"),
+    cll::init(TriangleCountPlan::kDefaultRelativeError));
+static cll::opt<double> confidence(
+    "confidence",
+    cll::desc("Confidence of the interval of wedgeSampling "
+              "(default value 0.95)"),
+    cll::init(TriangleCountPlan::kDefaultConfidence));
+
 static cll::opt<bool> relabel(
     "relabel",
     cll::desc("Relabel nodes of the graph (default value of false => "
@@ -85,6 +99,23 @@ main(int argc, char** argv) {
     plan = TriangleCountPlan::OrderedCount(relabeling_flag);
     break;
 
+  case TriangleCountPlan::kWedgeSampling: {
+    plan = TriangleCountPlan::WedgeSampling(relative_error, confidence);
+    auto estimate_result = ApproximateTriangleCount(pg.get(), plan);
+    if (!estimate_result) {
+      KATANA_LOG_FATAL("failed to run algorithm: {}", estimate_result.error());
+    }
+    const auto& estimate = estimate_result.value();
+    std::cout << "NumTriangles: " << estimate.estimate << " in ["
+              << estimate.lower_bound << ", " << estimate.upper_bound
+              << "] with confidence " << confidence << " from "
+              << estimate.num_samples << " wedges\n";
+    std::cout << "ClosedWedgeFraction: " << estimate.closed_wedge_fraction
+              << "\n";
+    totalTime.stop();
+    return 0;
+  }
+
   default:
     std::cerr << "Unknown algo: " << algo << "\n";
   }
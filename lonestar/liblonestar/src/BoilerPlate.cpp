@@ -34,6 +34,18 @@ llvm::cl::opt<std::string> statFile(
     "statFile",
     llvm::cl::desc("ouput file to print stats to (default value empty)"),
     llvm::cl::init(""));
+static llvm::cl::opt<katana::StatFormat> statFormat(
+    "statFormat",
+    llvm::cl::desc(
+        "format of printed stats (default value from KATANA_STAT_FORMAT, or "
+        "text)"),
+    llvm::cl::values(
+        clEnumValN(katana::StatFormat::kText, "text", "comma-separated table"),
+        clEnumValN(
+            katana::StatFormat::kCSV, "csv", "CSV with per-thread values"),
+        clEnumValN(
+            katana::StatFormat::kJSON, "json",
+            "JSON lines per region with per-thread values")));
 
 //! Flag that forces user to be aware that they should be passing in a
 //! symmetric graph.
@@ -82,6 +94,9 @@ LonestarStart(
   numThreads = katana::setActiveThreads(numThreads);
 
   katana::SetStatFile(statFile);
+  if (statFormat.getNumOccurrences()) {
+    katana::SetStatFormat(statFormat);
+  }
 
   LonestarPrintVersion(llvm::outs());
   llvm::outs() << "Copyright (C) " << katana::getCopyrightYear()